@@ -0,0 +1,105 @@
+#include "Benchmark.hpp"
+
+#include <Pine/Core/Log/Log.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <vector>
+
+namespace
+{
+    struct RegisteredBenchmark
+    {
+        const char* Name = nullptr;
+        Benchmark::BenchmarkFunction Function = nullptr;
+    };
+
+    // Benchmarks register themselves during static initialization, so the list can't be a plain global.
+    std::vector<RegisteredBenchmark>& GetBenchmarks()
+    {
+        static std::vector<RegisteredBenchmark> benchmarks;
+
+        return benchmarks;
+    }
+
+    std::atomic<std::uint64_t> m_Sink = 0;
+}
+
+Benchmark::Registration::Registration(const char* name, BenchmarkFunction function)
+{
+    GetBenchmarks().push_back({ name, function });
+}
+
+int Benchmark::RunAll(const std::string& filter)
+{
+    auto benchmarks = GetBenchmarks();
+
+    std::sort(benchmarks.begin(), benchmarks.end(), [](const RegisteredBenchmark& a, const RegisteredBenchmark& b)
+    {
+        return std::string(a.Name) < std::string(b.Name);
+    });
+
+    int count = 0;
+
+    for (const auto& benchmark : benchmarks)
+    {
+        if (!filter.empty() && std::string(benchmark.Name).find(filter) == std::string::npos)
+            continue;
+
+        // Anything logged during setup should be out of the way before the results are printed.
+        Pine::Log::Flush();
+
+        fmt::print("\n{}\n", benchmark.Name);
+
+        benchmark.Function();
+
+        count++;
+    }
+
+    return count;
+}
+
+void Benchmark::Measure(const std::string& label, int iterations, const std::function<void()>& fn, const std::function<void()>& reset)
+{
+    if (reset)
+        reset();
+
+    fn();
+
+    std::vector<double> times;
+
+    times.reserve(iterations);
+
+    for (int i = 0; i < iterations; i++)
+    {
+        if (reset)
+            reset();
+
+        const auto start = std::chrono::steady_clock::now();
+
+        fn();
+
+        times.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+    }
+
+    double total = 0.0;
+
+    for (const auto time : times)
+    {
+        total += time;
+    }
+
+    Pine::Log::Flush();
+
+    fmt::print("  {:<48} avg {:>10.3f} ms   min {:>10.3f} ms   max {:>10.3f} ms\n",
+               label,
+               times.empty() ? 0.0 : total / times.size(),
+               times.empty() ? 0.0 : *std::min_element(times.begin(), times.end()),
+               times.empty() ? 0.0 : *std::max_element(times.begin(), times.end()));
+}
+
+void Benchmark::DoNotOptimize(std::uint64_t value)
+{
+    m_Sink.fetch_add(value, std::memory_order_relaxed);
+}
@@ -0,0 +1,33 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <fmt/format.h>
+
+#include <Pine/Performance/Performance.hpp>
+
+// Registers a benchmark, which is run by the benchmark executable if its name matches the filter.
+#define PINE_BENCHMARK(name) static void CONCAT(benchmark, __LINE__)(); \
+    static const Benchmark::Registration CONCAT(benchmarkRegistration, __LINE__)(name, CONCAT(benchmark, __LINE__)); \
+    static void CONCAT(benchmark, __LINE__)()
+
+namespace Benchmark
+{
+    using BenchmarkFunction = void(*)();
+
+    struct Registration
+    {
+        Registration(const char* name, BenchmarkFunction function);
+    };
+
+    // Runs every registered benchmark with a name containing filter, or all of them if it's empty.
+    // Returns the number of benchmarks that were run.
+    int RunAll(const std::string& filter);
+
+    // Calls fn once to warm up, then times `iterations` calls and prints the average, minimum and maximum.
+    // reset is called before every call to fn, without being timed.
+    void Measure(const std::string& label, int iterations, const std::function<void()>& fn, const std::function<void()>& reset = nullptr);
+
+    // Prevents the compiler from optimizing away a computation whose result is otherwise unused.
+    void DoNotOptimize(std::uint64_t value);
+}
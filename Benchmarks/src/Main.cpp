@@ -0,0 +1,38 @@
+#include <Pine/Pine.hpp>
+#include <Pine/Core/Log/Log.hpp>
+
+#include "Benchmark/Benchmark.hpp"
+
+#include <string>
+
+// Measures the CPU cost of engine systems without a window or GPU, through the Null graphics API.
+// Has to be run from a directory containing the engine assets, such as /assets. Pass a name, or part
+// of one, to only run the matching benchmarks.
+int main(int argc, char* argv[])
+{
+    const std::string filter = argc > 1 ? argv[1] : "";
+
+    Pine::Engine::EngineConfiguration engineConfiguration;
+
+    engineConfiguration.m_GraphicsAPI = Pine::Graphics::GraphicsAPI::Null;
+    engineConfiguration.m_Headless = true;
+    engineConfiguration.m_EnableDebugTools = false;
+
+    if (!Pine::Engine::Setup(engineConfiguration))
+    {
+        return 1;
+    }
+
+    Pine::Log::SetMinimumSeverity(Pine::LogSeverity::Warning);
+
+    const auto count = Benchmark::RunAll(filter);
+
+    if (count == 0)
+    {
+        fmt::print("No benchmarks matching '{}'.\n", filter);
+    }
+
+    Pine::Engine::Shutdown();
+
+    return count == 0 ? 1 : 0;
+}
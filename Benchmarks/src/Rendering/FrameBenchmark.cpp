@@ -0,0 +1,96 @@
+#include "Benchmark/Benchmark.hpp"
+#include "Scene/Scene.hpp"
+
+#include <Pine/Engine/Engine.hpp>
+#include <Pine/Rendering/RenderManager/RenderManager.hpp>
+#include <Pine/Rendering/RenderingContext.hpp>
+#include <Pine/World/Components/Components.hpp>
+#include <Pine/World/Components/SpriteRenderer/SpriteRenderer.hpp>
+#include <Pine/World/Entities/Entities.hpp>
+
+namespace
+{
+    constexpr std::uint32_t FrameCount = 100;
+
+    // Moved a bit every frame from a render callback, so the transforms and the spatial index have work to do.
+    std::vector<Pine::Entity*> m_MovingEntities;
+    float m_Offset = 0.f;
+
+    void MoveEntities(Pine::RenderingContext*, Pine::RenderStage stage, float)
+    {
+        if (stage != Pine::RenderStage::PreRender)
+        {
+            return;
+        }
+
+        m_Offset += 0.01f;
+
+        for (const auto entity : m_MovingEntities)
+        {
+            const auto transform = entity->GetTransform();
+            const auto position = transform->GetLocalPosition();
+
+            transform->SetLocalPosition(Pine::Vector3f(position.x, m_Offset, position.z));
+        }
+    }
+}
+
+// Runs whole frames through Engine::Run(), the same way the headless mode does, so the render manager,
+// Pipeline3D and Pipeline2D all get measured together on the Null graphics API.
+PINE_BENCHMARK("Rendering: 30k model renderers, 2k sprites, headless frames")
+{
+    // Render callbacks can't be removed, so the callback is added once and does nothing without moving entities.
+    static bool callbackAdded = false;
+
+    if (!callbackAdded)
+    {
+        Pine::RenderManager::AddRenderCallback(MoveEntities);
+        callbackAdded = true;
+    }
+
+    const auto entities = Benchmark::Scene::CreateEntities(30000, 100, 2.f);
+
+    for (std::uint32_t i = 0; i < entities.size(); i += 10)
+    {
+        m_MovingEntities.push_back(entities[i]);
+    }
+
+    // There are no textures among the engine assets, so the sprites only go through Pipeline2D's gathering
+    // and sorting, not the actual drawing.
+    for (int i = 0; i < 2000; i++)
+    {
+        const auto entity = Pine::Entities::Create("Sprite");
+
+        entity->AddComponent<Pine::SpriteRenderer>()->SetOrder(i % 8);
+    }
+
+    const auto cameraEntity = Pine::Entities::Create("Camera");
+    const auto camera = cameraEntity->AddComponent<Pine::Camera>();
+
+    cameraEntity->GetTransform()->SetLocalPosition(Pine::Vector3f(170.f, 20.f, 400.f));
+    cameraEntity->GetTransform()->SetEulerAngles(Pine::Vector3f(-20.f, 0.f, 0.f));
+
+    camera->SetOverrideAspectRatio(16.f / 9.f);
+
+    const auto renderingContext = Pine::RenderManager::GetPrimaryRenderingContext();
+    const auto previousCamera = renderingContext->SceneCamera;
+
+    renderingContext->SceneCamera = camera;
+
+    auto& engineConfiguration = Pine::Engine::GetEngineConfiguration();
+    const auto previousFrameCount = engineConfiguration.m_HeadlessFrameCount;
+
+    engineConfiguration.m_HeadlessFrameCount = FrameCount;
+
+    Benchmark::Measure(fmt::format("Engine::Run(), {} headless frames", FrameCount), 5, []
+    {
+        Pine::Engine::Run();
+    });
+
+    engineConfiguration.m_HeadlessFrameCount = previousFrameCount;
+    renderingContext->SceneCamera = previousCamera;
+
+    m_MovingEntities.clear();
+
+    Benchmark::Scene::Clear();
+}
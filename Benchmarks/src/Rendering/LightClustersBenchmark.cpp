@@ -0,0 +1,76 @@
+#include "Benchmark/Benchmark.hpp"
+#include "Scene/Scene.hpp"
+
+#include <Pine/Rendering/Features/LightClusters/LightClusters.hpp>
+#include <Pine/Rendering/Renderer3D/Renderer3D.hpp>
+#include <Pine/World/Components/Components.hpp>
+#include <Pine/World/Components/ModelRenderer/ModelRenderer.hpp>
+#include <Pine/World/Entities/Entities.hpp>
+#include <Pine/World/SpatialIndex/SpatialIndex.hpp>
+
+#include <array>
+#include <limits>
+
+PINE_BENCHMARK("Rendering: 30k model renderers, clustered lights vs nearest lights per model")
+{
+    // A light on every 100th entity, so 300 lights of which at most the renderer's limit get clustered.
+    Benchmark::Scene::CreateEntities(30000, 100, 2.f);
+
+    const auto cameraEntity = Pine::Entities::Create("Camera");
+    const auto camera = cameraEntity->AddComponent<Pine::Camera>();
+
+    cameraEntity->GetTransform()->SetLocalPosition(Pine::Vector3f(170.f, 20.f, 400.f));
+    cameraEntity->GetTransform()->SetEulerAngles(Pine::Vector3f(-20.f, 0.f, 0.f));
+
+    camera->SetOverrideAspectRatio(16.f / 9.f);
+    camera->OnRender(0.f);
+
+    Pine::SpatialIndex::Update();
+
+    // Same as the search that used to be done for every model renderer, which kept the three closest lights.
+    Benchmark::Measure("Nearest three lights per model renderer", 5, []
+    {
+        std::uint64_t checksum = 0;
+
+        for (const auto& modelRenderer : Pine::Components::Get<Pine::ModelRenderer>())
+        {
+            const auto position = modelRenderer.GetParent()->GetTransform()->GetPosition();
+
+            std::array<float, 3> closest;
+
+            closest.fill(std::numeric_limits<float>::max());
+
+            for (const auto& light : Pine::Components::Get<Pine::Light>())
+            {
+                auto distance = glm::distance2(light.GetParent()->GetTransform()->GetPosition(), position);
+
+                for (auto& slot : closest)
+                {
+                    if (distance < slot)
+                    {
+                        std::swap(distance, slot);
+                    }
+                }
+            }
+
+            checksum += static_cast<std::uint64_t>(closest[0]);
+        }
+
+        Benchmark::DoNotOptimize(checksum);
+    });
+
+    Benchmark::Measure("LightClusters::Build()", 20, [&]
+    {
+        Pine::Rendering::LightClusters::Build(camera);
+    }, Pine::Renderer3D::FrameReset);
+
+    const auto& statistics = Pine::Rendering::LightClusters::GetStatistics();
+
+    fmt::print("  {} lights clustered, {} skipped, {} light indices, at most {} lights in a cluster{}\n",
+               statistics.Lights, statistics.SkippedLights, statistics.LightIndices, statistics.MaxClusterLights,
+               statistics.Overflowed ? ", overflowed" : "");
+
+    Pine::Renderer3D::FrameReset();
+
+    Benchmark::Scene::Clear();
+}
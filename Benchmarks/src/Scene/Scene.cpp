@@ -0,0 +1,47 @@
+#include "Scene.hpp"
+
+#include <Pine/Assets/Assets.hpp>
+#include <Pine/Assets/Model/Model.hpp>
+#include <Pine/World/Components/Light/Light.hpp>
+#include <Pine/World/Components/ModelRenderer/ModelRenderer.hpp>
+#include <Pine/World/Entities/Entities.hpp>
+
+#include <cmath>
+
+std::vector<Pine::Entity*> Benchmark::Scene::CreateEntities(std::uint32_t count, std::uint32_t lightInterval, float spacing)
+{
+    const auto model = Pine::Assets::Get<Pine::Model>("engine/primitive/cube.glb");
+    const auto gridSize = static_cast<std::uint32_t>(std::ceil(std::sqrt(static_cast<float>(count))));
+
+    std::vector<Pine::Entity*> entities;
+
+    entities.reserve(count);
+
+    Pine::Entities::Reserve(count);
+
+    for (std::uint32_t i = 0; i < count; i++)
+    {
+        const auto entity = Pine::Entities::Create("Entity");
+
+        entity->GetTransform()->SetLocalPosition(Pine::Vector3f(static_cast<float>(i % gridSize) * spacing, 0.f, static_cast<float>(i / gridSize) * spacing));
+
+        entity->AddComponent<Pine::ModelRenderer>()->SetModel(model);
+
+        if (lightInterval != 0 && i % lightInterval == 0)
+        {
+            const auto light = entity->AddComponent<Pine::Light>();
+
+            light->SetLightType(Pine::LightType::PointLight);
+            light->SetLightColor(Pine::Vector3f(static_cast<float>(i % 3) / 2.f, 0.5f, 1.f));
+        }
+
+        entities.push_back(entity);
+    }
+
+    return entities;
+}
+
+void Benchmark::Scene::Clear()
+{
+    Pine::Entities::DeleteAll(true);
+}
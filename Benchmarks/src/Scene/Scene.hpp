@@ -0,0 +1,17 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include <Pine/World/Entity/Entity.hpp>
+
+namespace Benchmark::Scene
+{
+
+    // Creates count entities spread out on a grid, each rendering the engine's cube primitive. Every
+    // lightInterval-th entity gets a point light as well, none do if it's zero.
+    std::vector<Pine::Entity*> CreateEntities(std::uint32_t count, std::uint32_t lightInterval = 0, float spacing = 4.f);
+
+    // Deletes every entity in the world.
+    void Clear();
+
+}
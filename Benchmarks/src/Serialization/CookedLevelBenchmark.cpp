@@ -0,0 +1,47 @@
+#include "Benchmark/Benchmark.hpp"
+#include "Scene/Scene.hpp"
+
+#include <Pine/Assets/Level/Level.hpp>
+
+#include <filesystem>
+
+PINE_BENCHMARK("Serialization: 10k entity level, JSON vs cooked")
+{
+    const auto directory = std::filesystem::temp_directory_path();
+    const auto jsonPath = directory / "pine-benchmark.lvl";
+    const auto cookedPath = directory / "pine-benchmark-cooked.lvl";
+
+    Benchmark::Scene::CreateEntities(10000, 16);
+
+    {
+        Pine::Level level;
+
+        level.SetFilePath(jsonPath);
+        level.CreateFromWorld();
+        level.SaveToFile();
+        level.Cook(cookedPath);
+        level.Dispose();
+    }
+
+    Benchmark::Scene::Clear();
+
+    fmt::print("  JSON {:.1f} kB, cooked {:.1f} kB\n", std::filesystem::file_size(jsonPath) / 1024.0, std::filesystem::file_size(cookedPath) / 1024.0);
+
+    Pine::Level loadedLevel;
+
+    const auto load = [&](const std::filesystem::path& path)
+    {
+        loadedLevel.SetFilePath(path);
+        loadedLevel.LoadFromFile(Pine::AssetLoadStage::Default);
+
+        Benchmark::DoNotOptimize(loadedLevel.GetBlueprintCount());
+    };
+
+    Benchmark::Measure("Load JSON level", 5, [&] { load(jsonPath); }, [&] { loadedLevel.ClearBlueprints(); });
+    Benchmark::Measure("Load cooked level", 5, [&] { load(cookedPath); }, [&] { loadedLevel.ClearBlueprints(); });
+
+    loadedLevel.Dispose();
+
+    std::filesystem::remove(jsonPath);
+    std::filesystem::remove(cookedPath);
+}
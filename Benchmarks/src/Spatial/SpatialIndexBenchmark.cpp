@@ -0,0 +1,151 @@
+#include "Benchmark/Benchmark.hpp"
+#include "Scene/Scene.hpp"
+
+#include <Pine/Core/DynamicAABBTree/DynamicAABBTree.hpp>
+#include <Pine/World/Components/Components.hpp>
+#include <Pine/World/Components/Light/Light.hpp>
+#include <Pine/World/Components/ModelRenderer/ModelRenderer.hpp>
+#include <Pine/World/SpatialIndex/SpatialIndex.hpp>
+
+#include <random>
+
+PINE_BENCHMARK("Spatial: 30k box AABB tree vs brute force")
+{
+    constexpr std::uint32_t BoxCount = 30000;
+    constexpr std::uint32_t QueryCount = 1000;
+
+    std::mt19937 random(1337);
+    std::uniform_real_distribution<float> position(-500.f, 500.f);
+    std::uniform_real_distribution<float> size(0.5f, 4.f);
+
+    std::vector<Pine::AABB> boxes(BoxCount);
+
+    for (auto& box : boxes)
+    {
+        box.Min = Pine::Vector3f(position(random), position(random), position(random));
+        box.Max = box.Min + Pine::Vector3f(size(random), size(random), size(random));
+    }
+
+    std::vector<Pine::Vector3f> queryCenters(QueryCount);
+
+    for (auto& center : queryCenters)
+    {
+        center = Pine::Vector3f(position(random), position(random), position(random));
+    }
+
+    Pine::DynamicAABBTree tree;
+    std::vector<std::int32_t> proxies(BoxCount);
+
+    Benchmark::Measure("Build tree", 5, [&]
+    {
+        for (std::uint32_t i = 0; i < BoxCount; i++)
+        {
+            proxies[i] = tree.CreateProxy(boxes[i], &boxes[i]);
+        }
+    }, [&] { tree.Clear(); });
+
+    fmt::print("  Tree height {}\n", tree.GetHeight());
+
+    constexpr float QueryRadius = 25.f;
+
+    Benchmark::Measure("1000 sphere queries, brute force", 5, [&]
+    {
+        std::uint64_t hits = 0;
+
+        for (const auto& center : queryCenters)
+        {
+            for (const auto& box : boxes)
+            {
+                if (glm::distance2(glm::clamp(center, box.Min, box.Max), center) <= QueryRadius * QueryRadius)
+                {
+                    hits++;
+                }
+            }
+        }
+
+        Benchmark::DoNotOptimize(hits);
+    });
+
+    Benchmark::Measure("1000 sphere queries, AABB tree", 5, [&]
+    {
+        std::uint64_t hits = 0;
+
+        for (const auto& center : queryCenters)
+        {
+            tree.QuerySphere(center, QueryRadius, [&](std::int32_t, void*) { hits++; });
+        }
+
+        Benchmark::DoNotOptimize(hits);
+    });
+
+    // Small movements stay within the fattened bounds, so most of these shouldn't touch the tree at all.
+    float offset = 0.f;
+
+    Benchmark::Measure("Move every proxy by a small step", 5, [&]
+    {
+        offset = offset > 0.f ? -0.05f : 0.05f;
+
+        std::uint64_t reinserted = 0;
+
+        for (std::uint32_t i = 0; i < BoxCount; i++)
+        {
+            auto& box = boxes[i];
+
+            box.Min.x += offset;
+            box.Max.x += offset;
+
+            reinserted += tree.MoveProxy(proxies[i], box);
+        }
+
+        Benchmark::DoNotOptimize(reinserted);
+    });
+}
+
+PINE_BENCHMARK("Spatial: 30k model renderers, light assignment")
+{
+    Benchmark::Scene::CreateEntities(30000, 100, 2.f);
+
+    Pine::SpatialIndex::Update();
+
+    std::vector<Pine::IComponent*> results;
+
+    Benchmark::Measure("Lights per model renderer, brute force", 5, [&]
+    {
+        std::uint64_t count = 0;
+
+        for (const auto& modelRenderer : Pine::Components::Get<Pine::ModelRenderer>())
+        {
+            const auto position = modelRenderer.GetParent()->GetTransform()->GetPosition();
+
+            for (const auto& light : Pine::Components::Get<Pine::Light>())
+            {
+                const auto range = light.GetRange();
+
+                if (glm::distance2(light.GetParent()->GetTransform()->GetPosition(), position) <= range * range)
+                {
+                    count++;
+                }
+            }
+        }
+
+        Benchmark::DoNotOptimize(count);
+    });
+
+    Benchmark::Measure("Lights per model renderer, spatial index", 5, [&]
+    {
+        std::uint64_t count = 0;
+
+        for (const auto& modelRenderer : Pine::Components::Get<Pine::ModelRenderer>())
+        {
+            results.clear();
+
+            Pine::SpatialIndex::QuerySphere(Pine::ComponentType::Light, modelRenderer.GetParent()->GetTransform()->GetPosition(), 0.f, results);
+
+            count += results.size();
+        }
+
+        Benchmark::DoNotOptimize(count);
+    });
+
+    Benchmark::Scene::Clear();
+}
@@ -0,0 +1,232 @@
+#include "Benchmark/Benchmark.hpp"
+
+#include <Pine/Threading/Threading.hpp>
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    constexpr std::uint32_t ElementCount = 4 * 1024 * 1024;
+    constexpr std::uint32_t ElementsPerTask = 64;
+    constexpr std::uint32_t TaskCount = ElementCount / ElementsPerTask;
+
+    // The thread pool the job system replaced: a single queue behind one mutex, with a heap allocated
+    // task, mutex and condition variable for every task. Kept here to compare against.
+    class LegacyThreadPool
+    {
+    public:
+        using TaskFunc = void(*)(void*);
+
+        struct Task
+        {
+            TaskFunc WorkFunction = nullptr;
+            void* WorkData = nullptr;
+
+            bool Finished = false;
+
+            std::mutex Mutex;
+            std::condition_variable ConditionVariable;
+        };
+    private:
+        bool m_IsRunning = true;
+
+        std::vector<std::thread> m_Threads;
+
+        std::mutex m_TaskQueueMutex;
+        std::condition_variable m_TaskQueueUpdated;
+        std::deque<std::shared_ptr<Task>> m_TasksQueue;
+
+        void Worker()
+        {
+            while (true)
+            {
+                std::unique_lock lock(m_TaskQueueMutex);
+
+                m_TaskQueueUpdated.wait(lock, [this]{ return !m_IsRunning || !m_TasksQueue.empty(); });
+
+                if (!m_IsRunning)
+                {
+                    return;
+                }
+
+                auto task = m_TasksQueue.front();
+
+                m_TasksQueue.pop_front();
+
+                lock.unlock();
+
+                task->WorkFunction(task->WorkData);
+
+                std::unique_lock taskLock(task->Mutex);
+
+                task->Finished = true;
+                task->ConditionVariable.notify_all();
+            }
+        }
+    public:
+        explicit LegacyThreadPool(int workerCount)
+        {
+            for (int i = 0; i < workerCount; i++)
+            {
+                m_Threads.emplace_back(&LegacyThreadPool::Worker, this);
+            }
+        }
+
+        ~LegacyThreadPool()
+        {
+            std::unique_lock lock(m_TaskQueueMutex);
+
+            m_IsRunning = false;
+            m_TaskQueueUpdated.notify_all();
+
+            lock.unlock();
+
+            for (auto& thread : m_Threads)
+            {
+                thread.join();
+            }
+        }
+
+        std::shared_ptr<Task> AddTask(TaskFunc function, void* data)
+        {
+            auto task = std::make_shared<Task>();
+
+            task->WorkFunction = function;
+            task->WorkData = data;
+
+            std::unique_lock lock(m_TaskQueueMutex);
+
+            m_TasksQueue.push_back(task);
+
+            lock.unlock();
+
+            m_TaskQueueUpdated.notify_one();
+
+            return task;
+        }
+
+        static void AwaitResult(const std::shared_ptr<Task>& task)
+        {
+            std::unique_lock lock(task->Mutex);
+
+            task->ConditionVariable.wait(lock, [&]{ return task->Finished; });
+        }
+    };
+
+    struct Chunk
+    {
+        const std::uint32_t* Data = nullptr;
+        std::uint64_t Result = 0;
+    };
+
+    std::uint64_t SumChunk(const std::uint32_t* data)
+    {
+        return std::accumulate(data, data + ElementsPerTask, std::uint64_t(0));
+    }
+
+    std::uint64_t SumResults(const std::vector<Chunk>& chunks)
+    {
+        std::uint64_t sum = 0;
+
+        for (const auto& chunk : chunks)
+        {
+            sum += chunk.Result;
+        }
+
+        return sum;
+    }
+}
+
+PINE_BENCHMARK("Threading: 65536 small tasks")
+{
+    std::vector<std::uint32_t> data(ElementCount);
+    std::iota(data.begin(), data.end(), 0u);
+
+    std::vector<Chunk> chunks(TaskCount);
+
+    for (std::uint32_t i = 0; i < TaskCount; i++)
+    {
+        chunks[i].Data = data.data() + i * ElementsPerTask;
+    }
+
+    const auto resetChunks = [&]
+    {
+        for (auto& chunk : chunks)
+        {
+            chunk.Result = 0;
+        }
+    };
+
+    Benchmark::Measure("Single thread", 10, [&]
+    {
+        for (auto& chunk : chunks)
+        {
+            chunk.Result = SumChunk(chunk.Data);
+        }
+
+        Benchmark::DoNotOptimize(SumResults(chunks));
+    }, resetChunks);
+
+    {
+        LegacyThreadPool legacyPool(Pine::Threading::GetWorkerCount());
+
+        std::vector<std::shared_ptr<LegacyThreadPool::Task>> tasks(TaskCount);
+
+        Benchmark::Measure("Legacy pool, AddTask per task", 10, [&]
+        {
+            for (std::uint32_t i = 0; i < TaskCount; i++)
+            {
+                tasks[i] = legacyPool.AddTask([](void* chunk)
+                {
+                    static_cast<Chunk*>(chunk)->Result = SumChunk(static_cast<Chunk*>(chunk)->Data);
+                }, &chunks[i]);
+            }
+
+            for (const auto& task : tasks)
+            {
+                LegacyThreadPool::AwaitResult(task);
+            }
+
+            Benchmark::DoNotOptimize(SumResults(chunks));
+        }, resetChunks);
+    }
+
+    Benchmark::Measure("Job system, Run per task", 10, [&]
+    {
+        Pine::Threading::TaskGroup group;
+
+        for (auto& chunk : chunks)
+        {
+            Pine::Threading::Run(group, [&chunk]
+            {
+                chunk.Result = SumChunk(chunk.Data);
+            });
+        }
+
+        Pine::Threading::Wait(group);
+
+        Benchmark::DoNotOptimize(SumResults(chunks));
+    }, resetChunks);
+
+    for (const std::uint32_t grainSize : { 1u, 64u, 1024u })
+    {
+        Benchmark::Measure(fmt::format("Job system, ParallelFor grain {}", grainSize), 10, [&]
+        {
+            Pine::Threading::ParallelFor(TaskCount, grainSize, [&](std::uint32_t begin, std::uint32_t end)
+            {
+                for (std::uint32_t i = begin; i < end; i++)
+                {
+                    chunks[i].Result = SumChunk(chunks[i].Data);
+                }
+            });
+
+            Benchmark::DoNotOptimize(SumResults(chunks));
+        }, resetChunks);
+    }
+}
@@ -0,0 +1,42 @@
+#include "Benchmark/Benchmark.hpp"
+#include "Scene/Scene.hpp"
+
+#include <Pine/Assets/Blueprint/Blueprint.hpp>
+
+PINE_BENCHMARK("World: 20k entity level spawn, per blueprint vs batched")
+{
+    std::vector<Pine::Blueprint*> blueprints;
+
+    for (const auto entity : Benchmark::Scene::CreateEntities(20000, 16))
+    {
+        auto blueprint = new Pine::Blueprint();
+
+        blueprint->CreateFromEntity(entity);
+
+        blueprints.push_back(blueprint);
+    }
+
+    Benchmark::Scene::Clear();
+
+    Benchmark::Measure("Blueprint::Spawn() per blueprint", 5, [&]
+    {
+        for (const auto blueprint : blueprints)
+        {
+            Benchmark::DoNotOptimize(blueprint->Spawn()->GetId());
+        }
+    }, Benchmark::Scene::Clear);
+
+    Benchmark::Measure("Blueprint::SpawnMultiple()", 5, [&]
+    {
+        Benchmark::DoNotOptimize(Pine::Blueprint::SpawnMultiple(blueprints).size());
+    }, Benchmark::Scene::Clear);
+
+    Benchmark::Scene::Clear();
+
+    for (const auto blueprint : blueprints)
+    {
+        blueprint->Dispose();
+
+        delete blueprint;
+    }
+}
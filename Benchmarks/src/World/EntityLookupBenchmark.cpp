@@ -0,0 +1,162 @@
+#include "Benchmark/Benchmark.hpp"
+#include "Scene/Scene.hpp"
+
+#include <Pine/World/Entities/Entities.hpp>
+
+#include <algorithm>
+#include <random>
+
+namespace
+{
+
+    constexpr std::uint32_t EntityCount = 50000;
+    constexpr std::uint32_t LookupCount = 10000;
+
+    std::vector<Pine::Entity*> CreateNamedEntities()
+    {
+        std::vector<Pine::Entity*> entities;
+
+        entities.reserve(EntityCount);
+
+        Pine::Entities::Reserve(EntityCount);
+
+        for (std::uint32_t i = 0; i < EntityCount; i++)
+        {
+            const auto entity = Pine::Entities::Create(fmt::format("Entity {}", i));
+
+            entity->SetTags(1ull << (i % 64));
+
+            entities.push_back(entity);
+        }
+
+        return entities;
+    }
+
+}
+
+PINE_BENCHMARK("World: 50k entity lookups, index vs linear scan")
+{
+    auto entities = CreateNamedEntities();
+
+    std::mt19937 random(1337);
+    std::uniform_int_distribution<std::uint32_t> distribution(0, EntityCount - 1);
+
+    std::vector<std::uint32_t> ids(LookupCount);
+    std::vector<std::string> names(LookupCount);
+
+    for (std::uint32_t i = 0; i < LookupCount; i++)
+    {
+        const auto entity = entities[distribution(random)];
+
+        ids[i] = entity->GetId();
+        names[i] = entity->GetName();
+    }
+
+    // What Find() used to do, a walk through the entity list.
+    Benchmark::Measure("10k finds by id, linear scan", 3, [&]
+    {
+        std::uint64_t found = 0;
+
+        for (const auto id : ids)
+        {
+            for (const auto entity : Pine::Entities::GetList())
+            {
+                if (entity->GetId() == id)
+                {
+                    found++;
+                    break;
+                }
+            }
+        }
+
+        Benchmark::DoNotOptimize(found);
+    });
+
+    Benchmark::Measure("10k finds by id", 10, [&]
+    {
+        std::uint64_t found = 0;
+
+        for (const auto id : ids)
+        {
+            found += Pine::Entities::Find(id) != nullptr;
+        }
+
+        Benchmark::DoNotOptimize(found);
+    });
+
+    Benchmark::Measure("10k finds by name, linear scan", 3, [&]
+    {
+        std::uint64_t found = 0;
+
+        for (const auto& name : names)
+        {
+            for (const auto entity : Pine::Entities::GetList())
+            {
+                if (entity->GetName() == name)
+                {
+                    found++;
+                    break;
+                }
+            }
+        }
+
+        Benchmark::DoNotOptimize(found);
+    });
+
+    Benchmark::Measure("10k finds by name", 10, [&]
+    {
+        std::uint64_t found = 0;
+
+        for (const auto& name : names)
+        {
+            found += Pine::Entities::Find(name) != nullptr;
+        }
+
+        Benchmark::DoNotOptimize(found);
+    });
+
+    Benchmark::Measure("64 finds by tag", 10, [&]
+    {
+        std::uint64_t found = 0;
+
+        for (std::uint32_t bit = 0; bit < 64; bit++)
+        {
+            found += Pine::Entities::FindByTag(1ull << bit).size();
+        }
+
+        Benchmark::DoNotOptimize(found);
+    });
+
+    Benchmark::Measure("64 finds by tag, linear scan", 10, [&]
+    {
+        std::uint64_t found = 0;
+
+        for (std::uint32_t bit = 0; bit < 64; bit++)
+        {
+            for (const auto entity : Pine::Entities::GetList())
+            {
+                found += (entity->GetTags() & (1ull << bit)) != 0;
+            }
+        }
+
+        Benchmark::DoNotOptimize(found);
+    });
+
+    // Deletes every entity in a random order, so most of them are nowhere near the end of the list.
+    Benchmark::Measure("Delete 50k entities in random order", 3, [&]
+    {
+        for (const auto entity : entities)
+        {
+            Pine::Entities::Delete(entity);
+        }
+    }, [&]
+    {
+        Benchmark::Scene::Clear();
+
+        entities = CreateNamedEntities();
+
+        std::shuffle(entities.begin(), entities.end(), random);
+    });
+
+    Benchmark::Scene::Clear();
+}
@@ -0,0 +1,70 @@
+#include "Benchmark/Benchmark.hpp"
+#include "Scene/Scene.hpp"
+
+#include <Pine/World/Components/Components.hpp>
+#include <Pine/World/Entities/Entities.hpp>
+
+namespace
+{
+
+    void RunTransformBenchmark(std::uint32_t count)
+    {
+        std::vector<Pine::Entity*> entities;
+
+        entities.reserve(count);
+
+        Pine::Entities::Reserve(count);
+
+        for (std::uint32_t i = 0; i < count; i++)
+        {
+            entities.push_back(Pine::Entities::Create("Entity"));
+        }
+
+        // Every fourth entity is parented to the one before it, so the hierarchy pass has something to do as well.
+        for (std::uint32_t i = 3; i < count; i += 4)
+        {
+            entities[i - 1]->AddChild(entities[i]);
+        }
+
+        float angle = 0.f;
+
+        const auto moveAll = [&]
+        {
+            angle += 1.f;
+
+            for (std::uint32_t i = 0; i < count; i++)
+            {
+                const auto transform = entities[i]->GetTransform();
+
+                transform->SetLocalPosition(Pine::Vector3f(static_cast<float>(i), angle, 0.f));
+                transform->SetEulerAngles(Pine::Vector3f(0.f, angle, 0.f));
+            }
+        };
+
+        Benchmark::Measure(fmt::format("{}k transforms, Transform::OnRender() per transform", count / 1000), 20, [&]
+        {
+            for (auto& transform : Pine::Components::Get<Pine::Transform>())
+            {
+                transform.OnRender(0.f);
+            }
+
+            Benchmark::DoNotOptimize(static_cast<std::uint64_t>(entities.back()->GetTransform()->GetTransformationMatrix()[3][0]));
+        }, moveAll);
+
+        Benchmark::Measure(fmt::format("{}k transforms, Transform::UpdateWorldTransforms()", count / 1000), 20, [&]
+        {
+            Pine::Transform::UpdateWorldTransforms();
+
+            Benchmark::DoNotOptimize(static_cast<std::uint64_t>(entities.back()->GetTransform()->GetTransformationMatrix()[3][0]));
+        }, moveAll);
+
+        Benchmark::Scene::Clear();
+    }
+
+}
+
+PINE_BENCHMARK("World: transform updates, per transform vs batched")
+{
+    RunTransformBenchmark(10000);
+    RunTransformBenchmark(100000);
+}
@@ -569,6 +569,11 @@ namespace
                 Editor::OsNative::OpenFileExplorer(std::filesystem::absolute(m_CurrentDirectory->Path));
             }
 
+            if (ImGui::MenuItem("Cook Assets"))
+            {
+                Commands::Cook();
+            }
+
             ImGui::Separator();
 
             if (ImGui::MenuItem("Rename", "F2", false, isTargetingAsset || isTargetingDirectory))
@@ -46,8 +46,6 @@ void Panels::Console::Render()
 
     if (ImGui::Begin(ICON_MD_TERMINAL " Console", &m_Active))
     {
-        const auto& messages = Pine::Log::GetLogMessages();
-
         ImGui::Checkbox("View Verbose", &m_ViewVerbose);
         ImGui::SameLine(0.f, 10.f);
         ImGui::Checkbox("Auto Scroll", &m_AutoScroll);
@@ -56,10 +54,10 @@ void Panels::Console::Render()
 
         HandleAutoScroll();
 
-        for (const auto& message : messages)
+        Pine::Log::ForEachMessage([](const Pine::LogMessage& message)
         {
             if (!m_ViewVerbose && message.Type == Pine::LogSeverity::Verbose)
-                continue;
+                return;
 
             bool restoreColor = true;
 
@@ -103,7 +101,7 @@ void Panels::Console::Render()
             {
                 ImGui::PopStyleColor();
             }
-        }
+        });
 
         ImGui::EndChild();
     }
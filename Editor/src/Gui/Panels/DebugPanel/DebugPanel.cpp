@@ -4,14 +4,12 @@
 #include <imgui.h>
 
 #include "IconsMaterialDesign.h"
-#include "Gui/Shared/Selection/Selection.hpp"
 #include "Pine/Physics/Physics3D/Physics3D.hpp"
 #include "Pine/Rendering/Features/AmbientOcclusion/AmbientOcclusion.hpp"
+#include "Pine/Rendering/Features/LightClusters/LightClusters.hpp"
 #include "Pine/Rendering/Pipeline/Pipeline2D/Pipeline2D.hpp"
 #include "Pine/Rendering/Pipeline/Pipeline3D/Pipeline3D.hpp"
-
-#include "Pine/World/Components/ModelRenderer/ModelRenderer.hpp"
-#include "Pine/World/Components/Light/Light.hpp"
+#include "Pine/World/Entities/Entities.hpp"
 
 namespace
 {
@@ -19,6 +17,23 @@ namespace
 
     bool m_AmbientOcclusionTexture = false;
     bool m_DepthPositionTexture = false;
+
+    void RenderStorageUsageRow(const char* name, const Pine::StorageUsage& usage)
+    {
+        ImGui::TableNextRow();
+
+        ImGui::TableSetColumnIndex(0);
+        ImGui::Text("%s", name);
+
+        ImGui::TableSetColumnIndex(1);
+        ImGui::Text("%u", usage.Pages);
+
+        ImGui::TableSetColumnIndex(2);
+        ImGui::Text("%u / %u", usage.Used, usage.Capacity);
+
+        ImGui::TableSetColumnIndex(3);
+        ImGui::Text("%.1f kB", usage.AllocatedSize / 1024.0);
+    }
 }
 
 void Panels::Debug::SetActive(bool value)
@@ -40,52 +55,15 @@ void Panels::Debug::Render()
     {
         if (ImGui::CollapsingHeader("Lightning"))
         {
+            const auto& lightClusters = Pine::Rendering::LightClusters::GetStatistics();
 
-            const auto& selectedEntities = Selection::GetSelectedEntities();
-            if (!selectedEntities.empty())
-            {
-                auto selectedEntity = selectedEntities.front();
-
-                if (auto modelRenderer = selectedEntity->GetComponent<Pine::ModelRenderer>())
-                {
-                    auto& lightData = modelRenderer->GetRenderingHintData();
-
-                    ImGui::Text("Has Computed Light Data: %d", lightData.HasComputedData);
-
-                    // Point Lights
-                    for (int i = 0; i < 5;i++)
-                    {
-                        if (auto light = lightData.LightSlotIndex[i].Get())
-                        {
-                            ImGui::Text("Point Light #%d: %s", i, light->GetParent()->GetName().c_str());
-                        }
-                        else
-                        {
-                            ImGui::Text("Point Light #%d: N/A", i);
-                        }
-                    }
-
-                    // Spotlights
-                    if (auto light = lightData.LightSlotIndex[5].Get())
-                    {
-                        ImGui::Text("Spot Light #1: %s", light->GetParent()->GetName().c_str());
-                    }
-                    else
-                    {
-                        ImGui::Text("Spot Light #2: N/A");
-                    }
-
-                    if (ImGui::Button("Invalidate object lightning data"))
-                    {
-                        lightData.HasComputedData = false;
-                    }
-                }
-
-                if (auto light = selectedEntity->GetComponent<Pine::Light>())
-                {
+            ImGui::Text("Light Clusters");
 
-                }
-            }
+            ImGui::Text("Lights: %d", lightClusters.Lights);
+            ImGui::Text("Skipped Lights: %d", lightClusters.SkippedLights);
+            ImGui::Text("Light Indices: %d", lightClusters.LightIndices);
+            ImGui::Text("Max Lights per Cluster: %d", lightClusters.MaxClusterLights);
+            ImGui::Text("Overflowed: %s", lightClusters.Overflowed ? "Yes" : "No");
 
             ImGui::Separator();
 
@@ -95,6 +73,27 @@ void Panels::Debug::Render()
             ImGui::Checkbox("View Position Texture", &m_DepthPositionTexture);
         }
 
+        if (ImGui::CollapsingHeader("Memory"))
+        {
+            if (ImGui::BeginTable("##StorageUsageTable", 4, ImGuiTableFlags_RowBg | ImGuiTableFlags_Resizable))
+            {
+                ImGui::TableSetupColumn("Storage", ImGuiTableColumnFlags_WidthStretch);
+                ImGui::TableSetupColumn("Pages");
+                ImGui::TableSetupColumn("Slots used");
+                ImGui::TableSetupColumn("Allocated");
+                ImGui::TableHeadersRow();
+
+                RenderStorageUsageRow("Entities", Pine::Entities::GetStorageUsage());
+
+                for (const auto block : Pine::Components::GetComponentTypes())
+                {
+                    RenderStorageUsageRow(Pine::ComponentTypeToString(block->m_Component->GetType()), block->GetStorageUsage());
+                }
+
+                ImGui::EndTable();
+            }
+        }
+
         if (ImGui::CollapsingHeader("Physics"))
         {
             if (ImGui::Button("Connect to PhysX debugger"))
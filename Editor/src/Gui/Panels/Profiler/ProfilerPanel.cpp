@@ -3,36 +3,191 @@
 #include "IconsMaterialDesign.h"
 #include "Pine/Performance/Performance.hpp"
 
+#include <string>
+
 namespace
 {
     bool m_Active = true;
-    int m_SelectedScope = -1;
 
-    void RenderTimedScopes()
+    // The selected node, as an index into the threads and then into the nodes of that thread.
+    int m_SelectedThread = -1;
+    int m_SelectedNode = -1;
+
+    const char* m_TraceExportPath = "profile.json";
+
+    // ImGui plots start at the oldest value, so the history has to be rotated once it has wrapped around.
+    void PlotHistory(const char* label, const std::array<float, Pine::Performance::HistorySize>& history, float height)
+    {
+        const auto count = static_cast<int>(Pine::Performance::GetHistoryCount());
+        const auto offset = count == static_cast<int>(Pine::Performance::HistorySize) ? static_cast<int>(Pine::Performance::GetHistoryIndex() + 1) % count : 0;
+        const auto statistics = Pine::Performance::GetStatistics(history);
+
+        const auto overlay = std::to_string(history[Pine::Performance::GetHistoryIndex()]) + " ms";
+
+        ImGui::PlotLines(label, history.data(), count, offset, overlay.c_str(), 0.f, statistics.Max * 1.2f, ImVec2(-1.f, height));
+    }
+
+    void RenderNode(int threadIndex, const Pine::Performance::ProfilerThread& thread, std::uint32_t nodeIndex)
     {
-        auto& timedScopes = Pine::Performance::GetTrackedScopes();
+        const auto& node = thread.Nodes[nodeIndex];
+        const auto statistics = Pine::Performance::GetStatistics(node.History);
+
+        ImGui::TableNextRow();
+        ImGui::TableSetColumnIndex(0);
+
+        ImGuiTreeNodeFlags flags = ImGuiTreeNodeFlags_OpenOnArrow | ImGuiTreeNodeFlags_SpanFullWidth;
 
-        if (ImGui::BeginTable("##ProfilerTable", 2, ImGuiTableFlags_RowBg))
+        if (node.Children.empty())
+            flags |= ImGuiTreeNodeFlags_Leaf;
+        if (threadIndex == m_SelectedThread && static_cast<int>(nodeIndex) == m_SelectedNode)
+            flags |= ImGuiTreeNodeFlags_Selected;
+
+        ImGui::PushID(static_cast<int>(nodeIndex));
+
+        const bool open = ImGui::TreeNodeEx(node.Scope->Name, flags);
+
+        if (ImGui::IsItemClicked())
+        {
+            m_SelectedThread = threadIndex;
+            m_SelectedNode = static_cast<int>(nodeIndex);
+        }
+
+        ImGui::TableSetColumnIndex(1);
+        ImGui::Text("%u", node.Calls);
+
+        ImGui::TableSetColumnIndex(2);
+        ImGui::Text("%.3f", node.History[Pine::Performance::GetHistoryIndex()]);
+
+        ImGui::TableSetColumnIndex(3);
+        ImGui::Text("%.3f", statistics.Min);
+
+        ImGui::TableSetColumnIndex(4);
+        ImGui::Text("%.3f", statistics.Average);
+
+        ImGui::TableSetColumnIndex(5);
+        ImGui::Text("%.3f", statistics.Max);
+
+        ImGui::TableSetColumnIndex(6);
+        ImGui::Text("%.3f", statistics.P99);
+
+        if (open)
+        {
+            for (const auto child : node.Children)
+            {
+                RenderNode(threadIndex, thread, child);
+            }
+
+            ImGui::TreePop();
+        }
+
+        ImGui::PopID();
+    }
+
+    void RenderScopeTree()
+    {
+        const auto& threads = Pine::Performance::GetThreads();
+
+        if (ImGui::BeginTable("##ProfilerTable", 7, ImGuiTableFlags_RowBg | ImGuiTableFlags_Resizable | ImGuiTableFlags_ScrollY))
         {
             ImGui::TableSetupColumn("Name", ImGuiTableColumnFlags_WidthStretch);
-            ImGui::TableSetupColumn("Time (s)");
+            ImGui::TableSetupColumn("Calls");
+            ImGui::TableSetupColumn("Last (ms)");
+            ImGui::TableSetupColumn("Min");
+            ImGui::TableSetupColumn("Avg");
+            ImGui::TableSetupColumn("Max");
+            ImGui::TableSetupColumn("P99");
             ImGui::TableHeadersRow();
 
-            for (const auto& scope : timedScopes)
+            for (int i = 0; i < static_cast<int>(threads.size()); i++)
             {
+                const auto& thread = threads[i];
+
+                // Threads that haven't recorded anything yet only have the root node.
+                if (thread.Nodes[0].Children.empty())
+                    continue;
+
+                ImGui::PushID(i);
+
+                ImGui::TableNextRow();
+                ImGui::TableSetColumnIndex(0);
+
+                if (ImGui::TreeNodeEx(thread.Name.c_str(), ImGuiTreeNodeFlags_SpanFullWidth | (i == 0 ? ImGuiTreeNodeFlags_DefaultOpen : 0)))
+                {
+                    for (const auto child : thread.Nodes[0].Children)
+                    {
+                        RenderNode(i, thread, child);
+                    }
+
+                    ImGui::TreePop();
+                }
+
+                ImGui::PopID();
+            }
+
+            ImGui::EndTable();
+        }
+    }
+
+    void RenderCounters()
+    {
+        bool trackAllocations = Pine::Performance::IsAllocationTrackingEnabled();
+
+        if (ImGui::Checkbox("Track allocations", &trackAllocations))
+        {
+            Pine::Performance::SetAllocationTrackingEnabled(trackAllocations);
+        }
+
+        if (ImGui::BeginTable("##CountersTable", 4, ImGuiTableFlags_RowBg | ImGuiTableFlags_Resizable))
+        {
+            ImGui::TableSetupColumn("Counter", ImGuiTableColumnFlags_WidthStretch);
+            ImGui::TableSetupColumn("Last");
+            ImGui::TableSetupColumn("Avg");
+            ImGui::TableSetupColumn("Max");
+            ImGui::TableHeadersRow();
+
+            for (const auto counter : Pine::Performance::GetCounters())
+            {
+                const auto statistics = Pine::Performance::GetStatistics(counter->History);
+
                 ImGui::TableNextRow();
 
                 ImGui::TableSetColumnIndex(0);
-                ImGui::Text("%s", scope->Name);
+                ImGui::Text("%s", counter->Name);
 
                 ImGui::TableSetColumnIndex(1);
-                ImGui::Text("%.5f sec", scope->Time);
+                ImGui::Text("%lld", static_cast<long long>(counter->Value));
+
+                ImGui::TableSetColumnIndex(2);
+                ImGui::Text("%.1f", statistics.Average);
+
+                ImGui::TableSetColumnIndex(3);
+                ImGui::Text("%.0f", statistics.Max);
             }
 
             ImGui::EndTable();
         }
+    }
 
+    void RenderCaptureControls()
+    {
+        if (Pine::Performance::IsCapturing())
+        {
+            if (ImGui::Button(ICON_MD_STOP " Stop capture"))
+            {
+                Pine::Performance::StopCapture();
+                Pine::Performance::ExportChromeTrace(m_TraceExportPath);
+            }
+        }
+        else
+        {
+            if (ImGui::Button(ICON_MD_FIBER_MANUAL_RECORD " Capture"))
+            {
+                Pine::Performance::StartCapture();
+            }
+        }
 
+        ImGui::SameLine();
+        ImGui::TextDisabled("Writes a Chrome trace to %s, dropped events: %llu", m_TraceExportPath, static_cast<unsigned long long>(Pine::Performance::GetDroppedEventCount()));
     }
 }
 
@@ -53,15 +208,36 @@ void Panels::Profiler::Render()
 
     if (ImGui::Begin(ICON_MD_SPEED " Profiler", &m_Active))
     {
+        const auto frameStatistics = Pine::Performance::GetStatistics(Pine::Performance::GetFrameTimes());
+
+        RenderCaptureControls();
+
+        ImGui::Text("Frame time: avg %.3f ms, max %.3f ms, p99 %.3f ms", frameStatistics.Average, frameStatistics.Max, frameStatistics.P99);
+
+        PlotHistory("##FrameTimes", Pine::Performance::GetFrameTimes(), 80.f);
+
         ImGui::Columns(2);
 
-        RenderTimedScopes();
+        RenderScopeTree();
 
         ImGui::NextColumn();
 
-        if (m_SelectedScope != -1)
+        const auto& threads = Pine::Performance::GetThreads();
+
+        if (m_SelectedThread >= 0 && m_SelectedThread < static_cast<int>(threads.size()) &&
+            m_SelectedNode > 0 && m_SelectedNode < static_cast<int>(threads[m_SelectedThread].Nodes.size()))
         {
+            const auto& node = threads[m_SelectedThread].Nodes[m_SelectedNode];
 
+            ImGui::Text("%s", node.Scope->Name);
+            ImGui::TextDisabled("%s", threads[m_SelectedThread].Name.c_str());
+
+            PlotHistory("##ScopeTimes", node.History, 120.f);
+        }
+
+        if (ImGui::CollapsingHeader("Counters", ImGuiTreeNodeFlags_DefaultOpen))
+        {
+            RenderCounters();
         }
 
         ImGui::Columns(1);
@@ -135,6 +135,13 @@ void Commands::Save()
     Pine::Assets::SaveAll();
 }
 
+void Commands::Cook()
+{
+    Save();
+
+    Pine::Assets::CookDirectory("game/assets", "game/cooked");
+}
+
 void Commands::Update()
 {
     if (KeybindSystem::IsKeybindPressed(Keybinds::Copy))
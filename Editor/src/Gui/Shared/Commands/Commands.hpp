@@ -16,4 +16,7 @@ namespace Commands
 
     void Refresh(bool engineAssets = false);
     void Save();
+
+    // Writes a cooked copy of the game's assets, see Pine::Assets::CookDirectory()
+    void Cook();
 }
\ No newline at end of file
@@ -49,7 +49,7 @@ namespace
             {
                 // We cannot encode this properly since the entity index is too high, should hopefully never
                 // happen.
-                Pine::Log::Warning(fmt::format("EntitySelection: Failed to encode entity id {}, value is too high.", id));
+                Pine::Log::Warning("EntitySelection: Failed to encode entity id {}, value is too high.", id);
                 break;
             }
         }
@@ -177,7 +177,7 @@ namespace
             }
             else
             {
-                Pine::Log::Error(fmt::format("Picked entity with ID {} does not exist.", entityId));
+                Pine::Log::Error("Picked entity with ID {} does not exist.", entityId);
             }
         }
         else
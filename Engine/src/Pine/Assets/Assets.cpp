@@ -13,15 +13,23 @@
 #include "Pine/Assets/Model/Model.hpp"
 #include "Pine/Core/Log/Log.hpp"
 #include "Pine/Core/String/String.hpp"
+#include "Pine/Core/Timer/Timer.hpp"
 #include "Pine/Engine/Engine.hpp"
+#include "Pine/Performance/Performance.hpp"
+#include "Pine/Threading/Threading.hpp"
 #include "Pine/Assets/Texture3D/Texture3D.hpp"
 #include "Pine/Assets/AudioFile/AudioFile.hpp"
 #include "Pine/Assets/CSharpScript/CSharpScript.hpp"
 
-#include <cmath>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
 #include <cstdint>
+#include <deque>
 #include <functional>
+#include <memory>
 #include <stdexcept>
+#include <shared_mutex>
 #include <thread>
 #include <unordered_map>
 #include <mutex>
@@ -40,6 +48,9 @@ namespace
     std::unordered_map<std::string, IAsset*> m_AssetsFilePath;
     std::unordered_map<std::uint32_t, IAsset*> m_AssetsId;
 
+    // Assets are registered from worker threads during LoadDirectory(), while other assets may be looking them up.
+    std::shared_mutex m_AssetsMutex;
+
     // Which assets paths we need to resolve to asset pointers during the end of an ongoing load
     std::vector<AssetResolveReference> m_AssetResolveReferences;
     std::mutex m_AssetResolveReferencesMutex;
@@ -120,22 +131,19 @@ namespace
     {
         const auto path = GetAssetMapPath(filePath, rootPath, mapPath);
 
-        if (m_Assets.count(path) == 0)
-            return nullptr;
+        std::shared_lock lock(m_AssetsMutex);
 
-        return m_Assets[path];
-    }
+        const auto it = m_Assets.find(path);
 
-    IAsset* PrepareAssetFromFile(const std::filesystem::path& filePath, const std::string& rootPath, const std::string& mapPath)
-    {
-        if (!exists(filePath))
+        if (it == m_Assets.end())
             return nullptr;
 
-        const auto path = GetAssetMapPath(filePath, rootPath, mapPath);
-
-        if (m_Assets.count(path) != 0)
-            return nullptr;
+        return it->second;
+    }
 
+    // Creates an asset object for the file, without an id and without registering it.
+    IAsset* CreateAssetFromFile(const std::filesystem::path& filePath, const std::string& rootPath, const std::string& mapPath)
+    {
         const auto factory = GetAssetFactoryFromFileName(filePath.filename());
 
         IAsset* asset;
@@ -146,14 +154,28 @@ namespace
             asset = new InvalidAsset();
 
         asset->SetFilePath(filePath, rootPath);
-        asset->SetPath(path);
-        asset->SetId(m_CurrentId++);
+        asset->SetPath(GetAssetMapPath(filePath, rootPath, mapPath));
 
         asset->LoadMetadata();
 
         return asset;
     }
 
+    IAsset* PrepareAssetFromFile(const std::filesystem::path& filePath, const std::string& rootPath, const std::string& mapPath)
+    {
+        if (!exists(filePath))
+            return nullptr;
+
+        if (FindExistingAssetFromFile(filePath, rootPath, mapPath) != nullptr)
+            return nullptr;
+
+        const auto asset = CreateAssetFromFile(filePath, rootPath, mapPath);
+
+        asset->SetId(m_CurrentId++);
+
+        return asset;
+    }
+
     // More or less which thread we're currently on, SingleThread in this context means
     // only the main thread, i.e., the thread that the OpenGL context is on.
     enum class LoadThreadingModeContext
@@ -175,7 +197,323 @@ namespace
             }
         }
 
-        return asset->LoadFromFile(loadStage);
+        const bool loadResult = asset->LoadFromFile(loadStage);
+
+        // Assets loaded in two stages are only counted once they're done.
+        if (loadResult && loadStage != AssetLoadStage::Prepare)
+        {
+            PINE_PF_COUNTER("Asset loads", 1);
+        }
+
+        return loadResult;
+    }
+
+    // A single asset within a LoadDirectory() call, and which assets that have to wait for it.
+    struct AssetLoadNode
+    {
+        IAsset* Asset = nullptr;
+
+        // Indices of the nodes depending on this asset.
+        std::vector<std::size_t> Dependents;
+
+        // The number of dependencies within the load graph that haven't finished loading yet.
+        std::atomic<int> PendingDependencies = 0;
+
+        // Set if any dependency failed to load, the asset will not be loaded.
+        std::atomic<bool> DependencyFailed = false;
+
+        // Only written by whoever runs the node's final load stage.
+        float LoadTime = 0.f;
+        bool Succeeded = false;
+    };
+
+    struct AssetLoadGraph
+    {
+        std::unique_ptr<AssetLoadNode[]> Nodes;
+        std::size_t NodeCount = 0;
+
+        // The number of scheduled nodes which haven't completed yet.
+        std::atomic<int> PendingNodes = 0;
+
+        Threading::TaskGroup Jobs;
+
+        // Load stages that have to run on the main thread, i.e. the thread with the OpenGL context.
+        std::vector<std::pair<AssetLoadNode*, AssetLoadStage>> MainThreadStages;
+        std::mutex MainThreadMutex;
+        std::condition_variable MainThreadUpdated;
+    };
+
+    // Used to match dependency file paths against the assets within the load graph.
+    std::string GetAssetFileKey(const std::filesystem::path& filePath)
+    {
+        return String::Replace(filePath.lexically_normal().string(), "\\", "/");
+    }
+
+    void RegisterAsset(IAsset* asset)
+    {
+        std::unique_lock lock(m_AssetsMutex);
+
+        m_Assets[asset->GetPath()] = asset;
+        m_AssetsFilePath[asset->GetFilePath().string()] = asset;
+        m_AssetsId[asset->GetId()] = asset;
+    }
+
+    void ScheduleAssetLoadNode(AssetLoadGraph& graph, AssetLoadNode& node);
+
+    void QueueMainThreadLoadStage(AssetLoadGraph& graph, AssetLoadNode& node, AssetLoadStage stage)
+    {
+        {
+            std::unique_lock lock(graph.MainThreadMutex);
+            graph.MainThreadStages.emplace_back(&node, stage);
+        }
+
+        graph.MainThreadUpdated.notify_one();
+    }
+
+    void CompleteAssetLoadNode(AssetLoadGraph& graph, AssetLoadNode& node, bool success)
+    {
+        node.Succeeded = success;
+
+        if (success)
+        {
+            node.Asset->SetLoadTime(node.LoadTime);
+            node.Asset->MarkAsUpdated();
+
+            // Dependents may look up this asset while loading, so it has to be registered now.
+            RegisterAsset(node.Asset);
+        }
+
+        for (const auto dependentIndex : node.Dependents)
+        {
+            auto& dependent = graph.Nodes[dependentIndex];
+
+            if (!success)
+            {
+                dependent.DependencyFailed = true;
+            }
+
+            if (--dependent.PendingDependencies == 0)
+            {
+                ScheduleAssetLoadNode(graph, dependent);
+            }
+        }
+
+        {
+            std::unique_lock lock(graph.MainThreadMutex);
+            graph.PendingNodes--;
+        }
+
+        graph.MainThreadUpdated.notify_one();
+    }
+
+    void RunAssetLoadStage(AssetLoadGraph& graph, AssetLoadNode& node, LoadThreadingModeContext threadingModeContext, AssetLoadStage stage)
+    {
+        Timer stageTimer;
+
+        const bool loadResult = LoadAssetDataFromFile(node.Asset, threadingModeContext, stage);
+
+        stageTimer.Stop();
+
+        node.LoadTime += stageTimer.GetElapsedTime();
+
+        if (stage == AssetLoadStage::Prepare)
+        {
+            if (loadResult)
+                QueueMainThreadLoadStage(graph, node, AssetLoadStage::Finish);
+            else
+                CompleteAssetLoadNode(graph, node, false);
+
+            return;
+        }
+
+        CompleteAssetLoadNode(graph, node, node.Asset->GetType() == AssetType::Invalid || node.Asset->GetState() == AssetState::Loaded);
+    }
+
+    // Called once all of the node's dependencies have finished, starts loading the asset on
+    // whatever thread its load mode allows.
+    void ScheduleAssetLoadNode(AssetLoadGraph& graph, AssetLoadNode& node)
+    {
+        if (node.DependencyFailed)
+        {
+            Log::Error("[Assets] Failed to import asset {}, missing dependency.", node.Asset->GetPath());
+            CompleteAssetLoadNode(graph, node, false);
+            return;
+        }
+
+        node.LoadTime = 0.f;
+
+        switch (node.Asset->GetLoadMode())
+        {
+        case AssetLoadMode::SingleThread:
+            QueueMainThreadLoadStage(graph, node, AssetLoadStage::Default);
+            break;
+        case AssetLoadMode::MultiThread:
+            Threading::Run(graph.Jobs, [&graph, &node]
+            {
+                RunAssetLoadStage(graph, node, LoadThreadingModeContext::MultiThread, AssetLoadStage::Default);
+            });
+            break;
+        case AssetLoadMode::MultiThreadPrepare:
+            Threading::Run(graph.Jobs, [&graph, &node]
+            {
+                RunAssetLoadStage(graph, node, LoadThreadingModeContext::MultiThread, AssetLoadStage::Prepare);
+            });
+            break;
+        }
+    }
+
+    // An asset being loaded through LoadAsync().
+    struct AsyncLoad
+    {
+        IAsset* Asset = nullptr;
+
+        // The registered asset, if it's being reloaded. It's left untouched, and stays in use, until the
+        // reloaded asset replaces it on the main thread.
+        IAsset* ReplacedAsset = nullptr;
+
+        std::promise<IAsset*> Promise;
+        std::shared_future<IAsset*> Future;
+
+        // See AsyncAssetLoad::m_Placeholder
+        std::shared_ptr<IAsset*> Placeholder;
+
+        // Set by the worker thread before the load is queued for the main thread.
+        bool Succeeded = true;
+        bool HasMainThreadStage = false;
+        AssetLoadStage MainThreadStage = AssetLoadStage::Default;
+    };
+
+    // Asynchronous loads that haven't finished yet by map path, only accessed by the main thread.
+    std::unordered_map<std::string, std::shared_ptr<AsyncLoad>> m_AsyncLoads;
+
+    // Asynchronous loads waiting for the main thread to finish them.
+    std::deque<std::shared_ptr<AsyncLoad>> m_AsyncLoadQueue;
+    std::mutex m_AsyncLoadQueueMutex;
+
+    Threading::TaskGroup m_AsyncLoadJobs;
+
+    // Assets that have been replaced by a reload. Anything may still hold a pointer to them, so they're
+    // only deleted on shutdown.
+    std::vector<IAsset*> m_ReplacedAssets;
+
+    AsyncAssetLoad CreateFinishedAsyncLoad(IAsset* asset)
+    {
+        std::promise<IAsset*> promise;
+
+        promise.set_value(asset);
+
+        return { promise.get_future().share(), std::make_shared<IAsset*>(asset) };
+    }
+
+    // Puts the reloaded asset in the place of the existing one, must be done on the main thread.
+    void ReplaceAsset(IAsset* existingAsset, IAsset* asset)
+    {
+        // Script objects refer to assets by id, which the new instance has taken over, so the script
+        // object can be handed over as well.
+        *asset->GetScriptHandle() = *existingAsset->GetScriptHandle();
+        *existingAsset->GetScriptHandle() = { nullptr, 0 };
+
+        existingAsset->Dispose();
+        existingAsset->MarkAsReplaced(asset);
+
+        m_ReplacedAssets.push_back(existingAsset);
+    }
+
+    void QueueAsyncLoad(const std::shared_ptr<AsyncLoad>& load, bool succeeded, bool hasMainThreadStage, AssetLoadStage mainThreadStage)
+    {
+        load->Succeeded = succeeded;
+        load->HasMainThreadStage = hasMainThreadStage;
+        load->MainThreadStage = mainThreadStage;
+
+        std::unique_lock lock(m_AsyncLoadQueueMutex);
+
+        m_AsyncLoadQueue.push_back(load);
+    }
+
+    // Returns false if there was no load ready to be finished.
+    bool FinishNextAsyncLoad()
+    {
+        std::shared_ptr<AsyncLoad> load;
+
+        {
+            std::unique_lock lock(m_AsyncLoadQueueMutex);
+
+            if (m_AsyncLoadQueue.empty())
+            {
+                return false;
+            }
+
+            load = std::move(m_AsyncLoadQueue.front());
+            m_AsyncLoadQueue.pop_front();
+        }
+
+        const auto asset = load->Asset;
+
+        Timer stageTimer;
+
+        bool success = load->Succeeded;
+
+        if (success && load->HasMainThreadStage)
+        {
+            success = LoadAssetDataFromFile(asset, LoadThreadingModeContext::SingleThread, load->MainThreadStage);
+        }
+
+        stageTimer.Stop();
+
+        asset->SetLoadTime(asset->GetLoadTime() + static_cast<float>(stageTimer.GetElapsedTime()));
+
+        success = success && (asset->GetType() == AssetType::Invalid || asset->GetState() == AssetState::Loaded);
+
+        m_AsyncLoads.erase(asset->GetPath());
+
+        if (!success)
+        {
+            Log::Error("[Assets] Failed to load asset '{}'.", asset->GetPath());
+
+            // A failed reload leaves the existing asset as it was.
+            if (load->ReplacedAsset == nullptr)
+            {
+                *load->Placeholder = nullptr;
+            }
+
+            asset->DestroyScriptHandle();
+            delete asset;
+
+            load->Promise.set_value(nullptr);
+
+            return true;
+        }
+
+        if (load->ReplacedAsset != nullptr)
+        {
+            ReplaceAsset(load->ReplacedAsset, asset);
+        }
+
+        asset->MarkAsUpdated();
+
+        if (asset->GetScriptHandle()->Object == nullptr)
+        {
+            asset->CreateScriptHandle();
+        }
+
+        RegisterAsset(asset);
+
+        load->Promise.set_value(asset);
+
+        return true;
+    }
+
+    // Blocks until every asynchronous load has finished, ignoring the upload budget.
+    void FinishAsyncLoads()
+    {
+        while (!m_AsyncLoads.empty())
+        {
+            if (FinishNextAsyncLoad())
+                continue;
+
+            if (!Threading::RunPendingJob())
+                std::this_thread::yield();
+        }
     }
 }
 
@@ -185,18 +523,34 @@ void Assets::Setup()
 
 void Assets::Shutdown()
 {
+    FinishAsyncLoads();
+
     for (auto& [path, asset] : m_Assets)
     {
-        Log::Verbose(fmt::format("[Assets] Disposing asset {}...", path));
+        Log::Verbose("[Assets] Disposing asset {}...", path);
 
         if (!asset->IsDeleted())
             asset->Dispose();
     }
+
+    // These have already been disposed when they were replaced.
+    for (const auto asset : m_ReplacedAssets)
+    {
+        delete asset;
+    }
+
+    m_ReplacedAssets.clear();
 }
 
 IAsset* Assets::LoadFromFile(const std::filesystem::path& path, const std::string& rootPath,
                              const std::string& mapPath)
 {
+    // The same asset may not be loaded twice at once, so let any pending asynchronous load finish first.
+    if (m_AsyncLoads.count(GetAssetMapPath(path, rootPath, mapPath)) != 0)
+    {
+        FinishAsyncLoads();
+    }
+
     bool hasExistingAsset = false;
     IAsset* asset;
 
@@ -266,9 +620,7 @@ IAsset* Assets::LoadFromFile(const std::filesystem::path& path, const std::strin
         asset->CreateScriptHandle();
     }
 
-    m_Assets[asset->GetPath()] = asset;
-    m_AssetsFilePath[asset->GetFilePath().string()] = asset;
-    m_AssetsId[asset->GetId()] = asset;
+    RegisterAsset(asset);
 
     return asset;
 }
@@ -277,12 +629,18 @@ int Assets::LoadDirectory(const std::filesystem::path& directoryPath, bool useAs
 {
     if (!exists(directoryPath))
     {
-        Log::Warning(fmt::format("[Assets] Loaded no assets from '{}', directory does not exist.", directoryPath.string()));
+        Log::Warning("[Assets] Loaded no assets from '{}', directory does not exist.", directoryPath.string());
         return -1;
     }
 
+    FinishAsyncLoads();
+
     m_State = AssetManagerState::LoadDirectory;
 
+    Timer loadTimer;
+
+    const auto rootPath = useAsRelativePath ? directoryPath.string() : "";
+
     // First gather a list of everything we need to load
     std::vector<IAsset*> loadPool;
 
@@ -293,7 +651,7 @@ int Assets::LoadDirectory(const std::filesystem::path& directoryPath, bool useAs
 
         IAsset* asset;
 
-        if (auto existingAsset = FindExistingAssetFromFile(dirEntry.path(), useAsRelativePath ? directoryPath.string() : "", ""))
+        if (auto existingAsset = FindExistingAssetFromFile(dirEntry.path(), rootPath, ""))
         {
             if (existingAsset->GetType() == AssetType::Invalid)
             {
@@ -311,7 +669,7 @@ int Assets::LoadDirectory(const std::filesystem::path& directoryPath, bool useAs
         }
         else
         {
-            asset = PrepareAssetFromFile(dirEntry.path(), useAsRelativePath ? directoryPath.string() : "", "");
+            asset = PrepareAssetFromFile(dirEntry.path(), rootPath, "");
         }
 
         if (asset == nullptr)
@@ -322,205 +680,161 @@ int Assets::LoadDirectory(const std::filesystem::path& directoryPath, bool useAs
         loadPool.push_back(asset);
     }
 
-    // Sort everything
-    std::vector<IAsset*> singleThreadLoadAssets;
-    std::vector<IAsset*> multiThreadLoadAssets;
-    std::vector<IAsset*> dependencyAssets;
+    // Build the load graph, dependencies within the directory become edges, anything else has to
+    // be available before we start.
+    AssetLoadGraph graph;
 
-    for (const auto& asset : loadPool)
-    {
-        // If the asset has dependencies, we have to postpone loading the asset and load everything else
-        // and hope that it's dependencies has loaded.
-        if (asset->HasDependencies())
-        {
-            dependencyAssets.push_back(asset);
-            continue;
-        }
+    graph.Nodes = std::make_unique<AssetLoadNode[]>(loadPool.size());
+    graph.NodeCount = loadPool.size();
 
-        switch (asset->GetLoadMode())
-        {
-        case AssetLoadMode::SingleThread:
-            singleThreadLoadAssets.push_back(asset);
-            break;
-        case AssetLoadMode::MultiThread:
-        case AssetLoadMode::MultiThreadPrepare:
-            multiThreadLoadAssets.push_back(asset);
-            break;
-        }
-    }
+    std::unordered_map<std::string, std::size_t> nodeFileIndex;
 
-    const int multiThreadAssetCount = static_cast<int>(multiThreadLoadAssets.size());
-
-    // Make sure we're not overdoing it, but if this is true
-    // we're probably overdoing it anyway.
-    int threadAmount = 10;
-    if (threadAmount > multiThreadAssetCount)
+    for (std::size_t i = 0; i < loadPool.size(); i++)
     {
-        threadAmount = multiThreadAssetCount;
-    }
+        graph.Nodes[i].Asset = loadPool[i];
 
-    std::vector<std::thread> loadThreads;
+        nodeFileIndex[GetAssetFileKey(loadPool[i]->GetFilePath())] = i;
+    }
 
-    // Maybe "multiThreadLoadAssets" could be passed through the capture list instead (?)
-    // Important part is that it's marked as const
-    const auto loadThread = [](const std::vector<IAsset*>& multiThreadLoadAssets, int startIndex, int endIndex)
+    for (std::size_t i = 0; i < graph.NodeCount; i++)
     {
-        for (int i = startIndex;i < endIndex;i++)
-        {
-            auto asset = multiThreadLoadAssets[i];
+        auto& node = graph.Nodes[i];
 
-            if (asset->GetLoadMode() == AssetLoadMode::MultiThreadPrepare)
-                LoadAssetDataFromFile(asset, LoadThreadingModeContext::MultiThread, AssetLoadStage::Prepare);
-            else
-                LoadAssetDataFromFile(asset, LoadThreadingModeContext::MultiThread, AssetLoadStage::Default);
+        if (!node.Asset->HasDependencies())
+        {
+            continue;
         }
-    };
-
-    // TODO: Move this crap to the threadpool worker system.
-    if (!multiThreadLoadAssets.empty())
-    {
-        // Attempt to split up the workload between the available threads
-        // This obviously won't be perfect as some assets may require more time to load.
-        int threadProcessAmount = static_cast<int>(std::floor(multiThreadAssetCount / threadAmount));
 
-        int startIndex = 0;
-        for (int i = 0; i < threadAmount;i++)
+        for (const auto& dependency : node.Asset->GetDependencies())
         {
-            int endIndex = startIndex + threadProcessAmount;
+            const auto dependencyNode = nodeFileIndex.find(GetAssetFileKey(dependency));
+
+            if (dependencyNode != nodeFileIndex.end())
+            {
+                if (dependencyNode->second != i)
+                {
+                    graph.Nodes[dependencyNode->second].Dependents.push_back(i);
+                    node.PendingDependencies++;
+                }
 
-            // If it's the last thread, make sure to load the possibly
-            // remaining bit as well.
-            if (i == threadAmount - 1)
-                endIndex = multiThreadAssetCount;
+                continue;
+            }
 
-            loadThreads.emplace_back(loadThread, std::cref(multiThreadLoadAssets), startIndex, endIndex);
+            if (Get(dependency, false, false) != nullptr)
+            {
+                continue;
+            }
 
-            startIndex += threadProcessAmount;
+            if (!LoadFromFile(dependency, rootPath, ""))
+            {
+                node.DependencyFailed = true;
+            }
         }
     }
 
-    // Start doing the single threaded load while we're waiting (or not if there aren't any MT assets)
-    for (auto asset : singleThreadLoadAssets)
-    {
-        LoadAssetDataFromFile(asset, LoadThreadingModeContext::SingleThread, AssetLoadStage::Default);
-    }
+    // Anything we can't reach by walking the graph from the assets without dependencies is part of
+    // (or depends on) a dependency cycle, and will never be loaded.
+    std::vector<std::size_t> readyNodes;
+    std::vector<int> remainingDependencies(graph.NodeCount);
 
-    // Now we're forced to wait for the threads to exit before continuing
-    for (auto& thread : loadThreads)
+    for (std::size_t i = 0; i < graph.NodeCount; i++)
     {
-        thread.join();
+        remainingDependencies[i] = graph.Nodes[i].PendingDependencies;
+
+        if (remainingDependencies[i] == 0)
+        {
+            readyNodes.push_back(i);
+        }
     }
 
-    // Now we have to finish the load for LoadType::MultiThreadPrepare, which means running the remaining bit
-    // on the main thread.
-    for (auto asset : multiThreadLoadAssets)
-    {
-        if (asset->GetLoadMode() != AssetLoadMode::MultiThreadPrepare)
-            continue;
+    std::vector<std::size_t> schedulableNodes = readyNodes;
 
-        LoadAssetDataFromFile(asset, LoadThreadingModeContext::SingleThread, AssetLoadStage::Finish);
+    for (std::size_t i = 0; i < schedulableNodes.size(); i++)
+    {
+        for (const auto dependent : graph.Nodes[schedulableNodes[i]].Dependents)
+        {
+            if (--remainingDependencies[dependent] == 0)
+            {
+                schedulableNodes.push_back(dependent);
+            }
+        }
     }
 
     int assetsLoaded = 0;
     int assetsLoadErrors = 0;
 
-    // Finally, add all loaded assets (except dependencies) to our asset map
-    for (auto asset : loadPool)
+    for (std::size_t i = 0; i < graph.NodeCount; i++)
     {
-        if (asset->HasDependencies())
-        {
-            continue;
-        }
-
-        if (asset->GetType() != AssetType::Invalid && asset->GetState() != AssetState::Loaded)
+        if (remainingDependencies[i] > 0)
         {
+            Log::Error("[Assets] Failed to import asset {}, circular dependency.", graph.Nodes[i].Asset->GetPath());
             assetsLoadErrors++;
-
-            continue;
         }
+    }
 
-        assetsLoaded++;
-
-        asset->MarkAsUpdated();
-
-        if (asset->GetScriptHandle()->Object == nullptr)
-        {
-            asset->CreateScriptHandle();
-        }
+    graph.PendingNodes = static_cast<int>(schedulableNodes.size());
 
-        m_Assets[asset->GetPath()] = asset;
-        m_AssetsFilePath[asset->GetFilePath().string()] = asset;
-        m_AssetsId[asset->GetId()] = asset;
+    for (const auto node : readyNodes)
+    {
+        ScheduleAssetLoadNode(graph, graph.Nodes[node]);
     }
 
-    // At this point we may now load the remaining assets that has dependencies.
-    for (const auto asset : dependencyAssets)
+    // Run the main thread stages as they become available, and help out with the
+    // rest of the jobs while waiting.
+    while (graph.PendingNodes > 0)
     {
-        const auto& dependencies = asset->GetDependencies();
+        std::vector<std::pair<AssetLoadNode*, AssetLoadStage>> mainThreadStages;
 
-        bool missingDependency = false;
-        for (const auto& dependency : dependencies)
         {
-            if (Get(dependency, false, false) != nullptr)
-            {
-                continue;
-            }
-
-            if (!LoadFromFile(dependency, useAsRelativePath ? directoryPath.string() : "", ""))
-            {
-                missingDependency = true;
-                break;
-            }
+            std::unique_lock lock(graph.MainThreadMutex);
+            mainThreadStages.swap(graph.MainThreadStages);
         }
 
-        if (missingDependency)
-        {
-            Log::Error("[Assets] Failed to import asset " + asset->GetPath() + ", missing dependency.");
-            assetsLoadErrors++;
-            continue;
-        }
-        
-        if (asset->GetLoadMode() == AssetLoadMode::MultiThreadPrepare)
+        if (!mainThreadStages.empty())
         {
-            if (!LoadAssetDataFromFile(asset, LoadThreadingModeContext::SingleThread, AssetLoadStage::Prepare))
+            for (const auto& [node, stage] : mainThreadStages)
             {
-                assetsLoadErrors++;
-                continue;
+                RunAssetLoadStage(graph, *node, LoadThreadingModeContext::SingleThread, stage);
             }
 
-            if (!LoadAssetDataFromFile(asset, LoadThreadingModeContext::SingleThread, AssetLoadStage::Finish))
-            {
-                assetsLoadErrors++;
-                continue;
-            }
+            continue;
         }
-        else
+
+        if (Threading::RunPendingJob())
         {
-            if (!LoadAssetDataFromFile(asset, LoadThreadingModeContext::SingleThread, AssetLoadStage::Default))
-            {
-                assetsLoadErrors++;
-                continue;
-            }
+            continue;
         }
 
-        if (asset->GetType() != AssetType::Invalid && asset->GetState() != AssetState::Loaded)
+        std::unique_lock lock(graph.MainThreadMutex);
+
+        graph.MainThreadUpdated.wait(lock, [&graph] { return !graph.MainThreadStages.empty() || graph.PendingNodes == 0; });
+    }
+
+    Threading::Wait(graph.Jobs);
+
+    float assetsLoadTime = 0.f;
+
+    std::vector<IAsset*> slowestAssets;
+
+    for (const auto index : schedulableNodes)
+    {
+        const auto& node = graph.Nodes[index];
+
+        if (!node.Succeeded)
         {
             assetsLoadErrors++;
             continue;
         }
 
         assetsLoaded++;
+        assetsLoadTime += node.Asset->GetLoadTime();
 
-        asset->MarkAsUpdated();
+        slowestAssets.push_back(node.Asset);
 
-        if (asset->GetScriptHandle()->Object == nullptr)
+        if (node.Asset->GetScriptHandle()->Object == nullptr)
         {
-            asset->CreateScriptHandle();
+            node.Asset->CreateScriptHandle();
         }
-
-        m_Assets[asset->GetPath()] = asset;
-        m_AssetsFilePath[asset->GetFilePath().string()] = asset;
-        m_AssetsId[asset->GetId()] = asset;
     }
 
     // During the load of all assets, some assets may have created resolve references, for assets that may not have
@@ -528,19 +842,19 @@ int Assets::LoadDirectory(const std::filesystem::path& directoryPath, bool useAs
     // we may attempt to resolve them to pointers now.
     for (auto& assetResolveReference : m_AssetResolveReferences)
     {
-        const auto refMapPath = GetAssetMapPath(assetResolveReference.m_Path, useAsRelativePath ? directoryPath.string() : "", "");
+        const auto refMapPath = GetAssetMapPath(assetResolveReference.m_Path, rootPath, "");
         const auto asset = Get(refMapPath);
 
         if (!asset)
         {
             // Ignoring warning here since the "Get" function will already warn the user.
-            //Log::Warning(fmt::format("Failed to resolve asset reference '{}'.", assetResolveReference.m_Path));
+            //Log::Warning("Failed to resolve asset reference '{}'.", assetResolveReference.m_Path);
             continue;
         }
 
         if (assetResolveReference.m_Type != AssetType::Invalid && asset->GetType() != assetResolveReference.m_Type)
         {
-            Log::Warning(fmt::format("[Assets] Failed to resolve asset reference '{}', asset type is invalid.", assetResolveReference.m_Path));
+            Log::Warning("[Assets] Failed to resolve asset reference '{}', asset type is invalid.", assetResolveReference.m_Path);
             continue;
         }
 
@@ -551,19 +865,195 @@ int Assets::LoadDirectory(const std::filesystem::path& directoryPath, bool useAs
 
     m_State = AssetManagerState::Idle;
 
+    loadTimer.Stop();
+
     // This is more to provide a warning, since assetsLoadErrors could still be 0, meaning nothing has really gone wrong,
     // however, this is most likely not what the user wanted.
     if (assetsLoaded == 0)
         return -1;
 
     if (assetsLoadErrors > 0)
-        Log::Warning(fmt::format("[Assets] Failed to load {} asset(s) from '{}'.", assetsLoadErrors, directoryPath.string()));
+        Log::Warning("[Assets] Failed to load {} asset(s) from '{}'.", assetsLoadErrors, directoryPath.string());
+
+    Log::Verbose("[Assets] Loaded {} asset(s) from {} in {:.2f} ms, {:.2f} ms of load time spread across {} thread(s).",
+                 assetsLoaded,
+                 directoryPath.string(),
+                 loadTimer.GetElapsedTime() * 1000.f,
+                 assetsLoadTime * 1000.f,
+                 Threading::GetWorkerCount() + 1);
 
-    Log::Verbose("[Assets] Loaded " + std::to_string(assetsLoaded) + " asset(s) from " + directoryPath.string());
+    const auto slowestAssetCount = std::min<std::size_t>(slowestAssets.size(), 5);
+
+    std::partial_sort(slowestAssets.begin(), slowestAssets.begin() + slowestAssetCount, slowestAssets.end(), [](const IAsset* a, const IAsset* b)
+    {
+        return a->GetLoadTime() > b->GetLoadTime();
+    });
+
+    for (std::size_t i = 0; i < slowestAssetCount; i++)
+    {
+        Log::Verbose("[Assets]  {:.2f} ms - {}", slowestAssets[i]->GetLoadTime() * 1000.f, slowestAssets[i]->GetPath());
+    }
 
     return assetsLoadErrors;
 }
 
+int Assets::CookDirectory(const std::filesystem::path& directoryPath, const std::filesystem::path& outputDirectoryPath)
+{
+    if (!exists(directoryPath))
+    {
+        Log::Warning("[Assets] Failed to cook '{}', directory does not exist.", directoryPath.string());
+        return -1;
+    }
+
+    int cookedAssets = 0;
+
+    for (const auto& dirEntry : std::filesystem::recursive_directory_iterator(directoryPath))
+    {
+        if (dirEntry.is_directory())
+            continue;
+
+        const auto outputPath = outputDirectoryPath / dirEntry.path().lexically_relative(directoryPath);
+
+        std::filesystem::create_directories(outputPath.parent_path());
+
+        const auto asset = Get(String::Replace(dirEntry.path().string(), "\\", "/"), true, false);
+
+        if (asset != nullptr && asset->GetState() == AssetState::Loaded)
+        {
+            bool cooked = false;
+
+            if (asset->GetType() == AssetType::Level)
+                cooked = dynamic_cast<Level*>(asset)->Cook(outputPath);
+            if (asset->GetType() == AssetType::Blueprint)
+                cooked = dynamic_cast<Blueprint*>(asset)->Cook(outputPath);
+
+            if (cooked)
+            {
+                cookedAssets++;
+                continue;
+            }
+        }
+
+        std::filesystem::copy_file(dirEntry.path(), outputPath, std::filesystem::copy_options::overwrite_existing);
+    }
+
+    Log::Info("[Assets] Cooked {} asset(s) from '{}' into '{}'.", cookedAssets, directoryPath.string(), outputDirectoryPath.string());
+
+    return cookedAssets;
+}
+
+AsyncAssetLoad Assets::LoadAsync(const std::filesystem::path& filePath, const std::string& rootPath, const std::string& mapPath)
+{
+    const auto path = GetAssetMapPath(filePath, rootPath, mapPath);
+
+    if (const auto it = m_AsyncLoads.find(path); it != m_AsyncLoads.end())
+    {
+        return { it->second->Future, it->second->Placeholder };
+    }
+
+    IAsset* existingAsset = FindExistingAssetFromFile(filePath, rootPath, mapPath);
+    IAsset* asset;
+
+    if (existingAsset != nullptr)
+    {
+        if (!existingAsset->HasBeenUpdated() || !exists(filePath))
+        {
+            return CreateFinishedAsyncLoad(existingAsset);
+        }
+
+        // The existing asset is still in use, so the worker threads can't touch it. Load into a new
+        // instance instead, which takes its place once it's done.
+        asset = CreateAssetFromFile(filePath, rootPath, mapPath);
+        asset->SetId(existingAsset->GetId());
+    }
+    else
+    {
+        asset = PrepareAssetFromFile(filePath, rootPath, mapPath);
+    }
+
+    if (!asset)
+    {
+        return CreateFinishedAsyncLoad(nullptr);
+    }
+
+    asset->SetState(AssetState::Preparing);
+    asset->SetLoadTime(0.f);
+
+    auto load = std::make_shared<AsyncLoad>();
+
+    load->Asset = asset;
+    load->ReplacedAsset = existingAsset;
+    load->Future = load->Promise.get_future().share();
+    load->Placeholder = std::make_shared<IAsset*>(existingAsset != nullptr ? existingAsset : asset);
+
+    m_AsyncLoads[path] = load;
+
+    switch (asset->GetLoadMode())
+    {
+    case AssetLoadMode::SingleThread:
+        QueueAsyncLoad(load, true, true, AssetLoadStage::Default);
+        break;
+    case AssetLoadMode::MultiThread:
+        Threading::Run(m_AsyncLoadJobs, [load]
+        {
+            Timer loadTimer;
+
+            const bool loadResult = LoadAssetDataFromFile(load->Asset, LoadThreadingModeContext::MultiThread, AssetLoadStage::Default);
+
+            loadTimer.Stop();
+
+            load->Asset->SetLoadTime(static_cast<float>(loadTimer.GetElapsedTime()));
+
+            QueueAsyncLoad(load, loadResult, false, AssetLoadStage::Default);
+        });
+        break;
+    case AssetLoadMode::MultiThreadPrepare:
+        Threading::Run(m_AsyncLoadJobs, [load]
+        {
+            Timer loadTimer;
+
+            const bool loadResult = LoadAssetDataFromFile(load->Asset, LoadThreadingModeContext::MultiThread, AssetLoadStage::Prepare);
+
+            loadTimer.Stop();
+
+            load->Asset->SetLoadTime(static_cast<float>(loadTimer.GetElapsedTime()));
+
+            QueueAsyncLoad(load, loadResult, true, AssetLoadStage::Finish);
+        });
+        break;
+    }
+
+    return { load->Future, load->Placeholder };
+}
+
+void Assets::Update()
+{
+    if (m_AsyncLoads.empty())
+    {
+        return;
+    }
+
+    const double uploadBudget = Engine::GetEngineConfiguration().m_AssetUploadBudget / 1000.0;
+
+    Timer budgetTimer;
+
+    // Always finish at least one load, so a tiny budget can't stall streaming entirely.
+    while (FinishNextAsyncLoad())
+    {
+        budgetTimer.Stop();
+
+        if (budgetTimer.GetElapsedTime() >= uploadBudget)
+        {
+            break;
+        }
+    }
+}
+
+int Assets::GetPendingAsyncLoadCount()
+{
+    return static_cast<int>(m_AsyncLoads.size());
+}
+
 void Assets::AddAssetResolveReference(const AssetResolveReference& resolveReference)
 {
     std::lock_guard guard(m_AssetResolveReferencesMutex);
@@ -574,32 +1064,42 @@ IAsset* Assets::Get(const std::string& inputPath, bool includeFilePath, bool log
 {
     const auto path = String::Replace(inputPath, "\\", "/");
 
+    std::shared_lock lock(m_AssetsMutex);
+
     // If we want to find the asset by its file path instead of a fake engine path
     if (includeFilePath)
     {
-        if (m_AssetsFilePath.count(path) != 0)
-            return m_AssetsFilePath[path];
+        if (const auto it = m_AssetsFilePath.find(path); it != m_AssetsFilePath.end())
+            return it->second;
     }
 
-    if (m_Assets.count(path) == 0)
+    const auto it = m_Assets.find(path);
+
+    if (it == m_Assets.end())
     {
+        lock.unlock();
+
         if (logWarning)
         {
-            Log::Warning(fmt::format("[Assets] Failed to find asset by path, {}", inputPath));
+            Log::Warning("[Assets] Failed to find asset by path, {}", inputPath);
         }
 
         return nullptr;
     }
 
-    return m_Assets[path];
+    return it->second;
 }
 
 IAsset* Assets::GetById(std::uint32_t id)
 {
-    if (m_AssetsId.count(id) == 0)
+    std::shared_lock lock(m_AssetsMutex);
+
+    const auto it = m_AssetsId.find(id);
+
+    if (it == m_AssetsId.end())
         return nullptr;
 
-    return m_AssetsId[id];
+    return it->second;
 }
 
 IAsset *Assets::GetOrLoad(const std::string &inputPath, const bool includeFilePath)
@@ -632,6 +1132,8 @@ void Assets::MoveAsset(IAsset *asset, const std::filesystem::path &newFilePath)
     asset->SetPath(newPath);
     asset->SetFilePath(newFilePath, String::StartsWith(newFilePath.string(), asset->GetFileRootPath().string()) ? asset->GetFileRootPath() : "");
 
+    std::unique_lock lock(m_AssetsMutex);
+
     m_Assets.erase(oldPath);
     m_AssetsFilePath.erase(oldFilePath.string());
 
@@ -655,7 +1157,7 @@ void Assets::SaveAll()
         if (!asset->IsModified())
             continue;
 
-        Log::Verbose(fmt::format("[Assets] Saving asset {}...", asset->GetPath()));
+        Log::Verbose("[Assets] Saving asset {}...", asset->GetPath());
 
         asset->SaveToFile();
         asset->SaveMetadata();
@@ -664,7 +1166,7 @@ void Assets::SaveAll()
         savedAssets++;
     }
 
-    Log::Info(fmt::format("[Assets] Saved {} modified assets.", savedAssets));
+    Log::Info("[Assets] Saved {} modified assets.", savedAssets);
 }
 
 void Assets::RefreshAll()
@@ -678,7 +1180,7 @@ void Assets::RefreshAll()
 
         if (!std::filesystem::exists(asset->GetFilePath()))
         {
-            Log::Warning(fmt::format("Assets: Asset '{}' has been deleted from disk.", asset->GetPath()));
+            Log::Warning("Assets: Asset '{}' has been deleted from disk.", asset->GetPath());
 
             asset->MarkAsDeleted();
             asset->Dispose();
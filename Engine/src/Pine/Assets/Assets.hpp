@@ -1,7 +1,10 @@
 #pragma once
 #include "Pine/Assets/IAsset/IAsset.hpp"
 
+#include <chrono>
 #include <filesystem>
+#include <future>
+#include <memory>
 #include <string>
 #include <unordered_map>
 
@@ -15,6 +18,32 @@ namespace Pine
         LoadDirectory
     };
 
+    // Returned by Assets::LoadAsync(). Once the load has finished, the future holds the asset, or nullptr
+    // if the load failed.
+    struct AsyncAssetLoad
+    {
+        std::shared_future<IAsset*> m_Future;
+
+        // The asset while it's loading, which is in the `Preparing` state, or the asset still in use if it's being
+        // reloaded. Shared with the load itself, which clears it if a failed load destroys the asset.
+        std::shared_ptr<IAsset*> m_Placeholder;
+
+        bool IsReady() const
+        {
+            return m_Future.valid() && m_Future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+        }
+
+        IAsset* GetAsset() const
+        {
+            if (IsReady())
+            {
+                return m_Future.get();
+            }
+
+            return m_Placeholder ? *m_Placeholder : nullptr;
+        }
+    };
+
 }
 
 namespace Pine::Assets
@@ -27,11 +56,29 @@ namespace Pine::Assets
     // it's going to as the internal path. You can always overwrite this with mapPath.
     IAsset* LoadFromFile(const std::filesystem::path& filePath, const std::string& rootPath = "", const std::string& mapPath = "");
 
+    // Same as LoadFromFile(), but returns right away, and loads the asset in the background. Decoding happens on the
+    // worker threads, while anything that needs the main thread (such as GPU uploads) is done by Update().
+    // The asset is registered once it has finished loading. Updated assets are reloaded into a new instance, which
+    // replaces the existing one once it's done, so the existing asset can be used in the meantime.
+    AsyncAssetLoad LoadAsync(const std::filesystem::path& filePath, const std::string& rootPath = "", const std::string& mapPath = "");
+
+    // Finishes asynchronous loads on the main thread until the frame's upload budget has been
+    // spent, see EngineConfiguration::m_AssetUploadBudget. Called at the start of every frame.
+    void Update();
+
+    // The number of LoadAsync() calls that haven't finished yet.
+    int GetPendingAsyncLoadCount();
+
     // Attempts to recursively load all asset files from a directory. Will by default
     // map all assets as relative path to the specified path, however you can overwrite this
     // behaviour with useAsRelativePath. Returns the amount of assets that it __FAILED__ to load, or -1 if none were loaded.
     int LoadDirectory(const std::filesystem::path& directoryPath, bool useAsRelativePath = true);
 
+    // Mirrors a directory into the output directory, with every loaded level and blueprint in it written in the cooked
+    // binary format, everything else is copied as-is. Cooked files keep their extension and are loaded just like
+    // the JSON versions. Returns the amount of assets that were cooked, or -1 on failure.
+    int CookDirectory(const std::filesystem::path& directoryPath, const std::filesystem::path& outputDirectoryPath);
+
     // Resolve references are a way to "lazy load" assets, and will signal to the asset manager that we will need to load
     // these assets added here later. For example while loading a Material, you don't exactly need to know the texture data
     // to have a material, we just know that these X textures are bound to this material, so we'll allow the asset manager
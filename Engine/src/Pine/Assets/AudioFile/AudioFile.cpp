@@ -50,7 +50,7 @@ namespace Pine
             case AudioFileFormat::Ogg:
                 return false;
             case AudioFileFormat::Unknown:
-                Log::Error(fmt::format("AudioFile::Setup(): Failed to get audio format from extension, {}", fileExtension));
+                Log::Error("AudioFile::Setup(): Failed to get audio format from extension, {}", fileExtension);
                 return false;
         }
 
@@ -1,5 +1,8 @@
 #include "Blueprint.hpp"
 #include "Pine/Core/Serialization/Serialization.hpp"
+#include "Pine/Core/MappedFile/MappedFile.hpp"
+#include "Pine/Core/Log/Log.hpp"
+#include "Pine/World/Entities/Entities.hpp"
 
 namespace
 {
@@ -60,6 +63,183 @@ namespace
             }
         }
     }
+
+    void StoreEntity(Pine::Serialization::BinaryWriter& writer, const Pine::Entity* entity)
+    {
+        writer.WriteString(entity->GetName());
+        writer.Write(entity->GetActive());
+        writer.Write(entity->GetStatic());
+        writer.Write(entity->GetTags());
+
+        writer.Write(static_cast<std::uint32_t>(entity->GetComponents().size()));
+
+        for (auto component : entity->GetComponents())
+        {
+            writer.Write(component->GetType());
+
+            // Every component is stored as its own block, so a component reading too little
+            // or too much can't corrupt the rest of the file.
+            const auto block = writer.BeginBlock();
+
+            component->SaveData(writer);
+
+            writer.EndBlock(block);
+        }
+
+        writer.Write(static_cast<std::uint32_t>(entity->GetChildren().size()));
+
+        for (auto child : entity->GetChildren())
+        {
+            StoreEntity(writer, child);
+        }
+    }
+
+    bool LoadEntity(Pine::Serialization::BinaryReader& reader, Pine::Entity* entity)
+    {
+        entity->SetName(std::string(reader.ReadString()));
+        entity->SetActive(reader.Read<bool>());
+        entity->SetStatic(reader.Read<bool>());
+        entity->SetTags(reader.Read<std::uint64_t>());
+
+        const auto componentCount = reader.Read<std::uint32_t>();
+
+        for (std::uint32_t i = 0; i < componentCount && !reader.HasFailed(); i++)
+        {
+            const auto type = reader.Read<Pine::ComponentType>();
+            auto block = reader.ReadBlock();
+
+            if (reader.HasFailed())
+            {
+                break;
+            }
+
+            // The file may be corrupt or written by another version of the engine, so an unknown component
+            // type is skipped rather than handed to Components::Create().
+            if (static_cast<std::size_t>(type) >= Pine::ComponentTypeCount)
+            {
+                Pine::Log::Warning("[Blueprint] Skipping component of unknown type {}.", static_cast<int>(type));
+                continue;
+            }
+
+            auto component = Pine::Components::Create(type, true);
+
+            component->LoadData(block);
+
+            entity->AddComponent(component);
+        }
+
+        const auto childCount = reader.Read<std::uint32_t>();
+
+        for (std::uint32_t i = 0; i < childCount && !reader.HasFailed(); i++)
+        {
+            auto child = new Pine::Entity(0);
+
+            entity->AddChild(child);
+
+            LoadEntity(reader, child);
+        }
+
+        return !reader.HasFailed();
+    }
+
+    // Counts the entities and components within the hierarchy, so storage for them can be reserved before spawning.
+    void CountEntity(const Pine::Entity* entity, std::uint32_t& entityCount, std::vector<std::uint32_t>& componentCounts)
+    {
+        entityCount++;
+
+        for (auto component : entity->GetComponents())
+        {
+            if (component->GetType() == Pine::ComponentType::NativeScript)
+                continue;
+
+            componentCounts[static_cast<int>(component->GetType())]++;
+        }
+
+        for (auto child : entity->GetChildren())
+        {
+            CountEntity(child, entityCount, componentCounts);
+        }
+    }
+
+    // Creates a world copy of the entity hierarchy, the created components are added to the list of their
+    // type without OnCopied() or OnCreated() having been called yet.
+    Pine::Entity* InstantiateEntity(const Pine::Entity* src, std::vector<std::vector<Pine::IComponent*>>& createdComponents)
+    {
+        auto entity = Pine::Entities::CreateEmpty();
+
+        entity->SetName(src->GetName());
+        entity->SetActive(src->GetActive());
+        entity->SetStatic(src->GetStatic());
+        entity->SetTags(src->GetTags());
+
+        for (auto component : src->GetComponents())
+        {
+            if (component->GetType() == Pine::ComponentType::NativeScript)
+                continue;
+
+            auto newComponent = Pine::Components::Clone(component);
+
+            entity->AddComponent(newComponent, false);
+
+            createdComponents[static_cast<int>(newComponent->GetType())].push_back(newComponent);
+        }
+
+        for (auto child : src->GetChildren())
+        {
+            entity->AddChild(InstantiateEntity(child, createdComponents));
+        }
+
+        return entity;
+    }
+
+    std::vector<Pine::Entity*> SpawnEntities(const std::vector<const Pine::Entity*>& entities)
+    {
+        const auto componentTypeCount = Pine::Components::GetComponentTypes().size();
+
+        std::uint32_t entityCount = 0;
+        std::vector<std::uint32_t> componentCounts(componentTypeCount, 0);
+
+        for (auto entity : entities)
+        {
+            CountEntity(entity, entityCount, componentCounts);
+        }
+
+        Pine::Entities::Reserve(entityCount);
+
+        std::vector<std::vector<Pine::IComponent*>> createdComponents(componentTypeCount);
+
+        for (std::size_t i = 0; i < componentTypeCount; i++)
+        {
+            if (componentCounts[i] == 0)
+                continue;
+
+            Pine::Components::Reserve(static_cast<Pine::ComponentType>(i), componentCounts[i]);
+
+            createdComponents[i].reserve(componentCounts[i]);
+        }
+
+        std::vector<Pine::Entity*> spawnedEntities;
+
+        spawnedEntities.reserve(entities.size());
+
+        for (auto entity : entities)
+        {
+            spawnedEntities.push_back(InstantiateEntity(entity, createdComponents));
+        }
+
+        // With every entity and component in place, run the callbacks one type at a time. Transforms
+        // are the first type, so they'll be ready by the time any other component gets created.
+        for (const auto& components : createdComponents)
+        {
+            for (auto component : components)
+            {
+                component->OnCopied();
+                component->OnCreated();
+            }
+        }
+
+        return spawnedEntities;
+    }
 }
 
 Pine::Blueprint::Blueprint()
@@ -127,11 +307,26 @@ Pine::Entity* Pine::Blueprint::Spawn() const
         throw std::runtime_error("Attempted to spawn invalid blueprint.");
    }
 
-   auto entity = Entity::Create();
+   return SpawnEntities({ m_Entity }).front();
+}
+
+std::vector<Pine::Entity*> Pine::Blueprint::SpawnMultiple(const std::vector<Blueprint*>& blueprints)
+{
+    std::vector<const Entity*> entities;
+
+    entities.reserve(blueprints.size());
+
+    for (auto blueprint : blueprints)
+    {
+        if (blueprint->m_Entity == nullptr)
+        {
+            throw std::runtime_error("Attempted to spawn invalid blueprint.");
+        }
 
-   CopyEntity(entity, m_Entity, true);
+        entities.push_back(blueprint->m_Entity);
+    }
 
-   return entity;
+    return SpawnEntities(entities);
 }
 
 void Pine::Blueprint::FromJson(const nlohmann::json& j)
@@ -155,8 +350,53 @@ nlohmann::json Pine::Blueprint::ToJson() const
    return json;
 }
 
+bool Pine::Blueprint::FromBinary(Serialization::BinaryReader& reader)
+{
+   m_Entity = new Entity(0);
+
+   return LoadEntity(reader, m_Entity);
+}
+
+void Pine::Blueprint::ToBinary(Serialization::BinaryWriter& writer) const
+{
+   if (!m_Entity)
+   {
+        throw std::runtime_error("Attempted to serialize invalid blueprint.");
+   }
+
+   StoreEntity(writer, m_Entity);
+}
+
+bool Pine::Blueprint::Cook(const std::filesystem::path& path) const
+{
+    Serialization::BinaryWriter writer;
+
+    Serialization::WriteCookedHeader(writer, AssetType::Blueprint);
+
+    ToBinary(writer);
+
+    return Serialization::SaveToFile(path, writer);
+}
+
 bool Pine::Blueprint::LoadFromFile(AssetLoadStage stage)
 {
+   MappedFile file;
+
+   if (file.Open(m_FilePath) && Serialization::IsCookedFile(file.GetData(), file.GetSize()))
+   {
+        Serialization::BinaryReader reader(file.GetData(), file.GetSize());
+
+        if (!Serialization::ReadCookedHeader(reader, AssetType::Blueprint) || !FromBinary(reader))
+        {
+            Log::Error("Failed to load cooked blueprint, {}", m_FilePath.filename().string());
+            return false;
+        }
+
+        m_State = AssetState::Loaded;
+
+        return true;
+   }
+
    auto json = Serialization::LoadFromFile(m_FilePath);
 
    if (!json.has_value())
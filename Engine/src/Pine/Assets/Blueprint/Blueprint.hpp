@@ -2,6 +2,7 @@
 
 #include "Pine/Assets/IAsset/IAsset.hpp"
 #include "Pine/World/Entity/Entity.hpp"
+#include "Pine/Core/Serialization/Binary/Binary.hpp"
 
 namespace Pine
 {
@@ -34,10 +35,22 @@ namespace Pine
         // Spawns the stored entity in the world
         Entity* Spawn() const;
 
+        // Spawns the stored entities of all the blueprints at once. Storage for every entity and component
+        // is reserved up front, and components are copied directly rather than through the serializer.
+        // Returns the spawned entities, in the same order as the blueprints.
+        static std::vector<Entity*> SpawnMultiple(const std::vector<Blueprint*>& blueprints);
+
         // Serializes or de-serializes the stored entity
         void FromJson(const nlohmann::json& j);
         nlohmann::json ToJson() const;
 
+        // Same as above, but using the cooked binary format.
+        bool FromBinary(Serialization::BinaryReader& reader);
+        void ToBinary(Serialization::BinaryWriter& writer) const;
+
+        // Writes the blueprint as a cooked file, LoadFromFile() will detect and load those as well.
+        bool Cook(const std::filesystem::path& path) const;
+
         bool LoadFromFile(AssetLoadStage stage = AssetLoadStage::Default) override;
         bool SaveToFile() override;
 
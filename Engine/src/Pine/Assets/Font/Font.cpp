@@ -1,68 +1,223 @@
 #include "Font.hpp"
+#include "Pine/Core/Log/Log.hpp"
 #include "Pine/Graphics/Graphics.hpp"
+#include <algorithm>
+#include <atomic>
 #include <fstream>
 
 #define STB_TRUETYPE_IMPLEMENTATION
 
 #include <stb_truetype.h>
 
+namespace
+{
+    constexpr int InitialAtlasSize = 512;
+    constexpr int MaxAtlasSize = 4096;
+
+    // Glyphs are spaced apart in the atlas, so filtering doesn't bleed into neighbouring glyphs.
+    constexpr int GlyphPadding = 1;
+
+    std::atomic<std::uint64_t> m_NextAtlasId = 1;
+}
+
 Pine::Font::Font()
 {
     m_Type = AssetType::Font;
 }
 
-std::uint32_t Pine::Font::Create(float fontSize)
+bool Pine::Font::PackGlyphs(FontData& data, const std::vector<int>& codepoints, std::vector<stbtt_packedchar>& glyphs)
 {
-    std::ifstream stream(m_FilePath.string(), std::ios::binary | std::ios::ate);
+    glyphs.assign(codepoints.size(), stbtt_packedchar());
+
+    stbtt_pack_range range = {};
+
+    range.font_size = data.m_Size;
+    range.array_of_unicode_codepoints = const_cast<int*>(codepoints.data());
+    range.num_chars = static_cast<int>(codepoints.size());
+    range.chardata_for_range = glyphs.data();
+
+    std::vector<stbrp_rect> rects(codepoints.size());
 
-    if (!stream.is_open())
+    const int rectCount = stbtt_PackFontRangesGatherRects(data.m_PackContext.get(), &m_FontInfo, &range, 1, rects.data());
+
+    stbtt_PackFontRangesPackRects(data.m_PackContext.get(), rects.data(), rectCount);
+    stbtt_PackFontRangesRenderIntoRects(data.m_PackContext.get(), &m_FontInfo, &range, 1, rects.data());
+
+    // Code points missing from the font get an empty rectangle, so only non-empty rectangles that weren't
+    // packed mean the atlas is full.
+    return std::none_of(rects.begin(), rects.begin() + rectCount, [](const stbrp_rect& rect)
+    {
+        return rect.w != 0 && rect.h != 0 && !rect.was_packed;
+    });
+}
+
+void Pine::Font::GrowAtlas(FontData& data, const std::vector<int>& codepoints)
+{
+    // Every glyph is packed again, since there's no way to grow the packing area of the existing atlas.
+    std::vector<int> allCodepoints = codepoints;
+
+    for (const auto& [codepoint, glyph] : data.m_Glyphs)
     {
-        return false;
+        allCodepoints.push_back(static_cast<int>(codepoint));
     }
 
-    std::streamsize size = stream.tellg();
+    std::vector<stbtt_packedchar> glyphs;
 
-    stream.seekg(0, std::ios::beg);
+    int size = data.m_AtlasSize == 0 ? InitialAtlasSize : std::min(data.m_AtlasSize * 2, MaxAtlasSize);
 
-    std::vector<char> buffer(size);
+    while (true)
+    {
+        if (data.m_PackContext)
+            stbtt_PackEnd(data.m_PackContext.get());
+        else
+            data.m_PackContext = std::make_unique<stbtt_pack_context>();
 
-    if (stream.read(buffer.data(), size))
+        data.m_AtlasBitmap.assign(static_cast<std::size_t>(size) * size, 0);
+
+        stbtt_PackBegin(data.m_PackContext.get(), data.m_AtlasBitmap.data(), size, size, 0, GlyphPadding, nullptr);
+        stbtt_PackSetOversampling(data.m_PackContext.get(), 1, 1);
+
+        if (PackGlyphs(data, allCodepoints, glyphs))
+            break;
+
+        if (size >= MaxAtlasSize)
+        {
+            Log::Warning("[Font] The glyph atlas of {} is full, some characters will be missing.", GetPath());
+            break;
+        }
+
+        size = std::min(size * 2, MaxAtlasSize);
+    }
+
+    data.m_Glyphs.clear();
+
+    for (std::size_t i = 0; i < allCodepoints.size(); i++)
+    {
+        data.m_Glyphs[static_cast<std::uint32_t>(allCodepoints[i])] = glyphs[i];
+    }
+
+    data.m_AtlasSize = size;
+    data.m_AtlasVersion++;
+
+    data.m_TextureFontAtlas->Bind();
+    data.m_TextureFontAtlas->UploadTextureData(size, size, Graphics::TextureFormat::SingleChannel, Graphics::TextureDataFormat::UnsignedByte, data.m_AtlasBitmap.data());
+}
+
+std::uint32_t Pine::Font::Create(float fontSize)
+{
+    if (m_FontFileData.empty())
     {
-        void* bitmapBuffer = malloc(1024 * 1024);
+        std::ifstream stream(m_FilePath.string(), std::ios::binary | std::ios::ate);
 
-        FontData data;
+        if (!stream.is_open())
+        {
+            return false;
+        }
 
-        data.m_Size = fontSize;
-        data.m_CharData.resize(96);
+        std::streamsize size = stream.tellg();
 
-        /*
-         * Baked fonts can't have subpixel positioning
-         */
-        // stbtt_BakeFontBitmap(reinterpret_cast<const unsigned char*>(buffer.data()), 0, fontSize, static_cast<unsigned char*>(bitmapBuffer), 1024, 1024, 32, 96, data.m_CharData.data());
+        stream.seekg(0, std::ios::beg);
 
-        // For several font sizes we use a range array and set the font sizes we want in it then pack it with stbtt_PackFontRanges
-        stbtt_pack_context ctx;
-        stbtt_PackBegin(&ctx, static_cast<unsigned char*>(bitmapBuffer), 1024, 1024, 0, 1, NULL);
-        stbtt_PackSetOversampling(&ctx, 1, 1);
-        stbtt_pack_range range[1] = {{fontSize, 32, nullptr, 96, data.m_CharData.data(), 0, 0}};
+        m_FontFileData.resize(size);
 
-        stbtt_PackFontRanges(&ctx, reinterpret_cast<const unsigned char*>(buffer.data()), 0, range, 1);
-        stbtt_PackEnd(&ctx);
+        if (!stream.read(reinterpret_cast<char*>(m_FontFileData.data()), size) ||
+            !stbtt_InitFont(&m_FontInfo, m_FontFileData.data(), stbtt_GetFontOffsetForIndex(m_FontFileData.data(), 0)))
+        {
+            m_FontFileData.clear();
 
-        data.m_TextureFontAtlas = Graphics::GetGraphicsAPI()->CreateTexture();
+            return 0;
+        }
+    }
 
-        data.m_TextureFontAtlas->Bind();
-        data.m_TextureFontAtlas->UploadTextureData(1024, 1024, Graphics::TextureFormat::SingleChannel, Graphics::TextureDataFormat::UnsignedByte, bitmapBuffer);
-        data.m_TextureFontAtlas->SetSwizzleMask(Graphics::SwizzleMaskChannel::Red, Graphics::SwizzleMaskChannel::Red, Graphics::SwizzleMaskChannel::Red, Graphics::SwizzleMaskChannel::Alpha);
+    auto& data = m_FontAtlas.emplace_back();
 
-        free(bitmapBuffer);
+    data.m_Id = m_NextAtlasId++;
+    data.m_Size = fontSize;
 
-        m_FontAtlas.push_back(data);
+    data.m_TextureFontAtlas = Graphics::GetGraphicsAPI()->CreateTexture();
+    data.m_TextureFontAtlas->Bind();
+    data.m_TextureFontAtlas->SetSwizzleMask(Graphics::SwizzleMaskChannel::Red, Graphics::SwizzleMaskChannel::Red, Graphics::SwizzleMaskChannel::Red, Graphics::SwizzleMaskChannel::Alpha);
 
-        return static_cast<std::uint32_t>(m_FontAtlas.size()) - 1;
+    // Printable ASCII is used by pretty much all text, anything else is added once it's used.
+    std::vector<int> codepoints;
+
+    for (int codepoint = 32; codepoint < 127; codepoint++)
+    {
+        codepoints.push_back(codepoint);
+    }
+
+    GrowAtlas(data, codepoints);
+
+    return static_cast<std::uint32_t>(m_FontAtlas.size()) - 1;
+}
+
+void Pine::Font::PrepareGlyphs(std::uint32_t index, const std::vector<std::uint32_t>& codepoints)
+{
+    auto& data = m_FontAtlas[index];
+
+    static std::vector<int> missingCodepoints;
+
+    missingCodepoints.clear();
+
+    for (const auto codepoint : codepoints)
+    {
+        if (codepoint >= 32 && data.m_Glyphs.count(codepoint) == 0)
+        {
+            missingCodepoints.push_back(static_cast<int>(codepoint));
+        }
+    }
+
+    if (missingCodepoints.empty())
+    {
+        return;
+    }
+
+    std::sort(missingCodepoints.begin(), missingCodepoints.end());
+    missingCodepoints.erase(std::unique(missingCodepoints.begin(), missingCodepoints.end()), missingCodepoints.end());
+
+    static std::vector<stbtt_packedchar> glyphs;
+
+    if (!PackGlyphs(data, missingCodepoints, glyphs))
+    {
+        if (data.m_AtlasSize < MaxAtlasSize)
+        {
+            GrowAtlas(data, missingCodepoints);
+            return;
+        }
+
+        // The atlas can't grow any further. The glyphs that didn't fit are kept as empty glyphs, so they're
+        // drawn as missing rather than being packed again every time they're used.
+        Log::Warning("[Font] The glyph atlas of {} is full, some characters will be missing.", GetPath());
+    }
+
+    // Only upload the rows of the atlas the new glyphs ended up in.
+    int firstRow = data.m_AtlasSize;
+    int lastRow = 0;
+
+    for (std::size_t i = 0; i < missingCodepoints.size(); i++)
+    {
+        const auto& glyph = glyphs[i];
+
+        data.m_Glyphs[static_cast<std::uint32_t>(missingCodepoints[i])] = glyph;
+
+        if (glyph.y1 > glyph.y0)
+        {
+            firstRow = std::min(firstRow, static_cast<int>(glyph.y0));
+            lastRow = std::max(lastRow, static_cast<int>(glyph.y1));
+        }
+    }
+
+    if (firstRow >= lastRow)
+    {
+        return;
     }
 
-    return 0;
+    data.m_TextureFontAtlas->Bind();
+    data.m_TextureFontAtlas->UploadTextureSubData(Vector2i(0, firstRow),
+                                                  Vector2i(data.m_AtlasSize, lastRow - firstRow),
+                                                  Graphics::TextureFormat::SingleChannel,
+                                                  Graphics::TextureDataFormat::UnsignedByte,
+                                                  data.m_AtlasBitmap.data() + static_cast<std::size_t>(firstRow) * data.m_AtlasSize);
 }
 
 const Pine::FontData& Pine::Font::GetFontData(std::uint32_t index) const
@@ -72,6 +227,21 @@ const Pine::FontData& Pine::Font::GetFontData(std::uint32_t index) const
 
 void Pine::Font::Dispose()
 {
+    for (auto& data : m_FontAtlas)
+    {
+        if (data.m_PackContext)
+        {
+            stbtt_PackEnd(data.m_PackContext.get());
+        }
+
+        if (data.m_TextureFontAtlas)
+        {
+            Graphics::GetGraphicsAPI()->DestroyTexture(data.m_TextureFontAtlas);
+        }
+    }
+
+    m_FontAtlas.clear();
+    m_FontFileData.clear();
 }
 
 bool Pine::Font::LoadFromFile(AssetLoadStage stage)
@@ -2,6 +2,8 @@
 
 #include "Pine/Assets/IAsset/IAsset.hpp"
 #include "Pine/Graphics/Interfaces/ITexture.hpp"
+#include <memory>
+#include <unordered_map>
 #include <stb_truetype.h>
 
 namespace Pine
@@ -9,22 +11,46 @@ namespace Pine
 
     struct FontData
     {
+        // Unique for every atlas ever created, so anything cached for an atlas isn't mistaken for one belonging to
+        // a reloaded font, which may well end up at the same address.
+        std::uint64_t m_Id = 0;
+
         float m_Size = 0.f;
 
-        std::vector<stbtt_packedchar> m_CharData;
+        // Glyphs are added to the atlas the first time they're used, indexed by their code point.
+        std::unordered_map<std::uint32_t, stbtt_packedchar> m_Glyphs;
 
         Graphics::ITexture* m_TextureFontAtlas = nullptr;
+
+        // The atlas is square, and grows once it's full.
+        int m_AtlasSize = 0;
+
+        // Incremented every time the atlas grows, since every glyph moves to a new location when it does.
+        std::uint32_t m_AtlasVersion = 0;
+
+        std::vector<unsigned char> m_AtlasBitmap;
+        std::unique_ptr<stbtt_pack_context> m_PackContext;
     };
 
     class Font : public IAsset
     {
     private:
         std::vector<FontData> m_FontAtlas;
+
+        std::vector<unsigned char> m_FontFileData;
+        stbtt_fontinfo m_FontInfo = {};
+
+        // Returns false if not every glyph fit in the atlas.
+        bool PackGlyphs(FontData& data, const std::vector<int>& codepoints, std::vector<stbtt_packedchar>& glyphs);
+        void GrowAtlas(FontData& data, const std::vector<int>& codepoints);
     public:
         Font();
 
         std::uint32_t Create(float fontSize);
 
+        // Adds every code point that isn't in the atlas yet.
+        void PrepareGlyphs(std::uint32_t index, const std::vector<std::uint32_t>& codepoints);
+
         const FontData& GetFontData(std::uint32_t index) const;
 
         bool LoadFromFile(AssetLoadStage stage) override;
@@ -32,4 +58,4 @@ namespace Pine
         void Dispose() override;
     };
 
-}
\ No newline at end of file
+}
@@ -77,6 +77,11 @@ const std::filesystem::path& Pine::IAsset::GetFileRootPath() const
     return m_FileRootPath;
 }
 
+void Pine::IAsset::SetState(AssetState state)
+{
+    m_State = state;
+}
+
 Pine::AssetState Pine::IAsset::GetState() const
 {
     return m_State;
@@ -92,6 +97,16 @@ Pine::AssetLoadMode Pine::IAsset::GetLoadMode() const
     return m_LoadMode;
 }
 
+void Pine::IAsset::SetLoadTime(float loadTime)
+{
+    m_LoadTime = loadTime;
+}
+
+float Pine::IAsset::GetLoadTime() const
+{
+    return m_LoadTime;
+}
+
 bool Pine::IAsset::LoadFromFile(AssetLoadStage stage) // NOLINT(google-default-arguments)
 {
     return true;
@@ -191,6 +206,17 @@ void Pine::IAsset::MarkAsDeleted()
     m_IsDeleted = true;
 }
 
+void Pine::IAsset::MarkAsReplaced(IAsset* replacement)
+{
+    m_IsDeleted = true;
+    m_ReplacedBy = replacement;
+}
+
+Pine::IAsset* Pine::IAsset::GetReplacement() const
+{
+    return m_ReplacedBy;
+}
+
 bool Pine::IAsset::IsModified() const
 {
     return m_HasBeenModified;
@@ -121,6 +121,9 @@ namespace Pine
 
         AssetLoadMode m_LoadMode = AssetLoadMode::SingleThread;
 
+        // Time in seconds spent loading the asset's data during the last load, all load stages combined.
+        float m_LoadTime = 0.f;
+
         // It's up to the asset to set this to true if needed. If it's true, the user may put any data
         // into m_Metadata and the asset manager should take care of loading/saving the data automatically.
         bool m_HasMetadata = false;
@@ -137,6 +140,10 @@ namespace Pine
         int m_ReferenceCount = 0;
         bool m_IsDeleted = false;
 
+        // Set if the asset was reloaded into a new instance, which took over its place. Asset handles
+        // still pointing to this asset will move on to the replacement.
+        IAsset* m_ReplacedBy = nullptr;
+
         Script::ObjectHandle m_ScriptObjectHandle = { nullptr, 0 };
 
         template<typename>
@@ -174,12 +181,20 @@ namespace Pine
         void MarkAsDeleted();
         void MarkAsModified();
 
+        // Marks the asset as deleted, with replacement taking its place.
+        void MarkAsReplaced(IAsset* replacement);
+        IAsset* GetReplacement() const;
+
         bool IsDeleted() const;
         bool IsModified() const;
 
+        void SetState(AssetState state);
         AssetState GetState() const;
         AssetLoadMode GetLoadMode() const;
 
+        void SetLoadTime(float loadTime);
+        float GetLoadTime() const;
+
         void LoadMetadata();
         void SaveMetadata();
 
@@ -195,9 +210,33 @@ namespace Pine
     {
     private:
         mutable T *m_Asset = nullptr;
+
+        // Moves the handle on to the instance that replaced the asset, if it has been reloaded.
+        void FollowReplacement() const
+        {
+            auto asset = reinterpret_cast<IAsset *>(m_Asset);
+
+            if (asset == nullptr || asset->m_ReplacedBy == nullptr)
+            {
+                return;
+            }
+
+            --asset->m_ReferenceCount;
+
+            while (asset->m_ReplacedBy != nullptr)
+            {
+                asset = asset->m_ReplacedBy;
+            }
+
+            ++asset->m_ReferenceCount;
+
+            m_Asset = reinterpret_cast<T *>(asset);
+        }
     public:
         T *Get() const
         {
+            FollowReplacement();
+
             // Make sure to remove any pending deletion assets
             if (m_Asset)
             {
@@ -214,6 +253,8 @@ namespace Pine
 
         T *operator->()
         {
+            FollowReplacement();
+
             return m_Asset;
         }
 
@@ -233,6 +274,14 @@ namespace Pine
             return *this;
         }
 
+        // Takes a reference on the asset that's already held, for handles that were copied bit for bit
+        // (i.e. within a cloned component) and therefore never went through operator=.
+        void AddReference()
+        {
+            if (m_Asset != nullptr)
+                ++reinterpret_cast<IAsset *>(m_Asset)->m_ReferenceCount;
+        }
+
         inline bool operator==(const IAsset *b)
         {
             return m_Asset == b;
@@ -1,9 +1,13 @@
 #include "Level.hpp"
 #include "Pine/Core/Serialization/Serialization.hpp"
+#include "Pine/Core/MappedFile/MappedFile.hpp"
+#include "Pine/Core/Log/Log.hpp"
 #include "Pine/World/World.hpp"
 #include "Pine/World/Entities/Entities.hpp"
 #include "Pine/Rendering/RenderManager/RenderManager.hpp"
 
+#include <algorithm>
+
 Pine::Level::Level()
 {
     m_Type = AssetType::Level;
@@ -69,9 +73,13 @@ void Pine::Level::Load()
 
     const auto entityOffset = Entities::GetList().size();
 
-    for (const auto& blueprint : m_Blueprints)
+    // Spawns the entire level in one go, rather than one blueprint at the time, so that storage is only
+    // reserved once and component callbacks can be run per component type.
+    Blueprint::SpawnMultiple(m_Blueprints);
+
+    if (Log::IsEnabled(LogSeverity::Verbose))
     {
-        blueprint->Spawn();
+        Components::LogStorageUsage();
     }
 
     if (m_LevelSettings.HasCamera)
@@ -116,8 +124,70 @@ Pine::LevelSettings& Pine::Level::GetLevelSettings()
     return m_LevelSettings;
 }
 
+bool Pine::Level::Cook(const std::filesystem::path& path) const
+{
+    Serialization::BinaryWriter writer;
+
+    Serialization::WriteCookedHeader(writer, AssetType::Level);
+
+    writer.Write(m_LevelSettings.HasCamera);
+    writer.Write(m_LevelSettings.CameraEntity);
+    Serialization::StoreAsset(writer, m_LevelSettings.Skybox);
+    writer.Write(m_LevelSettings.AmbientColor);
+
+    writer.Write(static_cast<std::uint32_t>(m_Blueprints.size()));
+
+    for (auto bp : m_Blueprints)
+    {
+        bp->ToBinary(writer);
+    }
+
+    return Serialization::SaveToFile(path, writer);
+}
+
 bool Pine::Level::LoadFromFile(AssetLoadStage stage)
 {
+    MappedFile file;
+
+    if (file.Open(m_FilePath) && Serialization::IsCookedFile(file.GetData(), file.GetSize()))
+    {
+        Serialization::BinaryReader reader(file.GetData(), file.GetSize());
+
+        if (!Serialization::ReadCookedHeader(reader, AssetType::Level))
+        {
+            Log::Error("Failed to load cooked level, {}", m_FilePath.filename().string());
+            return false;
+        }
+
+        reader.Read(m_LevelSettings.HasCamera);
+        reader.Read(m_LevelSettings.CameraEntity);
+        Serialization::LoadAsset(reader, m_LevelSettings.Skybox);
+        reader.Read(m_LevelSettings.AmbientColor);
+
+        const auto blueprintCount = reader.Read<std::uint32_t>();
+
+        m_Blueprints.reserve(std::min<std::size_t>(blueprintCount, reader.GetSize()));
+
+        for (std::uint32_t i = 0; i < blueprintCount && !reader.HasFailed(); i++)
+        {
+            auto blueprint = new Blueprint();
+
+            blueprint->FromBinary(reader);
+
+            m_Blueprints.push_back(blueprint);
+        }
+
+        if (reader.HasFailed())
+        {
+            Log::Error("Failed to load cooked level, {}", m_FilePath.filename().string());
+            return false;
+        }
+
+        m_State = AssetState::Loaded;
+
+        return true;
+    }
+
     const auto json = Serialization::LoadFromFile(m_FilePath);
 
     if (!json.has_value())
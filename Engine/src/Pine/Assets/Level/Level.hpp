@@ -39,6 +39,9 @@ namespace Pine
 
         LevelSettings& GetLevelSettings();
 
+        // Writes the level as a cooked file, LoadFromFile() will detect and load those as well.
+        bool Cook(const std::filesystem::path& path) const;
+
         bool LoadFromFile(AssetLoadStage stage) override;
         bool SaveToFile() override;
 
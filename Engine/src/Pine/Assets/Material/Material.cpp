@@ -2,6 +2,14 @@
 
 #include "Pine/Core/Serialization/Serialization.hpp"
 
+#include <atomic>
+
+namespace
+{
+	// Meshes may get their materials assigned on the asset loading threads.
+	std::atomic<std::uint32_t> m_RenderingModeRevision = 0;
+}
+
 Pine::Material::Material()
 {
 	m_Type = AssetType::Material;
@@ -113,6 +121,8 @@ void Pine::Material::SetRenderingMode(MaterialRenderingMode mode)
 {
 	m_RenderingMode = mode;
     m_HasBeenModified = true;
+
+	MarkRenderingModesModified();
 }
 
 Pine::MaterialRenderingMode Pine::Material::GetRenderingMode() const
@@ -120,6 +130,16 @@ Pine::MaterialRenderingMode Pine::Material::GetRenderingMode() const
 	return m_RenderingMode;
 }
 
+std::uint32_t Pine::Material::GetRenderingModeRevision()
+{
+	return m_RenderingModeRevision;
+}
+
+void Pine::Material::MarkRenderingModesModified()
+{
+	++m_RenderingModeRevision;
+}
+
 void Pine::Material::SetShininess(float value)
 {
 	m_Shininess = value;
@@ -165,6 +185,8 @@ bool Pine::Material::LoadFromFile(AssetLoadStage stage)
 
 	Serialization::LoadValue(j, "renderingMode", m_RenderingMode);
 
+	MarkRenderingModesModified();
+
 	Serialization::LoadValue(j, "shininess", m_Shininess);
 	Serialization::LoadValue(j, "textureScale", m_TextureScale);
 
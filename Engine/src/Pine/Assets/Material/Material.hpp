@@ -64,6 +64,11 @@ namespace Pine
 		void SetRenderingMode(MaterialRenderingMode mode);
 		MaterialRenderingMode GetRenderingMode() const;
 
+		// Changes whenever the rendering mode of any material, or the material of any mesh, changes. Allows
+		// anything caching the rendering modes of materials to know when to update them.
+		static std::uint32_t GetRenderingModeRevision();
+		static void MarkRenderingModesModified();
+
 		void SetShininess(float value);
 		float GetShininess() const;
 
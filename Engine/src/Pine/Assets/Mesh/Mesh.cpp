@@ -41,6 +41,8 @@ void Pine::Mesh::SetMaterial(Material*material)
 {
     m_Material = material;
 
+    Material::MarkRenderingModesModified();
+
     if (material && !material->IsMeshGenerated())
     {
         m_Model->MarkAsModified();
@@ -155,7 +155,7 @@ bool Model::LoadModel()
 
     if (!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode)
     {
-        Log::Error(fmt::format("Model importing error: {}", importer.GetErrorString()));
+        Log::Error("Model importing error: {}", importer.GetErrorString());
         return false;
     }
 
@@ -260,6 +260,8 @@ Mesh* Model::CreateMesh()
 
     m_Meshes.push_back(mesh);
 
+    Material::MarkRenderingModesModified();
+
     return mesh;
 }
 
@@ -268,6 +270,30 @@ const std::vector<Mesh*> &Model::GetMeshes() const
     return m_Meshes;
 }
 
+bool Model::HasTransparentMaterial() const
+{
+    const auto revision = Material::GetRenderingModeRevision();
+
+    if (m_TransparencyRevision == revision)
+    {
+        return m_HasTransparentMaterial;
+    }
+
+    m_HasTransparentMaterial = false;
+    m_TransparencyRevision = revision;
+
+    for (const auto mesh : m_Meshes)
+    {
+        if (mesh->GetMaterial() && mesh->GetMaterial()->GetRenderingMode() == MaterialRenderingMode::Transparent)
+        {
+            m_HasTransparentMaterial = true;
+            break;
+        }
+    }
+
+    return m_HasTransparentMaterial;
+}
+
 const Vector3f& Model::GetBoundingBoxMin() const
 {
     return m_BoundingBoxMin;
@@ -302,6 +328,8 @@ void Model::Dispose()
     }
 
     m_Meshes.clear();
+
+    Material::MarkRenderingModesModified();
 }
 
 bool Model::SaveToFile()
@@ -3,6 +3,8 @@
 #include "Pine/Assets/IAsset/IAsset.hpp"
 #include "Pine/Assets/Mesh/Mesh.hpp"
 
+#include <limits>
+
 class aiMesh;
 struct aiScene;
 class aiNode;
@@ -52,6 +54,10 @@ namespace Pine
 
         bool m_UsedAsCollider = false;
 
+        // Cached by HasTransparentMaterial(), computed at the stored material rendering mode revision.
+        mutable bool m_HasTransparentMaterial = false;
+        mutable std::uint32_t m_TransparencyRevision = std::numeric_limits<std::uint32_t>::max();
+
         void ProcessMesh(aiMesh *mesh, const aiScene *scene);
         void ProcessNode(const aiNode *node, const aiScene *scene);
 
@@ -64,6 +70,9 @@ namespace Pine
 
         const std::vector<Mesh*>& GetMeshes() const;
 
+        // If any of the meshes has a material that requires blending.
+        bool HasTransparentMaterial() const;
+
         const Pine::Vector3f& GetBoundingBoxMin() const;
         const Pine::Vector3f& GetBoundingBoxMax() const;
 
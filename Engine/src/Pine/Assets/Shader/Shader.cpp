@@ -65,7 +65,7 @@ namespace
             }
             else
             {
-                Pine::Log::Warning(fmt::format("Failed to find shader include file {} compiling {}", filePath.string(), shaderCompileContext.Shader->GetFileName()));
+                Pine::Log::Warning("Failed to find shader include file {} compiling {}", filePath.string(), shaderCompileContext.Shader->GetFileName());
                 return "";
             }
         }
@@ -83,7 +83,7 @@ namespace
 
         if (!std::filesystem::exists(shaderCompileContext.FilePath) && !hasParentShader)
         {
-            Pine::Log::Error("Failed to find shader file " + shaderCompileContext.FilePath);
+            Pine::Log::Error("Failed to find shader file {}", shaderCompileContext.FilePath);
             return false;
         }
 
@@ -91,7 +91,7 @@ namespace
 
         if (file.empty() && !hasParentShader)
         {
-            Pine::Log::Error("Failed to read file " + shaderCompileContext.FilePath);
+            Pine::Log::Error("Failed to read file {}", shaderCompileContext.FilePath);
             return false;
         }
 
@@ -125,7 +125,7 @@ namespace
 
         if (!shaderCompileContext.Program->CompileAndLoadShader(src, shaderCompileContext.Type))
         {
-            Pine::Log::Error(fmt::format("Error occurred in file {}", shaderCompileContext.FilePath));
+            Pine::Log::Error("Error occurred in file {}", shaderCompileContext.FilePath);
 
             return false;
         }
@@ -301,7 +301,7 @@ bool Pine::Shader::LoadShaderPackage(const nlohmann::json &j, std::uint32_t shad
     // Invalid shader configuration
     if (vertexPath.empty() && fragmentPath.empty() && computePath.empty() && geometryPath.empty())
     {
-        Log::Error("No shader files specified in " + m_FileName);
+        Log::Error("No shader files specified in {}", m_FileName);
 
         return false;
     }
@@ -316,7 +316,7 @@ bool Pine::Shader::LoadShaderPackage(const nlohmann::json &j, std::uint32_t shad
 
         if (!m_ParentShader)
         {
-            Log::Error(fmt::format("Failed to find parent shader in {}, parent shader: {}.", m_FileName, j["parent"].get<std::string>()));
+            Log::Error("Failed to find parent shader in {}, parent shader: {}.", m_FileName, j["parent"].get<std::string>());
             return false;
         }
     }
@@ -427,7 +427,7 @@ bool Pine::Shader::LoadShaderPackage(const nlohmann::json &j, std::uint32_t shad
 
             if (uniformVariable == nullptr)
             {
-                Log::Warning("Failed to find texture sampler " + name + ", " + m_FileName);
+                Log::Warning("Failed to find texture sampler {}, {}", name, m_FileName);
                 continue;
             }
 
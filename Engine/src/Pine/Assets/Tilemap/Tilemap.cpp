@@ -2,6 +2,32 @@
 #include "Pine/Assets/IAsset/IAsset.hpp"
 #include "Pine/Core/Serialization/Serialization.hpp"
 
+#include <algorithm>
+#include <atomic>
+
+namespace
+{
+    // Tilemaps may be loaded from several threads at once.
+    std::atomic<std::uint64_t> m_NextChunkId = 1;
+
+    int FloorDivide(int value, int divisor)
+    {
+        return value < 0 ? (value - divisor + 1) / divisor : value / divisor;
+    }
+
+    std::uint64_t GetChunkKey(Pine::Vector2i chunkPosition)
+    {
+        return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(chunkPosition.x)) << 32) | static_cast<std::uint32_t>(chunkPosition.y);
+    }
+
+    int GetTileSlot(const Pine::TileChunk& chunk, Pine::Vector2i gridPosition)
+    {
+        const auto localPosition = gridPosition - chunk.m_Position * Pine::TileChunkSize;
+
+        return localPosition.y * Pine::TileChunkSize + localPosition.x;
+    }
+}
+
 Pine::Tilemap::Tilemap()
 {
     m_Type = AssetType::Tilemap;
@@ -12,6 +38,12 @@ void Pine::Tilemap::SetTileset(Tileset* tileset)
 {
     m_Tileset = tileset;
     m_HasBeenModified = true;
+
+    // The render indices may differ in the new tileset, so anything cached for the chunks is outdated.
+    for (auto& [key, chunk] : m_Chunks)
+    {
+        chunk.m_Version++;
+    }
 }
 
 Pine::Tileset* Pine::Tilemap::GetTileset() const
@@ -19,9 +51,45 @@ Pine::Tileset* Pine::Tilemap::GetTileset() const
     return m_Tileset.Get();
 }
 
-const std::vector<Pine::TileInstance>& Pine::Tilemap::GetTiles() const
+std::uint32_t Pine::Tilemap::GetTileCount() const
 {
-    return m_Tiles;
+    return m_TileCount;
+}
+
+void Pine::Tilemap::ForEachTile(const std::function<void(const TileInstance&)>& fn) const
+{
+    for (const auto& [key, chunk] : m_Chunks)
+    {
+        for (int i = 0; i < TileChunkArea; i++)
+        {
+            if (chunk.m_Occupied[i])
+            {
+                fn(chunk.m_Tiles[i]);
+            }
+        }
+    }
+}
+
+const Pine::TileChunk* Pine::Tilemap::GetChunk(Vector2i chunkPosition) const
+{
+    const auto it = m_Chunks.find(GetChunkKey(chunkPosition));
+
+    if (it == m_Chunks.end())
+    {
+        return nullptr;
+    }
+
+    return &it->second;
+}
+
+const std::unordered_map<std::uint64_t, Pine::TileChunk>& Pine::Tilemap::GetChunks() const
+{
+    return m_Chunks;
+}
+
+Pine::Vector2i Pine::Tilemap::GetChunkPosition(Vector2i gridPosition)
+{
+    return Vector2i(FloorDivide(gridPosition.x, TileChunkSize), FloorDivide(gridPosition.y, TileChunkSize));
 }
 
 void Pine::Tilemap::Dispose()
@@ -53,32 +121,89 @@ void Pine::Tilemap::CreateTile(std::uint32_t index, Vector2i gridPosition, std::
     if (flags != 0)
         tileInstance.m_Flags = flags;
 
-    m_Tiles.push_back(tileInstance);
+    const auto chunkPosition = GetChunkPosition(gridPosition);
+
+    auto [it, inserted] = m_Chunks.try_emplace(GetChunkKey(chunkPosition));
+    auto& chunk = it->second;
+
+    if (inserted)
+    {
+        chunk.m_Id = m_NextChunkId++;
+        chunk.m_Position = chunkPosition;
+    }
+
+    const auto slot = GetTileSlot(chunk, gridPosition);
+
+    if (!chunk.m_Occupied[slot])
+    {
+        chunk.m_Occupied[slot] = true;
+        chunk.m_TileCount++;
+
+        m_TileCount++;
+    }
+
+    chunk.m_Tiles[slot] = tileInstance;
+    chunk.m_Version++;
 }
 
 void Pine::Tilemap::RemoveTile(const TileInstance& instance)
 {
-    for (int i = 0; i < m_Tiles.size();i++)
+    RemoveTile(instance.m_Position);
+}
+
+void Pine::Tilemap::RemoveTile(Vector2i gridPosition)
+{
+    const auto it = m_Chunks.find(GetChunkKey(GetChunkPosition(gridPosition)));
+
+    if (it == m_Chunks.end())
     {
-        if (&m_Tiles[i] == &instance)
-        {
-            m_Tiles.erase(m_Tiles.begin() + i);
-            break;
-        }
+        return;
+    }
+
+    auto& chunk = it->second;
+
+    const auto slot = GetTileSlot(chunk, gridPosition);
+
+    if (!chunk.m_Occupied[slot])
+    {
+        return;
     }
+
+    chunk.m_Occupied[slot] = false;
+    chunk.m_TileCount--;
+    chunk.m_Version++;
+
+    m_TileCount--;
+
+    if (chunk.m_TileCount == 0)
+    {
+        m_Chunks.erase(it);
+    }
+}
+
+void Pine::Tilemap::ClearTiles()
+{
+    m_Chunks.clear();
+    m_TileCount = 0;
 }
 
 const Pine::TileInstance* Pine::Tilemap::GetTileByPosition(Vector2i gridPosition) const
 {
-    for (const auto & m_Tile : m_Tiles)
+    const auto chunk = GetChunk(GetChunkPosition(gridPosition));
+
+    if (chunk == nullptr)
     {
-        if (m_Tile.m_Position == gridPosition)
-        {
-            return &m_Tile;
-        }
+        return nullptr;
     }
 
-    return nullptr;
+    const auto slot = GetTileSlot(*chunk, gridPosition);
+
+    if (!chunk->m_Occupied[slot])
+    {
+        return nullptr;
+    }
+
+    return &chunk->m_Tiles[slot];
 }
 
 bool Pine::Tilemap::LoadFromFile(AssetLoadStage stage)
@@ -92,6 +217,8 @@ bool Pine::Tilemap::LoadFromFile(AssetLoadStage stage)
 
     Serialization::LoadAsset(j, "tileSet", m_Tileset, false);
 
+    ClearTiles();
+
     if (j.contains("tiles"))
     {
         for (const auto& tileData : j["tiles"])
@@ -111,27 +238,52 @@ bool Pine::Tilemap::SaveToFile()
 
     j["tileSet"] = Serialization::StoreAsset(m_Tileset.Get());
 
-    for (const auto& tileInstance : m_Tiles)
+    // Store the chunks in a fixed order, so saving an unchanged tilemap produces the same file.
+    std::vector<const TileChunk*> chunks;
+
+    chunks.reserve(m_Chunks.size());
+
+    for (const auto& [key, chunk] : m_Chunks)
     {
-        auto tileData = m_Tileset->GetTileByIndex(tileInstance.m_Index);
+        chunks.push_back(&chunk);
+    }
+
+    std::sort(chunks.begin(), chunks.end(), [](const TileChunk* a, const TileChunk* b)
+    {
+        return a->m_Position.y < b->m_Position.y || (a->m_Position.y == b->m_Position.y && a->m_Position.x < b->m_Position.x);
+    });
 
-        if (tileData == nullptr)
+    for (const auto chunk : chunks)
+    {
+        for (int i = 0; i < TileChunkArea; i++)
         {
-            continue;
-        }
+            if (!chunk->m_Occupied[i])
+            {
+                continue;
+            }
 
-        nlohmann::json tileInstanceData;
+            const auto& tileInstance = chunk->m_Tiles[i];
 
-        tileInstanceData["i"] = tileInstance.m_Index;
-        tileInstanceData["x"] = tileInstance.m_Position.x;
-        tileInstanceData["y"] = tileInstance.m_Position.y;
+            auto tileData = m_Tileset->GetTileByIndex(tileInstance.m_Index);
 
-        if (tileInstance.m_Flags != tileData->m_DefaultFlags)
-        {
-            tileInstanceData["f"] = tileInstance.m_Flags;
-        }
+            if (tileData == nullptr)
+            {
+                continue;
+            }
+
+            nlohmann::json tileInstanceData;
+
+            tileInstanceData["i"] = tileInstance.m_Index;
+            tileInstanceData["x"] = tileInstance.m_Position.x;
+            tileInstanceData["y"] = tileInstance.m_Position.y;
 
-        j["tiles"].push_back(tileInstanceData);
+            if (tileInstance.m_Flags != tileData->m_DefaultFlags)
+            {
+                tileInstanceData["f"] = tileInstance.m_Flags;
+            }
+
+            j["tiles"].push_back(tileInstanceData);
+        }
     }
 
     Serialization::SaveToFile(m_FilePath, j);
@@ -1,16 +1,25 @@
 #pragma once
 
+#include <array>
+#include <bitset>
+#include <functional>
+#include <unordered_map>
+
 #include "Pine/Assets/IAsset/IAsset.hpp"
 #include "Pine/Assets/Tileset/Tileset.hpp"
 
 namespace Pine
 {
 
+    // The number of tiles along each side of a tilemap chunk.
+    constexpr int TileChunkSize = 32;
+    constexpr int TileChunkArea = TileChunkSize * TileChunkSize;
+
     struct TileInstance // (Not to be confused with TileData)
     {
         // The index that the tile is being identified as within a tilemap
         std::uint32_t m_Index = 0;
-        
+
         // The index the renderer will use when rendering the tile from the texture atlas.
         std::uint32_t m_RenderIndex = 0;
 
@@ -20,26 +29,60 @@ namespace Pine
 
         // XY position for this tile in a grid, tile size within the grid can be obtained from the tileset itself.
         Vector2i m_Position = Vector2i(0);
-    }; 
+    };
+
+    struct TileChunk
+    {
+        // Unique for every chunk ever created, so data derived from a chunk can be cached by id.
+        std::uint64_t m_Id = 0;
+
+        // Incremented every time a tile within the chunk changes.
+        std::uint32_t m_Version = 0;
+
+        // The position of the chunk in chunks, the first tile of the chunk is at m_Position * TileChunkSize.
+        Vector2i m_Position = Vector2i(0);
+
+        std::uint32_t m_TileCount = 0;
+
+        // Tiles are stored row by row, a tile only exists if its bit in m_Occupied is set.
+        std::bitset<TileChunkArea> m_Occupied;
+        std::array<TileInstance, TileChunkArea> m_Tiles;
+    };
 
     class Tilemap : public IAsset
     {
     private:
         AssetHandle<Tileset> m_Tileset;
 
-        std::vector<TileInstance> m_Tiles;
+        std::unordered_map<std::uint64_t, TileChunk> m_Chunks;
+
+        std::uint32_t m_TileCount = 0;
     public:
         Tilemap();
 
         void SetTileset(Tileset* tileset);
         Tileset* GetTileset() const;
 
+        // Creates a tile at the grid position, replacing the tile that's already there.
         void CreateTile(std::uint32_t index, Vector2i gridPosition, std::uint32_t flags = 0);
+
         void RemoveTile(const TileInstance& instance);
+        void RemoveTile(Vector2i gridPosition);
+
+        void ClearTiles();
 
         TileInstance const* GetTileByPosition(Vector2i gridPosition) const;
 
-        const std::vector<TileInstance>& GetTiles() const;
+        std::uint32_t GetTileCount() const;
+
+        // Calls fn for every tile, chunk by chunk in no particular order.
+        void ForEachTile(const std::function<void(const TileInstance&)>& fn) const;
+
+        TileChunk const* GetChunk(Vector2i chunkPosition) const;
+        const std::unordered_map<std::uint64_t, TileChunk>& GetChunks() const;
+
+        // The position of the chunk containing the tile at the grid position.
+        static Vector2i GetChunkPosition(Vector2i gridPosition);
 
         bool LoadFromFile(AssetLoadStage stage = AssetLoadStage::Default) override;
         bool SaveToFile() override;
@@ -47,4 +90,4 @@ namespace Pine
         void Dispose() override;
     };
 
-}
\ No newline at end of file
+}
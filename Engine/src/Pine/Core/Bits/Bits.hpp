@@ -0,0 +1,47 @@
+#pragma once
+#include <cstdint>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+// Small wrappers around the compiler's bit scanning intrinsics, all functions
+// expect a non-zero value unless stated otherwise.
+namespace Pine::Bits
+{
+
+    // Returns the index of the lowest set bit
+    inline int CountTrailingZeros(std::uint64_t value)
+    {
+#ifdef _MSC_VER
+        unsigned long index;
+        _BitScanForward64(&index, value);
+        return static_cast<int>(index);
+#else
+        return __builtin_ctzll(value);
+#endif
+    }
+
+    // Returns the number of zero bits above the highest set bit
+    inline int CountLeadingZeros(std::uint64_t value)
+    {
+#ifdef _MSC_VER
+        unsigned long index;
+        _BitScanReverse64(&index, value);
+        return 63 - static_cast<int>(index);
+#else
+        return __builtin_clzll(value);
+#endif
+    }
+
+    // Returns the number of set bits, zero is a valid input
+    inline int PopCount(std::uint64_t value)
+    {
+#ifdef _MSC_VER
+        return static_cast<int>(__popcnt64(value));
+#else
+        return __builtin_popcountll(value);
+#endif
+    }
+
+}
@@ -0,0 +1,314 @@
+#include "DynamicAABBTree.hpp"
+
+#include <cassert>
+
+// Based on the dynamic tree in Box2D, extended to three dimensions.
+
+Pine::DynamicAABBTree::DynamicAABBTree(float margin)
+    : m_Margin(margin)
+{
+}
+
+std::int32_t Pine::DynamicAABBTree::AllocateNode()
+{
+    if (m_FreeList == NullNode)
+    {
+        m_Nodes.emplace_back();
+
+        return static_cast<std::int32_t>(m_Nodes.size() - 1);
+    }
+
+    const auto node = m_FreeList;
+
+    m_FreeList = m_Nodes[node].Parent;
+    m_Nodes[node] = Node();
+
+    return node;
+}
+
+void Pine::DynamicAABBTree::FreeNode(std::int32_t node)
+{
+    m_Nodes[node].Parent = m_FreeList;
+    m_Nodes[node].Height = -1;
+    m_Nodes[node].UserData = nullptr;
+
+    m_FreeList = node;
+}
+
+void Pine::DynamicAABBTree::InsertLeaf(std::int32_t leaf)
+{
+    if (m_Root == NullNode)
+    {
+        m_Root = leaf;
+        m_Nodes[leaf].Parent = NullNode;
+
+        return;
+    }
+
+    // Find the best sibling for the leaf, by walking down the cheapest path according to the
+    // surface area heuristic.
+    const auto leafBounds = m_Nodes[leaf].Bounds;
+
+    std::int32_t index = m_Root;
+
+    while (!m_Nodes[index].IsLeaf())
+    {
+        const auto& node = m_Nodes[index];
+
+        const float area = node.Bounds.GetSurfaceArea();
+        const float combinedArea = AABB::Combine(node.Bounds, leafBounds).GetSurfaceArea();
+
+        // Cost of creating a new parent for this node and the new leaf
+        const float cost = 2.f * combinedArea;
+
+        // Minimum cost of pushing the leaf further down the tree
+        const float inheritanceCost = 2.f * (combinedArea - area);
+
+        const auto childCost = [&](std::int32_t child)
+        {
+            const auto combined = AABB::Combine(leafBounds, m_Nodes[child].Bounds).GetSurfaceArea();
+
+            if (m_Nodes[child].IsLeaf())
+            {
+                return combined + inheritanceCost;
+            }
+
+            return combined - m_Nodes[child].Bounds.GetSurfaceArea() + inheritanceCost;
+        };
+
+        const float leftCost = childCost(node.Left);
+        const float rightCost = childCost(node.Right);
+
+        if (cost < leftCost && cost < rightCost)
+        {
+            break;
+        }
+
+        index = leftCost < rightCost ? node.Left : node.Right;
+    }
+
+    const auto sibling = index;
+
+    // Create a new parent for the sibling and the leaf
+    const auto oldParent = m_Nodes[sibling].Parent;
+    const auto newParent = AllocateNode();
+
+    m_Nodes[newParent].Parent = oldParent;
+    m_Nodes[newParent].Bounds = AABB::Combine(leafBounds, m_Nodes[sibling].Bounds);
+    m_Nodes[newParent].Height = m_Nodes[sibling].Height + 1;
+    m_Nodes[newParent].Left = sibling;
+    m_Nodes[newParent].Right = leaf;
+
+    if (oldParent != NullNode)
+    {
+        if (m_Nodes[oldParent].Left == sibling)
+            m_Nodes[oldParent].Left = newParent;
+        else
+            m_Nodes[oldParent].Right = newParent;
+    }
+    else
+    {
+        m_Root = newParent;
+    }
+
+    m_Nodes[sibling].Parent = newParent;
+    m_Nodes[leaf].Parent = newParent;
+
+    Refit(newParent);
+}
+
+void Pine::DynamicAABBTree::RemoveLeaf(std::int32_t leaf)
+{
+    if (leaf == m_Root)
+    {
+        m_Root = NullNode;
+        return;
+    }
+
+    const auto parent = m_Nodes[leaf].Parent;
+    const auto grandParent = m_Nodes[parent].Parent;
+    const auto sibling = m_Nodes[parent].Left == leaf ? m_Nodes[parent].Right : m_Nodes[parent].Left;
+
+    // The parent goes away, and the sibling takes its place.
+    FreeNode(parent);
+
+    if (grandParent == NullNode)
+    {
+        m_Root = sibling;
+        m_Nodes[sibling].Parent = NullNode;
+
+        return;
+    }
+
+    if (m_Nodes[grandParent].Left == parent)
+        m_Nodes[grandParent].Left = sibling;
+    else
+        m_Nodes[grandParent].Right = sibling;
+
+    m_Nodes[sibling].Parent = grandParent;
+
+    Refit(grandParent);
+}
+
+std::int32_t Pine::DynamicAABBTree::Balance(std::int32_t a)
+{
+    if (m_Nodes[a].IsLeaf() || m_Nodes[a].Height < 2)
+    {
+        return a;
+    }
+
+    const auto b = m_Nodes[a].Left;
+    const auto c = m_Nodes[a].Right;
+
+    const auto balance = m_Nodes[c].Height - m_Nodes[b].Height;
+
+    if (balance >= -1 && balance <= 1)
+    {
+        return a;
+    }
+
+    // Rotate the taller child up, a becomes a child of it.
+    const auto rotate = [&](std::int32_t child, std::int32_t other, bool childIsRight)
+    {
+        const auto f = m_Nodes[child].Left;
+        const auto g = m_Nodes[child].Right;
+
+        m_Nodes[child].Left = a;
+        m_Nodes[child].Parent = m_Nodes[a].Parent;
+        m_Nodes[a].Parent = child;
+
+        if (m_Nodes[child].Parent != NullNode)
+        {
+            auto& parent = m_Nodes[m_Nodes[child].Parent];
+
+            if (parent.Left == a)
+                parent.Left = child;
+            else
+                parent.Right = child;
+        }
+        else
+        {
+            m_Root = child;
+        }
+
+        // Keep the taller grandchild in the rotated node, and give a the shorter one.
+        const bool keepF = m_Nodes[f].Height > m_Nodes[g].Height;
+        const auto kept = keepF ? f : g;
+        const auto moved = keepF ? g : f;
+
+        m_Nodes[child].Right = kept;
+
+        if (childIsRight)
+            m_Nodes[a].Right = moved;
+        else
+            m_Nodes[a].Left = moved;
+
+        m_Nodes[moved].Parent = a;
+
+        m_Nodes[a].Bounds = AABB::Combine(m_Nodes[other].Bounds, m_Nodes[moved].Bounds);
+        m_Nodes[child].Bounds = AABB::Combine(m_Nodes[a].Bounds, m_Nodes[kept].Bounds);
+
+        m_Nodes[a].Height = 1 + std::max(m_Nodes[other].Height, m_Nodes[moved].Height);
+        m_Nodes[child].Height = 1 + std::max(m_Nodes[a].Height, m_Nodes[kept].Height);
+
+        return child;
+    };
+
+    if (balance > 1)
+    {
+        return rotate(c, b, true);
+    }
+
+    return rotate(b, c, false);
+}
+
+void Pine::DynamicAABBTree::Refit(std::int32_t node)
+{
+    while (node != NullNode)
+    {
+        node = Balance(node);
+
+        const auto left = m_Nodes[node].Left;
+        const auto right = m_Nodes[node].Right;
+
+        m_Nodes[node].Height = 1 + std::max(m_Nodes[left].Height, m_Nodes[right].Height);
+        m_Nodes[node].Bounds = AABB::Combine(m_Nodes[left].Bounds, m_Nodes[right].Bounds);
+
+        node = m_Nodes[node].Parent;
+    }
+}
+
+std::int32_t Pine::DynamicAABBTree::CreateProxy(const AABB& bounds, void* userData)
+{
+    const auto proxy = AllocateNode();
+
+    m_Nodes[proxy].Bounds = { bounds.Min - Vector3f(m_Margin), bounds.Max + Vector3f(m_Margin) };
+    m_Nodes[proxy].UserData = userData;
+    m_Nodes[proxy].Height = 0;
+
+    InsertLeaf(proxy);
+
+    m_ProxyCount++;
+
+    return proxy;
+}
+
+void Pine::DynamicAABBTree::DestroyProxy(std::int32_t proxy)
+{
+    assert(m_Nodes[proxy].IsLeaf() && m_Nodes[proxy].Height == 0);
+
+    RemoveLeaf(proxy);
+    FreeNode(proxy);
+
+    m_ProxyCount--;
+}
+
+bool Pine::DynamicAABBTree::MoveProxy(std::int32_t proxy, const AABB& bounds)
+{
+    if (m_Nodes[proxy].Bounds.Contains(bounds))
+    {
+        return false;
+    }
+
+    RemoveLeaf(proxy);
+
+    m_Nodes[proxy].Bounds = { bounds.Min - Vector3f(m_Margin), bounds.Max + Vector3f(m_Margin) };
+
+    InsertLeaf(proxy);
+
+    return true;
+}
+
+void* Pine::DynamicAABBTree::GetUserData(std::int32_t proxy) const
+{
+    return m_Nodes[proxy].UserData;
+}
+
+const Pine::AABB& Pine::DynamicAABBTree::GetFatBounds(std::int32_t proxy) const
+{
+    return m_Nodes[proxy].Bounds;
+}
+
+std::uint32_t Pine::DynamicAABBTree::GetProxyCount() const
+{
+    return m_ProxyCount;
+}
+
+std::int32_t Pine::DynamicAABBTree::GetHeight() const
+{
+    if (m_Root == NullNode)
+    {
+        return 0;
+    }
+
+    return m_Nodes[m_Root].Height;
+}
+
+void Pine::DynamicAABBTree::Clear()
+{
+    m_Nodes.clear();
+
+    m_Root = NullNode;
+    m_FreeList = NullNode;
+    m_ProxyCount = 0;
+}
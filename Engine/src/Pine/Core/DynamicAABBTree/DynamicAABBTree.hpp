@@ -0,0 +1,221 @@
+#pragma once
+
+#include "Pine/Core/Math/Math.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace Pine
+{
+
+    struct AABB
+    {
+        Vector3f Min = Vector3f(0.f);
+        Vector3f Max = Vector3f(0.f);
+
+        __inline bool Contains(const AABB& other) const
+        {
+            return Min.x <= other.Min.x && Min.y <= other.Min.y && Min.z <= other.Min.z &&
+                   Max.x >= other.Max.x && Max.y >= other.Max.y && Max.z >= other.Max.z;
+        }
+
+        __inline bool Overlaps(const AABB& other) const
+        {
+            return Min.x <= other.Max.x && Min.y <= other.Max.y && Min.z <= other.Max.z &&
+                   Max.x >= other.Min.x && Max.y >= other.Min.y && Max.z >= other.Min.z;
+        }
+
+        __inline float GetSurfaceArea() const
+        {
+            const auto size = Max - Min;
+
+            return 2.f * (size.x * size.y + size.y * size.z + size.z * size.x);
+        }
+
+        __inline static AABB Combine(const AABB& a, const AABB& b)
+        {
+            return { glm::min(a.Min, b.Min), glm::max(a.Max, b.Max) };
+        }
+    };
+
+    // Bounding volume hierarchy of axis aligned boxes that can be updated incrementally. The boxes are fattened
+    // by a margin when inserted, so a proxy only has to be re-inserted once it moves outside its fattened box.
+    // Queries test against the fattened boxes, so callers that need exact results will have to test again.
+    class DynamicAABBTree
+    {
+    public:
+        static constexpr std::int32_t NullNode = -1;
+    private:
+        struct Node
+        {
+            AABB Bounds;
+
+            void* UserData = nullptr;
+
+            // The parent while in the tree, or the next free node while on the free list.
+            std::int32_t Parent = NullNode;
+
+            std::int32_t Left = NullNode;
+            std::int32_t Right = NullNode;
+
+            // Leaves have a height of zero, free nodes have a height of -1.
+            std::int32_t Height = -1;
+
+            __inline bool IsLeaf() const
+            {
+                return Left == NullNode;
+            }
+        };
+
+        std::vector<Node> m_Nodes;
+
+        std::int32_t m_Root = NullNode;
+        std::int32_t m_FreeList = NullNode;
+
+        std::uint32_t m_ProxyCount = 0;
+
+        float m_Margin = 0.f;
+
+        std::int32_t AllocateNode();
+        void FreeNode(std::int32_t node);
+
+        void InsertLeaf(std::int32_t leaf);
+        void RemoveLeaf(std::int32_t leaf);
+
+        // Rotates the subtree if it's unbalanced, returns the new root of the subtree.
+        std::int32_t Balance(std::int32_t node);
+
+        // Walks up from the node, recalculating the bounds and heights and balancing the tree as it goes.
+        void Refit(std::int32_t node);
+
+        // Calls callback(proxy, userData) for every leaf whose bounds pass test(bounds), skipping
+        // entire subtrees that fail the test.
+        template<typename Test, typename F>
+        void Traverse(const Test& test, const F& callback) const
+        {
+            if (m_Root == NullNode)
+            {
+                return;
+            }
+
+            std::vector<std::int32_t> stack;
+
+            stack.reserve(64);
+            stack.push_back(m_Root);
+
+            while (!stack.empty())
+            {
+                const auto nodeIndex = stack.back();
+                stack.pop_back();
+
+                const auto& node = m_Nodes[nodeIndex];
+
+                if (!test(node.Bounds))
+                {
+                    continue;
+                }
+
+                if (node.IsLeaf())
+                {
+                    callback(nodeIndex, node.UserData);
+                }
+                else
+                {
+                    stack.push_back(node.Left);
+                    stack.push_back(node.Right);
+                }
+            }
+        }
+    public:
+        explicit DynamicAABBTree(float margin = 0.1f);
+
+        // Returns the proxy id, which stays the same until the proxy is destroyed.
+        std::int32_t CreateProxy(const AABB& bounds, void* userData);
+        void DestroyProxy(std::int32_t proxy);
+
+        // Updates the bounds of the proxy, returns true if it had to be re-inserted into the tree.
+        bool MoveProxy(std::int32_t proxy, const AABB& bounds);
+
+        void* GetUserData(std::int32_t proxy) const;
+        const AABB& GetFatBounds(std::int32_t proxy) const;
+
+        std::uint32_t GetProxyCount() const;
+        std::int32_t GetHeight() const;
+
+        void Clear();
+
+        template<typename F>
+        void Query(const AABB& bounds, const F& callback) const
+        {
+            Traverse([&](const AABB& nodeBounds) { return nodeBounds.Overlaps(bounds); }, callback);
+        }
+
+        template<typename F>
+        void QuerySphere(const Vector3f& center, float radius, const F& callback) const
+        {
+            Traverse([&](const AABB& nodeBounds)
+            {
+                const auto closestPoint = glm::clamp(center, nodeBounds.Min, nodeBounds.Max);
+
+                return glm::distance2(closestPoint, center) <= radius * radius;
+            }, callback);
+        }
+
+        // The planes should have their normals pointing inwards, see Camera::GetFrustumPlanes().
+        template<typename F>
+        void QueryFrustum(const std::array<Vector4f, 6>& planes, const F& callback) const
+        {
+            Traverse([&](const AABB& nodeBounds)
+            {
+                const auto center = (nodeBounds.Min + nodeBounds.Max) * 0.5f;
+                const auto extent = (nodeBounds.Max - nodeBounds.Min) * 0.5f;
+
+                for (const auto& plane : planes)
+                {
+                    const auto normal = Vector3f(plane);
+
+                    if (glm::dot(normal, center) + plane.w + glm::dot(glm::abs(normal), extent) < 0.f)
+                    {
+                        return false;
+                    }
+                }
+
+                return true;
+            }, callback);
+        }
+
+        // Calls callback(proxy, userData, distance) for every proxy the ray hits within maxDistance, the
+        // callback returns the new max distance, which allows it to only look for the closest hit.
+        template<typename F>
+        void RayCast(const Vector3f& origin, const Vector3f& direction, float maxDistance, const F& callback) const
+        {
+            const auto inverseDirection = 1.f / direction;
+
+            float distance = 0.f;
+
+            const auto intersect = [&](const AABB& nodeBounds)
+            {
+                const auto t0 = (nodeBounds.Min - origin) * inverseDirection;
+                const auto t1 = (nodeBounds.Max - origin) * inverseDirection;
+
+                const auto entries = glm::min(t0, t1);
+                const auto exits = glm::max(t0, t1);
+
+                const float entry = std::max(std::max(entries.x, entries.y), std::max(entries.z, 0.f));
+                const float exit = std::min(std::min(exits.x, exits.y), std::min(exits.z, maxDistance));
+
+                distance = entry;
+
+                return entry <= exit;
+            };
+
+            Traverse(intersect, [&](std::int32_t proxy, void* userData)
+            {
+                maxDistance = callback(proxy, userData, distance);
+            });
+        }
+    };
+
+}
@@ -1,8 +1,18 @@
 #include "Log.hpp"
 
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <fstream>
 #include <iostream>
+#include <memory>
 #include <mutex>
-#include <fmt/format.h>
+#include <thread>
+#include <vector>
+
+#include "Pine/Performance/Performance.hpp"
 
 #ifdef _WIN32
 #include <Windows.h>
@@ -10,8 +20,6 @@
 
 namespace
 {
-    std::mutex m_LogMutex;
-
 #ifdef _WIN32
     enum class ConsoleColor
     {
@@ -47,75 +55,548 @@ namespace
             return;
         }
 
-        std::cout << "\033[;" << std::to_string(static_cast<int>(colorCode)) << "m";
+        std::cout << "\033[;" << static_cast<int>(colorCode) << "m";
     }
 #endif
 
-    void PrintMessage(const char* prefix, ConsoleColor color, const char* str, ConsoleColor msgColor = ConsoleColor::None)
+    // The number of messages each thread can queue before it has to wait for the log thread.
+    constexpr std::uint64_t QueueSize = 256;
+
+    // Messages up to this length are stored in the queue itself, longer ones are moved to the heap.
+    constexpr std::size_t InlineMessageSize = 232;
+
+    // The number of messages kept for the editor console.
+    constexpr std::size_t HistorySize = 512;
+
+    struct QueuedMessage
+    {
+        std::uint64_t Timestamp;
+
+        Pine::LogSeverity Severity;
+
+        std::uint32_t Length;
+        std::unique_ptr<std::string> Overflow;
+
+        char Text[InlineMessageSize];
+    };
+
+    // Every thread pushes its messages into its own queue, which only the log thread reads from, so the
+    // indices are all the synchronization needed.
+    struct MessageQueue
+    {
+        std::unique_ptr<QueuedMessage[]> Messages = std::make_unique<QueuedMessage[]>(QueueSize);
+
+        std::atomic<std::uint64_t> WriteIndex = 0;
+        std::atomic<std::uint64_t> ReadIndex = 0;
+    };
+
+    struct PendingMessage
+    {
+        std::uint64_t Timestamp;
+        Pine::LogSeverity Severity;
+        std::string Text;
+    };
+
+    std::mutex m_QueuesMutex;
+    std::vector<std::unique_ptr<MessageQueue>> m_Queues;
+
+    thread_local MessageQueue* m_CurrentQueue = nullptr;
+
+    std::atomic<bool> m_Running = false;
+    std::thread m_LogThread;
+
+    // The number of threads within Log::Internal::Write() that may still be queueing a message, see Shutdown().
+    std::atomic<std::uint32_t> m_ActiveWriters = 0;
+
+    // Used to wake up the log thread, and to let Flush() know when it's done.
+    std::mutex m_SignalMutex;
+    std::condition_variable m_Signal;
+    std::condition_variable m_Flushed;
+    std::uint64_t m_FlushRequested = 0;
+    std::uint64_t m_FlushCompleted = 0;
+
+    // Only one thread writes to the sinks at a time, either the log thread, or the logging thread itself
+    // while the log thread isn't running.
+    std::mutex m_WriteMutex;
+
+    std::mutex m_HistoryMutex;
+    std::array<Pine::LogMessage, HistorySize> m_History;
+    std::size_t m_HistoryStart = 0;
+    std::size_t m_HistoryCount = 0;
+
+    std::mutex m_FileMutex;
+    std::ofstream m_File;
+    std::filesystem::path m_FilePath;
+    std::uintmax_t m_FileSize = 0;
+    std::uintmax_t m_MaxFileSize = 0;
+    int m_MaxFileCount = 0;
+
+    // Stops the log thread if the application exits without shutting down the engine.
+    struct LogThreadGuard
     {
+        ~LogThreadGuard()
+        {
+            Pine::Log::Shutdown();
+        }
+    } m_LogThreadGuard;
+
+    std::uint64_t GetTimestamp()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    const char* GetSeverityName(Pine::LogSeverity severity)
+    {
+        switch (severity)
+        {
+            case Pine::LogSeverity::Verbose:
+                return "verbose";
+            case Pine::LogSeverity::Info:
+                return "info";
+            case Pine::LogSeverity::Warning:
+                return "warning";
+            case Pine::LogSeverity::Error:
+                return "error";
+            default:
+                return "fatal";
+        }
+    }
+
+    void PrintMessage(Pine::LogSeverity severity, const std::string& str)
+    {
+        auto color = ConsoleColor::White;
+        auto msgColor = ConsoleColor::None;
+
+        switch (severity)
+        {
+            case Pine::LogSeverity::Verbose:
+                color = msgColor = ConsoleColor::DarkGray;
+                break;
+            case Pine::LogSeverity::Warning:
+                color = ConsoleColor::Yellow;
+                break;
+            case Pine::LogSeverity::Error:
+                color = ConsoleColor::Red;
+                break;
+            case Pine::LogSeverity::Fatal:
+                color = msgColor = ConsoleColor::Red;
+                break;
+            default:
+                break;
+        }
+
         SetConsoleColor(color);
 
-        std::cout << prefix << ": ";
+        std::cout << GetSeverityName(severity) << ": ";
 
         SetConsoleColor(msgColor);
 
-        std::cout << str << std::endl;
+        std::cout << str << '\n';
+    }
+
+    void AddLogMessage(Pine::LogSeverity severity, const std::string& str)
+    {
+        std::unique_lock lock(m_HistoryMutex);
+
+        // Once the history is full, the oldest message is overwritten, which reuses its string.
+        auto& message = m_History[(m_HistoryStart + m_HistoryCount) % HistorySize];
+
+        message.Message.assign(str);
+        message.Type = severity;
+
+        if (m_HistoryCount < HistorySize)
+        {
+            m_HistoryCount++;
+        }
+        else
+        {
+            m_HistoryStart = (m_HistoryStart + 1) % HistorySize;
+        }
+    }
+
+    void RotateFile()
+    {
+        m_File.close();
+
+        std::error_code error;
+
+        for (int i = m_MaxFileCount - 1; i >= 1; i--)
+        {
+            auto source = m_FilePath;
+            auto destination = m_FilePath;
+
+            source += "." + std::to_string(i);
+            destination += "." + std::to_string(i + 1);
+
+            std::filesystem::rename(source, destination, error);
+        }
+
+        auto firstBackup = m_FilePath;
+
+        firstBackup += ".1";
+
+        std::filesystem::rename(m_FilePath, firstBackup, error);
+
+        m_File.open(m_FilePath, std::ios::out | std::ios::trunc);
+        m_FileSize = 0;
+    }
+
+    void WriteFile(Pine::LogSeverity severity, const std::string& str)
+    {
+        std::unique_lock lock(m_FileMutex);
+
+        if (!m_File.is_open())
+        {
+            return;
+        }
+
+        const auto severityName = GetSeverityName(severity);
+        const auto length = std::strlen(severityName) + 2 + str.size() + 1;
+
+        if (m_MaxFileSize > 0 && m_FileSize > 0 && m_FileSize + length > m_MaxFileSize)
+        {
+            RotateFile();
+        }
+
+        m_File << severityName << ": " << str << '\n';
+        m_FileSize += length;
+    }
+
+    void WriteMessages(std::vector<PendingMessage>& messages)
+    {
+        std::unique_lock lock(m_WriteMutex);
+
+        for (const auto& message : messages)
+        {
+            PrintMessage(message.Severity, message.Text);
+            AddLogMessage(message.Severity, message.Text);
+            WriteFile(message.Severity, message.Text);
+        }
+
+        std::cout.flush();
+
+        std::unique_lock fileLock(m_FileMutex);
+
+        if (m_File.is_open())
+        {
+            m_File.flush();
+        }
+    }
+
+    MessageQueue* GetMessageQueue()
+    {
+        if (m_CurrentQueue == nullptr)
+        {
+            std::unique_lock lock(m_QueuesMutex);
+
+            m_CurrentQueue = m_Queues.emplace_back(std::make_unique<MessageQueue>()).get();
+        }
+
+        return m_CurrentQueue;
+    }
+
+    // Empties the queues of every thread, and writes their messages in the order they were logged.
+    void DrainQueues()
+    {
+        PINE_PF_ALLOCATION_SCOPE("Log");
+
+        static std::vector<PendingMessage> messages;
+
+        {
+            std::unique_lock lock(m_QueuesMutex);
+
+            for (const auto& queue : m_Queues)
+            {
+                const auto readIndex = queue->ReadIndex.load(std::memory_order_relaxed);
+                const auto writeIndex = queue->WriteIndex.load(std::memory_order_acquire);
+
+                for (auto index = readIndex; index < writeIndex; index++)
+                {
+                    auto& queuedMessage = queue->Messages[index % QueueSize];
+
+                    auto& message = messages.emplace_back();
+
+                    message.Timestamp = queuedMessage.Timestamp;
+                    message.Severity = queuedMessage.Severity;
+
+                    if (queuedMessage.Overflow)
+                    {
+                        message.Text = std::move(*queuedMessage.Overflow);
+                        queuedMessage.Overflow.reset();
+                    }
+                    else
+                    {
+                        message.Text.assign(queuedMessage.Text, queuedMessage.Length);
+                    }
+                }
+
+                queue->ReadIndex.store(writeIndex, std::memory_order_release);
+            }
+        }
+
+        if (messages.empty())
+        {
+            return;
+        }
+
+        std::stable_sort(messages.begin(), messages.end(), [](const PendingMessage& a, const PendingMessage& b)
+        {
+            return a.Timestamp < b.Timestamp;
+        });
+
+        WriteMessages(messages);
+
+        messages.clear();
+    }
+
+    void LogThread()
+    {
+        while (true)
+        {
+            std::unique_lock lock(m_SignalMutex);
+
+            m_Signal.wait_for(lock, std::chrono::milliseconds(10), []
+            {
+                return !m_Running || m_FlushRequested != m_FlushCompleted;
+            });
+
+            const auto flushRequested = m_FlushRequested;
+            const bool running = m_Running;
+
+            lock.unlock();
+
+            DrainQueues();
+
+            lock.lock();
+
+            m_FlushCompleted = flushRequested;
+            m_Flushed.notify_all();
+
+            if (!running)
+            {
+                break;
+            }
+        }
+    }
+
+    void WriteImmediately(Pine::LogSeverity severity, std::string_view str)
+    {
+        PINE_PF_ALLOCATION_SCOPE("Log");
+
+        std::vector<PendingMessage> messages;
+
+        messages.push_back({ GetTimestamp(), severity, std::string(str) });
+
+        WriteMessages(messages);
     }
+}
 
-    std::vector<Pine::LogMessage> m_LogMessages;
+void Pine::Log::Internal::Write(LogSeverity severity, std::string_view message)
+{
+    // Counted before checking if the log thread is running, so Shutdown() can wait for a message that's
+    // being queued while the log thread stops, rather than draining the queues before it's there.
+    m_ActiveWriters.fetch_add(1);
 
-    void AddLogMessage(const Pine::LogMessage& message)
+    if (!m_Running)
     {
-        m_LogMessages.push_back(message);
+        m_ActiveWriters.fetch_sub(1);
+
+        WriteImmediately(severity, message);
+        return;
+    }
 
-        if (m_LogMessages.size() > 256)
+    const auto queue = GetMessageQueue();
+    const auto writeIndex = queue->WriteIndex.load(std::memory_order_relaxed);
+
+    // The queue is full, wait for the log thread to catch up rather than losing the message.
+    while (writeIndex - queue->ReadIndex.load(std::memory_order_acquire) >= QueueSize)
+    {
+        // Once the log thread has stopped nothing empties the queue anymore, what's already in it is
+        // written by Shutdown().
+        if (!m_Running)
         {
-            m_LogMessages.erase(m_LogMessages.begin());
+            m_ActiveWriters.fetch_sub(1);
+
+            WriteImmediately(severity, message);
+            return;
         }
+
+        m_Signal.notify_one();
+        std::this_thread::yield();
+    }
+
+    auto& queuedMessage = queue->Messages[writeIndex % QueueSize];
+
+    queuedMessage.Timestamp = GetTimestamp();
+    queuedMessage.Severity = severity;
+
+    if (message.size() <= InlineMessageSize)
+    {
+        std::memcpy(queuedMessage.Text, message.data(), message.size());
+        queuedMessage.Length = static_cast<std::uint32_t>(message.size());
+    }
+    else
+    {
+        queuedMessage.Overflow = std::make_unique<std::string>(message);
+        queuedMessage.Length = 0;
+    }
+
+    queue->WriteIndex.store(writeIndex + 1, std::memory_order_release);
+
+    m_ActiveWriters.fetch_sub(1);
+
+    // Make sure fatal errors make it out before the application goes down.
+    if (severity == LogSeverity::Fatal)
+    {
+        Flush();
     }
 }
 
-void Pine::Log::Verbose(const std::string &str)
+void Pine::Log::Internal::WriteFormatted(LogSeverity severity, fmt::string_view format, fmt::format_args args)
 {
-    std::unique_lock lck(m_LogMutex);
+    // Short messages are formatted on the stack, so logging doesn't have to allocate.
+    fmt::memory_buffer buffer;
 
-    PrintMessage("verbose", ConsoleColor::DarkGray, str.c_str(), ConsoleColor::DarkGray);
-    AddLogMessage({str, Pine::LogSeverity::Verbose});
+    fmt::vformat_to(fmt::appender(buffer), format, args);
+
+    Write(severity, std::string_view(buffer.data(), buffer.size()));
 }
 
-void Pine::Log::Info(const std::string &str)
+void Pine::Log::Setup()
 {
-    std::unique_lock lck(m_LogMutex);
+    if (m_Running)
+    {
+        return;
+    }
 
-    PrintMessage("info", ConsoleColor::White, str.c_str());
-    AddLogMessage({str, Pine::LogSeverity::Info});
+    m_Running = true;
+    m_LogThread = std::thread(LogThread);
 }
 
-void Pine::Log::Warning(const std::string &str)
+void Pine::Log::Shutdown()
+{
+    if (!m_Running)
+    {
+        return;
+    }
+
+    {
+        std::unique_lock lock(m_SignalMutex);
+
+        m_Running = false;
+        m_Signal.notify_all();
+    }
+
+    m_LogThread.join();
+
+    // Any thread that saw the log thread running may still be putting its message in a queue, anything
+    // logged from here on is written immediately instead.
+    while (m_ActiveWriters.load() != 0)
+    {
+        std::this_thread::yield();
+    }
+
+    // Pick up anything that was queued while the log thread was stopping.
+    DrainQueues();
+}
+
+void Pine::Log::Flush()
 {
-    std::unique_lock lck(m_LogMutex);
+    if (!m_Running)
+    {
+        return;
+    }
+
+    std::unique_lock lock(m_SignalMutex);
+
+    const auto flushRequest = ++m_FlushRequested;
 
-    PrintMessage("warning", ConsoleColor::Yellow, str.c_str());
-    AddLogMessage({str, Pine::LogSeverity::Warning});
+    m_Signal.notify_all();
+
+    m_Flushed.wait(lock, [flushRequest]
+    {
+        return m_FlushCompleted >= flushRequest || !m_Running;
+    });
 }
 
-void Pine::Log::Error(const std::string &str)
+void Pine::Log::SetMinimumSeverity(LogSeverity severity)
 {
-    std::unique_lock lck(m_LogMutex);
+    Internal::MinimumSeverity.store(severity, std::memory_order_relaxed);
+}
 
-    PrintMessage("error", ConsoleColor::Red, str.c_str());
-    AddLogMessage({str, Pine::LogSeverity::Error});
+Pine::LogSeverity Pine::Log::GetMinimumSeverity()
+{
+    return Internal::MinimumSeverity.load(std::memory_order_relaxed);
 }
 
-void Pine::Log::Fatal(const std::string &str)
+bool Pine::Log::OpenFileSink(const std::filesystem::path& path, std::uintmax_t maxFileSize, int maxFileCount)
 {
-    std::unique_lock lck(m_LogMutex);
+    std::unique_lock lock(m_FileMutex);
+
+    m_File.close();
+    m_File.open(path, std::ios::out | std::ios::trunc);
 
-    PrintMessage("fatal", ConsoleColor::Red, str.c_str(), ConsoleColor::Red);
-    AddLogMessage({str, Pine::LogSeverity::Fatal});
+    if (!m_File.is_open())
+    {
+        lock.unlock();
+
+        Error("[Log] Failed to open log file {}.", path.string());
+
+        return false;
+    }
+
+    m_FilePath = path;
+    m_FileSize = 0;
+    m_MaxFileSize = maxFileSize;
+    m_MaxFileCount = std::max(maxFileCount, 1);
+
+    return true;
 }
 
-const std::vector<Pine::LogMessage> &Pine::Log::GetLogMessages()
+void Pine::Log::CloseFileSink()
 {
-    return m_LogMessages;
+    Flush();
+
+    std::unique_lock lock(m_FileMutex);
+
+    m_File.close();
+}
+
+void Pine::Log::Verbose(const std::string &str)
+{
+    if (IsEnabled(LogSeverity::Verbose))
+        Internal::Write(LogSeverity::Verbose, str);
+}
+
+void Pine::Log::Info(const std::string &str)
+{
+    if (IsEnabled(LogSeverity::Info))
+        Internal::Write(LogSeverity::Info, str);
+}
+
+void Pine::Log::Warning(const std::string &str)
+{
+    if (IsEnabled(LogSeverity::Warning))
+        Internal::Write(LogSeverity::Warning, str);
+}
+
+void Pine::Log::Error(const std::string &str)
+{
+    if (IsEnabled(LogSeverity::Error))
+        Internal::Write(LogSeverity::Error, str);
+}
+
+void Pine::Log::Fatal(const std::string &str)
+{
+    Internal::Write(LogSeverity::Fatal, str);
+}
+
+void Pine::Log::ForEachMessage(const std::function<void(const LogMessage&)>& fn)
+{
+    std::unique_lock lock(m_HistoryMutex);
+
+    for (std::size_t i = 0; i < m_HistoryCount; i++)
+    {
+        fn(m_History[(m_HistoryStart + i) % HistorySize]);
+    }
 }
@@ -1,6 +1,9 @@
 #pragma once
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
 #include <string>
-#include <vector>
 #include <fmt/format.h>
 
 namespace Pine
@@ -26,12 +29,80 @@ namespace Pine
 namespace Pine::Log
 {
 
+    namespace Internal
+    {
+        // Messages below this severity are dropped before they're formatted.
+        inline std::atomic<LogSeverity> MinimumSeverity = LogSeverity::Verbose;
+
+        void Write(LogSeverity severity, std::string_view message);
+        void WriteFormatted(LogSeverity severity, fmt::string_view format, fmt::format_args args);
+    }
+
+    // Starts the thread writing the messages to the console, the history and the file sink. Until then, and
+    // after Shutdown(), messages are written right away on the calling thread instead.
+    void Setup();
+    void Shutdown();
+
+    // Blocks until every message logged before the call has been written.
+    void Flush();
+
+    inline bool IsEnabled(LogSeverity severity)
+    {
+        return severity >= Internal::MinimumSeverity.load(std::memory_order_relaxed);
+    }
+
+    void SetMinimumSeverity(LogSeverity severity);
+    LogSeverity GetMinimumSeverity();
+
+    // Also writes every message to the file at `path`. Once the file grows beyond `maxFileSize` bytes it's
+    // moved to path.1, the older files are shifted along and only `maxFileCount` of them are kept.
+    bool OpenFileSink(const std::filesystem::path& path, std::uintmax_t maxFileSize = 4 * 1024 * 1024, int maxFileCount = 3);
+    void CloseFileSink();
+
     void Verbose(const std::string& str);
     void Info(const std::string& str);
     void Warning(const std::string& str);
     void Error(const std::string& str);
     void Fatal(const std::string& str);
 
-    const std::vector<LogMessage>& GetLogMessages();
+    // Formats the message with fmt, the format string is checked at compile time. Nothing is formatted if
+    // the severity is below the minimum.
+    template<typename... Args>
+    void Verbose(fmt::format_string<Args...> format, Args&&... args)
+    {
+        if (IsEnabled(LogSeverity::Verbose))
+            Internal::WriteFormatted(LogSeverity::Verbose, format, fmt::make_format_args(args...));
+    }
+
+    template<typename... Args>
+    void Info(fmt::format_string<Args...> format, Args&&... args)
+    {
+        if (IsEnabled(LogSeverity::Info))
+            Internal::WriteFormatted(LogSeverity::Info, format, fmt::make_format_args(args...));
+    }
+
+    template<typename... Args>
+    void Warning(fmt::format_string<Args...> format, Args&&... args)
+    {
+        if (IsEnabled(LogSeverity::Warning))
+            Internal::WriteFormatted(LogSeverity::Warning, format, fmt::make_format_args(args...));
+    }
+
+    template<typename... Args>
+    void Error(fmt::format_string<Args...> format, Args&&... args)
+    {
+        if (IsEnabled(LogSeverity::Error))
+            Internal::WriteFormatted(LogSeverity::Error, format, fmt::make_format_args(args...));
+    }
+
+    template<typename... Args>
+    void Fatal(fmt::format_string<Args...> format, Args&&... args)
+    {
+        Internal::WriteFormatted(LogSeverity::Fatal, format, fmt::make_format_args(args...));
+    }
 
-}
\ No newline at end of file
+    // Calls fn for every message in the history, from oldest to newest. The history is locked meanwhile,
+    // so fn may not log anything itself.
+    void ForEachMessage(const std::function<void(const LogMessage&)>& fn);
+
+}
@@ -0,0 +1,128 @@
+#include "MappedFile.hpp"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+Pine::MappedFile::~MappedFile()
+{
+    Close();
+}
+
+bool Pine::MappedFile::Open(const std::filesystem::path& path)
+{
+    Close();
+
+#ifdef _WIN32
+    const auto file = CreateFileW(path.wstring().c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    LARGE_INTEGER fileSize;
+
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    const auto mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+    if (mapping == nullptr)
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    const auto data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+
+    if (data == nullptr)
+    {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+
+    m_FileHandle = file;
+    m_MappingHandle = mapping;
+    m_Data = static_cast<const std::uint8_t*>(data);
+    m_Size = static_cast<std::size_t>(fileSize.QuadPart);
+#else
+    const int file = open(path.c_str(), O_RDONLY);
+
+    if (file < 0)
+    {
+        return false;
+    }
+
+    struct stat fileStat{};
+
+    if (fstat(file, &fileStat) != 0 || fileStat.st_size == 0)
+    {
+        close(file);
+        return false;
+    }
+
+    const auto data = mmap(nullptr, static_cast<std::size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+
+    // The mapping stays valid after the descriptor has been closed.
+    close(file);
+
+    if (data == MAP_FAILED)
+    {
+        return false;
+    }
+
+    m_Data = static_cast<const std::uint8_t*>(data);
+    m_Size = static_cast<std::size_t>(fileStat.st_size);
+#endif
+
+    return true;
+}
+
+void Pine::MappedFile::Close()
+{
+    if (m_Data == nullptr)
+    {
+        return;
+    }
+
+#ifdef _WIN32
+    UnmapViewOfFile(m_Data);
+    CloseHandle(m_MappingHandle);
+    CloseHandle(m_FileHandle);
+
+    m_FileHandle = nullptr;
+    m_MappingHandle = nullptr;
+#else
+    munmap(const_cast<std::uint8_t*>(m_Data), m_Size);
+#endif
+
+    m_Data = nullptr;
+    m_Size = 0;
+}
+
+bool Pine::MappedFile::IsOpen() const
+{
+    return m_Data != nullptr;
+}
+
+const std::uint8_t* Pine::MappedFile::GetData() const
+{
+    return m_Data;
+}
+
+std::size_t Pine::MappedFile::GetSize() const
+{
+    return m_Size;
+}
@@ -0,0 +1,37 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+
+namespace Pine
+{
+
+    // Maps an entire file into memory as read-only, the mapping is released once the object goes away.
+    class MappedFile
+    {
+    private:
+        const std::uint8_t* m_Data = nullptr;
+        std::size_t m_Size = 0;
+
+#ifdef _WIN32
+        void* m_FileHandle = nullptr;
+        void* m_MappingHandle = nullptr;
+#endif
+    public:
+        MappedFile() = default;
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        // Returns false if the file couldn't be opened or mapped, empty files are not mapped either.
+        bool Open(const std::filesystem::path& path);
+        void Close();
+
+        bool IsOpen() const;
+
+        const std::uint8_t* GetData() const;
+        std::size_t GetSize() const;
+    };
+
+}
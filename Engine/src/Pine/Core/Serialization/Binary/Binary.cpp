@@ -0,0 +1,157 @@
+#include "Binary.hpp"
+
+void Pine::Serialization::BinaryWriter::Write(const Vector2f& vector)
+{
+    Write(vector.x);
+    Write(vector.y);
+}
+
+void Pine::Serialization::BinaryWriter::Write(const Vector3f& vector)
+{
+    Write(vector.x);
+    Write(vector.y);
+    Write(vector.z);
+}
+
+void Pine::Serialization::BinaryWriter::Write(const Vector4f& vector)
+{
+    Write(vector.x);
+    Write(vector.y);
+    Write(vector.z);
+    Write(vector.w);
+}
+
+void Pine::Serialization::BinaryWriter::Write(const Quaternion& quaternion)
+{
+    Write(quaternion.x);
+    Write(quaternion.y);
+    Write(quaternion.z);
+    Write(quaternion.w);
+}
+
+void Pine::Serialization::BinaryWriter::WriteString(std::string_view string)
+{
+    Write(static_cast<std::uint32_t>(string.size()));
+
+    m_Data.insert(m_Data.end(), string.begin(), string.end());
+}
+
+std::size_t Pine::Serialization::BinaryWriter::BeginBlock()
+{
+    const auto blockOffset = m_Data.size();
+
+    // Placeholder for the size, filled in by EndBlock()
+    Write(static_cast<std::uint32_t>(0));
+
+    return blockOffset;
+}
+
+void Pine::Serialization::BinaryWriter::EndBlock(std::size_t blockOffset)
+{
+    const auto blockSize = static_cast<std::uint32_t>(m_Data.size() - blockOffset - sizeof(std::uint32_t));
+
+    for (std::size_t i = 0; i < sizeof(std::uint32_t); i++)
+    {
+        m_Data[blockOffset + i] = static_cast<std::uint8_t>(blockSize >> (i * 8));
+    }
+}
+
+const std::vector<std::uint8_t>& Pine::Serialization::BinaryWriter::GetData() const
+{
+    return m_Data;
+}
+
+Pine::Serialization::BinaryReader::BinaryReader(const void* data, std::size_t size)
+    : m_Data(static_cast<const std::uint8_t*>(data)),
+      m_Size(size)
+{
+}
+
+void Pine::Serialization::BinaryReader::Read(Vector2f& vector)
+{
+    Read(vector.x);
+    Read(vector.y);
+}
+
+void Pine::Serialization::BinaryReader::Read(Vector3f& vector)
+{
+    Read(vector.x);
+    Read(vector.y);
+    Read(vector.z);
+}
+
+void Pine::Serialization::BinaryReader::Read(Vector4f& vector)
+{
+    Read(vector.x);
+    Read(vector.y);
+    Read(vector.z);
+    Read(vector.w);
+}
+
+void Pine::Serialization::BinaryReader::Read(Quaternion& quaternion)
+{
+    Read(quaternion.x);
+    Read(quaternion.y);
+    Read(quaternion.z);
+    Read(quaternion.w);
+}
+
+std::string_view Pine::Serialization::BinaryReader::ReadString()
+{
+    const auto length = Read<std::uint32_t>();
+
+    if (m_Size - m_Position < length)
+    {
+        m_Position = m_Size;
+        m_HasFailed = true;
+        return {};
+    }
+
+    const std::string_view string(reinterpret_cast<const char*>(m_Data + m_Position), length);
+
+    m_Position += length;
+
+    return string;
+}
+
+Pine::Serialization::BinaryReader Pine::Serialization::BinaryReader::ReadBlock()
+{
+    const auto blockSize = Read<std::uint32_t>();
+
+    if (m_HasFailed || m_Size - m_Position < blockSize)
+    {
+        m_Position = m_Size;
+        m_HasFailed = true;
+
+        BinaryReader failedReader;
+        failedReader.m_HasFailed = true;
+
+        return failedReader;
+    }
+
+    BinaryReader blockReader(m_Data + m_Position, blockSize);
+
+    m_Position += blockSize;
+
+    return blockReader;
+}
+
+std::size_t Pine::Serialization::BinaryReader::GetPosition() const
+{
+    return m_Position;
+}
+
+std::size_t Pine::Serialization::BinaryReader::GetSize() const
+{
+    return m_Size;
+}
+
+bool Pine::Serialization::BinaryReader::IsAtEnd() const
+{
+    return m_Position >= m_Size;
+}
+
+bool Pine::Serialization::BinaryReader::HasFailed() const
+{
+    return m_HasFailed;
+}
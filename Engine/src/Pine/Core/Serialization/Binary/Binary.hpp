@@ -0,0 +1,186 @@
+#pragma once
+#include "Pine/Core/Math/Math.hpp"
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+// Binary counterpart to the JSON serialization, used for cooked assets. All values are
+// stored as little-endian regardless of the host, and blocks are prefixed with their size
+// so that readers may skip data they don't understand.
+namespace Pine::Serialization
+{
+
+    class BinaryWriter
+    {
+    private:
+        std::vector<std::uint8_t> m_Data;
+
+        void WriteBytes(std::uint64_t value, std::size_t count)
+        {
+            for (std::size_t i = 0; i < count; i++)
+            {
+                m_Data.push_back(static_cast<std::uint8_t>(value >> (i * 8)));
+            }
+        }
+    public:
+        // Writes any integral, enum, bool or floating point value.
+        template<typename T>
+        void Write(T value)
+        {
+            if constexpr (std::is_enum_v<T>)
+            {
+                Write(static_cast<std::underlying_type_t<T>>(value));
+            }
+            else if constexpr (std::is_same_v<T, bool>)
+            {
+                WriteBytes(value ? 1 : 0, 1);
+            }
+            else if constexpr (std::is_same_v<T, float>)
+            {
+                std::uint32_t bits;
+                std::memcpy(&bits, &value, sizeof(bits));
+                WriteBytes(bits, sizeof(bits));
+            }
+            else if constexpr (std::is_same_v<T, double>)
+            {
+                std::uint64_t bits;
+                std::memcpy(&bits, &value, sizeof(bits));
+                WriteBytes(bits, sizeof(bits));
+            }
+            else
+            {
+                static_assert(std::is_integral_v<T>, "Unsupported type.");
+                WriteBytes(static_cast<std::uint64_t>(value), sizeof(T));
+            }
+        }
+
+        void Write(const Vector2f& vector);
+        void Write(const Vector3f& vector);
+        void Write(const Vector4f& vector);
+        void Write(const Quaternion& quaternion);
+
+        template<typename T, std::size_t N>
+        void Write(const std::array<T, N>& array)
+        {
+            for (const auto& value : array)
+            {
+                Write(value);
+            }
+        }
+
+        // Strings are stored as a 32-bit length followed by the characters, without a terminator.
+        void WriteString(std::string_view string);
+
+        // Starts a size-prefixed block, returns the offset which has to be passed to EndBlock().
+        std::size_t BeginBlock();
+        void EndBlock(std::size_t blockOffset);
+
+        const std::vector<std::uint8_t>& GetData() const;
+    };
+
+    // Reads directly from a memory buffer, such as a mapped file, without copying it. Reading past the
+    // end of the buffer returns zeroed values and marks the reader as failed, so callers only have to
+    // check HasFailed() once they're done.
+    class BinaryReader
+    {
+    private:
+        const std::uint8_t* m_Data = nullptr;
+        std::size_t m_Size = 0;
+        std::size_t m_Position = 0;
+
+        bool m_HasFailed = false;
+
+        std::uint64_t ReadBytes(std::size_t count)
+        {
+            if (m_Size - m_Position < count)
+            {
+                m_Position = m_Size;
+                m_HasFailed = true;
+                return 0;
+            }
+
+            std::uint64_t value = 0;
+
+            for (std::size_t i = 0; i < count; i++)
+            {
+                value |= static_cast<std::uint64_t>(m_Data[m_Position + i]) << (i * 8);
+            }
+
+            m_Position += count;
+
+            return value;
+        }
+    public:
+        BinaryReader() = default;
+        BinaryReader(const void* data, std::size_t size);
+
+        template<typename T>
+        void Read(T& value)
+        {
+            if constexpr (std::is_enum_v<T>)
+            {
+                std::underlying_type_t<T> underlying;
+                Read(underlying);
+                value = static_cast<T>(underlying);
+            }
+            else if constexpr (std::is_same_v<T, bool>)
+            {
+                value = ReadBytes(1) != 0;
+            }
+            else if constexpr (std::is_same_v<T, float>)
+            {
+                const auto bits = static_cast<std::uint32_t>(ReadBytes(sizeof(std::uint32_t)));
+                std::memcpy(&value, &bits, sizeof(value));
+            }
+            else if constexpr (std::is_same_v<T, double>)
+            {
+                const auto bits = ReadBytes(sizeof(std::uint64_t));
+                std::memcpy(&value, &bits, sizeof(value));
+            }
+            else
+            {
+                static_assert(std::is_integral_v<T>, "Unsupported type.");
+                value = static_cast<T>(ReadBytes(sizeof(T)));
+            }
+        }
+
+        template<typename T>
+        T Read()
+        {
+            T value{};
+            Read(value);
+            return value;
+        }
+
+        void Read(Vector2f& vector);
+        void Read(Vector3f& vector);
+        void Read(Vector4f& vector);
+        void Read(Quaternion& quaternion);
+
+        template<typename T, std::size_t N>
+        void Read(std::array<T, N>& array)
+        {
+            for (auto& value : array)
+            {
+                Read(value);
+            }
+        }
+
+        // The returned view points into the reader's buffer.
+        std::string_view ReadString();
+
+        // Reads a block written with BinaryWriter::BeginBlock()/EndBlock(), and skips past it.
+        BinaryReader ReadBlock();
+
+        std::size_t GetPosition() const;
+        std::size_t GetSize() const;
+
+        bool IsAtEnd() const;
+        bool HasFailed() const;
+    };
+
+}
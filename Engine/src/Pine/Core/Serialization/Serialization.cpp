@@ -20,7 +20,7 @@ std::optional<nlohmann::json> Pine::Serialization::LoadFromFile(const std::files
     }
     catch (...)
     {
-        Log::Error("Error loading JSON file, " + path.filename().string());
+        Log::Error("Error loading JSON file, {}", path.filename().string());
         return {};
     }
 
@@ -36,6 +36,52 @@ void Pine::Serialization::SaveToFile(const std::filesystem::path& path, const nl
     stream.close();
 }
 
+bool Pine::Serialization::IsCookedFile(const void* data, std::size_t size)
+{
+    BinaryReader reader(data, size);
+
+    return reader.Read<std::uint32_t>() == CookedFileMagic && !reader.HasFailed();
+}
+
+void Pine::Serialization::WriteCookedHeader(BinaryWriter& writer, AssetType type)
+{
+    writer.Write(CookedFileMagic);
+    writer.Write(CookedFileVersion);
+    writer.Write(static_cast<std::uint16_t>(type));
+}
+
+bool Pine::Serialization::ReadCookedHeader(BinaryReader& reader, AssetType type)
+{
+    const auto magic = reader.Read<std::uint32_t>();
+    const auto version = reader.Read<std::uint16_t>();
+    const auto assetType = reader.Read<std::uint16_t>();
+
+    if (reader.HasFailed() || magic != CookedFileMagic)
+        return false;
+
+    if (version != CookedFileVersion)
+    {
+        Log::Error("Unsupported cooked file version {}, expected {}.", version, CookedFileVersion);
+        return false;
+    }
+
+    return assetType == static_cast<std::uint16_t>(type);
+}
+
+bool Pine::Serialization::SaveToFile(const std::filesystem::path& path, const BinaryWriter& writer)
+{
+    std::ofstream stream(path, std::ios::binary);
+
+    if (!stream.is_open())
+        return false;
+
+    const auto& data = writer.GetData();
+
+    stream.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+
+    return stream.good();
+}
+
 nlohmann::json Pine::Serialization::StoreVector2(const Vector2f& vector)
 {
     nlohmann::json j;
@@ -125,4 +171,8 @@ void Pine::Serialization::LoadQuaternion(const nlohmann::json& j, const std::str
 nlohmann::json Pine::Serialization::StoreAsset(const IAsset* asset)
 {
     return asset == nullptr ? "null" : asset->GetPath();
-}
\ No newline at end of file
+}
+void Pine::Serialization::StoreAsset(BinaryWriter& writer, const IAsset* asset)
+{
+    writer.WriteString(asset == nullptr ? "" : asset->GetPath());
+}
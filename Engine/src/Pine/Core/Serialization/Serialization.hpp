@@ -2,6 +2,7 @@
 #include "Pine/Assets/Assets.hpp"
 #include "Pine/Assets/IAsset/IAsset.hpp"
 #include "Pine/Core/Math/Math.hpp"
+#include "Pine/Core/Serialization/Binary/Binary.hpp"
 #include <filesystem>
 #include <nlohmann/json.hpp>
 #include <optional>
@@ -20,6 +21,22 @@ namespace Pine::Serialization
     std::optional<nlohmann::json> LoadFromFile(const std::filesystem::path& path);
     void SaveToFile(const std::filesystem::path& path, const nlohmann::json& json);
 
+    /* Cooked */
+
+    // Cooked assets start with the magic "PNCK", a format version and the asset type, followed by the asset's own data.
+    constexpr std::uint32_t CookedFileMagic = 0x4B434E50;
+    constexpr std::uint16_t CookedFileVersion = 1;
+
+    // Checks for the magic only, use ReadCookedHeader() to validate the rest.
+    bool IsCookedFile(const void* data, std::size_t size);
+
+    void WriteCookedHeader(BinaryWriter& writer, AssetType type);
+
+    // Returns false if the header is invalid, of another asset type or from an unsupported version.
+    bool ReadCookedHeader(BinaryReader& reader, AssetType type);
+
+    bool SaveToFile(const std::filesystem::path& path, const BinaryWriter& writer);
+
     /* Store */
 
     nlohmann::json StoreVector2(const Vector2f& vector);
@@ -36,6 +53,14 @@ namespace Pine::Serialization
         return StoreAsset(asset.Get());
     }
 
+    void StoreAsset(BinaryWriter& writer, const IAsset* asset);
+
+    template <typename T>
+    void StoreAsset(BinaryWriter& writer, const AssetHandle<T> asset)
+    {
+        StoreAsset(writer, asset.Get());
+    }
+
     /* Load */
 
     void LoadVector2(const nlohmann::json& j, const std::string& name, Vector2f& vec);
@@ -62,6 +87,24 @@ namespace Pine::Serialization
         }
     }
 
+    template <typename T>
+    void LoadAsset(BinaryReader& reader, AssetHandle<T>& asset, bool allowReference = true)
+    {
+        const auto path = reader.ReadString();
+
+        if (path.empty())
+            return;
+
+        if (Assets::GetState() == AssetManagerState::LoadDirectory && allowReference)
+        {
+            Assets::AddAssetResolveReference({std::string(path), reinterpret_cast<AssetHandle<IAsset>*>(&asset)});
+        }
+        else
+        {
+            asset = Assets::Get(std::string(path));
+        }
+    }
+
     // Quick and easy way to load any data, but only if it exists. Generally makes the code look cleaner
     // within the component code.
     template <typename T>
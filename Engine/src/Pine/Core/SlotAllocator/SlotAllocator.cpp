@@ -0,0 +1,129 @@
+#include "SlotAllocator.hpp"
+
+#include <algorithm>
+
+Pine::SlotAllocator::SlotAllocator(std::uint32_t capacity)
+{
+    SetCapacity(capacity);
+}
+
+void Pine::SlotAllocator::SetCapacity(std::uint32_t capacity)
+{
+    if (capacity < m_Capacity)
+    {
+        return;
+    }
+
+    m_Capacity = capacity;
+    m_OccupationBits.resize((capacity + 63) / 64, 0);
+}
+
+std::uint32_t Pine::SlotAllocator::GetCapacity() const
+{
+    return m_Capacity;
+}
+
+std::uint32_t Pine::SlotAllocator::Allocate()
+{
+    std::uint32_t slot;
+
+    if (!m_FreeSlots.empty())
+    {
+        slot = m_FreeSlots.back();
+        m_FreeSlots.pop_back();
+    }
+    else if (m_NextUnusedSlot < m_Capacity)
+    {
+        slot = m_NextUnusedSlot++;
+    }
+    else
+    {
+        return m_Capacity;
+    }
+
+    m_OccupationBits[slot >> 6] |= 1ull << (slot & 63);
+    m_Count++;
+
+    if (slot >= m_HighestSlot)
+        m_HighestSlot = slot + 1;
+
+    return slot;
+}
+
+bool Pine::SlotAllocator::Free(std::uint32_t slot)
+{
+    if (slot >= m_Capacity || !IsOccupied(slot))
+    {
+        return false;
+    }
+
+    m_OccupationBits[slot >> 6] &= ~(1ull << (slot & 63));
+    m_Count--;
+
+    if (m_Count == 0)
+    {
+        // Everything has been freed, start over from the beginning so that the next
+        // allocations are contiguous again.
+        m_FreeSlots.clear();
+        m_NextUnusedSlot = 0;
+        m_HighestSlot = 0;
+
+        return true;
+    }
+
+    m_FreeSlots.push_back(slot);
+
+    if (slot + 1 != m_HighestSlot)
+    {
+        return true;
+    }
+
+    // We removed the highest slot, walk backwards through the bitset until we
+    // find the new highest one, 64 slots at a time.
+    std::uint32_t word = slot >> 6;
+
+    while (true)
+    {
+        if (const auto bits = m_OccupationBits[word])
+        {
+            m_HighestSlot = (word << 6) + (64 - Bits::CountLeadingZeros(bits));
+            break;
+        }
+
+        if (word == 0)
+        {
+            m_HighestSlot = 0;
+            break;
+        }
+
+        word--;
+    }
+
+    return true;
+}
+
+void Pine::SlotAllocator::Clear()
+{
+    std::fill(m_OccupationBits.begin(), m_OccupationBits.end(), 0);
+
+    m_FreeSlots.clear();
+
+    m_NextUnusedSlot = 0;
+    m_HighestSlot = 0;
+    m_Count = 0;
+}
+
+std::uint32_t Pine::SlotAllocator::GetAvailableCount() const
+{
+    return m_Capacity - m_Count;
+}
+
+std::uint32_t Pine::SlotAllocator::GetCount() const
+{
+    return m_Count;
+}
+
+std::uint32_t Pine::SlotAllocator::GetHighestSlot() const
+{
+    return m_HighestSlot;
+}
@@ -0,0 +1,86 @@
+#pragma once
+#include "Pine/Core/Bits/Bits.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace Pine
+{
+
+    // Keeps track of which slots in a fixed size object array are in use. Occupation is stored
+    // as a packed bitset, free slots are handed out through a free stack, and the highest
+    // occupied slot is maintained incrementally, making allocation and freeing constant time.
+    class SlotAllocator
+    {
+    private:
+        // One bit per slot, set if the slot is occupied.
+        std::vector<std::uint64_t> m_OccupationBits;
+
+        // Slots that have been freed and can be handed out again.
+        std::vector<std::uint32_t> m_FreeSlots;
+
+        // The number of slots this allocator may hand out.
+        std::uint32_t m_Capacity = 0;
+
+        // Slots at and above this index have never been handed out.
+        std::uint32_t m_NextUnusedSlot = 0;
+
+        // Highest occupied slot + 1, zero if empty.
+        std::uint32_t m_HighestSlot = 0;
+
+        // The number of currently occupied slots.
+        std::uint32_t m_Count = 0;
+    public:
+        SlotAllocator() = default;
+        explicit SlotAllocator(std::uint32_t capacity);
+
+        // Changes the slot capacity, shrinking is not supported.
+        void SetCapacity(std::uint32_t capacity);
+        std::uint32_t GetCapacity() const;
+
+        // Returns a free slot and marks it as occupied, or GetCapacity() if full.
+        std::uint32_t Allocate();
+
+        // Marks the slot as available again, returns false if it wasn't occupied.
+        bool Free(std::uint32_t slot);
+
+        // Marks every slot as available.
+        void Clear();
+
+        std::uint32_t GetCount() const;
+
+        // The number of slots that can be allocated before running out of capacity.
+        std::uint32_t GetAvailableCount() const;
+
+        // Highest occupied slot + 1, zero if empty.
+        std::uint32_t GetHighestSlot() const;
+
+        // Slots beyond the capacity are never occupied.
+        bool IsOccupied(std::uint32_t slot) const
+        {
+            return slot < m_Capacity && (m_OccupationBits[slot >> 6] >> (slot & 63)) & 1;
+        }
+
+        // Returns the first occupied slot at or above `slot`, or GetHighestSlot() if there is none.
+        // Skips 64 empty slots per step.
+        std::uint32_t FindNextOccupied(std::uint32_t slot) const
+        {
+            if (slot >= m_HighestSlot)
+                return m_HighestSlot;
+
+            std::uint32_t word = slot >> 6;
+            std::uint64_t bits = m_OccupationBits[word] & (~0ull << (slot & 63));
+
+            while (bits == 0)
+            {
+                if (++word << 6 >= m_HighestSlot)
+                    return m_HighestSlot;
+
+                bits = m_OccupationBits[word];
+            }
+
+            return (word << 6) + Bits::CountTrailingZeros(bits);
+        }
+    };
+
+}
@@ -59,3 +59,79 @@ std::string Pine::String::ToUpper(const std::string& str)
 
     return ret;
 }
+
+
+void Pine::String::DecodeUtf8(std::string_view str, std::vector<std::uint32_t>& codepoints)
+{
+    constexpr std::uint32_t ReplacementCharacter = 0xFFFD;
+
+    std::size_t i = 0;
+
+    while (i < str.size())
+    {
+        const auto lead = static_cast<unsigned char>(str[i]);
+
+        int length;
+        std::uint32_t codepoint;
+
+        if (lead < 0x80)
+        {
+            length = 1;
+            codepoint = lead;
+        }
+        else if ((lead & 0xE0) == 0xC0)
+        {
+            length = 2;
+            codepoint = lead & 0x1F;
+        }
+        else if ((lead & 0xF0) == 0xE0)
+        {
+            length = 3;
+            codepoint = lead & 0x0F;
+        }
+        else if ((lead & 0xF8) == 0xF0)
+        {
+            length = 4;
+            codepoint = lead & 0x07;
+        }
+        else
+        {
+            codepoints.push_back(ReplacementCharacter);
+            i++;
+            continue;
+        }
+
+        bool valid = i + length <= str.size();
+
+        for (int j = 1; valid && j < length; j++)
+        {
+            const auto continuation = static_cast<unsigned char>(str[i + j]);
+
+            if ((continuation & 0xC0) != 0x80)
+            {
+                valid = false;
+                break;
+            }
+
+            codepoint = (codepoint << 6) | (continuation & 0x3F);
+        }
+
+        // Overlong encodings, surrogates and values beyond the Unicode range aren't valid either.
+        static constexpr std::uint32_t minimumCodepoint[] = { 0, 0, 0x80, 0x800, 0x10000 };
+
+        if (valid && (codepoint < minimumCodepoint[length] || codepoint > 0x10FFFF || (codepoint >= 0xD800 && codepoint <= 0xDFFF)))
+        {
+            valid = false;
+        }
+
+        if (!valid)
+        {
+            codepoints.push_back(ReplacementCharacter);
+            i++;
+            continue;
+        }
+
+        codepoints.push_back(codepoint);
+        i += length;
+    }
+}
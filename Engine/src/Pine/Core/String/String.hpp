@@ -1,5 +1,7 @@
 #pragma once
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include <vector>
 
 // Utility functions for strings
@@ -16,4 +18,7 @@ namespace Pine::String
 
     std::string Replace(const std::string& str, const std::string& pattern, const std::string& replacement);
 
+    // Appends the code points of a UTF-8 string to codepoints, invalid sequences are replaced by U+FFFD.
+    void DecodeUtf8(std::string_view str, std::vector<std::uint32_t>& codepoints);
+
 }
\ No newline at end of file
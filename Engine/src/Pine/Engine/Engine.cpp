@@ -18,10 +18,12 @@
 #include "Pine/Script/ScriptManager.hpp"
 
 #include <GLFW/glfw3.h>
+#include <chrono>
 #include <stdexcept>
 
 #include "Pine/Game/Game.hpp"
 #include "Pine/Physics/Physics2D/Physics2D.hpp"
+#include "Pine/Performance/Performance.hpp"
 #include "Pine/Threading/Threading.hpp"
 
 namespace
@@ -31,31 +33,91 @@ namespace
     Pine::Engine::EngineConfiguration m_EngineConfiguration;
     Pine::Graphics::IGraphicsAPI* m_GraphicsAPI;
     Pine::Audio::IAudioAPI* m_AudioAPI;
+
+    std::chrono::steady_clock::time_point m_StartTime;
+
+    // Tears down the window and GLFW, if they were ever set up.
+    void ShutdownWindow()
+    {
+        if (m_EngineConfiguration.m_Headless)
+        {
+            return;
+        }
+
+        Pine::WindowManager::Internal::DestroyWindow();
+
+        glfwTerminate();
+    }
+
+    void RunFrame()
+    {
+        Pine::Performance::BeginFrame();
+
+        Pine::Assets::Update();
+
+        m_GraphicsAPI->ClearColor(Pine::Color(0, 0, 0, 255));
+        m_GraphicsAPI->ClearBuffers(Pine::Graphics::ColorBuffer);
+
+        if (!m_EngineConfiguration.m_Standalone)
+        {
+            // There is no window to read input from while headless.
+            if (!m_EngineConfiguration.m_Headless)
+            {
+                Pine::Input::Update();
+            }
+
+            Pine::World::Update();
+        }
+
+        Pine::RenderManager::Run();
+
+        Pine::Performance::EndFrame();
+    }
 }
 
 bool Pine::Engine::Setup(const EngineConfiguration& engineConfiguration)
 {
     m_EngineConfiguration = engineConfiguration;
+    m_StartTime = std::chrono::steady_clock::now();
 
-    // Initially we need to initialize some core stuff, such as libraries
-    // and a window (therefore graphics context) before initializing the rest
-    // of the engine.
+    Log::Setup();
 
-    if (!glfwInit())
+    if (!engineConfiguration.m_LogFilePath.empty())
     {
-        Log::Fatal("[Engine] Failed to setup core library: GLFW");
+        Log::OpenFileSink(engineConfiguration.m_LogFilePath, engineConfiguration.m_LogFileMaxSize, engineConfiguration.m_LogFileMaxCount);
+    }
+
+    Performance::SetAllocationTrackingEnabled(engineConfiguration.m_TrackAllocations);
+
+    if (engineConfiguration.m_Headless && engineConfiguration.m_GraphicsAPI != Graphics::GraphicsAPI::Null)
+    {
+        Log::Fatal("[Engine] Headless mode requires the Null graphics API.");
 
         return false;
     }
 
-    if (!WindowManager::Internal::CreateWindow(engineConfiguration.m_WindowPosition, engineConfiguration.m_WindowSize,
-                                               engineConfiguration.m_WindowTitle, WindowManager::ScreenType::Default))
+    // Initially we need to initialize some core stuff, such as libraries
+    // and a window (therefore graphics context) before initializing the rest
+    // of the engine.
+
+    if (!engineConfiguration.m_Headless)
     {
-        Log::Fatal("[Engine] Failed to setup window");
+        if (!glfwInit())
+        {
+            Log::Fatal("[Engine] Failed to setup core library: GLFW");
 
-        glfwTerminate();
+            return false;
+        }
 
-        return false;
+        if (!WindowManager::Internal::CreateWindow(engineConfiguration.m_WindowPosition, engineConfiguration.m_WindowSize,
+                                                   engineConfiguration.m_WindowTitle, WindowManager::ScreenType::Default))
+        {
+            Log::Fatal("[Engine] Failed to setup window");
+
+            glfwTerminate();
+
+            return false;
+        }
     }
 
     // Set up our graphics API.
@@ -63,22 +125,19 @@ bool Pine::Engine::Setup(const EngineConfiguration& engineConfiguration)
     {
         Log::Fatal("[Engine] Failed to setup graphics API");
 
-        WindowManager::Internal::DestroyWindow();
-
-        glfwTerminate();
+        ShutdownWindow();
 
         return false;
     }
 
     Graphics::GetGraphicsAPI()->EnableErrorLogging();
 
-    if (!Audio::Setup())
+    // Headless runs have no use for audio, and may be on machines without an audio device at all.
+    if (!engineConfiguration.m_Headless && !Audio::Setup())
     {
         Log::Fatal("[Engine] Failed to setup audio API");
 
-        WindowManager::Internal::DestroyWindow();
-
-        glfwTerminate();
+        ShutdownWindow();
 
         return false;
     }
@@ -101,9 +160,7 @@ bool Pine::Engine::Setup(const EngineConfiguration& engineConfiguration)
     {
         Log::Fatal("[Engine] Failed to load engine assets.");
 
-        WindowManager::Internal::DestroyWindow();
-
-        glfwTerminate();
+        ShutdownWindow();
 
         return false;
     }
@@ -136,14 +193,15 @@ void Pine::Engine::Run()
         throw std::runtime_error("[Engine] Engine has not been initialized.");
     }
 
-    const auto windowPointer = static_cast<GLFWwindow*>(WindowManager::GetWindowPointer());
-
     // During the window setup, we've actually made the window to be invisible by default.
     // This is because:
     // 1. Initialize the engine without making a visible frozen window.
     // 2. Allow the user to modify the window, without the window flickering during startup.
     // Therefore, we'll have to restore it here.
-    WindowManager::SetWindowVisible(true);
+    if (!m_EngineConfiguration.m_Headless)
+    {
+        WindowManager::SetWindowVisible(true);
+    }
 
     // At this point the user should have loaded their game assembly, so we can allow the
     // script manager to start preparing all the scripts.
@@ -158,21 +216,24 @@ void Pine::Engine::Run()
         World::OnStart();
     }
 
+    if (m_EngineConfiguration.m_Headless)
+    {
+        for (std::uint32_t i = 0; i < m_EngineConfiguration.m_HeadlessFrameCount; i++)
+        {
+            RunFrame();
+        }
+
+        return;
+    }
+
+    const auto windowPointer = static_cast<GLFWwindow*>(WindowManager::GetWindowPointer());
+
     // The main rendering loop itself
     while (WindowManager::IsWindowOpen())
     {
         m_EngineConfiguration.m_WaitEvents ? glfwWaitEventsTimeout(1) : glfwPollEvents();
 
-        m_GraphicsAPI->ClearColor(Color(0, 0, 0, 255));
-        m_GraphicsAPI->ClearBuffers(Graphics::ColorBuffer);
-
-        if (!m_EngineConfiguration.m_Standalone)
-        {
-            Input::Update();
-            World::Update();
-        }
-
-        RenderManager::Run();
+        RunFrame();
 
         glfwSwapBuffers(windowPointer);
     }
@@ -197,12 +258,17 @@ void Pine::Engine::Shutdown()
     RenderManager::Shutdown();
     Assets::Shutdown();
     Graphics::Shutdown();
-    Audio::Shutdown();
+
+    if (!m_EngineConfiguration.m_Headless)
+    {
+        Audio::Shutdown();
+    }
+
     Threading::Shutdown();
 
-    WindowManager::Internal::DestroyWindow();
+    ShutdownWindow();
 
-    glfwTerminate();
+    Log::Shutdown();
 }
 
 bool Pine::Engine::IsInitialized()
@@ -210,6 +276,11 @@ bool Pine::Engine::IsInitialized()
     return m_IsInitialized;
 }
 
+double Pine::Engine::GetTime()
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - m_StartTime).count();
+}
+
 Pine::Engine::EngineConfiguration &Pine::Engine::GetEngineConfiguration()
 {
     return m_EngineConfiguration;
@@ -3,6 +3,7 @@
 #include <Pine/Graphics/Graphics.hpp>
 #include <Pine/Audio/Audio.hpp>
 
+#include <cstdint>
 #include <string>
 
 namespace Pine::Engine
@@ -19,9 +20,14 @@ namespace Pine::Engine
         // engine tasks.
         int m_ThreadPoolWorkers = 8;
 
-        // Refers to both entity and component count
+        // The number of entities to reserve room for up front. Entity and component
+        // storage grows on demand in pages, so this is only a hint.
         std::uint32_t m_MaxObjectCount = 4096;
 
+        // The amount of time in milliseconds the main thread may spend each frame finishing
+        // assets loaded through Assets::LoadAsync(), such as uploading textures to the GPU.
+        float m_AssetUploadBudget = 2.f;
+
         // Whether to enable engine debug tools, such as hot reload
         bool m_EnableDebugTools = true;
 
@@ -35,7 +41,23 @@ namespace Pine::Engine
         // Disables all the engine stuff (such as handling entities, input and physics)
         bool m_Standalone = false;
 
+        // Counts every heap allocation towards the subsystem making it, see PINE_PF_ALLOCATION_SCOPE(). Can also be
+        // toggled later through Performance::SetAllocationTrackingEnabled().
+        bool m_TrackAllocations = false;
+
+        // Also writes the log to this file if set. Once it grows beyond m_LogFileMaxSize bytes it's rotated,
+        // keeping m_LogFileMaxCount older files around, see Log::OpenFileSink().
+        std::string m_LogFilePath;
+        std::uintmax_t m_LogFileMaxSize = 4 * 1024 * 1024;
+        int m_LogFileMaxCount = 3;
+
         Graphics::GraphicsAPI m_GraphicsAPI = Graphics::GraphicsAPI::OpenGL;
+
+        // Runs the engine without a window, input or audio, which requires the Null graphics API. Run() will
+        // render m_HeadlessFrameCount frames and then return, useful for measuring frame times on machines
+        // without a GPU or display.
+        bool m_Headless = false;
+        std::uint32_t m_HeadlessFrameCount = 1;
     };
 
     // Attempts to set up the engine with the provided engine configuration
@@ -55,6 +77,9 @@ namespace Pine::Engine
     // Returns true if Setup() has been called and completed successfully
     bool IsInitialized();
 
+    // Returns the time in seconds since Setup() was called.
+    double GetTime();
+
     // Returns the engine configuration used during Setup(), values such as
     // window parameters are not updated.
     EngineConfiguration& GetEngineConfiguration();
@@ -66,7 +66,7 @@ void Pine::Game::OnStart()
     auto asset = Pine::Assets::Get<Level>(m_GameProperties.StartupLevel);
     if (!asset)
     {
-        Log::Warning(fmt::format("Referenced startup level {} could not be found.", m_GameProperties.StartupLevel));
+        Log::Warning("Referenced startup level {} could not be found.", m_GameProperties.StartupLevel);
     }
 
     World::SetActiveLevel(asset);
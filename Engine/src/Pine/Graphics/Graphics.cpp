@@ -1,6 +1,7 @@
 #include "Graphics.hpp"
 
 #include "OpenGL/OpenGL.hpp"
+#include "Null/NullGraphicsAPI.hpp"
 
 namespace
 {
@@ -17,6 +18,9 @@ bool Pine::Graphics::Setup(GraphicsAPI api)
         case GraphicsAPI::Vulkan:
             // Not supported for now.
             return false;
+        case GraphicsAPI::Null:
+            m_GraphicsAPI = new NullGraphicsAPI();
+            break;
         default:
             return false;
     }
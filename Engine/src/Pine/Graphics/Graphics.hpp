@@ -6,7 +6,8 @@ namespace Pine::Graphics
     enum class GraphicsAPI
     {
         OpenGL,
-        Vulkan
+        Vulkan,
+        Null // Doesn't render anything, see NullGraphicsAPI
     };
 
     // Attempt to create and initialize the specified graphics API
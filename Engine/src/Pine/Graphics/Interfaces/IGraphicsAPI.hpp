@@ -118,6 +118,9 @@ namespace Pine::Graphics
 
         virtual int GetSupportedTextureSlots() = 0;
 
+        // The largest uniform block a shader may use, in bytes.
+        virtual int GetMaxUniformBlockSize() = 0;
+
         virtual IShaderProgram* CreateShaderProgram() = 0;
         virtual void DestroyShaderProgram(IShaderProgram* program) = 0;
 
@@ -165,8 +165,15 @@ namespace Pine::Graphics
         virtual void ResetSwizzleMask() = 0;
 
         virtual void UploadTextureData(int width, int height, TextureFormat textureFormat, TextureDataFormat dataFormat, void* data) = 0;
+
+        // Replaces part of a texture that has already been uploaded, the rows in data are tightly packed.
+        virtual void UploadTextureSubData(Vector2i position, Vector2i size, TextureFormat textureFormat, TextureDataFormat dataFormat, void* data) = 0;
         virtual void CopyTextureData(ITexture* texture, TextureUploadTarget textureUploadTarget, Vector4i srcRect = Vector4i(-1), Vector2i dstPos = Vector2i(0)) = 0;
 
+        // Copies all of texture into this already uploaded texture at position, without going through the CPU.
+        // Both textures need the same format.
+        virtual void CopyTextureSubData(ITexture* texture, Vector2i position) = 0;
+
         virtual void GenerateMipmaps() = 0;
     };
 }
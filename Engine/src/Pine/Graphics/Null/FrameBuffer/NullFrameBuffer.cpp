@@ -0,0 +1,199 @@
+#include "NullFrameBuffer.hpp"
+#include "Pine/Graphics/Null/NullGraphicsAPI.hpp"
+
+#include <cassert>
+#include <cstring>
+
+namespace
+{
+
+    int GetReadFormatChannelCount(Pine::Graphics::ReadFormat format)
+    {
+        switch (format)
+        {
+            case Pine::Graphics::ReadFormat::RGBA:
+                return 4;
+            case Pine::Graphics::ReadFormat::RGB:
+                return 3;
+            case Pine::Graphics::ReadFormat::RG:
+                return 2;
+            default:
+                return 1;
+        }
+    }
+
+}
+
+Pine::Vector2i Pine::Graphics::NullFrameBuffer::GetSize()
+{
+    return m_Size;
+}
+
+Pine::Graphics::ITexture* Pine::Graphics::NullFrameBuffer::GetColorBuffer()
+{
+    return m_ColorBuffer;
+}
+
+Pine::Graphics::ITexture* Pine::Graphics::NullFrameBuffer::GetDepthBuffer()
+{
+    return m_DepthBuffer;
+}
+
+Pine::Graphics::ITexture* Pine::Graphics::NullFrameBuffer::GetNormalBuffer()
+{
+    return m_NormalBuffer;
+}
+
+Pine::Graphics::ITexture* Pine::Graphics::NullFrameBuffer::GetDepthStencilBuffer()
+{
+    return m_DepthStencilBuffer;
+}
+
+std::uint32_t Pine::Graphics::NullFrameBuffer::GetId() const
+{
+    return m_Id;
+}
+
+void Pine::Graphics::NullFrameBuffer::Bind()
+{
+    NullGraphicsAPI::Record(NullCommandType::BindFrameBuffer, m_Id);
+}
+
+void Pine::Graphics::NullFrameBuffer::Dispose()
+{
+    if (m_ColorBuffer != nullptr)
+    {
+        m_ColorBuffer->Dispose();
+
+        delete m_ColorBuffer;
+    }
+
+    if (m_DepthBuffer != nullptr)
+    {
+        m_DepthBuffer->Dispose();
+
+        delete m_DepthBuffer;
+    }
+
+    if (m_NormalBuffer != nullptr)
+    {
+        m_NormalBuffer->Dispose();
+
+        delete m_NormalBuffer;
+    }
+
+    m_Id = 0;
+}
+
+void Pine::Graphics::NullFrameBuffer::Prepare()
+{
+    // Please dispose of the previous frame buffer before creating a new one.
+    assert(m_Id == 0);
+
+    m_Id = NullGraphicsAPI::GenerateId();
+
+    Bind();
+}
+
+void Pine::Graphics::NullFrameBuffer::AttachTextures(int width, int height, int buffers, int multiSample)
+{
+    if (buffers & StencilBuffer)
+    {
+        // Notice: When creating a stencil buffer, a depth buffer must also be created.
+        assert(buffers & DepthBuffer);
+    }
+
+    const bool multiSampleEnabled = multiSample != 0;
+
+    if (buffers & ColorBuffer)
+    {
+        m_ColorBuffer = new NullTexture();
+
+        m_ColorBuffer->SetMultiSampled(multiSampleEnabled);
+        m_ColorBuffer->SetSamples(multiSample);
+
+        m_ColorBuffer->Bind();
+        m_ColorBuffer->UploadTextureData(width, height, TextureFormat::RGBA, TextureDataFormat::UnsignedByte, nullptr);
+    }
+
+    if (buffers & NormalBuffer)
+    {
+        m_NormalBuffer = new NullTexture();
+        m_NormalBuffer->Bind();
+        m_NormalBuffer->UploadTextureData(width, height, TextureFormat::RGBA16F, TextureDataFormat::Float, nullptr);
+    }
+
+    if (buffers & StencilBuffer)
+    {
+        m_DepthStencilBuffer = new NullTexture();
+
+        m_DepthStencilBuffer->SetMultiSampled(multiSampleEnabled);
+        m_DepthStencilBuffer->SetSamples(multiSample);
+
+        m_DepthStencilBuffer->Bind();
+        m_DepthStencilBuffer->UploadTextureData(width, height, TextureFormat::DepthStencil, TextureDataFormat::UnsignedInt24_8, nullptr);
+    }
+    else
+    {
+        if (buffers & DepthBuffer)
+        {
+            m_DepthBuffer = new NullTexture();
+
+            m_DepthBuffer->SetMultiSampled(multiSampleEnabled);
+            m_DepthBuffer->SetSamples(multiSample);
+
+            m_DepthBuffer->Bind();
+            m_DepthBuffer->UploadTextureData(width, height, TextureFormat::Depth, TextureDataFormat::Float, nullptr);
+        }
+    }
+
+    m_Size = Vector2i(width, height);
+}
+
+void Pine::Graphics::NullFrameBuffer::AttachTexture(ITexture *texture, BufferAttachment attachment, int attachmentOffset)
+{
+    const auto nullTexture = dynamic_cast<NullTexture*>(texture);
+
+    assert(nullTexture != nullptr);
+
+    switch (attachment)
+    {
+        case BufferAttachment::Color:
+            if (attachmentOffset == 0)
+                m_ColorBuffer = nullTexture;
+            else
+                m_NormalBuffer = nullTexture;
+            break;
+        case BufferAttachment::Depth:
+            m_DepthBuffer = nullTexture;
+            break;
+        case BufferAttachment::DepthStencil:
+            m_DepthStencilBuffer = nullTexture;
+            break;
+        default:
+            break;
+    }
+}
+
+bool Pine::Graphics::NullFrameBuffer::Finish()
+{
+    return true;
+}
+
+void Pine::Graphics::NullFrameBuffer::Blit(IFrameBuffer *source, Buffers buffer, Vector4i srcRect, Vector4i dstRect)
+{
+    const auto nullSource = dynamic_cast<NullFrameBuffer*>(source);
+
+    NullGraphicsAPI::Record(NullCommandType::BlitFrameBuffer, m_Id, nullSource != nullptr ? nullSource->GetId() : 0, buffer);
+}
+
+void Pine::Graphics::NullFrameBuffer::ReadPixels(Vector2i position, Vector2i size, ReadFormat readFormat, TextureDataFormat dataFormat, size_t bufferSize, void *buffer)
+{
+    const auto dataSize = dataFormat == TextureDataFormat::UnsignedByte ? 1 : 4;
+    const auto readSize = static_cast<std::uint32_t>(size.x * size.y * GetReadFormatChannelCount(readFormat) * dataSize);
+
+    NullGraphicsAPI::Record(NullCommandType::ReadPixels, m_Id, readSize);
+
+    // There is nothing rendered to read back, but don't leave the caller with uninitialized memory.
+    memset(buffer, 0, bufferSize);
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "Pine/Graphics/Interfaces/IFrameBuffer.hpp"
+#include "Pine/Graphics/Null/Texture/NullTexture.hpp"
+
+namespace Pine::Graphics
+{
+
+   class NullFrameBuffer : public IFrameBuffer
+   {
+   private:
+       std::uint32_t m_Id = 0;
+
+       NullTexture* m_ColorBuffer = nullptr;
+       NullTexture* m_DepthBuffer = nullptr;
+       NullTexture* m_DepthStencilBuffer = nullptr;
+       NullTexture* m_NormalBuffer = nullptr;
+
+       Vector2i m_Size = Vector2i(0);
+   public:
+       void Bind() override;
+       void Dispose() override;
+
+       void Prepare() override;
+
+       void AttachTextures(int width, int height, int buffers, int multiSample = 0) override;
+
+       void AttachTexture(ITexture* texture, BufferAttachment attachment, int attachmentOffset = 0) override;
+
+       bool Finish() override;
+
+       void Blit(IFrameBuffer* source, Buffers buffer = ColorBuffer, Vector4i srcRect = Vector4i(-1), Vector4i dstRect = Vector4i(-1)) override;
+       void ReadPixels(Vector2i position, Vector2i size, ReadFormat readFormat, TextureDataFormat dataFormat, size_t bufferSize, void* buffer) override;
+       Vector2i GetSize() override;
+
+       ITexture* GetColorBuffer() override;
+       ITexture* GetDepthBuffer() override;
+       ITexture* GetNormalBuffer() override;
+       ITexture* GetDepthStencilBuffer() override;
+
+       std::uint32_t GetId() const;
+   };
+
+}
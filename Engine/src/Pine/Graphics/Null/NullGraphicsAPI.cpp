@@ -0,0 +1,346 @@
+#include "NullGraphicsAPI.hpp"
+#include "Pine/Graphics/Null/FrameBuffer/NullFrameBuffer.hpp"
+#include "Pine/Graphics/Null/ShaderProgram/NullShaderProgram.hpp"
+#include "Pine/Graphics/Null/Texture/NullTexture.hpp"
+#include "Pine/Graphics/Null/VertexArray/NullVertexArray.hpp"
+#include "Pine/Graphics/Null/UniformBuffer/NullUniformBuffer.hpp"
+#include "Pine/Performance/Performance.hpp"
+
+namespace
+{
+
+    bool m_RecordingEnabled = false;
+
+    std::vector<Pine::Graphics::NullCommand> m_RecordedCommands;
+
+    Pine::Graphics::NullStatistics m_Statistics;
+
+    std::uint32_t m_IdCounter = 0;
+
+    // Matches the texture slot count the OpenGL implementation reports.
+    constexpr int SupportedTextureSlots = 16;
+
+    // The smallest limit OpenGL allows, so anything that works headless fits on every GPU.
+    constexpr int MaxUniformBlockSize = 16384;
+
+    void RecordState(Pine::Graphics::NullState state, bool value)
+    {
+        Pine::Graphics::NullGraphicsAPI::Record(Pine::Graphics::NullCommandType::SetState, static_cast<std::uint32_t>(state), value);
+    }
+
+}
+
+bool Pine::Graphics::NullGraphicsAPI::Setup()
+{
+    return true;
+}
+
+void Pine::Graphics::NullGraphicsAPI::Shutdown()
+{
+    m_RecordedCommands.clear();
+    m_RecordedCommands.shrink_to_fit();
+}
+
+void Pine::Graphics::NullGraphicsAPI::EnableErrorLogging()
+{
+}
+
+void Pine::Graphics::NullGraphicsAPI::DisableErrorLogging()
+{
+}
+
+void Pine::Graphics::NullGraphicsAPI::ResetInternalChangeTracking()
+{
+    NullTexture::ResetChangeTracking();
+    NullShaderProgram::ResetChangeTracking();
+    NullUniformBuffer::ResetChangeTracking();
+}
+
+const char* Pine::Graphics::NullGraphicsAPI::GetName() const
+{
+    return "Null";
+}
+
+const char* Pine::Graphics::NullGraphicsAPI::GetVersionString() const
+{
+    return "1.0";
+}
+
+const char* Pine::Graphics::NullGraphicsAPI::GetGraphicsAdapter() const
+{
+    return "None";
+}
+
+void Pine::Graphics::NullGraphicsAPI::ClearBuffers(std::uint32_t buffers)
+{
+    if (buffers == 0)
+        return;
+
+    Record(NullCommandType::Clear, buffers);
+}
+
+void Pine::Graphics::NullGraphicsAPI::ClearColor(Color color)
+{
+    const auto packedColor = static_cast<std::uint32_t>(color.r & 0xFF) |
+                             static_cast<std::uint32_t>(color.g & 0xFF) << 8 |
+                             static_cast<std::uint32_t>(color.b & 0xFF) << 16 |
+                             static_cast<std::uint32_t>(color.a & 0xFF) << 24;
+
+    Record(NullCommandType::SetClearColor, packedColor);
+}
+
+void Pine::Graphics::NullGraphicsAPI::SetViewport(Vector2i position, Vector2i size)
+{
+    Record(NullCommandType::SetViewport, (position.x & 0xFFFF) | static_cast<std::uint32_t>(position.y & 0xFFFF) << 16, size.x, size.y);
+}
+
+void Pine::Graphics::NullGraphicsAPI::SetBlendingEnabled(bool value)
+{
+    RecordState(NullState::Blending, value);
+}
+
+void Pine::Graphics::NullGraphicsAPI::SetDepthTestEnabled(bool value)
+{
+    RecordState(NullState::DepthTest, value);
+}
+
+void Pine::Graphics::NullGraphicsAPI::SetStencilTestEnabled(bool value)
+{
+    RecordState(NullState::StencilTest, value);
+}
+
+void Pine::Graphics::NullGraphicsAPI::SetFaceCullingEnabled(bool value)
+{
+    RecordState(NullState::FaceCulling, value);
+}
+
+void Pine::Graphics::NullGraphicsAPI::SetMultiSampleEnabled(bool value)
+{
+    RecordState(NullState::MultiSample, value);
+}
+
+void Pine::Graphics::NullGraphicsAPI::SetWireframeEnabled(bool value)
+{
+    RecordState(NullState::Wireframe, value);
+}
+
+void Pine::Graphics::NullGraphicsAPI::SetFaceCullingMode(FaceCullMode mode)
+{
+    Record(NullCommandType::SetFaceCullingMode, static_cast<std::uint32_t>(mode));
+}
+
+void Pine::Graphics::NullGraphicsAPI::SetBlendingFunction(BlendingFunction source, BlendingFunction destination)
+{
+    Record(NullCommandType::SetBlendingFunction, static_cast<std::uint32_t>(source), static_cast<std::uint32_t>(destination));
+}
+
+void Pine::Graphics::NullGraphicsAPI::SetDepthFunction(TestFunction value)
+{
+    Record(NullCommandType::SetDepthFunction, static_cast<std::uint32_t>(value));
+}
+
+void Pine::Graphics::NullGraphicsAPI::SetStencilFunction(TestFunction function, int ref, int mask)
+{
+    Record(NullCommandType::SetStencilFunction, static_cast<std::uint32_t>(function), ref, mask);
+}
+
+void Pine::Graphics::NullGraphicsAPI::SetStencilOperation(StencilOperation stencilFail, StencilOperation depthFail, StencilOperation depthPass)
+{
+    Record(NullCommandType::SetStencilOperation,
+           static_cast<std::uint32_t>(stencilFail),
+           static_cast<std::uint32_t>(depthFail),
+           static_cast<std::uint32_t>(depthPass));
+}
+
+void Pine::Graphics::NullGraphicsAPI::SetStencilMask(int mask)
+{
+    Record(NullCommandType::SetStencilMask, mask);
+}
+
+Pine::Graphics::IVertexArray* Pine::Graphics::NullGraphicsAPI::CreateVertexArray()
+{
+    return new NullVertexArray();
+}
+
+void Pine::Graphics::NullGraphicsAPI::DestroyVertexArray(IVertexArray* array)
+{
+    array->Dispose();
+
+    delete array;
+}
+
+Pine::Graphics::ITexture* Pine::Graphics::NullGraphicsAPI::CreateTexture()
+{
+    return new NullTexture();
+}
+
+void Pine::Graphics::NullGraphicsAPI::DestroyTexture(ITexture* texture)
+{
+    texture->Dispose();
+
+    delete texture;
+}
+
+int Pine::Graphics::NullGraphicsAPI::GetSupportedTextureSlots()
+{
+    return SupportedTextureSlots;
+}
+
+int Pine::Graphics::NullGraphicsAPI::GetMaxUniformBlockSize()
+{
+    return MaxUniformBlockSize;
+}
+
+Pine::Graphics::IShaderProgram* Pine::Graphics::NullGraphicsAPI::CreateShaderProgram()
+{
+    return new NullShaderProgram();
+}
+
+void Pine::Graphics::NullGraphicsAPI::DestroyShaderProgram(IShaderProgram* program)
+{
+    program->Dispose();
+
+    delete program;
+}
+
+Pine::Graphics::IUniformBuffer* Pine::Graphics::NullGraphicsAPI::CreateUniformBuffer()
+{
+    return new NullUniformBuffer();
+}
+
+void Pine::Graphics::NullGraphicsAPI::DestroyUniformBuffer(IUniformBuffer* buffer)
+{
+    buffer->Dispose();
+
+    delete buffer;
+}
+
+Pine::Graphics::IFrameBuffer* Pine::Graphics::NullGraphicsAPI::CreateFrameBuffer()
+{
+    return new NullFrameBuffer();
+}
+
+void Pine::Graphics::NullGraphicsAPI::DestroyFrameBuffer(IFrameBuffer* buffer)
+{
+    buffer->Dispose();
+
+    delete buffer;
+}
+
+void Pine::Graphics::NullGraphicsAPI::BindFrameBuffer(IFrameBuffer* buffer)
+{
+    if (buffer)
+        buffer->Bind();
+    else
+        Record(NullCommandType::BindFrameBuffer, 0);
+}
+
+void Pine::Graphics::NullGraphicsAPI::DrawArrays(RenderMode mode, int count)
+{
+    Record(NullCommandType::Draw, static_cast<std::uint32_t>(mode), count, 1);
+}
+
+void Pine::Graphics::NullGraphicsAPI::DrawElements(RenderMode mode, int count)
+{
+    Record(NullCommandType::Draw, static_cast<std::uint32_t>(mode), count, 1);
+}
+
+void Pine::Graphics::NullGraphicsAPI::DrawArraysInstanced(RenderMode mode, int count, int instanceCount)
+{
+    Record(NullCommandType::DrawInstanced, static_cast<std::uint32_t>(mode), count, instanceCount);
+}
+
+void Pine::Graphics::NullGraphicsAPI::DrawElementsInstanced(RenderMode mode, int count, int instanceCount)
+{
+    Record(NullCommandType::DrawInstanced, static_cast<std::uint32_t>(mode), count, instanceCount);
+}
+
+void Pine::Graphics::NullGraphicsAPI::Record(NullCommandType type, std::uint32_t a, std::uint32_t b, std::uint32_t c)
+{
+    m_Statistics.Commands++;
+
+    switch (type)
+    {
+        case NullCommandType::Clear:
+            m_Statistics.Clears++;
+            break;
+        case NullCommandType::BindFrameBuffer:
+        case NullCommandType::BindTexture:
+        case NullCommandType::BindVertexArray:
+        case NullCommandType::BindVertexBuffer:
+        case NullCommandType::BindUniformBuffer:
+        case NullCommandType::UseShaderProgram:
+            m_Statistics.Binds++;
+            break;
+        case NullCommandType::LoadUniform:
+            m_Statistics.UniformUploads++;
+            break;
+        case NullCommandType::UploadTexture:
+            m_Statistics.Uploads++;
+            m_Statistics.UploadedBytes += b;
+            PINE_PF_COUNTER("Texture uploads", 1);
+            break;
+        case NullCommandType::UploadVertexBuffer:
+        case NullCommandType::UploadElementBuffer:
+        case NullCommandType::UploadUniformBuffer:
+            m_Statistics.Uploads++;
+            m_Statistics.UploadedBytes += b;
+            PINE_PF_COUNTER("Buffer uploads", 1);
+            PINE_PF_COUNTER("Buffer upload bytes", b);
+            break;
+        case NullCommandType::Draw:
+        case NullCommandType::DrawInstanced:
+            m_Statistics.DrawCalls++;
+            m_Statistics.DrawnElements += static_cast<std::uint64_t>(b) * c;
+            PINE_PF_COUNTER("Draw calls", 1);
+            PINE_PF_COUNTER("Drawn vertices", static_cast<std::int64_t>(b) * c);
+            break;
+        case NullCommandType::BlitFrameBuffer:
+        case NullCommandType::CopyTexture:
+        case NullCommandType::ReadPixels:
+            break;
+        default:
+            m_Statistics.StateChanges++;
+            break;
+    }
+
+    if (m_RecordingEnabled)
+    {
+        m_RecordedCommands.push_back({ type, { a, b, c } });
+    }
+}
+
+std::uint32_t Pine::Graphics::NullGraphicsAPI::GenerateId()
+{
+    return ++m_IdCounter;
+}
+
+void Pine::Graphics::NullGraphicsAPI::SetRecordingEnabled(bool value)
+{
+    m_RecordingEnabled = value;
+}
+
+bool Pine::Graphics::NullGraphicsAPI::IsRecordingEnabled()
+{
+    return m_RecordingEnabled;
+}
+
+const std::vector<Pine::Graphics::NullCommand>& Pine::Graphics::NullGraphicsAPI::GetRecordedCommands()
+{
+    return m_RecordedCommands;
+}
+
+void Pine::Graphics::NullGraphicsAPI::ClearRecordedCommands()
+{
+    m_RecordedCommands.clear();
+}
+
+const Pine::Graphics::NullStatistics& Pine::Graphics::NullGraphicsAPI::GetStatistics()
+{
+    return m_Statistics;
+}
+
+void Pine::Graphics::NullGraphicsAPI::ResetStatistics()
+{
+    m_Statistics = NullStatistics();
+}
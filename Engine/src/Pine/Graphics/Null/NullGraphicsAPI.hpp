@@ -0,0 +1,160 @@
+#pragma once
+#include "Pine/Graphics/Interfaces/IGraphicsAPI.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace Pine::Graphics
+{
+
+    enum class NullCommandType : std::uint32_t
+    {
+        Clear,
+        SetClearColor,
+        SetViewport,
+        SetState,
+        SetBlendingFunction,
+        SetDepthFunction,
+        SetFaceCullingMode,
+        SetStencilFunction,
+        SetStencilOperation,
+        SetStencilMask,
+        BindFrameBuffer,
+        BindTexture,
+        BindVertexArray,
+        BindVertexBuffer,
+        BindUniformBuffer,
+        UseShaderProgram,
+        LoadUniform,
+        UploadTexture,
+        UploadVertexBuffer,
+        UploadElementBuffer,
+        UploadUniformBuffer,
+        BlitFrameBuffer,
+        CopyTexture,
+        ReadPixels,
+        Draw,
+        DrawInstanced
+    };
+
+    // The pipeline state toggled by a NullCommandType::SetState command.
+    enum class NullState : std::uint32_t
+    {
+        Blending,
+        DepthTest,
+        StencilTest,
+        FaceCulling,
+        MultiSample,
+        Wireframe
+    };
+
+    // A single recorded graphics call, the meaning of the arguments depends on the type, but the first one is
+    // usually the id of the object involved, and the byte count is in the second one for uploads. Draws store
+    // the render mode, the element count and the instance count.
+    struct NullCommand
+    {
+        NullCommandType Type = NullCommandType::Clear;
+
+        std::uint32_t Arguments[3] = { 0, 0, 0 };
+    };
+
+    struct NullStatistics
+    {
+        std::uint64_t Commands = 0;
+
+        std::uint64_t DrawCalls = 0;
+        std::uint64_t DrawnElements = 0;
+
+        // Pipeline state changes such as blending or depth testing, binds are counted separately.
+        std::uint64_t StateChanges = 0;
+        std::uint64_t Binds = 0;
+
+        std::uint64_t UniformUploads = 0;
+
+        std::uint64_t Uploads = 0;
+        std::uint64_t UploadedBytes = 0;
+
+        std::uint64_t Clears = 0;
+    };
+
+    // A graphics API that doesn't talk to any GPU, which allows running the renderer on machines without one,
+    // for measuring the CPU side cost of a frame for example. Every call is counted, and can optionally be
+    // recorded into a command stream for later inspection.
+    class NullGraphicsAPI : public IGraphicsAPI
+    {
+    public:
+        bool Setup() override;
+        void Shutdown() override;
+
+        void EnableErrorLogging() override;
+        void DisableErrorLogging() override;
+
+        void ResetInternalChangeTracking() override;
+
+        const char* GetName() const override;
+        const char* GetVersionString() const override;
+        const char* GetGraphicsAdapter() const override;
+
+        void ClearBuffers(std::uint32_t buffers) override;
+        void ClearColor(Color color) override;
+
+        void SetViewport(Vector2i position, Vector2i size) override;
+
+        void SetBlendingEnabled(bool value) override;
+        void SetDepthTestEnabled(bool value) override;
+        void SetStencilTestEnabled(bool value) override;
+        void SetFaceCullingEnabled(bool value) override;
+        void SetMultiSampleEnabled(bool value) override;
+        void SetWireframeEnabled(bool value) override;
+
+        void SetFaceCullingMode(FaceCullMode mode) override;
+
+        void SetBlendingFunction(BlendingFunction source, BlendingFunction destination) override;
+
+        void SetDepthFunction(TestFunction value) override;
+
+        void SetStencilFunction(TestFunction function, int ref, int mask) override;
+        void SetStencilOperation(StencilOperation stencilFail, StencilOperation depthFail, StencilOperation depthPass) override;
+        void SetStencilMask(int mask) override;
+
+        IVertexArray* CreateVertexArray() override;
+        void DestroyVertexArray(IVertexArray* array) override;
+
+        ITexture* CreateTexture() override;
+        void DestroyTexture(ITexture* texture) override;
+
+        int GetSupportedTextureSlots() override;
+        int GetMaxUniformBlockSize() override;
+
+        IShaderProgram* CreateShaderProgram() override;
+        void DestroyShaderProgram(IShaderProgram* program) override;
+
+        IUniformBuffer* CreateUniformBuffer() override;
+        void DestroyUniformBuffer(IUniformBuffer* buffer) override;
+
+        IFrameBuffer* CreateFrameBuffer() override;
+        void DestroyFrameBuffer(IFrameBuffer* buffer) override;
+        void BindFrameBuffer(IFrameBuffer* buffer) override;
+
+        void DrawArrays(RenderMode mode, int count) override;
+        void DrawElements(RenderMode mode, int count) override;
+
+        void DrawArraysInstanced(RenderMode mode, int count, int instanceCount) override;
+        void DrawElementsInstanced(RenderMode mode, int count, int instanceCount) override;
+
+        // Counts the command, and adds it to the command stream if recording is enabled.
+        static void Record(NullCommandType type, std::uint32_t a = 0, std::uint32_t b = 0, std::uint32_t c = 0);
+
+        // Hands out a unique id to every created object, zero is never used.
+        static std::uint32_t GenerateId();
+
+        static void SetRecordingEnabled(bool value);
+        static bool IsRecordingEnabled();
+
+        static const std::vector<NullCommand>& GetRecordedCommands();
+        static void ClearRecordedCommands();
+
+        static const NullStatistics& GetStatistics();
+        static void ResetStatistics();
+    };
+
+}
@@ -0,0 +1,76 @@
+#include "NullShaderProgram.hpp"
+#include "Pine/Graphics/Null/NullGraphicsAPI.hpp"
+
+#include <cassert>
+
+namespace
+{
+    std::uint32_t m_ActiveShader = 0;
+}
+
+Pine::Graphics::NullShaderProgram::NullShaderProgram()
+    : m_Id(NullGraphicsAPI::GenerateId())
+{
+}
+
+void Pine::Graphics::NullShaderProgram::Use()
+{
+    if (m_ActiveShader == m_Id)
+    {
+        return;
+    }
+
+    NullGraphicsAPI::Record(NullCommandType::UseShaderProgram, m_Id);
+
+    m_ActiveShader = m_Id;
+}
+
+void Pine::Graphics::NullShaderProgram::Dispose()
+{
+    for (const auto& [name, variable] : m_UniformVariables)
+    {
+        delete variable;
+    }
+
+    m_UniformVariables.clear();
+
+    if (m_ActiveShader == m_Id)
+    {
+        m_ActiveShader = 0;
+    }
+}
+
+bool Pine::Graphics::NullShaderProgram::CompileAndLoadShader(const std::string &src, ShaderType type)
+{
+    return true;
+}
+
+bool Pine::Graphics::NullShaderProgram::LinkProgram()
+{
+    return true;
+}
+
+Pine::Graphics::IUniformVariable *Pine::Graphics::NullShaderProgram::GetUniformVariable(const std::string &name)
+{
+    // Make sure you bind the shader before attempting to grab a uniform variable!
+    assert(m_ActiveShader == m_Id);
+
+    auto& variable = m_UniformVariables[name];
+
+    if (variable == nullptr)
+    {
+        variable = new NullUniformVariable(m_Id);
+    }
+
+    return variable;
+}
+
+bool Pine::Graphics::NullShaderProgram::AttachUniformBuffer(IUniformBuffer *buffer, const std::string &bufferName)
+{
+    return true;
+}
+
+void Pine::Graphics::NullShaderProgram::ResetChangeTracking()
+{
+    m_ActiveShader = 0;
+}
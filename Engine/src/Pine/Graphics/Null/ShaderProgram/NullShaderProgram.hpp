@@ -0,0 +1,34 @@
+#pragma once
+#include <unordered_map>
+
+#include "Pine/Graphics/Interfaces/IShaderProgram.hpp"
+#include "Pine/Graphics/Null/UniformVariable/NullUniformVariable.hpp"
+
+namespace Pine::Graphics
+{
+
+    // Null implementation of IShaderProgram, the shader sources are accepted as is, and every uniform
+    // variable asked for exists.
+    class NullShaderProgram : public IShaderProgram
+    {
+    private:
+        std::uint32_t m_Id = 0;
+
+        std::unordered_map<std::string, NullUniformVariable*> m_UniformVariables;
+    public:
+        NullShaderProgram();
+
+        void Use() override;
+        void Dispose() override;
+
+        bool CompileAndLoadShader(const std::string& src, ShaderType type) override;
+        bool LinkProgram() override;
+
+        IUniformVariable* GetUniformVariable(const std::string& name) override;
+
+        bool AttachUniformBuffer(IUniformBuffer* buffer, const std::string& bufferName) override;
+
+        static void ResetChangeTracking();
+    };
+
+}
@@ -0,0 +1,270 @@
+#include "NullTexture.hpp"
+#include "Pine/Graphics/Null/NullGraphicsAPI.hpp"
+
+#include <algorithm>
+#include <limits>
+
+namespace
+{
+
+    std::uint32_t m_BoundTextures[64] = { std::numeric_limits<std::uint32_t>::max() };
+
+    int GetChannelCount(Pine::Graphics::TextureFormat format)
+    {
+        switch (format)
+        {
+            case Pine::Graphics::TextureFormat::RGB:
+            case Pine::Graphics::TextureFormat::RGB16F:
+                return 3;
+            case Pine::Graphics::TextureFormat::RGBA:
+            case Pine::Graphics::TextureFormat::RGBA16F:
+                return 4;
+            default:
+                return 1;
+        }
+    }
+
+    int GetDataFormatSize(Pine::Graphics::TextureDataFormat format)
+    {
+        switch (format)
+        {
+            case Pine::Graphics::TextureDataFormat::Float:
+            case Pine::Graphics::TextureDataFormat::UnsignedInt24_8:
+                return 4;
+            default:
+                return 1;
+        }
+    }
+
+    // The number of bytes the graphics driver would have to read from the data pointer.
+    std::uint32_t CalculateUploadSize(int width, int height, int layers, Pine::Graphics::TextureFormat format, Pine::Graphics::TextureDataFormat dataFormat)
+    {
+        return static_cast<std::uint32_t>(width * height * layers * GetChannelCount(format) * GetDataFormatSize(dataFormat));
+    }
+
+}
+
+Pine::Graphics::NullTexture::NullTexture()
+    : m_Id(NullGraphicsAPI::GenerateId())
+{
+}
+
+void Pine::Graphics::NullTexture::Bind(int textureIndex)
+{
+    if (m_BoundTextures[textureIndex] == m_Id)
+    {
+        return;
+    }
+
+    NullGraphicsAPI::Record(NullCommandType::BindTexture, m_Id, textureIndex);
+
+    m_BoundTextures[textureIndex] = m_Id;
+}
+
+void Pine::Graphics::NullTexture::CopyTextureData(ITexture *texture,
+                                                  TextureUploadTarget textureUploadTarget,
+                                                  Vector4i srcRect,
+                                                  Vector2i dstPos)
+{
+    if (srcRect.x < 0)
+        srcRect = Vector4i(0, 0, texture->GetWidth(), texture->GetHeight());
+
+    // The OpenGL implementation copies the source texture through the CPU, so count it as an upload.
+    NullGraphicsAPI::Record(NullCommandType::UploadTexture,
+                            m_Id,
+                            CalculateUploadSize(texture->GetWidth(), texture->GetHeight(), 1, texture->GetTextureFormat(), texture->GetTextureDataFormat()),
+                            static_cast<std::uint32_t>(textureUploadTarget));
+
+    if (m_Width == 0 || m_Height == 0)
+    {
+        m_Width = srcRect.z;
+        m_Height = srcRect.w;
+        m_TextureFormat = texture->GetTextureFormat();
+        m_TextureDataFormat = texture->GetTextureDataFormat();
+    }
+}
+
+void Pine::Graphics::NullTexture::CopyTextureSubData(ITexture* texture, Vector2i position)
+{
+    // Stays on the GPU, so nothing is uploaded.
+    NullGraphicsAPI::Record(NullCommandType::CopyTexture, m_Id, *static_cast<std::uint32_t*>(texture->GetGraphicsIdentifier()));
+}
+
+void Pine::Graphics::NullTexture::Dispose()
+{
+    for (auto& boundTexture : m_BoundTextures)
+    {
+        if (boundTexture == m_Id)
+        {
+            boundTexture = std::numeric_limits<std::uint32_t>::max();
+        }
+    }
+}
+
+void Pine::Graphics::NullTexture::UploadTextureData(int width, int height, TextureFormat format, TextureDataFormat dataFormat, void *data)
+{
+    const int layers = m_Type == TextureType::Texture2DArray ? std::max(m_ArraySize, 1) : 1;
+
+    // Allocating the texture storage without any data doesn't transfer anything.
+    NullGraphicsAPI::Record(NullCommandType::UploadTexture,
+                            m_Id,
+                            data != nullptr ? CalculateUploadSize(width, height, layers, format, dataFormat) : 0);
+
+    m_Width = width;
+    m_Height = height;
+    m_TextureFormat = format;
+    m_TextureDataFormat = dataFormat;
+}
+
+void Pine::Graphics::NullTexture::UploadTextureSubData(Vector2i position, Vector2i size, TextureFormat format, TextureDataFormat dataFormat, void *data)
+{
+    NullGraphicsAPI::Record(NullCommandType::UploadTexture, m_Id, CalculateUploadSize(size.x, size.y, 1, format, dataFormat));
+}
+
+Pine::Graphics::TextureType Pine::Graphics::NullTexture::GetType()
+{
+    return m_Type;
+}
+
+void Pine::Graphics::NullTexture::SetType(TextureType type)
+{
+    m_Type = type;
+}
+
+void Pine::Graphics::NullTexture::SetFilteringMode(TextureFilteringMode mode)
+{
+    m_FilteringMode = mode;
+}
+
+Pine::Graphics::TextureFilteringMode Pine::Graphics::NullTexture::GetFilteringMode()
+{
+    return m_FilteringMode;
+}
+
+void Pine::Graphics::NullTexture::SetMipmapFilteringMode(TextureFilteringMode mode)
+{
+    m_MipmapFilteringMode = mode;
+}
+
+Pine::Graphics::TextureFilteringMode Pine::Graphics::NullTexture::GetMipmapFilteringMode()
+{
+    return m_MipmapFilteringMode;
+}
+
+void Pine::Graphics::NullTexture::SetTextureWrapMode(TextureWrapMode mode)
+{
+    m_WrapMode = mode;
+}
+
+Pine::Graphics::TextureWrapMode Pine::Graphics::NullTexture::GetTextureWrapMode()
+{
+    return m_WrapMode;
+}
+
+void Pine::Graphics::NullTexture::SetBorderColor(Vector4f color)
+{
+    m_BorderColor = color;
+}
+
+Pine::Vector4f Pine::Graphics::NullTexture::GetBorderColor()
+{
+    return m_BorderColor;
+}
+
+void Pine::Graphics::NullTexture::SetCompareModeLowerEqual()
+{
+}
+
+void Pine::Graphics::NullTexture::SetMaxAnisotropy(const float value)
+{
+}
+
+std::uint32_t Pine::Graphics::NullTexture::GetId() const
+{
+    return m_Id;
+}
+
+void *Pine::Graphics::NullTexture::GetGraphicsIdentifier()
+{
+    return &m_Id;
+}
+
+int Pine::Graphics::NullTexture::GetWidth()
+{
+    return m_Width;
+}
+
+int Pine::Graphics::NullTexture::GetHeight()
+{
+    return m_Height;
+}
+
+Pine::Graphics::TextureFormat Pine::Graphics::NullTexture::GetTextureFormat()
+{
+    return m_TextureFormat;
+}
+
+Pine::Graphics::TextureDataFormat Pine::Graphics::NullTexture::GetTextureDataFormat()
+{
+    return m_TextureDataFormat;
+}
+
+void Pine::Graphics::NullTexture::GenerateMipmaps()
+{
+    m_HasMipmaps = true;
+}
+
+void Pine::Graphics::NullTexture::SetMultiSampled(bool multiSampled)
+{
+    m_IsMultiSampled = multiSampled;
+}
+
+bool Pine::Graphics::NullTexture::IsMultiSampled()
+{
+    return m_IsMultiSampled;
+}
+
+void Pine::Graphics::NullTexture::SetSamples(int samples)
+{
+    m_Samples = samples;
+}
+
+int Pine::Graphics::NullTexture::GetSamples()
+{
+    return m_Samples;
+}
+
+void Pine::Graphics::NullTexture::SetArraySize(int arraySize)
+{
+    m_ArraySize = arraySize;
+}
+
+int Pine::Graphics::NullTexture::GetArraySize()
+{
+    return m_ArraySize;
+}
+
+bool Pine::Graphics::NullTexture::HasCustomSwizzleMask()
+{
+    return m_HasCustomSwizzleMask;
+}
+
+void Pine::Graphics::NullTexture::SetSwizzleMask(SwizzleMaskChannel r, SwizzleMaskChannel g, SwizzleMaskChannel b, SwizzleMaskChannel a)
+{
+    m_SwizzleMask = { r, g, b, a };
+    m_HasCustomSwizzleMask = true;
+}
+
+void Pine::Graphics::NullTexture::ResetSwizzleMask()
+{
+    m_SwizzleMask = { SwizzleMaskChannel::Red, SwizzleMaskChannel::Green, SwizzleMaskChannel::Blue, SwizzleMaskChannel::Alpha };
+    m_HasCustomSwizzleMask = false;
+}
+
+void Pine::Graphics::NullTexture::ResetChangeTracking()
+{
+    for (auto& boundTexture : m_BoundTextures)
+    {
+        boundTexture = std::numeric_limits<std::uint32_t>::max();
+    }
+}
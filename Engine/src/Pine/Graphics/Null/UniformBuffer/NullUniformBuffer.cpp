@@ -0,0 +1,52 @@
+#include "NullUniformBuffer.hpp"
+#include "Pine/Graphics/Null/NullGraphicsAPI.hpp"
+
+namespace
+{
+    std::uint32_t m_BoundUniformBuffer = 0;
+}
+
+void Pine::Graphics::NullUniformBuffer::Bind()
+{
+    if (m_BoundUniformBuffer == m_Id)
+    {
+        return;
+    }
+
+    NullGraphicsAPI::Record(NullCommandType::BindUniformBuffer, m_Id);
+
+    m_BoundUniformBuffer = m_Id;
+}
+
+void Pine::Graphics::NullUniformBuffer::Dispose()
+{
+    if (m_BoundUniformBuffer == m_Id)
+    {
+        m_BoundUniformBuffer = 0;
+    }
+}
+
+void Pine::Graphics::NullUniformBuffer::Create(std::size_t size, int bindingIndex)
+{
+    m_Id = NullGraphicsAPI::GenerateId();
+    m_BindingIndex = bindingIndex;
+
+    NullGraphicsAPI::Record(NullCommandType::BindUniformBuffer, m_Id);
+
+    m_BoundUniformBuffer = m_Id;
+}
+
+void Pine::Graphics::NullUniformBuffer::UploadData(void* data, std::size_t size, std::size_t offset)
+{
+    NullGraphicsAPI::Record(NullCommandType::UploadUniformBuffer, m_Id, static_cast<std::uint32_t>(size), static_cast<std::uint32_t>(offset));
+}
+
+int Pine::Graphics::NullUniformBuffer::GetBindIndex() const
+{
+    return m_BindingIndex;
+}
+
+void Pine::Graphics::NullUniformBuffer::ResetChangeTracking()
+{
+    m_BoundUniformBuffer = 0;
+}
@@ -0,0 +1,52 @@
+#include "NullUniformVariable.hpp"
+#include "Pine/Graphics/Null/NullGraphicsAPI.hpp"
+
+Pine::Graphics::NullUniformVariable::NullUniformVariable(std::uint32_t programId)
+    : m_ProgramId(programId)
+{
+}
+
+void Pine::Graphics::NullUniformVariable::LoadInteger(int value)
+{
+    NullGraphicsAPI::Record(NullCommandType::LoadUniform, m_ProgramId, sizeof(value));
+}
+
+void Pine::Graphics::NullUniformVariable::LoadFloat(float value)
+{
+    NullGraphicsAPI::Record(NullCommandType::LoadUniform, m_ProgramId, sizeof(value));
+}
+
+void Pine::Graphics::NullUniformVariable::LoadVector2(const Vector2f& value)
+{
+    NullGraphicsAPI::Record(NullCommandType::LoadUniform, m_ProgramId, sizeof(value));
+}
+
+void Pine::Graphics::NullUniformVariable::LoadVector3(const Vector3f& value)
+{
+    NullGraphicsAPI::Record(NullCommandType::LoadUniform, m_ProgramId, sizeof(value));
+}
+
+void Pine::Graphics::NullUniformVariable::LoadVector4(const Vector4f& value)
+{
+    NullGraphicsAPI::Record(NullCommandType::LoadUniform, m_ProgramId, sizeof(value));
+}
+
+void Pine::Graphics::NullUniformVariable::LoadVector2(const Vector2i& value)
+{
+    NullGraphicsAPI::Record(NullCommandType::LoadUniform, m_ProgramId, sizeof(value));
+}
+
+void Pine::Graphics::NullUniformVariable::LoadVector3(const Vector3i& value)
+{
+    NullGraphicsAPI::Record(NullCommandType::LoadUniform, m_ProgramId, sizeof(value));
+}
+
+void Pine::Graphics::NullUniformVariable::LoadVector4(const Vector4i& value)
+{
+    NullGraphicsAPI::Record(NullCommandType::LoadUniform, m_ProgramId, sizeof(value));
+}
+
+void Pine::Graphics::NullUniformVariable::LoadMatrix4(const Matrix4f& value)
+{
+    NullGraphicsAPI::Record(NullCommandType::LoadUniform, m_ProgramId, sizeof(value));
+}
@@ -0,0 +1,30 @@
+#pragma once
+#include <cstdint>
+
+#include "Pine/Graphics/Interfaces/IUniformVariable.hpp"
+
+namespace Pine::Graphics
+{
+
+    class NullUniformVariable : public IUniformVariable
+    {
+    private:
+        std::uint32_t m_ProgramId = 0;
+    public:
+        explicit NullUniformVariable(std::uint32_t programId);
+
+        void LoadInteger(int value) override;
+        void LoadFloat(float value) override;
+
+        void LoadVector2(const Vector2f& value) override;
+        void LoadVector3(const Vector3f& value) override;
+        void LoadVector4(const Vector4f& value) override;
+
+        void LoadVector2(const Vector2i& value) override;
+        void LoadVector3(const Vector3i& value) override;
+        void LoadVector4(const Vector4i& value) override;
+
+        void LoadMatrix4(const Matrix4f& value) override;
+    };
+
+}
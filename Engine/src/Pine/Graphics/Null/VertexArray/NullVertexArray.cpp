@@ -0,0 +1,65 @@
+#include "NullVertexArray.hpp"
+#include "Pine/Graphics/Null/NullGraphicsAPI.hpp"
+#include "Pine/Graphics/Null/VertexBuffer/NullVertexBuffer.hpp"
+
+Pine::Graphics::NullVertexArray::NullVertexArray()
+    : m_Id(NullGraphicsAPI::GenerateId())
+{
+}
+
+void Pine::Graphics::NullVertexArray::Bind()
+{
+    NullGraphicsAPI::Record(NullCommandType::BindVertexArray, m_Id);
+}
+
+void Pine::Graphics::NullVertexArray::Dispose()
+{
+    for (auto buffer : m_Buffers)
+        delete buffer;
+
+    m_Buffers.clear();
+}
+
+Pine::Graphics::NullVertexBuffer* Pine::Graphics::NullVertexArray::CreateArrayBuffer(const void* data, std::size_t size, int binding)
+{
+    const auto buffer = new NullVertexBuffer(NullGraphicsAPI::GenerateId(), binding);
+
+    m_Buffers.push_back(buffer);
+
+    buffer->Bind();
+
+    // Only count the buffer as an upload if there was any data, otherwise it's just allocated.
+    NullGraphicsAPI::Record(NullCommandType::UploadVertexBuffer, buffer->GetId(), data != nullptr ? static_cast<std::uint32_t>(size) : 0);
+
+    return buffer;
+}
+
+Pine::Graphics::IVertexBuffer* Pine::Graphics::NullVertexArray::CreateFloatArrayBuffer(std::size_t size, int binding, int vecSize, BufferUsageHint usageHint)
+{
+    return CreateArrayBuffer(nullptr, size, binding);
+}
+
+Pine::Graphics::IVertexBuffer* Pine::Graphics::NullVertexArray::CreateIntegerArrayBuffer(std::size_t size, int binding, int vecSize, BufferUsageHint usageHint)
+{
+    return CreateArrayBuffer(nullptr, size, binding);
+}
+
+Pine::Graphics::IVertexBuffer* Pine::Graphics::NullVertexArray::StoreFloatArrayBuffer(float *data, std::size_t size, int binding, int vecSize, BufferUsageHint hint)
+{
+    return CreateArrayBuffer(data, size, binding);
+}
+
+Pine::Graphics::IVertexBuffer* Pine::Graphics::NullVertexArray::StoreIntArrayBuffer(float *data, std::size_t size, int binding, int vecSize, BufferUsageHint hint)
+{
+    return CreateArrayBuffer(data, size, binding);
+}
+
+void Pine::Graphics::NullVertexArray::StoreElementArrayBuffer(std::uint32_t *data, std::size_t size)
+{
+    NullGraphicsAPI::Record(NullCommandType::UploadElementBuffer, m_Id, static_cast<std::uint32_t>(size));
+}
+
+std::uint32_t Pine::Graphics::NullVertexArray::GetId() const
+{
+    return m_Id;
+}
@@ -0,0 +1,36 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "Pine/Graphics/Interfaces/IVertexArray.hpp"
+
+namespace Pine::Graphics
+{
+    class NullVertexBuffer;
+
+    // Null implementation of a vertex array, the vertex buffers are owned by the array.
+    class NullVertexArray : public IVertexArray
+    {
+    private:
+        std::uint32_t m_Id = 0;
+
+        std::vector<NullVertexBuffer*> m_Buffers;
+
+        NullVertexBuffer* CreateArrayBuffer(const void* data, std::size_t size, int binding);
+    public:
+        NullVertexArray();
+
+        void Bind() override;
+        void Dispose() override;
+
+        IVertexBuffer* CreateFloatArrayBuffer(std::size_t size, int binding, int vecSize, BufferUsageHint usageHint) override;
+        IVertexBuffer* CreateIntegerArrayBuffer(std::size_t size, int binding, int vecSize, BufferUsageHint usageHint) override;
+
+        IVertexBuffer* StoreFloatArrayBuffer(float *data, std::size_t size, int binding, int vecSize, BufferUsageHint hint) override;
+        IVertexBuffer* StoreIntArrayBuffer(float *data, std::size_t size, int binding, int vecSize, BufferUsageHint hint) override;
+        void StoreElementArrayBuffer(std::uint32_t *data, std::size_t size) override;
+
+        std::uint32_t GetId() const;
+    };
+
+}
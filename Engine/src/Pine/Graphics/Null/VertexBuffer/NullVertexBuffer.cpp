@@ -0,0 +1,27 @@
+#include "NullVertexBuffer.hpp"
+#include "Pine/Graphics/Null/NullGraphicsAPI.hpp"
+
+Pine::Graphics::NullVertexBuffer::NullVertexBuffer(std::uint32_t id, std::uint32_t binding)
+    : m_Id(id),
+      m_Binding(binding)
+{
+}
+
+void Pine::Graphics::NullVertexBuffer::Bind()
+{
+    NullGraphicsAPI::Record(NullCommandType::BindVertexBuffer, m_Id);
+}
+
+void Pine::Graphics::NullVertexBuffer::UploadData(const void* data, std::size_t size, std::size_t offset)
+{
+    NullGraphicsAPI::Record(NullCommandType::UploadVertexBuffer, m_Id, static_cast<std::uint32_t>(size), static_cast<std::uint32_t>(offset));
+}
+
+void Pine::Graphics::NullVertexBuffer::SetDivisor(VertexBufferDivisor mode, int instanceCount)
+{
+}
+
+std::uint32_t Pine::Graphics::NullVertexBuffer::GetId() const
+{
+    return m_Id;
+}
@@ -0,0 +1,25 @@
+#pragma once
+#include <cstdint>
+
+#include "Pine/Graphics/Interfaces/IVertexBuffer.hpp"
+
+namespace Pine::Graphics
+{
+
+    class NullVertexBuffer : public IVertexBuffer
+    {
+    private:
+        std::uint32_t m_Id = 0;
+        std::uint32_t m_Binding = 0;
+    public:
+        explicit NullVertexBuffer(std::uint32_t id, std::uint32_t bindingIndex);
+
+        void Bind() override;
+        void UploadData(const void* data, std::size_t size, std::size_t offset) override;
+
+        void SetDivisor(VertexBufferDivisor mode, int instanceCount) override;
+
+        std::uint32_t GetId() const;
+    };
+
+}
@@ -5,6 +5,7 @@
 #include "Pine/Graphics/OpenGL/VertexArray/GLVertexArray.hpp"
 #include "Pine/Graphics/OpenGL/UniformBuffer/GLUniformBuffer.hpp"
 #include "Pine/Core/Log/Log.hpp"
+#include "Pine/Performance/Performance.hpp"
 #include <GL/glew.h>
 #include <stdexcept>
 
@@ -143,7 +144,7 @@ namespace
 			return;
 		}
 
-		Pine::Log::Error(fmt::format("OpenGL 0x{:x}: {}", type, message));
+		Pine::Log::Error("OpenGL 0x{:x}: {}", type, message);
 	}
 
 }
@@ -212,6 +213,8 @@ bool Pine::Graphics::OpenGL::Setup()
 	// TODO: Figure out how this exactly works, using GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS doesn't work.
 	m_SupportedTextureSlots = 16;
 
+	glGetIntegerv(GL_MAX_UNIFORM_BLOCK_SIZE, &m_MaxUniformBlockSize);
+
 	glEnable(GL_BLEND);
 	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
@@ -261,21 +264,33 @@ void Pine::Graphics::OpenGL::DestroyShaderProgram(IShaderProgram* program)
 void Pine::Graphics::OpenGL::DrawArrays(RenderMode mode, int count)
 {
 	glDrawArrays(TranslateRenderMode(mode), 0, count);
+
+	PINE_PF_COUNTER("Draw calls", 1);
+	PINE_PF_COUNTER("Drawn vertices", count);
 }
 
 void Pine::Graphics::OpenGL::DrawElements(RenderMode mode, int count)
 {
 	glDrawElements(TranslateRenderMode(mode), count, GL_UNSIGNED_INT, nullptr);
+
+	PINE_PF_COUNTER("Draw calls", 1);
+	PINE_PF_COUNTER("Drawn vertices", count);
 }
 
 void Pine::Graphics::OpenGL::DrawArraysInstanced(RenderMode mode, int count, int instanceCount)
 {
 	glDrawArraysInstanced(TranslateRenderMode(mode), 0, count, instanceCount);
+
+	PINE_PF_COUNTER("Draw calls", 1);
+	PINE_PF_COUNTER("Drawn vertices", static_cast<std::int64_t>(count) * instanceCount);
 }
 
 void Pine::Graphics::OpenGL::DrawElementsInstanced(RenderMode mode, int count, int instanceCount)
 {
 	glDrawElementsInstanced(TranslateRenderMode(mode), count, GL_UNSIGNED_INT, nullptr, instanceCount);
+
+	PINE_PF_COUNTER("Draw calls", 1);
+	PINE_PF_COUNTER("Drawn vertices", static_cast<std::int64_t>(count) * instanceCount);
 }
 
 int Pine::Graphics::OpenGL::GetSupportedTextureSlots()
@@ -283,6 +298,11 @@ int Pine::Graphics::OpenGL::GetSupportedTextureSlots()
 	return m_SupportedTextureSlots;
 }
 
+int Pine::Graphics::OpenGL::GetMaxUniformBlockSize()
+{
+	return m_MaxUniformBlockSize;
+}
+
 Pine::Graphics::IFrameBuffer* Pine::Graphics::OpenGL::CreateFrameBuffer()
 {
 	return new GLFrameBuffer();
@@ -13,6 +13,7 @@ namespace Pine::Graphics
         std::string m_GraphicsAdapter;
 
         int m_SupportedTextureSlots = 0;
+        int m_MaxUniformBlockSize = 0;
     public:
         bool Setup() override;
         void Shutdown() override;
@@ -55,6 +56,7 @@ namespace Pine::Graphics
         void DestroyTexture(ITexture* texture) override;
 
         int GetSupportedTextureSlots() override;
+        int GetMaxUniformBlockSize() override;
 
         IShaderProgram* CreateShaderProgram() override;
         void DestroyShaderProgram(IShaderProgram* program) override;
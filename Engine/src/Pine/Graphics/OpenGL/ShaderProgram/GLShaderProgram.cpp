@@ -170,7 +170,7 @@ Pine::Graphics::IUniformVariable *Pine::Graphics::GLShaderProgram::GetUniformVar
             // Insert an empty pointer to indicate that we have already tried to find the variable.
             m_UniformVariables[name] = nullptr;
 
-            Log::Warning("[Renderer] Failed to find uniform variable: " + name);
+            Log::Warning("[Renderer] Failed to find uniform variable: {}", name);
 
             return nullptr;
         }
@@ -186,7 +186,7 @@ bool Pine::Graphics::GLShaderProgram::AttachUniformBuffer(IUniformBuffer*buffer,
 
     if (0 > bufferIndex)
     {
-        Log::Error(fmt::format("Failed to find uniform buffer {}", bufferName));
+        Log::Error("Failed to find uniform buffer {}", bufferName);
 
         return false;
     }
@@ -1,5 +1,6 @@
 #include "GLTexture.hpp"
 #include "Pine/Core/Log/Log.hpp"
+#include "Pine/Performance/Performance.hpp"
 
 #include <GL/glew.h>
 #include <stdexcept>
@@ -210,6 +211,25 @@ void Pine::Graphics::GLTexture::CopyTextureData(ITexture *texture,
     */
 }
 
+void Pine::Graphics::GLTexture::CopyTextureSubData(ITexture* texture, Vector2i position)
+{
+    const auto srcId = *reinterpret_cast<std::uint32_t *>(texture->GetGraphicsIdentifier());
+
+    PINE_PF_COUNTER("Texture copies", 1);
+
+    glCopyImageSubData(srcId,
+                       GL_TEXTURE_2D,
+                       0,
+                       0, 0, 0,
+                       m_Id,
+                       TranslateTextureType(m_Type, m_IsMultiSampled),
+                       0,
+                       position.x, position.y, 0,
+                       texture->GetWidth(),
+                       texture->GetHeight(),
+                       1);
+}
+
 void Pine::Graphics::GLTexture::Dispose()
 {
     glDeleteTextures(1, &m_Id);
@@ -219,6 +239,8 @@ void Pine::Graphics::GLTexture::UploadTextureData(int width, int height, Texture
 {
     auto [openglFormat, openglInternalFormat] = TranslateOpenGLTextureFormat(format);
 
+    PINE_PF_COUNTER("Texture uploads", 1);
+
     const auto openglType = TranslateTextureType(m_Type, m_IsMultiSampled);
 
     if (m_Type != TextureType::Texture2DArray)
@@ -258,6 +280,20 @@ void Pine::Graphics::GLTexture::UploadTextureData(int width, int height, Texture
     m_TextureDataFormat = dataFormat;
 }
 
+void Pine::Graphics::GLTexture::UploadTextureSubData(Vector2i position, Vector2i size, TextureFormat format, TextureDataFormat dataFormat, void* data)
+{
+    auto [openglFormat, openglInternalFormat] = TranslateOpenGLTextureFormat(format);
+
+    PINE_PF_COUNTER("Texture uploads", 1);
+
+    // Rows of single channel textures aren't necessarily a multiple of 4 bytes long.
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+    glTexSubImage2D(TranslateTextureType(m_Type, m_IsMultiSampled), 0, position.x, position.y, size.x, size.y, openglFormat, TranslateTextureDataFormatType(dataFormat), data);
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+}
+
 Pine::Graphics::TextureType Pine::Graphics::GLTexture::GetType()
 {
     return m_Type;
@@ -63,7 +63,9 @@ namespace Pine::Graphics
         void ResetSwizzleMask() override;
 
         void UploadTextureData(int width, int height, TextureFormat format, TextureDataFormat dataFormat, void* data) override;
+        void UploadTextureSubData(Vector2i position, Vector2i size, TextureFormat format, TextureDataFormat dataFormat, void* data) override;
         void CopyTextureData(ITexture* texture, TextureUploadTarget textureUploadTarget, Vector4i srcRect = Vector4i(-1), Vector2i dstPos = Vector2i(0)) override;
+        void CopyTextureSubData(ITexture* texture, Vector2i position) override;
 
         void GenerateMipmaps() override;
 
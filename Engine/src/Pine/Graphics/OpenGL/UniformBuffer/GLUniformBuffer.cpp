@@ -1,4 +1,5 @@
 #include "GLUniformBuffer.hpp"
+#include "Pine/Performance/Performance.hpp"
 #include <GL/glew.h>
 #include <limits>
 
@@ -38,6 +39,9 @@ void Pine::Graphics::GLUniformBuffer::Create(std::size_t size, int bindingIndex)
 void Pine::Graphics::GLUniformBuffer::UploadData(void* data, std::size_t size, std::size_t offset)
 {
     glBufferSubData(GL_UNIFORM_BUFFER, static_cast<std::int32_t>(offset), static_cast<std::int32_t>(size), data);
+
+    PINE_PF_COUNTER("Buffer uploads", 1);
+    PINE_PF_COUNTER("Buffer upload bytes", static_cast<std::int64_t>(size));
 }
 
 int Pine::Graphics::GLUniformBuffer::GetBindIndex() const
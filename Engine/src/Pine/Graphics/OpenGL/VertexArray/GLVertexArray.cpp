@@ -1,5 +1,6 @@
 #include "GLVertexArray.hpp"
 #include "Pine/Graphics/OpenGL/VertexBuffer/GLVertexBuffer.hpp"
+#include "Pine/Performance/Performance.hpp"
 
 #include <GL/glew.h>
 #include <stdexcept>
@@ -63,6 +64,9 @@ void Pine::Graphics::GLVertexArray::StoreElementArrayBuffer(std::uint32_t *data,
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffer);
     glBufferData(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLsizeiptr>(size), reinterpret_cast<void*>(data), GL_STATIC_DRAW);
 
+    PINE_PF_COUNTER("Buffer uploads", 1);
+    PINE_PF_COUNTER("Buffer upload bytes", static_cast<std::int64_t>(size));
+
     // For element array buffers we don't have to do any binding stuff.
 }
 
@@ -1,4 +1,5 @@
 #include "GLVertexBuffer.hpp"
+#include "Pine/Performance/Performance.hpp"
 #include <GL/glew.h>
 
 Pine::Graphics::GLVertexBuffer::GLVertexBuffer(std::uint32_t id, std::uint32_t binding)
@@ -15,6 +16,9 @@ void Pine::Graphics::GLVertexBuffer::Bind()
 void Pine::Graphics::GLVertexBuffer::UploadData(const void* data, std::size_t size, std::size_t offset)
 {
     glBufferSubData(GL_ARRAY_BUFFER, static_cast<std::int32_t>(offset), static_cast<std::int32_t>(size), data);
+
+    PINE_PF_COUNTER("Buffer uploads", 1);
+    PINE_PF_COUNTER("Buffer upload bytes", static_cast<std::int64_t>(size));
 }
 
 void Pine::Graphics::GLVertexBuffer::SetDivisor(VertexBufferDivisor mode, int instanceCount)
@@ -0,0 +1,22 @@
+﻿#include "AllocationScope.hpp"
+
+namespace
+{
+    thread_local const Pine::Performance::AllocationTag* m_CurrentTag = nullptr;
+}
+
+Pine::AllocationScope::AllocationScope(const Performance::AllocationTag* tag)
+{
+    m_PreviousTag = m_CurrentTag;
+    m_CurrentTag = tag;
+}
+
+Pine::AllocationScope::~AllocationScope()
+{
+    m_CurrentTag = m_PreviousTag;
+}
+
+const Pine::Performance::AllocationTag* Pine::AllocationScope::GetCurrentTag()
+{
+    return m_CurrentTag;
+}
@@ -0,0 +1,25 @@
+﻿#pragma once
+
+namespace Pine
+{
+    namespace Performance
+    {
+        struct AllocationTag;
+    }
+
+    // Makes the calling thread count its heap allocations towards the tag until the scope ends.
+    class AllocationScope
+    {
+    private:
+        const Performance::AllocationTag* m_PreviousTag;
+    public:
+        explicit AllocationScope(const Performance::AllocationTag* tag);
+        ~AllocationScope();
+
+        AllocationScope(const AllocationScope&) = delete;
+        AllocationScope& operator=(const AllocationScope&) = delete;
+
+        // The tag of the innermost allocation scope of the calling thread, or nullptr if there is none.
+        static const Performance::AllocationTag* GetCurrentTag();
+    };
+}
\ No newline at end of file
@@ -0,0 +1,111 @@
+#include "Pine/Performance/Performance.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// Replaces the global operator new and delete, so heap allocations can be counted per subsystem. The
+// allocations themselves are left to malloc, and tracking costs a single relaxed load while disabled.
+
+namespace
+{
+    std::atomic<bool> m_AllocationTrackingEnabled = false;
+
+    // Set while an allocation is being counted, the profiler allocates as well, which shouldn't be counted or recurse.
+    thread_local bool m_InsideAllocationHook = false;
+
+    void* Allocate(std::size_t size)
+    {
+        const auto pointer = std::malloc(size == 0 ? 1 : size);
+
+        if (pointer == nullptr)
+        {
+            throw std::bad_alloc();
+        }
+
+        if (m_AllocationTrackingEnabled.load(std::memory_order_relaxed) && !m_InsideAllocationHook)
+        {
+            m_InsideAllocationHook = true;
+
+            Pine::Performance::TrackAllocation(size);
+
+            m_InsideAllocationHook = false;
+        }
+
+        return pointer;
+    }
+}
+
+void Pine::Performance::SetAllocationTrackingEnabled(bool value)
+{
+    m_AllocationTrackingEnabled.store(value, std::memory_order_relaxed);
+}
+
+bool Pine::Performance::IsAllocationTrackingEnabled()
+{
+    return m_AllocationTrackingEnabled.load(std::memory_order_relaxed);
+}
+
+void* operator new(std::size_t size)
+{
+    return Allocate(size);
+}
+
+void* operator new[](std::size_t size)
+{
+    return Allocate(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    try
+    {
+        return Allocate(size);
+    }
+    catch (...)
+    {
+        return nullptr;
+    }
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    try
+    {
+        return Allocate(size);
+    }
+    catch (...)
+    {
+        return nullptr;
+    }
+}
+
+void operator delete(void* pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, const std::nothrow_t&) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept
+{
+    std::free(pointer);
+}
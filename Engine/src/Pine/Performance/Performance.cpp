@@ -1,22 +1,711 @@
 ﻿#include "Performance.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <mutex>
+
+#include "Pine/Core/Log/Log.hpp"
+
+using namespace Pine;
+
 namespace
 {
-    std::vector<Pine::Performance::TrackedScope*> m_TrackedScopes;
+    // The number of events each thread can buffer between two collections, has to be a power of two.
+    constexpr std::uint64_t EventBufferSize = 1 << 16;
+
+    struct ScopeEvent
+    {
+        std::uint64_t Timestamp;
+        const Performance::TrackedScope* Scope;
+        bool Begin;
+    };
+
+    // Every thread writes its events into its own ring buffer, which the main thread empties at the end
+    // of each frame. There is a single producer and a single consumer, so the indices are all the
+    // synchronization needed.
+    struct ThreadBuffer
+    {
+        std::unique_ptr<ScopeEvent[]> Events = std::make_unique<ScopeEvent[]>(EventBufferSize);
+
+        std::atomic<std::uint64_t> WriteIndex = 0;
+        std::atomic<std::uint64_t> ReadIndex = 0;
+
+        std::atomic<std::uint64_t> DroppedEvents = 0;
+
+        // Only ever added to by the owning thread, and emptied by the main thread at the end of a frame.
+        std::array<std::atomic<std::int64_t>, Performance::MaxCounters> Counters = {};
+
+        // Only used by the owning thread, the number of scopes with a recorded begin event that haven't
+        // ended yet, and the number of scopes that were dropped.
+        std::uint32_t OpenDepth = 0;
+        std::uint32_t DroppedDepth = 0;
+
+        // The position of the buffer in m_ThreadBuffers, also used as the thread id in exported traces.
+        std::uint32_t Index = 0;
+
+        // Protected by m_ThreadMutex.
+        std::string Name;
+    };
+
+    // A scope with a begin event, which is waiting for its end event while collecting.
+    struct OpenScope
+    {
+        std::uint32_t Node;
+        std::uint64_t Timestamp;
+    };
+
+    struct CapturedScope
+    {
+        const Performance::TrackedScope* Scope;
+        std::uint32_t Thread;
+        std::uint64_t Start;
+        std::uint64_t End;
+    };
+
+    std::mutex m_TrackedScopesMutex;
+    std::vector<Performance::TrackedScope*> m_TrackedScopes;
+
+    std::mutex m_ThreadMutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> m_ThreadBuffers;
+
+    thread_local ThreadBuffer* m_CurrentThreadBuffer = nullptr;
+
+    // Allocations made while the profiler holds one of its locks aren't counted, as counting them could
+    // end up taking the same lock again.
+    thread_local std::uint32_t m_AllocationTrackingSuspended = 0;
+
+    struct SuspendAllocationTracking
+    {
+        SuspendAllocationTracking()
+        {
+            m_AllocationTrackingSuspended++;
+        }
+
+        ~SuspendAllocationTracking()
+        {
+            m_AllocationTrackingSuspended--;
+        }
+    };
+
+    std::mutex m_CountersMutex;
+    std::vector<Performance::Counter*> m_Counters;
+
+    // Storage for the names of the counters created for allocation tags.
+    std::deque<std::string> m_CounterNames;
+
+    std::atomic<bool> m_Enabled = true;
+
+    // Everything below is only used by the main thread.
+    std::vector<Performance::ProfilerThread> m_Threads;
+    std::vector<std::vector<OpenScope>> m_OpenScopes;
+
+    std::array<float, Performance::HistorySize> m_FrameTimes = {};
+    std::uint64_t m_FrameCount = 0;
+    std::uint64_t m_FrameStart = 0;
+    std::uint32_t m_FrameThread = 0;
+
+    std::uint64_t m_DroppedEvents = 0;
+
+    // Captures kept in memory stop once they reach this many scopes, which is around 128 MB worth. Captures
+    // streamed to a file write their events out every CaptureChunkSize scopes instead.
+    constexpr std::size_t MaxCapturedScopes = 1 << 22;
+    constexpr std::size_t CaptureChunkSize = 1 << 16;
+
+    bool m_Capturing = false;
+    std::uint64_t m_CaptureStart = 0;
+    std::vector<CapturedScope> m_CapturedScopes;
+    std::vector<std::uint64_t> m_CapturedFrames;
+
+    std::ofstream m_CaptureStream;
+    bool m_CaptureStreamEmpty = true;
+
+    std::uint64_t GetTimestamp()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    ThreadBuffer* GetThreadBuffer()
+    {
+        if (m_CurrentThreadBuffer == nullptr)
+        {
+            SuspendAllocationTracking suspendTracking;
+
+            std::unique_lock lock(m_ThreadMutex);
+
+            auto buffer = std::make_unique<ThreadBuffer>();
+
+            buffer->Index = static_cast<std::uint32_t>(m_ThreadBuffers.size());
+            buffer->Name = "Thread #" + std::to_string(buffer->Index);
+
+            m_CurrentThreadBuffer = buffer.get();
+            m_ThreadBuffers.push_back(std::move(buffer));
+        }
+
+        return m_CurrentThreadBuffer;
+    }
+
+    void PushEvent(const Performance::TrackedScope* scope, bool begin)
+    {
+        const auto buffer = GetThreadBuffer();
+
+        if (begin)
+        {
+            const auto writeIndex = buffer->WriteIndex.load(std::memory_order_relaxed);
+            const auto used = writeIndex - buffer->ReadIndex.load(std::memory_order_acquire);
+
+            // Leave room for the end events of every open scope, so the events always stay balanced.
+            if (buffer->DroppedDepth > 0 || used + buffer->OpenDepth + 2 > EventBufferSize)
+            {
+                buffer->DroppedDepth++;
+                buffer->DroppedEvents.fetch_add(1, std::memory_order_relaxed);
+
+                return;
+            }
+
+            buffer->OpenDepth++;
+        }
+        else
+        {
+            if (buffer->DroppedDepth > 0)
+            {
+                buffer->DroppedDepth--;
+                buffer->DroppedEvents.fetch_add(1, std::memory_order_relaxed);
+
+                return;
+            }
+
+            buffer->OpenDepth--;
+        }
+
+        const auto writeIndex = buffer->WriteIndex.load(std::memory_order_relaxed);
+
+        buffer->Events[writeIndex & (EventBufferSize - 1)] = { GetTimestamp(), scope, begin };
+        buffer->WriteIndex.store(writeIndex + 1, std::memory_order_release);
+    }
+
+    std::uint32_t GetChildNode(Performance::ProfilerThread& thread, std::uint32_t parent, const Performance::TrackedScope* scope)
+    {
+        for (const auto child : thread.Nodes[parent].Children)
+        {
+            if (thread.Nodes[child].Scope == scope)
+            {
+                return child;
+            }
+        }
+
+        const auto index = static_cast<std::uint32_t>(thread.Nodes.size());
+
+        Performance::ProfilerNode node;
+
+        node.Scope = scope;
+        node.Parent = parent;
+
+        thread.Nodes.push_back(node);
+        thread.Nodes[parent].Children.push_back(index);
+
+        return index;
+    }
+
+    void ProcessEvent(std::uint32_t threadIndex, const ScopeEvent& event)
+    {
+        auto& thread = m_Threads[threadIndex];
+        auto& openScopes = m_OpenScopes[threadIndex];
+
+        if (event.Begin)
+        {
+            const auto parent = openScopes.empty() ? 0 : openScopes.back().Node;
+
+            openScopes.push_back({ GetChildNode(thread, parent, event.Scope), event.Timestamp });
+
+            return;
+        }
+
+        if (openScopes.empty())
+        {
+            return;
+        }
+
+        const auto openScope = openScopes.back();
+
+        openScopes.pop_back();
+
+        auto& node = thread.Nodes[openScope.Node];
+
+        node.FrameTime += static_cast<double>(event.Timestamp - openScope.Timestamp) / 1e6;
+        node.FrameCalls++;
+
+        if (m_Capturing && openScope.Timestamp >= m_CaptureStart)
+        {
+            m_CapturedScopes.push_back({ event.Scope, threadIndex, openScope.Timestamp, event.Timestamp });
+        }
+    }
+
+    void CollectEvents()
+    {
+        std::unique_lock lock(m_ThreadMutex);
+
+        for (std::uint32_t i = 0; i < m_ThreadBuffers.size(); i++)
+        {
+            auto& buffer = *m_ThreadBuffers[i];
+
+            if (i >= m_Threads.size())
+            {
+                m_Threads.emplace_back().Nodes.emplace_back();
+                m_OpenScopes.emplace_back();
+            }
+
+            m_Threads[i].Name = buffer.Name;
+
+            const auto readIndex = buffer.ReadIndex.load(std::memory_order_relaxed);
+            const auto writeIndex = buffer.WriteIndex.load(std::memory_order_acquire);
+
+            for (auto index = readIndex; index < writeIndex; index++)
+            {
+                ProcessEvent(i, buffer.Events[index & (EventBufferSize - 1)]);
+            }
+
+            buffer.ReadIndex.store(writeIndex, std::memory_order_release);
+
+            m_DroppedEvents += buffer.DroppedEvents.exchange(0, std::memory_order_relaxed);
+        }
+    }
+
+    void CollectCounters(std::uint32_t historyIndex)
+    {
+        std::unique_lock threadLock(m_ThreadMutex);
+        std::unique_lock counterLock(m_CountersMutex);
+
+        for (const auto counter : m_Counters)
+        {
+            std::int64_t value = 0;
+
+            for (const auto& buffer : m_ThreadBuffers)
+            {
+                value += buffer->Counters[counter->Id].exchange(0, std::memory_order_relaxed);
+            }
+
+            counter->Value = value;
+            counter->History[historyIndex] = static_cast<float>(value);
+        }
+    }
+
+    void WriteEscaped(std::ofstream& stream, const char* text)
+    {
+        for (; *text != '\0'; text++)
+        {
+            if (*text == '"' || *text == '\\')
+            {
+                stream << '\\';
+            }
+
+            stream << *text;
+        }
+    }
+
+    // Chrome expects timestamps in microseconds.
+    double ToTraceMicroseconds(std::uint64_t timestamp)
+    {
+        return static_cast<double>(timestamp - m_CaptureStart) / 1e3;
+    }
+
+    void BeginTrace(std::ofstream& stream)
+    {
+        stream << std::fixed;
+        stream.precision(3);
+
+        stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    }
+
+    void BeginTraceEvent(std::ofstream& stream, bool& empty)
+    {
+        if (!empty)
+        {
+            stream << ",\n";
+        }
+
+        empty = false;
+    }
+
+    void WriteTraceThreadNames(std::ofstream& stream, bool& empty)
+    {
+        for (std::uint32_t i = 0; i < m_Threads.size(); i++)
+        {
+            BeginTraceEvent(stream, empty);
+
+            stream << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << i << ",\"args\":{\"name\":\"";
+            WriteEscaped(stream, m_Threads[i].Name.c_str());
+            stream << "\"}}";
+        }
+    }
+
+    // Writes the frames and scopes captured so far.
+    void WriteTraceEvents(std::ofstream& stream, bool& empty)
+    {
+        for (const auto frame : m_CapturedFrames)
+        {
+            BeginTraceEvent(stream, empty);
+
+            stream << "{\"name\":\"Frame\",\"ph\":\"i\",\"s\":\"g\",\"pid\":1,\"tid\":" << m_FrameThread << ",\"ts\":" << ToTraceMicroseconds(frame) << "}";
+        }
+
+        for (const auto& scope : m_CapturedScopes)
+        {
+            BeginTraceEvent(stream, empty);
+
+            stream << "{\"name\":\"";
+            WriteEscaped(stream, scope.Scope->Name);
+            stream << "\",\"cat\":\"pine\",\"ph\":\"X\",\"pid\":1,\"tid\":" << scope.Thread
+                   << ",\"ts\":" << ToTraceMicroseconds(scope.Start)
+                   << ",\"dur\":" << static_cast<double>(scope.End - scope.Start) / 1e3 << "}";
+        }
+    }
+
+    void EndTrace(std::ofstream& stream)
+    {
+        stream << "]}\n";
+    }
+
+    // Either writes the captured events out to the capture stream, or stops the capture if it's kept in memory.
+    void LimitCapture()
+    {
+        if (m_CaptureStream.is_open())
+        {
+            if (m_CapturedScopes.size() < CaptureChunkSize)
+            {
+                return;
+            }
+
+            WriteTraceEvents(m_CaptureStream, m_CaptureStreamEmpty);
+
+            m_CapturedScopes.clear();
+            m_CapturedFrames.clear();
+
+            return;
+        }
+
+        if (m_CapturedScopes.size() >= MaxCapturedScopes)
+        {
+            m_Capturing = false;
+
+            Log::Warning("[Performance] The capture reached {} scopes and was stopped, stream longer captures to a file instead.", MaxCapturedScopes);
+        }
+    }
 }
 
-Pine::Performance::TrackedScope* Pine::Performance::CreateTrackedScope(const char* name)
+Performance::TrackedScope* Performance::CreateTrackedScope(const char* name)
 {
+    std::unique_lock lock(m_TrackedScopesMutex);
+
     auto trackedScope = new TrackedScope();
 
     trackedScope->Name = name;
+    trackedScope->Id = static_cast<std::uint32_t>(m_TrackedScopes.size());
 
     m_TrackedScopes.push_back(trackedScope);
 
     return trackedScope;
 }
 
-const std::vector<Pine::Performance::TrackedScope*>& Pine::Performance::GetTrackedScopes()
+const std::vector<Performance::TrackedScope*>& Performance::GetTrackedScopes()
 {
     return m_TrackedScopes;
 }
+
+void Performance::SetThreadName(const std::string& name)
+{
+    const auto buffer = GetThreadBuffer();
+
+    std::unique_lock lock(m_ThreadMutex);
+
+    buffer->Name = name;
+}
+
+void Performance::BeginScope(const TrackedScope* scope)
+{
+    PushEvent(scope, true);
+}
+
+void Performance::EndScope(const TrackedScope* scope)
+{
+    PushEvent(scope, false);
+}
+
+void Performance::BeginFrame()
+{
+    m_FrameStart = GetTimestamp();
+    m_FrameThread = GetThreadBuffer()->Index;
+
+    if (m_Capturing)
+    {
+        m_CapturedFrames.push_back(m_FrameStart);
+    }
+}
+
+void Performance::EndFrame()
+{
+    const auto historyIndex = m_FrameCount % HistorySize;
+
+    m_FrameTimes[historyIndex] = static_cast<float>(static_cast<double>(GetTimestamp() - m_FrameStart) / 1e6);
+
+    CollectEvents();
+    CollectCounters(historyIndex);
+
+    if (m_Capturing)
+    {
+        LimitCapture();
+    }
+
+    for (auto& thread : m_Threads)
+    {
+        for (auto& node : thread.Nodes)
+        {
+            node.History[historyIndex] = static_cast<float>(node.FrameTime);
+            node.Calls = node.FrameCalls;
+
+            node.FrameTime = 0.0;
+            node.FrameCalls = 0;
+        }
+    }
+
+    m_FrameCount++;
+}
+
+void Performance::SetEnabled(bool value)
+{
+    m_Enabled.store(value, std::memory_order_relaxed);
+}
+
+bool Performance::IsEnabled()
+{
+    return m_Enabled.load(std::memory_order_relaxed);
+}
+
+const std::vector<Performance::ProfilerThread>& Performance::GetThreads()
+{
+    return m_Threads;
+}
+
+const std::array<float, Performance::HistorySize>& Performance::GetFrameTimes()
+{
+    return m_FrameTimes;
+}
+
+std::uint32_t Performance::GetHistoryIndex()
+{
+    return static_cast<std::uint32_t>((m_FrameCount + HistorySize - 1) % HistorySize);
+}
+
+std::uint32_t Performance::GetHistoryCount()
+{
+    return static_cast<std::uint32_t>(std::min<std::uint64_t>(m_FrameCount, HistorySize));
+}
+
+Performance::ScopeStatistics Performance::GetStatistics(const std::array<float, HistorySize>& history)
+{
+    const auto count = GetHistoryCount();
+
+    if (count == 0)
+    {
+        return {};
+    }
+
+    // The history is filled from the start, so the first `count` entries are the valid ones.
+    std::array<float, HistorySize> sorted = history;
+
+    std::sort(sorted.begin(), sorted.begin() + count);
+
+    ScopeStatistics statistics;
+
+    float total = 0.f;
+
+    for (std::uint32_t i = 0; i < count; i++)
+    {
+        total += sorted[i];
+    }
+
+    statistics.Min = sorted[0];
+    statistics.Max = sorted[count - 1];
+    statistics.Average = total / static_cast<float>(count);
+    statistics.P99 = sorted[static_cast<std::uint32_t>(std::ceil(static_cast<float>(count) * 0.99f)) - 1];
+
+    return statistics;
+}
+
+Performance::Counter* Performance::CreateCounter(const char* name)
+{
+    SuspendAllocationTracking suspendTracking;
+
+    std::unique_lock lock(m_CountersMutex);
+
+    for (const auto counter : m_Counters)
+    {
+        if (std::strcmp(counter->Name, name) == 0)
+        {
+            return counter;
+        }
+    }
+
+    if (m_Counters.size() >= MaxCounters)
+    {
+        // Logging creates counters of its own, so the lock has to be released first.
+        lock.unlock();
+
+        Log::Warning("[Performance] Out of counters, '{}' will not be tracked.", name);
+
+        static Counter overflowCounter = { "Overflow", MaxCounters };
+
+        return &overflowCounter;
+    }
+
+    const auto counter = new Counter();
+
+    counter->Name = name;
+    counter->Id = static_cast<std::uint32_t>(m_Counters.size());
+
+    m_Counters.push_back(counter);
+
+    return counter;
+}
+
+void Performance::IncrementCounter(const Counter* counter, std::int64_t amount)
+{
+    if (counter->Id >= MaxCounters)
+    {
+        return;
+    }
+
+    GetThreadBuffer()->Counters[counter->Id].fetch_add(amount, std::memory_order_relaxed);
+}
+
+const std::vector<Performance::Counter*>& Performance::GetCounters()
+{
+    return m_Counters;
+}
+
+Performance::AllocationTag* Performance::CreateAllocationTag(const char* name)
+{
+    const char* allocationsName;
+    const char* allocatedBytesName;
+
+    {
+        SuspendAllocationTracking suspendTracking;
+
+        std::unique_lock lock(m_CountersMutex);
+
+        allocationsName = m_CounterNames.emplace_back(fmt::format("Allocations ({})", name)).c_str();
+        allocatedBytesName = m_CounterNames.emplace_back(fmt::format("Allocated bytes ({})", name)).c_str();
+    }
+
+    const auto tag = new AllocationTag();
+
+    tag->Name = name;
+    tag->Allocations = CreateCounter(allocationsName);
+    tag->AllocatedBytes = CreateCounter(allocatedBytesName);
+
+    return tag;
+}
+
+void Performance::TrackAllocation(std::size_t size)
+{
+    if (m_AllocationTrackingSuspended > 0)
+    {
+        return;
+    }
+
+    auto tag = AllocationScope::GetCurrentTag();
+
+    if (tag == nullptr)
+    {
+        static const AllocationTag* untaggedTag = CreateAllocationTag("Untagged");
+
+        tag = untaggedTag;
+    }
+
+    IncrementCounter(tag->Allocations, 1);
+    IncrementCounter(tag->AllocatedBytes, static_cast<std::int64_t>(size));
+}
+
+std::uint64_t Performance::GetDroppedEventCount()
+{
+    return m_DroppedEvents;
+}
+
+void Performance::StartCapture()
+{
+    m_CapturedScopes.clear();
+    m_CapturedFrames.clear();
+
+    m_CaptureStart = GetTimestamp();
+    m_Capturing = true;
+}
+
+bool Performance::StartCapture(const std::string& path)
+{
+    m_CaptureStream.open(path);
+
+    if (!m_CaptureStream.is_open())
+    {
+        Log::Error("[Performance] Failed to open {} for writing.", path);
+        return false;
+    }
+
+    m_CaptureStreamEmpty = true;
+
+    BeginTrace(m_CaptureStream);
+
+    StartCapture();
+
+    return true;
+}
+
+void Performance::StopCapture()
+{
+    // Pick up whatever the threads have recorded since the last frame ended.
+    CollectEvents();
+
+    m_Capturing = false;
+
+    if (m_CaptureStream.is_open())
+    {
+        // Threads may have been created during the capture, so their names are written last.
+        WriteTraceEvents(m_CaptureStream, m_CaptureStreamEmpty);
+        WriteTraceThreadNames(m_CaptureStream, m_CaptureStreamEmpty);
+        EndTrace(m_CaptureStream);
+
+        m_CaptureStream.close();
+
+        m_CapturedScopes.clear();
+        m_CapturedFrames.clear();
+    }
+}
+
+bool Performance::IsCapturing()
+{
+    return m_Capturing;
+}
+
+bool Performance::ExportChromeTrace(const std::string& path)
+{
+    std::ofstream stream(path);
+
+    if (!stream.is_open())
+    {
+        Log::Error("[Performance] Failed to open {} for writing.", path);
+        return false;
+    }
+
+    bool empty = true;
+
+    BeginTrace(stream);
+    WriteTraceThreadNames(stream, empty);
+    WriteTraceEvents(stream, empty);
+    EndTrace(stream);
+
+    return true;
+}
@@ -1,6 +1,11 @@
 ﻿#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
 #include <vector>
 
+#include "Pine/Performance/AllocationScope/AllocationScope.hpp"
 #include "Pine/Performance/ScopedTimer/ScopedTimer.hpp"
 
 namespace Pine
@@ -15,17 +20,152 @@ namespace Pine
 #define PINE_PF_SCOPE_MANUAL(x) static Pine::Performance::TrackedScope* CONCAT(scope, __LINE__) = Pine::Performance::CreateTrackedScope(x); \
 Pine::ScopedTimer CONCAT(timer, __LINE__)(CONCAT(scope, __LINE__))
 
+// Adds to the named counter, counters with the same name are shared between all call sites.
+#define PINE_PF_COUNTER(name, amount) do { static const Pine::Performance::Counter* CONCAT(counter, __LINE__) = Pine::Performance::CreateCounter(name); \
+    Pine::Performance::IncrementCounter(CONCAT(counter, __LINE__), amount); } while (false)
+
+// Attributes the heap allocations made by the calling thread until the end of the scope to the named subsystem.
+#define PINE_PF_ALLOCATION_SCOPE(name) static const Pine::Performance::AllocationTag* CONCAT(allocationTag, __LINE__) = Pine::Performance::CreateAllocationTag(name); \
+    Pine::AllocationScope CONCAT(allocationScope, __LINE__)(CONCAT(allocationTag, __LINE__))
+
 }
 
 namespace Pine::Performance
 {
+    // The number of frames the profiler keeps timings for.
+    constexpr std::uint32_t HistorySize = 240;
+
+    // The number of counters every thread has room for.
+    constexpr std::uint32_t MaxCounters = 256;
+
     struct TrackedScope
     {
         const char* Name;
-        double Time;
+        std::uint32_t Id;
+    };
+
+    // A scope as it was entered from a specific parent scope on a specific thread, so the same scope
+    // shows up once for every call path it's used from.
+    struct ProfilerNode
+    {
+        // The root node of every thread has no scope.
+        const TrackedScope* Scope = nullptr;
+
+        std::uint32_t Parent = 0;
+        std::vector<std::uint32_t> Children;
+
+        // The total time in milliseconds spent in this scope during each of the last frames, indexed
+        // the same way as the frame times.
+        std::array<float, HistorySize> History = {};
+
+        // The number of times the scope was entered during the last frame.
+        std::uint32_t Calls = 0;
+
+        // Used while collecting the current frame.
+        double FrameTime = 0.0;
+        std::uint32_t FrameCalls = 0;
+    };
+
+    struct ProfilerThread
+    {
+        std::string Name;
+
+        // The first node is the root of the tree.
+        std::vector<ProfilerNode> Nodes;
+    };
+
+    struct Counter
+    {
+        const char* Name;
+        std::uint32_t Id;
+
+        // The total of all threads during the last frame.
+        std::int64_t Value = 0;
+
+        std::array<float, HistorySize> History = {};
+    };
+
+    struct AllocationTag
+    {
+        const char* Name;
+
+        const Counter* Allocations;
+        const Counter* AllocatedBytes;
+    };
+
+    struct ScopeStatistics
+    {
+        float Min = 0.f;
+        float Average = 0.f;
+        float Max = 0.f;
+        float P99 = 0.f;
     };
 
     TrackedScope* CreateTrackedScope(const char* name);
 
     const std::vector<TrackedScope*>& GetTrackedScopes();
-}
\ No newline at end of file
+
+    // Names the calling thread in the profiler and in exported traces.
+    void SetThreadName(const std::string& name);
+
+    // Records the start or end of a scope on the calling thread, use PINE_PF_SCOPE() instead.
+    void BeginScope(const TrackedScope* scope);
+    void EndScope(const TrackedScope* scope);
+
+    // Marks the start of a new frame, should be called once per frame from the main thread.
+    void BeginFrame();
+
+    // Collects the events every thread recorded since the last call and updates the scope timings.
+    void EndFrame();
+
+    void SetEnabled(bool value);
+    bool IsEnabled();
+
+    // The profiling data of every thread that has recorded anything, may only be accessed from the main thread.
+    const std::vector<ProfilerThread>& GetThreads();
+
+    // The duration of the last frames in milliseconds, the most recent frame is at GetHistoryIndex().
+    const std::array<float, HistorySize>& GetFrameTimes();
+
+    std::uint32_t GetHistoryIndex();
+
+    // The number of frames in the history that contain data.
+    std::uint32_t GetHistoryCount();
+
+    ScopeStatistics GetStatistics(const std::array<float, HistorySize>& history);
+
+    // Events that didn't fit in their thread's buffer since it was last collected.
+    std::uint64_t GetDroppedEventCount();
+
+    // While capturing, every collected event is also kept so it can be exported afterwards. Captures kept in
+    // memory are stopped once they grow too large, so record long captures by passing a path instead. The
+    // events are then written to the file in chunks as the capture goes, and StopCapture() finishes the file.
+    void StartCapture();
+    bool StartCapture(const std::string& path);
+    void StopCapture();
+    bool IsCapturing();
+
+    // Returns the counter with the given name, or creates it if it doesn't exist yet.
+    Counter* CreateCounter(const char* name);
+
+    // Adds to the calling thread's copy of the counter, which is cheap enough for hot paths. The copies of
+    // all threads are added up at the end of every frame.
+    void IncrementCounter(const Counter* counter, std::int64_t amount = 1);
+
+    // May only be accessed from the main thread.
+    const std::vector<Counter*>& GetCounters();
+
+    // Creates the allocation and allocated bytes counters for a subsystem.
+    AllocationTag* CreateAllocationTag(const char* name);
+
+    // While enabled, every heap allocation made through operator new is counted towards the allocation
+    // tag of the innermost PINE_PF_ALLOCATION_SCOPE() of the allocating thread.
+    void SetAllocationTrackingEnabled(bool value);
+    bool IsAllocationTrackingEnabled();
+
+    // Called by the operator new replacements.
+    void TrackAllocation(std::size_t size);
+
+    // Writes the captured events in the Chrome trace event format, which can be opened in Perfetto or chrome://tracing.
+    bool ExportChromeTrace(const std::string& path);
+}
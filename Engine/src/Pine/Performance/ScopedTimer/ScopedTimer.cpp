@@ -2,9 +2,15 @@
 
 #include "Pine/Performance/Performance.hpp"
 
-Pine::ScopedTimer::ScopedTimer(Performance::TrackedScope* scope)
+Pine::ScopedTimer::ScopedTimer(const Performance::TrackedScope* scope)
 {
     m_TrackedScope = scope;
+    m_Active = Performance::IsEnabled();
+
+    if (m_Active)
+    {
+        Performance::BeginScope(m_TrackedScope);
+    }
 }
 
 Pine::ScopedTimer::~ScopedTimer()
@@ -14,7 +20,12 @@ Pine::ScopedTimer::~ScopedTimer()
 
 void Pine::ScopedTimer::Stop()
 {
-    m_Timer.Stop();
+    if (!m_Active)
+    {
+        return;
+    }
+
+    Performance::EndScope(m_TrackedScope);
 
-    m_TrackedScope->Time = m_Timer.GetElapsedTime();
+    m_Active = false;
 }
@@ -1,5 +1,4 @@
 ﻿#pragma once
-#include "Pine/Core/Timer/Timer.hpp"
 
 namespace Pine
 {
@@ -8,16 +7,18 @@ namespace Pine
         struct TrackedScope;
     }
 
+    // Records the begin and end events of a tracked scope on the calling thread.
     class ScopedTimer
     {
     private:
-        Performance::TrackedScope* m_TrackedScope;
+        const Performance::TrackedScope* m_TrackedScope;
 
-        Timer m_Timer;
+        // Whether the begin event was recorded, profiling may be toggled while the scope is open.
+        bool m_Active = false;
     public:
-        explicit ScopedTimer(Performance::TrackedScope* scope);
+        explicit ScopedTimer(const Performance::TrackedScope* scope);
         ~ScopedTimer();
 
         void Stop();
     };
-}
+}
\ No newline at end of file
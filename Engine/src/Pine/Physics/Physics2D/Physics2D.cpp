@@ -9,6 +9,8 @@
 namespace
 {
     b2World *m_World = nullptr;
+
+    std::unordered_map<std::uint64_t, std::unordered_map<std::uint64_t, Pine::Physics2D::TileChunkFixtures>> m_TileChunkFixtures;
 }
 
 void Pine::Physics2D::Setup()
@@ -20,6 +22,8 @@ void Pine::Physics2D::Setup()
 
 void Pine::Physics2D::Shutdown()
 {
+	m_TileChunkFixtures.clear();
+
 	delete m_World;
 }
 
@@ -53,6 +57,8 @@ void Pine::Physics2D::Update(double deltaTime)
 
     m_World->Step(physicsTimeDelta, 8, 3);
 
+    PINE_PF_COUNTER("Physics steps", 1);
+
     for (auto& collider : Pine::Components::Get<Pine::Collider2D>())
         collider.OnPostPhysicsUpdate();
     for (auto& rigidBody : Pine::Components::Get<Pine::RigidBody2D>())
@@ -62,4 +68,14 @@ void Pine::Physics2D::Update(double deltaTime)
 b2World * Pine::Physics2D::GetWorld()
 {
     return m_World;
+}
+
+std::unordered_map<std::uint64_t, Pine::Physics2D::TileChunkFixtures>& Pine::Physics2D::GetTileChunkFixtures(std::uint64_t colliderId)
+{
+    return m_TileChunkFixtures[colliderId];
+}
+
+void Pine::Physics2D::ReleaseTileChunkFixtures(std::uint64_t colliderId)
+{
+    m_TileChunkFixtures.erase(colliderId);
 }
\ No newline at end of file
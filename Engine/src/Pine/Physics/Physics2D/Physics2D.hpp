@@ -1,10 +1,22 @@
 #pragma once
 
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
 class b2World;
+class b2Fixture;
 
 namespace Pine::Physics2D
 {
 
+	// The fixtures built for one chunk of a tilemap collider, so only the chunks that changed have to be rebuilt.
+	struct TileChunkFixtures
+	{
+		std::uint32_t m_Version = 0;
+		std::vector<b2Fixture*> m_Fixtures;
+	};
+
 	void Setup();
 	void Shutdown();
 
@@ -12,4 +24,9 @@ namespace Pine::Physics2D
 
 	b2World* GetWorld();
 
+	// Components are copied around as plain memory, so tilemap colliders keep their fixtures here instead, keyed
+	// by the collider's unique id and then by the id of the chunk. Release them when the collider's body is destroyed.
+	std::unordered_map<std::uint64_t, TileChunkFixtures>& GetTileChunkFixtures(std::uint64_t colliderId);
+	void ReleaseTileChunkFixtures(std::uint64_t colliderId);
+
 }
\ No newline at end of file
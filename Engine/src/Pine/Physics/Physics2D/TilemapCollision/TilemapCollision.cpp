@@ -0,0 +1,93 @@
+#include "TilemapCollision.hpp"
+
+#include <bitset>
+
+namespace
+{
+    bool HasDefaultCollider(const Pine::TileData& tileData)
+    {
+        return tileData.m_ColliderOffset == Pine::Vector2f(0.f) &&
+               tileData.m_ColliderSize == Pine::Vector2f(1.f) &&
+               tileData.m_ColliderRotation == 0.f;
+    }
+}
+
+void Pine::Physics2D::BuildTileChunkColliders(const TileChunk& chunk, Tileset* tileset, std::vector<TileColliderBox>& boxes)
+{
+    // The tiles that can be merged, cleared again once they're part of a rectangle.
+    std::bitset<TileChunkArea> solid;
+
+    for (int i = 0; i < TileChunkArea; i++)
+    {
+        if (!chunk.m_Occupied[i])
+            continue;
+
+        const auto& tile = chunk.m_Tiles[i];
+
+        if (tile.m_Flags & TileFlags_NoCollision)
+            continue;
+
+        const auto tileData = tileset->GetTileByIndex(tile.m_Index);
+
+        if (tileData == nullptr)
+            continue;
+
+        if (HasDefaultCollider(*tileData))
+        {
+            solid[i] = true;
+            continue;
+        }
+
+        boxes.push_back({ Vector2f(tile.m_Position) + tileData->m_ColliderOffset, tileData->m_ColliderSize, tileData->m_ColliderRotation });
+    }
+
+    const auto chunkOrigin = chunk.m_Position * TileChunkSize;
+
+    for (int y = 0; y < TileChunkSize; y++)
+    {
+        for (int x = 0; x < TileChunkSize; x++)
+        {
+            if (!solid[y * TileChunkSize + x])
+                continue;
+
+            // Grow the rectangle along the row first, then down for as long as every tile below it is solid.
+            int width = 1;
+
+            while (x + width < TileChunkSize && solid[y * TileChunkSize + x + width])
+                width++;
+
+            int height = 1;
+
+            while (y + height < TileChunkSize)
+            {
+                bool rowSolid = true;
+
+                for (int i = 0; i < width; i++)
+                {
+                    if (!solid[(y + height) * TileChunkSize + x + i])
+                    {
+                        rowSolid = false;
+                        break;
+                    }
+                }
+
+                if (!rowSolid)
+                    break;
+
+                height++;
+            }
+
+            for (int j = 0; j < height; j++)
+            {
+                for (int i = 0; i < width; i++)
+                {
+                    solid[(y + j) * TileChunkSize + x + i] = false;
+                }
+            }
+
+            const auto size = Vector2f(static_cast<float>(width), static_cast<float>(height));
+
+            boxes.push_back({ Vector2f(chunkOrigin + Vector2i(x, y)) + (size - Vector2f(1.f)) * 0.5f, size, 0.f });
+        }
+    }
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <vector>
+
+#include "Pine/Assets/Tilemap/Tilemap.hpp"
+
+namespace Pine::Physics2D
+{
+
+    // A box shaped collider measured in tiles, positioned by its center where the center of a tile is at its grid position.
+    struct TileColliderBox
+    {
+        Vector2f m_Position = Vector2f(0.f);
+        Vector2f m_Size = Vector2f(1.f);
+        float m_Rotation = 0.f;
+    };
+
+    // Builds the colliders for the tiles of a chunk. Adjacent tiles with the default collider are greedily
+    // merged into rectangles, tiles with a custom collider offset, size or rotation get a box of their own,
+    // and tiles flagged with TileFlags_NoCollision are skipped.
+    void BuildTileChunkColliders(const TileChunk& chunk, Tileset* tileset, std::vector<TileColliderBox>& boxes);
+
+}
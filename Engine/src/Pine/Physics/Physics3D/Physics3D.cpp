@@ -3,6 +3,7 @@
 #include "Pine/World/Components/Components.hpp"
 #include "Pine/World/Components/Collider/Collider.hpp"
 #include "Pine/World/Components/RigidBody/RigidBody.hpp"
+#include "Pine/World/Query/Query.hpp"
 
 #include "physx/PxPhysicsAPI.h"
 #include "Pine/Performance/Performance.hpp"
@@ -117,18 +118,27 @@ void Pine::Physics3D::Update(double deltaTime)
 
     accumulator = 0.0;
 
+    // Gathered once for the entire step, as the simulation doesn't create or delete any entities. Writing the
+    // results back then doesn't have to look up the transform of every rigid body through its entity.
+    const auto rigidBodies = Pine::World::Query<Transform, RigidBody>();
+
     for (auto& collider : Pine::Components::Get<Collider>())
         collider.OnPrePhysicsUpdate();
-    for (auto& rigidBody : Pine::Components::Get<RigidBody>())
-        rigidBody.OnPrePhysicsUpdate();
+    for (const auto& [transform, rigidBody] : rigidBodies)
+        rigidBody->OnPrePhysicsUpdate();
 
     m_Scene->simulate(physicsTimeDelta);
     m_Scene->fetchResults(true);
 
+    PINE_PF_COUNTER("Physics steps", 1);
+
     for (auto& collider : Pine::Components::Get<Collider>())
         collider.OnPostPhysicsUpdate();
-    for (auto& rigidBody : Pine::Components::Get<RigidBody>())
-        rigidBody.OnPostPhysicsUpdate();
+
+    rigidBodies.ForEach([](Transform& transform, RigidBody& rigidBody)
+    {
+        rigidBody.ApplyGlobalPose(transform);
+    });
 }
 
 PxPhysics* Pine::Physics3D::GetPhysics()
@@ -0,0 +1,323 @@
+#include "CommandBuffer.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include "Pine/Assets/Model/Model.hpp"
+#include "Pine/Performance/Performance.hpp"
+#include "Pine/Rendering/Renderer3D/Renderer3D.hpp"
+#include "Pine/Threading/Threading.hpp"
+#include "Pine/World/Components/ModelRenderer/ModelRenderer.hpp"
+#include "Pine/World/Entity/Entity.hpp"
+
+using namespace Pine;
+
+namespace
+{
+    // The number of instances each worker records at a time.
+    constexpr std::uint32_t RecordGrainSize = 256;
+
+    constexpr int RadixBits = 8;
+    constexpr int RadixBuckets = 1 << RadixBits;
+
+    std::uint32_t GetId(std::unordered_map<const void*, std::uint32_t>& ids, const void* object, std::uint64_t mask)
+    {
+        if (object == nullptr)
+        {
+            return 0;
+        }
+
+        const auto [it, inserted] = ids.try_emplace(object, static_cast<std::uint32_t>(ids.size() + 1));
+
+        // Running out of ids only makes the sorting less effective, the draws themselves are still correct.
+        return static_cast<std::uint32_t>(it->second & mask);
+    }
+
+    // The squared distance as a sortable integer, positive floats compare the same as their bit patterns
+    // do, so the exponent and the highest bits of the mantissa are enough.
+    std::uint64_t QuantizeDepth(float distanceSquared)
+    {
+        std::uint32_t bits;
+        std::memcpy(&bits, &distanceSquared, sizeof(bits));
+
+        return (bits >> 16) & Rendering::SortKey::DepthMask;
+    }
+}
+
+void Rendering::CommandBuffer::Reset()
+{
+    m_Draws.clear();
+    m_Commands.clear();
+    m_SortEntries.clear();
+
+    m_ShaderIds.clear();
+    m_MaterialIds.clear();
+    m_MeshIds.clear();
+
+    m_Sorted = false;
+}
+
+void Rendering::CommandBuffer::AddDraws(const ObjectBatchMap& batches, const CommandRecordSettings& settings)
+{
+    const auto& configuration = Renderer3D::GetRenderConfiguration();
+
+    m_InstanceCount = 0;
+
+    for (const auto& [object, instances] : batches)
+    {
+        int meshIndex = -1;
+
+        for (const auto mesh : object.Model->GetMeshes())
+        {
+            meshIndex++;
+
+            const auto material = object.OverrideMaterial != nullptr ? object.OverrideMaterial : mesh->GetMaterial();
+
+            // Make sure we're rendering materials with the correct mode
+            if (settings.FilterRenderingMode && material && material->GetRenderingMode() != settings.RenderingMode)
+            {
+                continue;
+            }
+
+            std::uint64_t key = static_cast<std::uint64_t>(settings.Pass & SortKey::PassMask) << SortKey::PassShift;
+
+            // If the materials are skipped, there is nothing to switch between except for the meshes.
+            if (!configuration.SkipMaterialInitialization)
+            {
+                const auto keyMaterial = configuration.OverrideMaterial ? configuration.OverrideMaterial : material;
+
+                if (keyMaterial != nullptr)
+                {
+                    const auto shader = configuration.OverrideShader ? configuration.OverrideShader : keyMaterial->GetShader();
+                    const auto discard = keyMaterial->GetRenderingMode() == MaterialRenderingMode::Discard;
+
+                    const auto shaderId = GetId(m_ShaderIds, shader, SortKey::ShaderMask >> 1) << 1 | discard;
+
+                    key |= static_cast<std::uint64_t>(shaderId) << SortKey::ShaderShift;
+                    key |= static_cast<std::uint64_t>(GetId(m_MaterialIds, keyMaterial, SortKey::MaterialMask)) << SortKey::MaterialShift;
+                }
+            }
+
+            key |= static_cast<std::uint64_t>(GetId(m_MeshIds, mesh, SortKey::MeshMask)) << SortKey::MeshShift;
+
+            RenderDraw draw;
+
+            draw.Mesh = mesh;
+            draw.OverrideMaterial = object.OverrideMaterial;
+            draw.SortKey = key;
+            draw.MeshIndex = meshIndex;
+            draw.Instances = &instances;
+            draw.InstanceOffset = m_InstanceCount;
+
+            m_Draws.push_back(draw);
+
+            m_InstanceCount += static_cast<std::uint32_t>(instances.size());
+        }
+    }
+}
+
+void Rendering::CommandBuffer::RecordInstances(std::uint32_t begin, std::uint32_t end, const CommandRecordSettings& settings, std::vector<RenderCommand>& commands) const
+{
+    // Draws recorded by earlier calls to Record() have already been handled.
+    const auto firstDraw = m_Draws.begin() + m_RecordDrawOffset;
+
+    // Find the draw the first instance of this range belongs to.
+    auto drawIt = std::upper_bound(firstDraw, m_Draws.end(), begin, [](std::uint32_t index, const RenderDraw& draw)
+    {
+        return index < draw.InstanceOffset;
+    }) - 1;
+
+    std::uint32_t index = begin;
+
+    while (index < end)
+    {
+        const auto& draw = *drawIt;
+        const auto drawIndex = static_cast<std::uint32_t>(drawIt - m_Draws.begin());
+        const auto drawEnd = std::min(end, draw.InstanceOffset + static_cast<std::uint32_t>(draw.Instances->size()));
+
+        for (; index < drawEnd; index++)
+        {
+            const auto modelRenderer = (*draw.Instances)[index - draw.InstanceOffset].renderer;
+
+            if (settings.RequireFrustumCulling && !modelRenderer->GetRenderingHintData().HasPassedFrustumCulling)
+            {
+                continue;
+            }
+
+            if (const int modelMeshIndex = modelRenderer->GetModelMeshIndex(); modelMeshIndex >= 0 && modelMeshIndex != draw.MeshIndex)
+            {
+                continue;
+            }
+
+            // The world transforms have already been brought up to date by the render manager at this point.
+            const auto& transformationMatrix = modelRenderer->GetParent()->GetTransform()->GetTransformationMatrix();
+            const auto distanceSquared = glm::distance2(settings.ViewPosition, Vector3f(transformationMatrix[3]));
+
+            if (distanceSquared > settings.MaxDistanceSquared)
+            {
+                continue;
+            }
+
+            auto& command = commands.emplace_back();
+
+            command.SortKey = draw.SortKey | QuantizeDepth(distanceSquared);
+            command.Draw = drawIndex;
+            command.TransformationMatrix = transformationMatrix;
+
+            if (settings.StencilOverrides && modelRenderer->GetOverrideStencilBuffer())
+            {
+                command.SortKey |= 1ull << SortKey::StencilShift;
+                command.StencilValue = modelRenderer->GetStencilBufferValue();
+            }
+        }
+
+        ++drawIt;
+    }
+}
+
+void Rendering::CommandBuffer::Record(const ObjectBatchMap& batches, const CommandRecordSettings& settings)
+{
+    PINE_PF_SCOPE();
+
+    m_RecordDrawOffset = static_cast<std::uint32_t>(m_Draws.size());
+
+    AddDraws(batches, settings);
+
+    const std::uint32_t chunkCount = (m_InstanceCount + RecordGrainSize - 1) / RecordGrainSize;
+
+    if (m_ChunkCommands.size() < chunkCount)
+    {
+        m_ChunkCommands.resize(chunkCount);
+    }
+
+    Threading::ParallelFor(m_InstanceCount, RecordGrainSize, [this, &settings](std::uint32_t begin, std::uint32_t end)
+    {
+        auto& commands = m_ChunkCommands[begin / RecordGrainSize];
+
+        commands.clear();
+
+        RecordInstances(begin, end, settings, commands);
+    });
+
+    // Merge the chunks in order, so the result doesn't depend on how the work got scheduled.
+    for (std::uint32_t i = 0; i < chunkCount; i++)
+    {
+        m_Commands.insert(m_Commands.end(), m_ChunkCommands[i].begin(), m_ChunkCommands[i].end());
+    }
+
+    m_Sorted = false;
+}
+
+void Rendering::CommandBuffer::Sort()
+{
+    PINE_PF_SCOPE();
+
+    const auto count = m_Commands.size();
+
+    m_SortEntries.resize(count);
+    m_SortScratch.resize(count);
+
+    std::uint64_t differingBits = 0;
+
+    for (std::size_t i = 0; i < count; i++)
+    {
+        m_SortEntries[i] = { m_Commands[i].SortKey, static_cast<std::uint32_t>(i) };
+
+        differingBits |= m_Commands[i].SortKey ^ m_Commands[0].SortKey;
+    }
+
+    // Least significant digit first radix sort, which is stable, so equal keys keep their recorded order.
+    // Digits that are the same for every key are skipped, which usually leaves only a few passes.
+    for (int shift = 0; shift < 64; shift += RadixBits)
+    {
+        if (((differingBits >> shift) & (RadixBuckets - 1)) == 0)
+        {
+            continue;
+        }
+
+        std::uint32_t offsets[RadixBuckets] = {};
+
+        for (const auto& entry : m_SortEntries)
+        {
+            offsets[(entry.Key >> shift) & (RadixBuckets - 1)]++;
+        }
+
+        std::uint32_t total = 0;
+
+        for (auto& offset : offsets)
+        {
+            const auto bucketCount = offset;
+
+            offset = total;
+            total += bucketCount;
+        }
+
+        for (const auto& entry : m_SortEntries)
+        {
+            m_SortScratch[offsets[(entry.Key >> shift) & (RadixBuckets - 1)]++] = entry;
+        }
+
+        m_SortEntries.swap(m_SortScratch);
+    }
+
+    m_Sorted = true;
+}
+
+void Rendering::CommandBuffer::Submit()
+{
+    PINE_PF_SCOPE();
+
+    if (m_Commands.empty())
+    {
+        return;
+    }
+
+    if (!m_Sorted)
+    {
+        Sort();
+    }
+
+    std::uint32_t currentDraw = std::numeric_limits<std::uint32_t>::max();
+
+    for (const auto& entry : m_SortEntries)
+    {
+        const auto& command = m_Commands[entry.Command];
+
+        if (command.Draw != currentDraw)
+        {
+            Renderer3D::RenderMeshInstanced();
+
+            const auto& draw = m_Draws[command.Draw];
+
+            Renderer3D::PrepareMesh(draw.Mesh, draw.OverrideMaterial);
+
+            currentDraw = command.Draw;
+        }
+
+        if (command.SortKey & (1ull << SortKey::StencilShift))
+        {
+            // The stencil commands of a draw are sorted after its other instances, so these are flushed first.
+            Renderer3D::RenderMeshInstanced();
+            Renderer3D::RenderMesh(command.TransformationMatrix, command.StencilValue);
+
+            continue;
+        }
+
+        if (Renderer3D::AddInstance(command.TransformationMatrix))
+        {
+            Renderer3D::RenderMeshInstanced();
+        }
+    }
+
+    Renderer3D::RenderMeshInstanced();
+}
+
+std::uint32_t Rendering::CommandBuffer::GetCommandCount() const
+{
+    return static_cast<std::uint32_t>(m_Commands.size());
+}
+
+std::uint32_t Rendering::CommandBuffer::GetDrawCount() const
+{
+    return static_cast<std::uint32_t>(m_Draws.size());
+}
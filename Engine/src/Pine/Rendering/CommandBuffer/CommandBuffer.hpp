@@ -0,0 +1,142 @@
+#pragma once
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+#include "Pine/Core/Math/Math.hpp"
+#include "Pine/Rendering/SceneProcessor/SceneProcessor.hpp"
+
+namespace Pine
+{
+    class Mesh;
+    class Material;
+}
+
+namespace Pine::Rendering
+{
+
+    // Layout of the 64-bit sort key of a render command, from the most significant bits down. Commands are
+    // submitted in ascending key order, so everything using the same shader, material and mesh ends up
+    // next to each other, and instances of the same mesh are drawn front to back.
+    namespace SortKey
+    {
+        constexpr std::uint64_t PassShift = 60;
+        constexpr std::uint64_t ShaderShift = 46;
+        constexpr std::uint64_t MaterialShift = 32;
+        constexpr std::uint64_t MeshShift = 16;
+        constexpr std::uint64_t StencilShift = 15;
+
+        constexpr std::uint64_t PassMask = 0xF;
+        constexpr std::uint64_t ShaderMask = 0x3FFF;
+        constexpr std::uint64_t MaterialMask = 0x3FFF;
+        constexpr std::uint64_t MeshMask = 0xFFFF;
+        constexpr std::uint64_t DepthMask = 0x7FFF;
+    }
+
+    struct RenderCommand
+    {
+        std::uint64_t SortKey = 0;
+
+        // The draw (mesh and material) this command is an instance of.
+        std::uint32_t Draw = 0;
+
+        // The stencil value to write, only used by the commands with the stencil bit set in their key.
+        std::int32_t StencilValue = 0;
+
+        Matrix4f TransformationMatrix = Matrix4f(1.f);
+    };
+
+    struct RenderDraw
+    {
+        Mesh* Mesh = nullptr;
+        Material* OverrideMaterial = nullptr;
+
+        // Everything in the sort key above the stencil bit.
+        std::uint64_t SortKey = 0;
+
+        // The index of the mesh within the model, model renderers set to a single mesh only render that one.
+        int MeshIndex = 0;
+
+        const std::vector<ObjectRenderInstance>* Instances = nullptr;
+
+        // Where the instances start in the combined range the workers go through.
+        std::uint32_t InstanceOffset = 0;
+    };
+
+    struct CommandRecordSettings
+    {
+        // The upper bits of the sort key, passes are submitted in ascending order.
+        std::uint32_t Pass = 0;
+
+        // Only meshes with a material using this rendering mode are recorded, unless FilterRenderingMode is false.
+        // Meshes without any material are always recorded.
+        bool FilterRenderingMode = false;
+        MaterialRenderingMode RenderingMode = MaterialRenderingMode::Opaque;
+
+        // Skips the model renderers that didn't make it through the frustum culling.
+        bool RequireFrustumCulling = true;
+
+        // Model renderers that override the stencil buffer are drawn one by one after the rest of the instances
+        // of the mesh, if disabled they're instanced like everything else.
+        bool StencilOverrides = true;
+
+        // The position the scene is viewed from, instances are sorted front to back from here.
+        Vector3f ViewPosition = Vector3f(0.f);
+
+        // Skips instances further away than this from the view position.
+        float MaxDistanceSquared = std::numeric_limits<float>::max();
+    };
+
+    // Collects the instances of the render batches as sort keyed commands, and submits them through Renderer3D.
+    // Recording is spread across the worker threads, each chunk of instances is recorded into its own buffer,
+    // which are then merged and radix sorted by their key before being submitted on the calling thread.
+    class CommandBuffer
+    {
+    private:
+        struct SortEntry
+        {
+            std::uint64_t Key = 0;
+            std::uint32_t Command = 0;
+        };
+
+        std::vector<RenderDraw> m_Draws;
+
+        std::vector<std::vector<RenderCommand>> m_ChunkCommands;
+        std::vector<RenderCommand> m_Commands;
+
+        std::vector<SortEntry> m_SortEntries;
+        std::vector<SortEntry> m_SortScratch;
+
+        // Small ids for the shaders, materials and meshes in the sort keys, handed out as they're first recorded.
+        std::unordered_map<const void*, std::uint32_t> m_ShaderIds;
+        std::unordered_map<const void*, std::uint32_t> m_MaterialIds;
+        std::unordered_map<const void*, std::uint32_t> m_MeshIds;
+
+        // The first draw and the number of instances added by the ongoing Record() call.
+        std::uint32_t m_RecordDrawOffset = 0;
+        std::uint32_t m_InstanceCount = 0;
+
+        bool m_Sorted = false;
+
+        void AddDraws(const ObjectBatchMap& batches, const CommandRecordSettings& settings);
+
+        void RecordInstances(std::uint32_t begin, std::uint32_t end, const CommandRecordSettings& settings, std::vector<RenderCommand>& commands) const;
+
+        void Sort();
+    public:
+        // Clears all recorded commands, should be called before recording a new frame.
+        void Reset();
+
+        // Records a command for every instance of every mesh in the batches that passes the settings. Uses the
+        // current Renderer3D configuration to figure out the shaders and materials.
+        void Record(const ObjectBatchMap& batches, const CommandRecordSettings& settings);
+
+        // Sorts and submits all recorded commands through Renderer3D, the commands are kept until Reset().
+        void Submit();
+
+        std::uint32_t GetCommandCount() const;
+        std::uint32_t GetDrawCount() const;
+    };
+
+}
@@ -0,0 +1,303 @@
+#include "LightClusters.hpp"
+
+#include "Pine/Core/DynamicAABBTree/DynamicAABBTree.hpp"
+#include "Pine/Performance/Performance.hpp"
+#include "Pine/Rendering/Renderer3D/Renderer3D.hpp"
+#include "Pine/Rendering/Renderer3D/ShaderStorages.hpp"
+#include "Pine/Threading/Threading.hpp"
+#include "Pine/World/Components/Light/Light.hpp"
+#include "Pine/World/Entity/Entity.hpp"
+#include "Pine/World/SpatialIndex/SpatialIndex.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+using namespace Pine;
+using namespace Pine::Renderer3D::Specifications::LightClusters;
+
+namespace
+{
+    // Slot 0 is reserved for the directional light.
+    constexpr std::size_t MaxClusteredLights = Renderer3D::Specifications::General::DYNAMIC_LIGHT_COUNT - 1;
+
+    struct ClusterLight
+    {
+        // View space position
+        Vector3f Center = Vector3f(0.f);
+        float Radius = 0.f;
+
+        std::uint8_t Index = 0;
+    };
+
+    // View space bounds of every cluster and the depth of every slice, only rebuilt once the projection changes.
+    std::vector<AABB> m_ClusterBounds(CLUSTER_COUNT);
+    std::array<float, CLUSTER_Z + 1> m_SliceDepths = {};
+    Vector4f m_SliceParameters = Vector4f(0.f);
+    Matrix4f m_ClusterProjection = Matrix4f(0.f);
+
+    std::vector<IComponent*> m_LightCandidates;
+    std::vector<Light*> m_Lights;
+    std::vector<ClusterLight> m_ClusterLights;
+
+    // The lights of every cluster before they get packed into the shader storage. The count keeps going
+    // past MAX_LIGHTS_PER_CLUSTER, so we're able to tell when a cluster has overflowed.
+    std::vector<std::uint8_t> m_ClusterLightIndices(CLUSTER_COUNT * MAX_LIGHTS_PER_CLUSTER);
+    std::vector<std::uint32_t> m_ClusterLightCounts(CLUSTER_COUNT);
+
+    Rendering::LightClusters::LightClusterStatistics m_Statistics;
+
+    int GetClusterIndex(int x, int y, int z)
+    {
+        return x + y * CLUSTER_X + z * CLUSTER_X * CLUSTER_Y;
+    }
+
+    void UpdateClusterBounds(const Camera* camera)
+    {
+        const auto& projection = camera->GetProjectionMatrix();
+
+        if (projection == m_ClusterProjection)
+        {
+            return;
+        }
+
+        m_ClusterProjection = projection;
+
+        const float nearPlane = camera->GetNearPlane();
+        const float farPlane = camera->GetFarPlane();
+
+        // Perspective projections use logarithmic slices, so the clusters keep a similar shape as they get
+        // further away. Orthographic projections don't get any wider, so the slices are kept linear.
+        const bool linearSlices = camera->GetCameraType() == CameraType::Orthographic;
+
+        for (int z = 0; z <= CLUSTER_Z; z++)
+        {
+            const float t = static_cast<float>(z) / CLUSTER_Z;
+
+            m_SliceDepths[z] = linearSlices ? nearPlane + (farPlane - nearPlane) * t : nearPlane * std::pow(farPlane / nearPlane, t);
+        }
+
+        if (linearSlices)
+        {
+            const float scale = CLUSTER_Z / (farPlane - nearPlane);
+
+            m_SliceParameters = Vector4f(scale, -nearPlane * scale, 1.f, 0.f);
+        }
+        else
+        {
+            const float scale = CLUSTER_Z / std::log(farPlane / nearPlane);
+
+            m_SliceParameters = Vector4f(scale, -std::log(nearPlane) * scale, 0.f, 0.f);
+        }
+
+        const auto inverseProjection = glm::inverse(projection);
+
+        const auto unproject = [&](float x, float y, float z)
+        {
+            const auto point = inverseProjection * Vector4f(x, y, z, 1.f);
+
+            return Vector3f(point) / point.w;
+        };
+
+        for (int y = 0; y < CLUSTER_Y; y++)
+        {
+            for (int x = 0; x < CLUSTER_X; x++)
+            {
+                const float tileX[2] = { -1.f + 2.f * x / CLUSTER_X, -1.f + 2.f * (x + 1) / CLUSTER_X };
+                const float tileY[2] = { -1.f + 2.f * y / CLUSTER_Y, -1.f + 2.f * (y + 1) / CLUSTER_Y };
+
+                // The lines from the near plane to the far plane going through the corners of the tile.
+                std::array<Vector3f, 4> nearPoints;
+                std::array<Vector3f, 4> farPoints;
+
+                for (int i = 0; i < 4; i++)
+                {
+                    nearPoints[i] = unproject(tileX[i & 1], tileY[i >> 1], -1.f);
+                    farPoints[i] = unproject(tileX[i & 1], tileY[i >> 1], 1.f);
+                }
+
+                for (int z = 0; z < CLUSTER_Z; z++)
+                {
+                    AABB bounds = { Vector3f(std::numeric_limits<float>::max()), Vector3f(std::numeric_limits<float>::lowest()) };
+
+                    for (const float depth : { m_SliceDepths[z], m_SliceDepths[z + 1] })
+                    {
+                        for (int i = 0; i < 4; i++)
+                        {
+                            const float t = (depth + nearPoints[i].z) / (nearPoints[i].z - farPoints[i].z);
+                            const auto point = nearPoints[i] + (farPoints[i] - nearPoints[i]) * t;
+
+                            bounds.Min = glm::min(bounds.Min, point);
+                            bounds.Max = glm::max(bounds.Max, point);
+                        }
+                    }
+
+                    m_ClusterBounds[GetClusterIndex(x, y, z)] = bounds;
+                }
+            }
+        }
+    }
+
+    bool Intersects(const AABB& bounds, const ClusterLight& light)
+    {
+        const auto closestPoint = glm::clamp(light.Center, bounds.Min, bounds.Max);
+        const auto difference = closestPoint - light.Center;
+
+        return glm::dot(difference, difference) <= light.Radius * light.Radius;
+    }
+
+    void AssignSlice(int z)
+    {
+        const float minDepth = m_SliceDepths[z];
+        const float maxDepth = m_SliceDepths[z + 1];
+
+        const auto sliceBegin = GetClusterIndex(0, 0, z);
+
+        std::fill_n(m_ClusterLightCounts.begin() + sliceBegin, CLUSTER_X * CLUSTER_Y, 0u);
+
+        for (const auto& light : m_ClusterLights)
+        {
+            const float depth = -light.Center.z;
+
+            if (depth + light.Radius < minDepth || depth - light.Radius > maxDepth)
+            {
+                continue;
+            }
+
+            for (int y = 0; y < CLUSTER_Y; y++)
+            {
+                for (int x = 0; x < CLUSTER_X; x++)
+                {
+                    const auto cluster = GetClusterIndex(x, y, z);
+
+                    if (!Intersects(m_ClusterBounds[cluster], light))
+                    {
+                        continue;
+                    }
+
+                    auto& count = m_ClusterLightCounts[cluster];
+
+                    if (count < MAX_LIGHTS_PER_CLUSTER)
+                    {
+                        m_ClusterLightIndices[cluster * MAX_LIGHTS_PER_CLUSTER + count] = light.Index;
+                    }
+
+                    count++;
+                }
+            }
+        }
+    }
+
+    // Writes every cluster's lights after each other into the shader storage's light index list.
+    void PackClusters(Renderer3D::ShaderStorages::LightClusterData& data)
+    {
+        std::uint32_t offset = 0;
+
+        for (int cluster = 0; cluster < CLUSTER_COUNT; cluster++)
+        {
+            const auto lightCount = m_ClusterLightCounts[cluster];
+            const auto count = std::min({ lightCount, static_cast<std::uint32_t>(MAX_LIGHTS_PER_CLUSTER), MAX_LIGHT_INDICES - offset });
+
+            for (std::uint32_t i = 0; i < count; i++)
+            {
+                const auto index = offset + i;
+                const auto shift = (index % 4) * 8;
+
+                auto& packed = data.LightIndices[index / 4];
+
+                packed = (packed & ~(0xFFu << shift)) | (static_cast<std::uint32_t>(m_ClusterLightIndices[cluster * MAX_LIGHTS_PER_CLUSTER + i]) << shift);
+            }
+
+            data.Clusters[cluster] = offset | (count << 16);
+
+            offset += count;
+
+            m_Statistics.MaxClusterLights = std::max(m_Statistics.MaxClusterLights, static_cast<int>(lightCount));
+            m_Statistics.Overflowed |= count < lightCount;
+        }
+
+        m_Statistics.LightIndices = static_cast<int>(offset);
+    }
+}
+
+void Rendering::LightClusters::Build(const Camera* camera)
+{
+    PINE_PF_SCOPE();
+
+    m_Statistics = {};
+
+    m_LightCandidates.clear();
+    m_Lights.clear();
+
+    SpatialIndex::QueryFrustum(ComponentType::Light, camera->GetFrustumPlanes(), m_LightCandidates);
+
+    for (const auto component : m_LightCandidates)
+    {
+        const auto light = static_cast<Light*>(component);
+
+        if (!light->IsWorldEnabled() || light->GetLightType() == LightType::Directional)
+        {
+            continue;
+        }
+
+        m_Lights.push_back(light);
+    }
+
+    // If there are more lights than the renderer is able to store, keep the ones closest to the camera.
+    if (m_Lights.size() > MaxClusteredLights)
+    {
+        const auto cameraPosition = camera->GetParent()->GetTransform()->GetPosition();
+
+        std::nth_element(m_Lights.begin(), m_Lights.begin() + MaxClusteredLights, m_Lights.end(), [&](const Light* a, const Light* b)
+        {
+            return glm::distance2(cameraPosition, a->GetParent()->GetTransform()->GetPosition()) <
+                   glm::distance2(cameraPosition, b->GetParent()->GetTransform()->GetPosition());
+        });
+
+        m_Statistics.SkippedLights = static_cast<int>(m_Lights.size() - MaxClusteredLights);
+
+        m_Lights.resize(MaxClusteredLights);
+    }
+
+    UpdateClusterBounds(camera);
+
+    const auto& viewMatrix = camera->GetViewMatrix();
+
+    m_ClusterLights.clear();
+
+    for (const auto light : m_Lights)
+    {
+        Renderer3D::AddLight(light);
+
+        ClusterLight clusterLight;
+
+        clusterLight.Center = Vector3f(viewMatrix * Vector4f(light->GetParent()->GetTransform()->GetPosition(), 1.f));
+        clusterLight.Radius = std::min(light->GetRange(), Renderer3D::Specifications::General::MAX_LIGHT_RANGE);
+        clusterLight.Index = static_cast<std::uint8_t>(light->GetLightHintData().LightIndex);
+
+        m_ClusterLights.push_back(clusterLight);
+    }
+
+    m_Statistics.Lights = static_cast<int>(m_ClusterLights.size());
+
+    // The slices don't share any clusters, so they can be assigned in parallel.
+    Threading::ParallelFor(CLUSTER_Z, 1, [](std::uint32_t begin, std::uint32_t end)
+    {
+        for (std::uint32_t z = begin; z < end; z++)
+        {
+            AssignSlice(static_cast<int>(z));
+        }
+    });
+
+    auto& data = Renderer3D::ShaderStorages::LightClusters.Data();
+
+    data.Parameters = m_SliceParameters;
+
+    PackClusters(data);
+}
+
+const Rendering::LightClusters::LightClusterStatistics& Rendering::LightClusters::GetStatistics()
+{
+    return m_Statistics;
+}
@@ -0,0 +1,28 @@
+#pragma once
+#include "Pine/World/Components/Camera/Camera.hpp"
+
+namespace Pine::Rendering::LightClusters
+{
+    struct LightClusterStatistics
+    {
+        // Point and spot lights within the camera's frustum that were added to the renderer.
+        int Lights = 0;
+
+        // Lights within the frustum that didn't fit within the renderer's light storage.
+        int SkippedLights = 0;
+
+        int LightIndices = 0;
+        int MaxClusterLights = 0;
+
+        // If any cluster had more lights than it could store, or the light index list ran out of space.
+        bool Overflowed = false;
+    };
+
+    // Divides the camera's view into a grid of clusters (screen space tiles, split into depth slices), and assigns
+    // the point and spot lights within the camera's frustum to every cluster they touch. The lights are added to
+    // the renderer, and the grid is written to the light cluster shader storage which is uploaded with the lights,
+    // so shaders only have to go through the lights of the cluster each fragment is in.
+    void Build(const Camera* camera);
+
+    const LightClusterStatistics& GetStatistics();
+}
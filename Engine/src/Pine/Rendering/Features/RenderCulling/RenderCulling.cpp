@@ -4,51 +4,181 @@
 #include "Pine/World/Components/Components.hpp"
 #include "Pine/World/Components/ModelRenderer/ModelRenderer.hpp"
 #include "Pine/World/Entity/Entity.hpp"
+#include "Pine/World/SpatialIndex/SpatialIndex.hpp"
 
-void Pine::Rendering::RenderCulling::RunFrustumCulling(const Camera* camera)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PINE_RENDER_CULLING_SSE
+#include <emmintrin.h>
+#endif
+
+namespace
 {
-    const auto frustumCorners = camera->GetFrustumCorners();
+    // World space bounds of every model renderer that is going to be tested, packed as separate
+    // arrays so they can be tested four at a time. Kept around to avoid allocating every frame.
+    struct PackedBounds
+    {
+        std::vector<float> CenterX;
+        std::vector<float> CenterY;
+        std::vector<float> CenterZ;
 
-    auto min = Vector3f(std::numeric_limits<float>::max());
-    auto max = Vector3f(std::numeric_limits<float>::lowest());
+        std::vector<float> ExtentX;
+        std::vector<float> ExtentY;
+        std::vector<float> ExtentZ;
 
-    for (const auto& corner : frustumCorners)
-    {
-        min = glm::min(min, corner);
-        max = glm::max(max, corner);
-    }
+        std::vector<std::uint8_t> Visible;
 
-    const auto center = (min + max) * 0.5f;
-    const float size = glm::distance2(min, max);
+        std::vector<Pine::ModelRenderer*> ModelRenderers;
 
-    int culledObjects = 0;
+        void Clear()
+        {
+            CenterX.clear();
+            CenterY.clear();
+            CenterZ.clear();
 
-    for (auto& modelRenderer : Components::Get<ModelRenderer>())
-    {
-        auto& renderingHintData = modelRenderer.GetRenderingHintData();
+            ExtentX.clear();
+            ExtentY.clear();
+            ExtentZ.clear();
+
+            ModelRenderers.clear();
+        }
 
-        if (!modelRenderer.GetModel())
+        void Add(Pine::ModelRenderer* modelRenderer, const Pine::Vector3f& center, const Pine::Vector3f& extent)
         {
-            continue;
+            CenterX.push_back(center.x);
+            CenterY.push_back(center.y);
+            CenterZ.push_back(center.z);
+
+            ExtentX.push_back(extent.x);
+            ExtentY.push_back(extent.y);
+            ExtentZ.push_back(extent.z);
+
+            ModelRenderers.push_back(modelRenderer);
         }
+    };
 
-        auto model = modelRenderer.GetModel();
-        auto transform = modelRenderer.GetParent()->GetTransform();
+    PackedBounds m_PackedBounds;
+
+    std::vector<Pine::IComponent*> m_Candidates;
+
+    // A box is outside the frustum if it's entirely behind any of the planes, which is the case if the
+    // distance from the plane to its center is less than the box's extent projected onto the plane normal.
+    void TestBounds(PackedBounds& bounds, const std::array<Pine::Vector4f, 6>& planes)
+    {
+        const auto count = bounds.ModelRenderers.size();
 
-        const auto position = transform->GetPosition();
+        bounds.Visible.resize(count);
 
-        const auto modelMin = model->GetBoundingBoxMin() * transform->GetScale();
-        const auto modelMax = model->GetBoundingBoxMax() * transform->GetScale();
-        const auto modelCenter = (modelMin + modelMax) * 0.5f + position;
+        std::size_t i = 0;
 
-        if (glm::distance2(modelCenter, center) < size)
+#ifdef PINE_RENDER_CULLING_SSE
+        const __m128 signMask = _mm_set1_ps(-0.f);
+
+        for (; i + 4 <= count; i += 4)
         {
-            renderingHintData.HasPassedFrustumCulling = true;
+            const __m128 centerX = _mm_loadu_ps(&bounds.CenterX[i]);
+            const __m128 centerY = _mm_loadu_ps(&bounds.CenterY[i]);
+            const __m128 centerZ = _mm_loadu_ps(&bounds.CenterZ[i]);
+
+            const __m128 extentX = _mm_loadu_ps(&bounds.ExtentX[i]);
+            const __m128 extentY = _mm_loadu_ps(&bounds.ExtentY[i]);
+            const __m128 extentZ = _mm_loadu_ps(&bounds.ExtentZ[i]);
+
+            __m128 visible = _mm_castsi128_ps(_mm_set1_epi32(-1));
+
+            for (const auto& plane : planes)
+            {
+                const __m128 normalX = _mm_set1_ps(plane.x);
+                const __m128 normalY = _mm_set1_ps(plane.y);
+                const __m128 normalZ = _mm_set1_ps(plane.z);
+
+                const __m128 distance = _mm_add_ps(
+                    _mm_add_ps(_mm_mul_ps(centerX, normalX), _mm_mul_ps(centerY, normalY)),
+                    _mm_add_ps(_mm_mul_ps(centerZ, normalZ), _mm_set1_ps(plane.w)));
+
+                const __m128 radius = _mm_add_ps(
+                    _mm_add_ps(_mm_mul_ps(extentX, _mm_andnot_ps(signMask, normalX)),
+                               _mm_mul_ps(extentY, _mm_andnot_ps(signMask, normalY))),
+                    _mm_mul_ps(extentZ, _mm_andnot_ps(signMask, normalZ)));
+
+                visible = _mm_and_ps(visible, _mm_cmpge_ps(_mm_add_ps(distance, radius), _mm_setzero_ps()));
+            }
+
+            const int mask = _mm_movemask_ps(visible);
+
+            for (int j = 0; j < 4; j++)
+            {
+                bounds.Visible[i + j] = (mask >> j) & 1;
+            }
         }
-        else
+#endif
+
+        for (; i < count; i++)
         {
-            renderingHintData.HasPassedFrustumCulling = false;
-            culledObjects++;
+            bool visible = true;
+
+            for (const auto& plane : planes)
+            {
+                const float distance = bounds.CenterX[i] * plane.x + bounds.CenterY[i] * plane.y + bounds.CenterZ[i] * plane.z + plane.w;
+                const float radius = bounds.ExtentX[i] * std::abs(plane.x) + bounds.ExtentY[i] * std::abs(plane.y) + bounds.ExtentZ[i] * std::abs(plane.z);
+
+                if (distance + radius < 0.f)
+                {
+                    visible = false;
+                    break;
+                }
+            }
+
+            bounds.Visible[i] = visible;
         }
     }
 }
+
+void Pine::Rendering::RenderCulling::RunFrustumCulling(const Camera* camera, RenderingStatistics& statistics)
+{
+    // Only the candidates returned by the spatial index get tested, so whatever passed last time has to be reset
+    // here. Components live in paged memory, so the pointers stay valid even if they have been removed since.
+    for (auto modelRenderer : m_PackedBounds.ModelRenderers)
+    {
+        modelRenderer->GetRenderingHintData().HasPassedFrustumCulling = false;
+    }
+
+    m_PackedBounds.Clear();
+
+    const auto& planes = camera->GetFrustumPlanes();
+
+    m_Candidates.clear();
+
+    SpatialIndex::QueryFrustum(ComponentType::ModelRenderer, planes, m_Candidates);
+
+    for (auto component : m_Candidates)
+    {
+        auto modelRenderer = static_cast<ModelRenderer*>(component);
+
+        if (!modelRenderer->IsWorldEnabled() || !modelRenderer->GetModel())
+        {
+            continue;
+        }
+
+        // The tree only knows about the fattened bounds, so test the exact bounds as well.
+        const auto& bounds = modelRenderer->GetRenderingHintData().WorldBounds;
+
+        m_PackedBounds.Add(modelRenderer, (bounds.Min + bounds.Max) * 0.5f, (bounds.Max - bounds.Min) * 0.5f);
+    }
+
+    TestBounds(m_PackedBounds, planes);
+
+    int visibleObjects = 0;
+
+    for (std::size_t i = 0; i < m_PackedBounds.ModelRenderers.size(); i++)
+    {
+        const bool visible = m_PackedBounds.Visible[i];
+
+        m_PackedBounds.ModelRenderers[i]->GetRenderingHintData().HasPassedFrustumCulling = visible;
+
+        if (visible)
+            visibleObjects++;
+    }
+
+    statistics.VisibleObjects += visibleObjects;
+    statistics.CulledObjects += static_cast<int>(SpatialIndex::GetCount(ComponentType::ModelRenderer)) - visibleObjects;
+}
@@ -1,7 +1,10 @@
 ﻿#pragma once
+#include "Pine/Rendering/RenderingContext.hpp"
 #include "Pine/World/Components/Camera/Camera.hpp"
 
 namespace Pine::Rendering::RenderCulling
 {
-    void RunFrustumCulling(const Camera* camera);
+    // Tests the bounds of every model renderer against the camera's frustum planes, and stores the result
+    // in the renderer's hint data. The number of visible and culled objects are added to the statistics.
+    void RunFrustumCulling(const Camera* camera, RenderingStatistics& statistics);
 }
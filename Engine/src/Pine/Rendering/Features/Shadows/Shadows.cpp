@@ -3,6 +3,7 @@
 #include "Pine/Assets/Assets.hpp"
 #include "Pine/Assets/Model/Model.hpp"
 #include "Pine/Graphics/Graphics.hpp"
+#include "Pine/Rendering/CommandBuffer/CommandBuffer.hpp"
 #include "Pine/Rendering/Pipeline/Pipeline3D/Pipeline3D.hpp"
 #include "Pine/Rendering/Renderer3D/Renderer3D.hpp"
 #include "Pine/Rendering/Renderer3D/ShaderStorages.hpp"
@@ -23,6 +24,8 @@ namespace
 
     Graphics::IFrameBuffer* m_DirectionalShadowMapBuffer = nullptr;
 
+    Rendering::CommandBuffer m_ShadowCommands;
+
     Vector3f ComputeBoxCenter(const std::array<Vector3f, 8>& corners)
     {
         auto min = Vector3f(std::numeric_limits<float>::max());
@@ -65,49 +68,17 @@ namespace
 
     void RenderScene(const Rendering::ObjectBatchMap& mapBatch, const Camera* sceneCamera)
     {
-        const auto cameraPosition = sceneCamera->GetParent()->GetTransform()->GetPosition();
-
-        for (const auto& [modelGroup, objectRenderInstances] : mapBatch)
-        {
-            const auto model = modelGroup.Model;
-
-            int meshIndex = -1;
-            for (const auto mesh : model->GetMeshes())
-            {
-                meshIndex++;
-
-                Renderer3D::PrepareMesh(mesh);
-
-                for (const auto [renderer, distance] : objectRenderInstances)
-                {
-                    const auto modelRenderer = renderer;
+        Rendering::CommandRecordSettings settings;
 
-                    auto modelRendererTransform = modelRenderer->GetParent()->GetTransform();
+        // Everything around the camera casts shadows, whether it's visible or not.
+        settings.RequireFrustumCulling = false;
+        settings.StencilOverrides = false;
+        settings.ViewPosition = sceneCamera->GetParent()->GetTransform()->GetPosition();
+        settings.MaxDistanceSquared = MAX_SHADOW_DISTANCE;
 
-                    if (glm::distance2(cameraPosition, modelRendererTransform->GetLocalPosition()) > MAX_SHADOW_DISTANCE)
-                    {
-                        continue;
-                    }
-
-                    modelRendererTransform->OnRender(0.f);
-
-                    if (const int modelMeshIndex = modelRenderer->GetModelMeshIndex(); modelMeshIndex >= 0)
-                    {
-                        if (modelMeshIndex != meshIndex)
-                        {
-                            continue;
-                        }
-                    }
-
-                    if (Renderer3D::AddInstance(modelRendererTransform->GetTransformationMatrix()))
-                    {
-                        Renderer3D::RenderMeshInstanced();
-                    }
-                }
-
-                Renderer3D::RenderMeshInstanced();
-            }
-        }
+        m_ShadowCommands.Reset();
+        m_ShadowCommands.Record(mapBatch, settings);
+        m_ShadowCommands.Submit();
     }
 
     void BuildLightSpaceMatrices(Vector3f lightDirection)
@@ -24,6 +24,10 @@ namespace
         RenderItemType m_Type = RenderItemType::SpriteRenderer;
         Pine::IComponent* m_ComponentPointer = nullptr;
         int m_Order = 0;
+
+        // Only used to group sprites with the same shader and texture together.
+        const Pine::Shader* m_Shader = nullptr;
+        const Pine::Graphics::ITexture* m_Texture = nullptr;
     };
 
     std::vector<Drawable> m_RenderItems;
@@ -41,23 +45,37 @@ void Pine::Pipeline2D::Run(RenderingContext& context)
 {
     PINE_PF_SCOPE();
 
+    // Items with the same order have no defined order between them, which lets us put sprites with the same
+    // shader and texture next to each other so Renderer2D can draw them in as few batches as possible.
     static const auto renderItemSort = [](const Drawable& a, const Drawable& b)
     {
-        return a.m_Order < b.m_Order;
+        if (a.m_Order != b.m_Order)
+            return a.m_Order < b.m_Order;
+        if (a.m_Type != b.m_Type)
+            return a.m_Type < b.m_Type;
+        if (a.m_Shader != b.m_Shader)
+            return std::less<const Shader*>()(a.m_Shader, b.m_Shader);
+
+        return std::less<const Graphics::ITexture*>()(a.m_Texture, b.m_Texture);
     };
 
     // This should keep the capacity the same from the last frame, which should avoid
     // us having to do re-allocations all the time.
     m_RenderItems.clear();
 
+    // Sprites are drawn with the override shader, if there is one.
+    const auto shader = Renderer2D::GetOverrideShader();
+
     for (auto& spriteRenderer : Components::Get<SpriteRenderer>())
     {
-        m_RenderItems.push_back({RenderItemType::SpriteRenderer, &spriteRenderer, spriteRenderer.GetOrder()});
+        const auto texture = spriteRenderer.GetTexture() ? spriteRenderer.GetTexture()->GetGraphicsTexture() : nullptr;
+
+        m_RenderItems.push_back({RenderItemType::SpriteRenderer, &spriteRenderer, spriteRenderer.GetOrder(), shader, texture});
     }
 
     for (auto& tilemapRenderer : Components::Get<TilemapRenderer>())
     {
-        m_RenderItems.push_back({RenderItemType::TilemapRenderer, &tilemapRenderer, tilemapRenderer.GetOrder()});
+        m_RenderItems.push_back({RenderItemType::TilemapRenderer, &tilemapRenderer, tilemapRenderer.GetOrder(), shader});
     }
 
     std::sort(m_RenderItems.begin(), m_RenderItems.end(), renderItemSort);
@@ -108,25 +126,12 @@ void Pine::Pipeline2D::Run(RenderingContext& context)
             }
 
             auto tileMap = tilemapRenderer->GetTilemap();
-            auto textureAtlas = tileMap->GetTileset()->GetTextureAtlas();
             auto tileSize = static_cast<float>(tileMap->GetTileset()->GetTileSize()) * transform->GetScale().x;
 
             auto positionOffset = Vector2f(transform->GetPosition()) * context.Size;
 
             Renderer2D::SetCoordinateSystem(Rendering::CoordinateSystem::Screen);
-
-            for (auto& tile : tileMap->GetTiles())
-            {
-                if (tile.m_Flags & TileFlags_Hidden)
-                    continue;
-
-                Renderer2D::AddTextureAtlasItem(positionOffset + Vector2f(tileSize * static_cast<float>(tile.m_Position.x), tileSize * static_cast<float>(tile.m_Position.y)),
-                                                tileSize,
-                                                textureAtlas,
-                                                tile.m_RenderIndex,
-                                                Color(255, 255, 255, 255));
-            }
-
+            Renderer2D::AddTilemap(tileMap, positionOffset, tileSize);
             Renderer2D::SetCoordinateSystem(Rendering::CoordinateSystem::World);
         }
     }
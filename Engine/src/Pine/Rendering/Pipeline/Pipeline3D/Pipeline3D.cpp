@@ -3,12 +3,15 @@
 #include "Pine/Assets/Assets.hpp"
 #include "Pine/Assets/Level/Level.hpp"
 #include "Pine/Rendering/Renderer3D/Renderer3D.hpp"
+#include "Pine/Rendering/CommandBuffer/CommandBuffer.hpp"
 #include "Pine/World/Entity/Entity.hpp"
+#include "Pine/World/Components/Camera/Camera.hpp"
 #include "Pine/World/Components/ModelRenderer/ModelRenderer.hpp"
 #include "Pine/World/Components/Light/Light.hpp"
 #include "Pine/Graphics/Graphics.hpp"
 #include "Pine/Performance/Performance.hpp"
 #include "Pine/Rendering/Features/AmbientOcclusion/AmbientOcclusion.hpp"
+#include "Pine/Rendering/Features/LightClusters/LightClusters.hpp"
 #include "Pine/Rendering/Features/RenderCulling/RenderCulling.hpp"
 #include "Pine/Rendering/Features/Shadows/Shadows.hpp"
 #include "Pine/Rendering/Features/Skybox/Skybox.hpp"
@@ -29,90 +32,24 @@ namespace
 
 	PipelineConfiguration m_Configuration;
 
-	void RenderBatch(const Rendering::ObjectBatchMap& mapBatch, MaterialRenderingMode materialRenderingMode)
+	// Recorded again every frame, kept around so their memory can be reused.
+	Rendering::CommandBuffer m_DepthCommands;
+	Rendering::CommandBuffer m_SceneCommands;
+
+	Rendering::CommandRecordSettings CreateRecordSettings(const RenderingContext& context, std::uint32_t pass, MaterialRenderingMode materialRenderingMode)
 	{
-		for (const auto& [modelGroup, objectRenderInstances] : mapBatch)
-		{
-			const auto model = modelGroup.Model;
+		Rendering::CommandRecordSettings settings;
 
-			int meshIndex = -1;
-			for (const auto mesh : model->GetMeshes())
-			{
-				meshIndex++;
-
-				// Make sure we're rendering materials with the correct mode
-				const auto material = modelGroup.OverrideMaterial != nullptr ? modelGroup.OverrideMaterial : mesh->GetMaterial();
-				if (material && material->GetRenderingMode() != materialRenderingMode)
-				{
-					continue;
-				}
-
-				Renderer3D::PrepareMesh(mesh, modelGroup.OverrideMaterial);
-
-				bool hasStencilBufferOverride = false;
-
-				for (auto [renderer, distance] : objectRenderInstances)
-				{
-					const auto modelRenderer = renderer;
-
-				    if (!modelRenderer->GetRenderingHintData().HasPassedFrustumCulling)
-				    {
-				        continue;
-				    }
-
-					modelRenderer->GetParent()->GetTransform()->OnRender(0.f);
-
-					int modelMeshIndex = modelRenderer->GetModelMeshIndex();
-					if (modelMeshIndex >= 0)
-					{
-						if (modelMeshIndex != meshIndex)
-						{
-							continue;
-						}
-					}
-
-				    if (modelRenderer->GetOverrideStencilBuffer())
-				    {
-				        hasStencilBufferOverride = true;
-				        continue;
-				    }
-
-					if (Renderer3D::AddInstance(
-					    modelRenderer->GetParent()->GetTransform()->GetTransformationMatrix(),
-					    &modelRenderer->GetRenderingHintData()))
-					{
-						Renderer3D::RenderMeshInstanced();
-					}
-				}
-
-				Renderer3D::RenderMeshInstanced();
-
-				if (hasStencilBufferOverride)
-				{
-					for (const auto [renderer, distance] : objectRenderInstances)
-					{
-					    int modelMeshIndex = renderer->GetModelMeshIndex();
-					    if (modelMeshIndex >= 0)
-					    {
-					        if (modelMeshIndex != meshIndex)
-					        {
-					            continue;
-					        }
-					    }
-
-						if (renderer->GetOverrideStencilBuffer())
-						{
-							renderer->GetParent()->GetTransform()->OnRender(0.f);
-
-							Renderer3D::RenderMesh(
-							    renderer->GetParent()->GetTransform()->GetTransformationMatrix(),
-							    &renderer->GetRenderingHintData(),
-							    renderer->GetStencilBufferValue());
-						}
-					}
-				}
-			}
+		settings.Pass = pass;
+		settings.FilterRenderingMode = true;
+		settings.RenderingMode = materialRenderingMode;
+
+		if (context.SceneCamera != nullptr)
+		{
+			settings.ViewPosition = context.SceneCamera->GetParent()->GetTransform()->GetPosition();
 		}
+
+		return settings;
 	}
 
 	void RenderDepthPrepass(RenderingContext& renderingContext)
@@ -140,7 +77,9 @@ namespace
 		renderSettings.IgnoreShaderVersions = true;
 		renderSettings.SkipMaterialInitialization = true;
 
-		RenderBatch(m_SceneContext.RenderingBatch.OpaqueObjects, MaterialRenderingMode::Opaque);
+		m_DepthCommands.Reset();
+		m_DepthCommands.Record(Rendering::SceneProcessor::GetRenderingBatch().OpaqueObjects, CreateRecordSettings(renderingContext, 0, MaterialRenderingMode::Opaque));
+		m_DepthCommands.Submit();
 
 		renderSettings.OverrideShader = nullptr;
 		renderSettings.IgnoreShaderVersions = false;
@@ -157,7 +96,7 @@ namespace
         {
             Renderer3D::SetCamera(context.SceneCamera);
 
-	        Rendering::RenderCulling::RunFrustumCulling(context.SceneCamera);
+	        Rendering::RenderCulling::RunFrustumCulling(context.SceneCamera, context.Statistics);
         }
 
         Renderer3D::UseRenderingContext(&context);
@@ -171,7 +110,11 @@ namespace
 
 		for (const auto light : lights)
 		{
-			Renderer3D::AddLight(light);
+			// Point and spot lights are added by the light clusters, as only the ones within the frustum are relevant.
+			if (light->GetLightType() == LightType::Directional)
+			{
+				Renderer3D::AddLight(light);
+			}
 
 			if (m_Configuration.RenderShadows)
 			{
@@ -179,13 +122,22 @@ namespace
 			}
 		}
 
+		if (context.SceneCamera)
+		{
+			Rendering::LightClusters::Build(context.SceneCamera);
+		}
+
 		Renderer3D::UploadLights();
 
-		// Render fully opaque objects.
-		RenderBatch(m_SceneContext.RenderingBatch.OpaqueObjects, MaterialRenderingMode::Opaque);
+		const auto& opaqueObjects = Rendering::SceneProcessor::GetRenderingBatch().OpaqueObjects;
+
+		m_SceneCommands.Reset();
+
+		// Render fully opaque objects first, then the objects which require discarding.
+		m_SceneCommands.Record(opaqueObjects, CreateRecordSettings(context, 0, MaterialRenderingMode::Opaque));
+		m_SceneCommands.Record(opaqueObjects, CreateRecordSettings(context, 1, MaterialRenderingMode::Discard));
 
-		// Render objects which require discarding
-		RenderBatch(m_SceneContext.RenderingBatch.OpaqueObjects, MaterialRenderingMode::Discard);
+		m_SceneCommands.Submit();
 
 		// TODO: Render semi-transparent objects, we'll have to sort all objects by distance as well.
 
@@ -271,7 +223,7 @@ void Pipeline3D::Run(RenderingContext& context, PipelineStage stage)
 
 			for (const auto light : m_SceneContext.Lights)
 			{
-				Rendering::Shadows::RenderPassLight(light, m_SceneContext.RenderingBatch);
+				Rendering::Shadows::RenderPassLight(light, Rendering::SceneProcessor::GetRenderingBatch());
 			}
 		}
 
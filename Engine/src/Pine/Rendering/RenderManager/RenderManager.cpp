@@ -3,9 +3,9 @@
 #include "Pine/Rendering/Pipeline/Pipeline2D/Pipeline2D.hpp"
 #include "Pine/Rendering/Pipeline/Pipeline3D/Pipeline3D.hpp"
 #include "Pine/World/World.hpp"
+#include "Pine/World/SpatialIndex/SpatialIndex.hpp"
 #include "Pine/Assets/Level/Level.hpp"
 #include <vector>
-#include <GLFW/glfw3.h>
 
 #include "Pine/Core/Timer/Timer.hpp"
 #include "Pine/Performance/Performance.hpp"
@@ -89,7 +89,7 @@ void Pine::RenderManager::Run()
 
     static auto engineConfig = Engine::GetEngineConfiguration();
 
-    double currentFrameTime = glfwGetTime();
+    double currentFrameTime = Engine::GetTime();
 
     double deltaTime = currentFrameTime - m_LastFrameTime;
     auto fDeltaTime = static_cast<float>(deltaTime);
@@ -98,15 +98,11 @@ void Pine::RenderManager::Run()
 
     CallRenderCallback(nullptr, RenderStage::PreRender, fDeltaTime);
 
-    // If we're in for example the editor, we'll always want to update
-    // the transformation matrices etc.
-    if (!engineConfig.m_ProductionMode)
-    {
-        for (auto& transform : Components::Get<Transform>(true))
-        {
-            transform.OnRender(fDeltaTime);
-        }
-    }
+    // Anything moved since the world update, by scripts for example, has to be brought up to date
+    // before we start rendering.
+    Transform::UpdateWorldTransforms();
+
+    SpatialIndex::Update();
 
     Pipeline3D::Prepare();
 
@@ -199,6 +195,8 @@ void Pine::RenderManager::Run()
     Graphics::GetGraphicsAPI()->BindFrameBuffer(nullptr);
 
     CallRenderCallback(nullptr, RenderStage::PostRender, fDeltaTime);
+
+    Transform::EndFrame();
 }
 
 void Pine::RenderManager::AddRenderCallback(const std::function<void(RenderingContext*, RenderStage, float)> &func)
@@ -2,10 +2,15 @@
 
 #include "Pine/Assets/Assets.hpp"
 #include "Pine/Assets/Shader/Shader.hpp"
+#include "Pine/Assets/Tilemap/Tilemap.hpp"
+#include "Pine/Core/String/String.hpp"
 #include "Pine/Graphics/Interfaces/IGraphicsAPI.hpp"
 #include "Pine/Graphics/Graphics.hpp"
 #include "Pine/Graphics/TextureAtlas/TextureAtlas.hpp"
+#include "Pine/Performance/Performance.hpp"
 #include "Pine/World/Entity/Entity.hpp"
+#include <array>
+#include <limits>
 #include <stdexcept>
 #include <vector>
 #include <unordered_map>
@@ -15,7 +20,10 @@ using namespace Pine;
 namespace
 {
     // Max amount of instances the 2D renderer may render before moving onto another draw call.
-    constexpr int MaxInstanceCount = 1024;
+    constexpr int MaxInstanceCount = 4096;
+
+    // The number of textures a single draw call can sample from, matches the sampler array in the 2D shaders.
+    constexpr int MaxTextureSlots = 16;
 
     // Cached graphics API for the current context
     Graphics::IGraphicsAPI* m_GraphicsAPI = nullptr;
@@ -47,10 +55,54 @@ namespace
         Graphics::ITexture* m_Texture = nullptr;
         Vector2f m_UvOffset = Vector2f(0.f);
         Vector2f m_UvScale = Vector2f(1.f);
+
+        // The override shader at the time the rectangle was added, if any.
+        Pine::Shader* m_Shader = nullptr;
+    };
+
+    struct TilemapItem
+    {
+        const Pine::Tilemap* m_Tilemap = nullptr;
+        Vector2f m_Position;
+        float m_TileSize = 0.f;
+        Rendering::CoordinateSystem m_CoordinateSystem;
+        Pine::Shader* m_Shader = nullptr;
+    };
+
+    namespace TextLayoutCache
+    {
+        struct TextLayout;
+    }
+
+    // The text itself is drawn from its cached layout, so only where and how it's drawn is stored per frame.
+    struct TextItem
+    {
+        TextLayoutCache::TextLayout* m_Layout = nullptr;
+
+        Vector2f m_Position;
+        Color m_Color;
+        Rendering::CoordinateSystem m_CoordinateSystem;
+        Pine::Shader* m_Shader = nullptr;
+    };
+
+    // Tilemaps and text are drawn from geometry that's kept around between frames rather than from the filled
+    // rectangles, so they're drawn in between the filled rectangles in the order everything was added.
+    struct CachedItem
+    {
+        bool m_IsText = false;
+
+        // Index into either the tilemaps or the text items.
+        std::size_t m_Index = 0;
+
+        // The number of filled rectangles added before the item.
+        std::size_t m_RectangleIndex = 0;
     };
 
     std::vector<Rectangle> m_FilledRectangles;
     std::vector<Rectangle> m_Rectangles;
+    std::vector<TilemapItem> m_Tilemaps;
+    std::vector<TextItem> m_TextItems;
+    std::vector<CachedItem> m_CachedItems;
 
     // TODO: Shouldn't we do this in the shader instead?
     Vector4f ComputePositionSize(const RenderingContext* context, Vector2f position, Vector2f size, Rendering::CoordinateSystem coordinateSystem)
@@ -85,6 +137,329 @@ namespace
         return {x, y, w, h};
     }
 
+    Vector2f ComputeScaling(const RenderingContext* context)
+    {
+        if (m_CoordinateSystem == Rendering::CoordinateSystem::Screen)
+            return Vector2f(1.f);
+
+        return Vector2f((context->Size.x / Rendering::PixelsPerUnit) / 2.f, (context->Size.y / Rendering::PixelsPerUnit) / 2.f);
+    }
+
+    // Laying out text is done once per string, the glyphs are then uploaded once and drawn from the same buffers for
+    // as long as the text is drawn.
+    namespace TextLayoutCache
+    {
+        // The number of frames a layout is kept around after it was last drawn.
+        constexpr std::uint64_t RetainFrameCount = 300;
+
+        struct TextLayout
+        {
+            Pine::Font* m_Font = nullptr;
+            std::uint32_t m_FontIndex = 0;
+
+            // The atlas the layout was made for, see FontData::m_Id, and its version at the time.
+            std::uint64_t m_AtlasId = 0;
+            std::uint32_t m_AtlasVersion = 0;
+
+            std::string m_Text;
+
+            // Positioned relative to the start of the text, in pixels.
+            std::vector<Rectangle> m_Glyphs;
+
+            // The glyphs as instance data, uploaded whenever the layout has been built.
+            Graphics::IVertexArray* m_VertexArray = nullptr;
+            Graphics::IVertexBuffer* m_PositionSizeBuffer = nullptr;
+            Graphics::IVertexBuffer* m_UvRadiusBuffer = nullptr;
+            int m_Capacity = 0;
+            bool m_Uploaded = false;
+
+            std::uint64_t m_LastUsedFrame = 0;
+        };
+
+        // Different strings may end up with the same key, which is why this is a multimap. Layouts stay where they are
+        // once added, so text items can point to them for the rest of the frame.
+        std::unordered_multimap<std::uint64_t, TextLayout> m_Layouts;
+
+        std::uint64_t m_FrameIndex = 0;
+
+        std::uint64_t GetLayoutKey(std::uint64_t atlasId, const std::string& str)
+        {
+            std::uint64_t key = std::hash<std::string>()(str);
+
+            key ^= std::hash<std::uint64_t>()(atlasId) + 0x9e3779b97f4a7c15ull + (key << 6) + (key >> 2);
+
+            return key;
+        }
+
+        void BuildLayout(TextLayout& layout)
+        {
+            static std::vector<std::uint32_t> codepoints;
+
+            codepoints.clear();
+
+            String::DecodeUtf8(layout.m_Text, codepoints);
+
+            // May grow the atlas, so the font data is only read afterwards.
+            layout.m_Font->PrepareGlyphs(layout.m_FontIndex, codepoints);
+
+            const auto& fontData = layout.m_Font->GetFontData(layout.m_FontIndex);
+            const auto textureAtlasSize = Vector2f(static_cast<float>(fontData.m_AtlasSize));
+
+            layout.m_AtlasVersion = fontData.m_AtlasVersion;
+            layout.m_Glyphs.clear();
+            layout.m_Uploaded = false;
+
+            float cursor = 0.f;
+
+            for (const auto codepoint : codepoints)
+            {
+                if (codepoint < 32)
+                    continue;
+
+                const auto it = fontData.m_Glyphs.find(codepoint);
+
+                if (it == fontData.m_Glyphs.end())
+                    continue;
+
+                const auto& chrData = it->second;
+
+                Rectangle glyph;
+
+                glyph.m_Position = Vector2f(cursor + chrData.xoff, chrData.yoff);
+                glyph.m_Size = Vector2f(chrData.x1 - chrData.x0, chrData.y1 - chrData.y0);
+                glyph.m_UvOffset = Vector2f(chrData.x0, chrData.y0) / textureAtlasSize;
+                glyph.m_UvScale = glyph.m_Size / textureAtlasSize;
+
+                // Whitespace only moves the cursor.
+                if (glyph.m_Size.x > 0.f && glyph.m_Size.y > 0.f)
+                    layout.m_Glyphs.push_back(glyph);
+
+                cursor += chrData.xadvance;
+            }
+        }
+
+        TextLayout& GetLayout(Pine::Font* font, std::uint32_t fontIndex, const std::string& str)
+        {
+            const auto atlasId = font->GetFontData(fontIndex).m_Id;
+            const auto key = GetLayoutKey(atlasId, str);
+
+            TextLayout* layout = nullptr;
+
+            for (auto [it, end] = m_Layouts.equal_range(key); it != end; ++it)
+            {
+                if (it->second.m_AtlasId == atlasId && it->second.m_Text == str)
+                {
+                    layout = &it->second;
+                    break;
+                }
+            }
+
+            if (layout == nullptr)
+            {
+                layout = &m_Layouts.emplace(key, TextLayout())->second;
+
+                layout->m_Font = font;
+                layout->m_FontIndex = fontIndex;
+                layout->m_AtlasId = atlasId;
+                layout->m_Text = str;
+
+                BuildLayout(*layout);
+            }
+
+            layout->m_LastUsedFrame = m_FrameIndex;
+
+            return *layout;
+        }
+
+        // Growing a font atlas moves every glyph in it, so the text drawn this frame is laid out again if the atlas of its
+        // font has grown since. That may grow the atlas once more, hence the loop.
+        void UpdateLayouts()
+        {
+            bool updated = true;
+
+            while (updated)
+            {
+                updated = false;
+
+                for (const auto& item : m_TextItems)
+                {
+                    auto& layout = *item.m_Layout;
+
+                    if (layout.m_AtlasVersion == layout.m_Font->GetFontData(layout.m_FontIndex).m_AtlasVersion)
+                        continue;
+
+                    BuildLayout(layout);
+
+                    updated = true;
+
+                    PINE_PF_COUNTER("Text relayouts", 1);
+                }
+            }
+        }
+
+        void ReleaseUnusedLayouts()
+        {
+            m_FrameIndex++;
+
+            if (m_FrameIndex % 60 != 0)
+                return;
+
+            for (auto it = m_Layouts.begin(); it != m_Layouts.end();)
+            {
+                if (m_FrameIndex - it->second.m_LastUsedFrame > RetainFrameCount)
+                {
+                    if (it->second.m_VertexArray != nullptr)
+                        m_GraphicsAPI->DestroyVertexArray(it->second.m_VertexArray);
+
+                    it = m_Layouts.erase(it);
+                }
+                else
+                {
+                    ++it;
+                }
+            }
+        }
+    }
+
+    // Small sprite textures are copied into one large texture the first time they're drawn, so sprites with different
+    // textures still share a texture slot and end up in the same instanced draw.
+    namespace SpriteAtlas
+    {
+        constexpr int AtlasSize = 2048;
+
+        // Larger textures would take up too much of the atlas, they're drawn from their own texture instead.
+        constexpr int MaxSpriteSize = 256;
+
+        // The transparent border kept around every sprite, so linear filtering doesn't pick up its neighbours.
+        constexpr int SpritePadding = 1;
+
+        // A full atlas is cleared at the start of the next frame, but no more often than this in case the
+        // sprites in use don't fit in it at all.
+        constexpr std::uint64_t MinResetFrameCount = 300;
+
+        struct Entry
+        {
+            Vector2f m_UvOffset;
+            Vector2f m_UvScale;
+        };
+
+        Graphics::ITexture* m_Texture = nullptr;
+
+        std::unordered_map<const Graphics::ITexture*, Entry> m_Entries;
+
+        // Sprites are packed left to right in rows, each row being as tall as the tallest sprite in it.
+        Vector2i m_RowPosition = Vector2i(0);
+        int m_RowHeight = 0;
+
+        bool m_Full = false;
+
+        std::uint64_t m_FrameIndex = 0;
+        std::uint64_t m_LastResetFrame = 0;
+
+        void Clear()
+        {
+            const std::vector<std::uint8_t> pixels(AtlasSize * AtlasSize * 4, 0);
+
+            m_Texture->Bind();
+            m_Texture->UploadTextureData(AtlasSize, AtlasSize, Graphics::TextureFormat::RGBA, Graphics::TextureDataFormat::UnsignedByte, const_cast<std::uint8_t*>(pixels.data()));
+        }
+
+        void Create()
+        {
+            m_Texture = m_GraphicsAPI->CreateTexture();
+
+            Clear();
+
+            // The atlas has no mipmaps, so sprites drawn from it are filtered like the tilemap atlases are.
+            m_Texture->SetFilteringMode(Graphics::TextureFilteringMode::Linear);
+            m_Texture->SetTextureWrapMode(Graphics::TextureWrapMode::ClampToEdge);
+        }
+
+        bool Allocate(Vector2i size, Vector2i& position)
+        {
+            const auto paddedSize = size + Vector2i(SpritePadding * 2);
+
+            if (m_RowPosition.x + paddedSize.x > AtlasSize)
+            {
+                m_RowPosition = Vector2i(0, m_RowPosition.y + m_RowHeight);
+                m_RowHeight = 0;
+            }
+
+            if (m_RowPosition.y + paddedSize.y > AtlasSize)
+                return false;
+
+            position = m_RowPosition + Vector2i(SpritePadding);
+
+            m_RowPosition.x += paddedSize.x;
+            m_RowHeight = std::max(m_RowHeight, paddedSize.y);
+
+            return true;
+        }
+
+        // Makes the rectangle draw its texture from the atlas, if the texture fits in it. The rectangle has
+        // to cover the whole texture, as the atlas can't repeat it.
+        void Map(Rectangle& rectangle)
+        {
+            const auto texture = rectangle.m_Texture;
+
+            auto it = m_Entries.find(texture);
+
+            if (it == m_Entries.end())
+            {
+                if (m_Full ||
+                    texture->GetType() != Graphics::TextureType::Texture2D ||
+                    texture->GetTextureFormat() != Graphics::TextureFormat::RGBA ||
+                    texture->IsMultiSampled() ||
+                    texture->GetWidth() <= 0 || texture->GetWidth() > MaxSpriteSize ||
+                    texture->GetHeight() <= 0 || texture->GetHeight() > MaxSpriteSize)
+                {
+                    return;
+                }
+
+                const auto size = Vector2i(texture->GetWidth(), texture->GetHeight());
+
+                Vector2i position;
+
+                if (!Allocate(size, position))
+                {
+                    m_Full = true;
+                    return;
+                }
+
+                if (m_Texture == nullptr)
+                    Create();
+
+                m_Texture->CopyTextureSubData(texture, position);
+
+                PINE_PF_COUNTER("Sprite atlas copies", 1);
+
+                it = m_Entries.emplace(texture, Entry { Vector2f(position) / static_cast<float>(AtlasSize), Vector2f(size) / static_cast<float>(AtlasSize) }).first;
+            }
+
+            rectangle.m_Texture = m_Texture;
+            rectangle.m_UvOffset = it->second.m_UvOffset;
+            rectangle.m_UvScale = it->second.m_UvScale;
+        }
+
+        void PrepareFrame()
+        {
+            m_FrameIndex++;
+
+            if (!m_Full || m_FrameIndex - m_LastResetFrame < MinResetFrameCount)
+                return;
+
+            // Start over, so the atlas only holds the sprites that are still in use.
+            m_Entries.clear();
+
+            m_RowPosition = Vector2i(0);
+            m_RowHeight = 0;
+            m_Full = false;
+            m_LastResetFrame = m_FrameIndex;
+
+            Clear();
+        }
+    }
+
     // I kind of dislike how this code is structured right now
     // might work on this later as it's not a high priority right now.
     namespace RectangleRenderer
@@ -179,64 +554,100 @@ namespace
                 m_Ready = true;
             }
 
-            void Render(RenderingContext* context, const std::vector<Rectangle>& rects) const
+            void Render(RenderingContext* context, const Rectangle* rects, int count) const
             {
-                const Pine::Shader* shader = m_OverrideShader == nullptr ? m_Shader : m_OverrideShader;
+                // A batch is drawn with a single shader, so each run of rectangles sharing one is drawn separately.
+                int startIndex = 0;
+                while (startIndex < count)
+                {
+                    const auto shader = rects[startIndex].m_Shader;
+
+                    int endIndex = startIndex + 1;
+                    while (endIndex < count && rects[endIndex].m_Shader == shader)
+                        endIndex++;
+
+                    Render(context, rects + startIndex, endIndex - startIndex, shader == nullptr ? m_Shader : shader);
 
+                    startIndex = endIndex;
+                }
+            }
+
+            void Render(RenderingContext* context, const Rectangle* rects, int count, const Pine::Shader* shader) const
+            {
                 shader->GetProgram()->Use();
 
                 m_VertexArray->Bind();
                 m_DefaultTexture->Bind();
 
-                const Vector2f scaling = m_CoordinateSystem == Rendering::CoordinateSystem::Screen ?
-                                    Vector2f(1.f) :
-                                    Vector2f((context->Size.x / Rendering::PixelsPerUnit) / 2.f, (context->Size.y / Rendering::PixelsPerUnit) / 2.f);
-
                 shader->GetProgram()->GetUniformVariable("m_ViewMatrix")->LoadMatrix4(m_ViewMatrix);
                 shader->GetProgram()->GetUniformVariable("m_ProjectionMatrix")->LoadMatrix4(m_ProjectionMatrix);
-                shader->GetProgram()->GetUniformVariable("m_Scaling")->LoadVector2(scaling);
-
-                // Prepare the new instance data for the next batch of rectangles
-                std::vector<Vector4f> rectPositionSizeData;
-                std::vector<Vector4f> rectUvTransformData;
-                std::vector<Vector4f> rectColorData;
-                std::vector<Vector3f> rectTextureIndexRadiusData;
+                shader->GetProgram()->GetUniformVariable("m_Scaling")->LoadVector2(ComputeScaling(context));
+                shader->GetProgram()->GetUniformVariable("m_InstanceTransform")->LoadVector4(Vector4f(1.f, 1.f, 0.f, 0.f));
+                shader->GetProgram()->GetUniformVariable("m_InstanceSizeScale")->LoadVector2(Vector2f(1.f));
+                shader->GetProgram()->GetUniformVariable("m_InstanceSizeOffset")->LoadVector2(Vector2f(0.f));
+                shader->GetProgram()->GetUniformVariable("m_InstanceColor")->LoadVector4(Vector4f(1.f));
+
+                // Prepare the new instance data for the next batch of rectangles, kept around to avoid re-allocations.
+                static std::vector<Vector4f> rectPositionSizeData;
+                static std::vector<Vector4f> rectUvTransformData;
+                static std::vector<Vector4f> rectColorData;
+                static std::vector<Vector3f> rectTextureIndexRadiusData;
+
+                rectPositionSizeData.resize(MaxInstanceCount);
+                rectUvTransformData.resize(MaxInstanceCount);
+                rectColorData.resize(MaxInstanceCount);
+                rectTextureIndexRadiusData.resize(MaxInstanceCount);
+
+                // Slot 0 is used by the default texture.
+                const int textureSlotCount = std::min(m_GraphicsAPI->GetSupportedTextureSlots(), MaxTextureSlots);
 
                 int startIndex = 0;
-                while (startIndex < static_cast<int>(rects.size()))
+                while (startIndex < count)
                 {
-                	int minSize = std::min(static_cast<int>(rects.size()) - startIndex, MaxInstanceCount);
+                	int minSize = std::min(count - startIndex, MaxInstanceCount);
 
-                    // To avoid re-allocations, we can fill out the vector directly
-                    rectPositionSizeData.resize(minSize);
-                    rectUvTransformData.resize(minSize);
-                    rectColorData.resize(minSize);
-                    rectTextureIndexRadiusData.resize(minSize);
-
-                    int vertexBufferIndex = 0;
+                    // The textures bound for this batch, the index being the texture slot.
+                    std::array<Graphics::ITexture*, MaxTextureSlots> textures = {};
                     int currentTextureSlot = 1;
 
-                    // To keep track of which textures we currently have in this instance batch,
-                    // and their respective indices.
-                    std::unordered_map<Graphics::ITexture*, int> textures;
+                    int vertexBufferIndex = 0;
 
                     // Fill up the vertex buffer instance data
                     for (int i = startIndex; i < startIndex + minSize;i++)
                     {
                         const auto& rect = rects[i];
 
-                        // If we've reached the instance count limit, hop out of the loop
-                        if (vertexBufferIndex >= MaxInstanceCount)
-                        {
-                            minSize = i - startIndex;
-                            break;
-                        }
+                        int textureSlot = 0;
 
-                        // Or if we've reached the maximum number of textures
-                        if (currentTextureSlot >= m_GraphicsAPI->GetSupportedTextureSlots())
+                        if (rect.m_Texture != nullptr)
                         {
-                            minSize = i - startIndex;
-                            break;
+                            // Pipeline2D sorts sprites by texture within their order, so the texture we're looking
+                            // for is usually the most recently bound one.
+                            for (int slot = currentTextureSlot - 1; slot >= 1; slot--)
+                            {
+                                if (textures[slot] == rect.m_Texture)
+                                {
+                                    textureSlot = slot;
+                                    break;
+                                }
+                            }
+
+                            if (textureSlot == 0)
+                            {
+                                // Only a new texture which doesn't fit in the remaining slots ends the batch.
+                                if (currentTextureSlot >= textureSlotCount)
+                                {
+                                    minSize = i - startIndex;
+                                    break;
+                                }
+
+                                rect.m_Texture->Bind(currentTextureSlot);
+
+                                textures[currentTextureSlot] = rect.m_Texture;
+                                textureSlot = currentTextureSlot;
+
+                                currentTextureSlot++;
+                            }
                         }
 
                         rectPositionSizeData[vertexBufferIndex] = ComputePositionSize(context, rect.m_Position, rect.m_Size, rect.m_CoordinateSystem);
@@ -251,27 +662,10 @@ namespace
                                                                     static_cast<float>(rect.m_Color.b) / 255.f,
                                                                     static_cast<float>(rect.m_Color.a) / 255.f);
 
+                        rectTextureIndexRadiusData[vertexBufferIndex].x = static_cast<float>(textureSlot);
                         rectTextureIndexRadiusData[vertexBufferIndex].y = rect.m_Radius;
                         rectTextureIndexRadiusData[vertexBufferIndex].z = -rect.m_Rotation;
 
-                        if (rect.m_Texture != nullptr)
-                        {
-                            if (textures.count(rect.m_Texture) == 0)
-                            {
-                                rect.m_Texture->Bind(currentTextureSlot);
-
-                                textures[rect.m_Texture] = currentTextureSlot;
-
-                                currentTextureSlot++;
-                            }
-
-                            rectTextureIndexRadiusData[vertexBufferIndex].x = static_cast<float>(textures[rect.m_Texture]);
-                        }
-                        else
-                        {
-                            rectTextureIndexRadiusData[vertexBufferIndex].x = 0.f;
-                        }
-
                         vertexBufferIndex++;
                     }
 
@@ -292,8 +686,19 @@ namespace
                     m_GraphicsAPI->DrawElementsInstanced(m_RenderLines ? Graphics::RenderMode::LineLoop : Graphics::RenderMode::Triangles, m_RenderCount, minSize);
 
                     context->Statistics.DrawCalls++;
+                    context->Statistics.Batches2D++;
+
+                    PINE_PF_COUNTER("2D batches", 1);
 
                     startIndex += minSize;
+
+                    // The batch was cut short by the instance or texture slot limit, rather than by the end of the rectangles.
+                    if (startIndex < count)
+                    {
+                        context->Statistics.BatchFlushes2D++;
+
+                        PINE_PF_COUNTER("2D batch flushes", 1);
+                    }
                 }
             }
         };
@@ -301,6 +706,350 @@ namespace
         RectangleInstanceRenderContext m_FilledRectangleRender;
         RectangleInstanceRenderContext m_RectangleRender;
 
+        // Creates a vertex array for up to instanceCount rectangles whose positions and uvs are kept around between
+        // frames. Every rectangle is drawn in white from the texture in slot 1, the color is set through the shader.
+        Graphics::IVertexArray* CreateCachedGeometry(int instanceCount, Graphics::IVertexBuffer*& positionSizeBuffer, Graphics::IVertexBuffer*& uvRadiusBuffer)
+        {
+            const auto vertexArray = m_GraphicsAPI->CreateVertexArray();
+            vertexArray->Bind();
+
+            std::vector<float> vertices =
+            {
+                -1.f, 1.f, 0.f,
+                -1.f, -1.f, 0.f,
+                1.f, -1.f, 0.f,
+                1.f, 1.f, 0.f,
+            };
+
+            std::vector<float> uvs = { 0, 0, 0, 1, 1, 1, 1, 0 };
+
+            std::vector<std::uint32_t> indices =
+            {
+                0,1,3,
+                3,1,2
+            };
+
+            vertexArray->StoreFloatArrayBuffer(vertices.data(), vertices.size() * sizeof(float), 0, 3, Graphics::BufferUsageHint::StaticDraw);
+            vertexArray->StoreFloatArrayBuffer(uvs.data(), uvs.size() * sizeof(float), 1, 2, Graphics::BufferUsageHint::StaticDraw);
+            vertexArray->StoreElementArrayBuffer(indices.data(), indices.size() * sizeof(int));
+
+            positionSizeBuffer = vertexArray->CreateFloatArrayBuffer(sizeof(Vector4f) * instanceCount, 2, 4, Graphics::BufferUsageHint::StaticDraw);
+            positionSizeBuffer->SetDivisor(Graphics::VertexBufferDivisor::PerInstance, 1);
+
+            uvRadiusBuffer = vertexArray->CreateFloatArrayBuffer(sizeof(Vector4f) * instanceCount, 3, 4, Graphics::BufferUsageHint::StaticDraw);
+            uvRadiusBuffer->SetDivisor(Graphics::VertexBufferDivisor::PerInstance, 1);
+
+            const std::vector<Vector4f> colors(instanceCount, Vector4f(1.f));
+            const std::vector<Vector3f> textureRotations(instanceCount, Vector3f(1.f, 0.f, 0.f));
+
+            auto colorBuffer = vertexArray->CreateFloatArrayBuffer(sizeof(Vector4f) * instanceCount, 4, 4, Graphics::BufferUsageHint::StaticDraw);
+            colorBuffer->SetDivisor(Graphics::VertexBufferDivisor::PerInstance, 1);
+            colorBuffer->UploadData(colors.data(), sizeof(Vector4f) * instanceCount, 0);
+
+            auto textureRotationBuffer = vertexArray->CreateFloatArrayBuffer(sizeof(Vector3f) * instanceCount, 5, 3, Graphics::BufferUsageHint::StaticDraw);
+            textureRotationBuffer->SetDivisor(Graphics::VertexBufferDivisor::PerInstance, 1);
+            textureRotationBuffer->UploadData(textureRotations.data(), sizeof(Vector3f) * instanceCount, 0);
+
+            return vertexArray;
+        }
+
+        // Tilemaps are drawn chunk by chunk from instance buffers that are kept around between frames, and
+        // only rebuilt once the chunk has changed.
+        namespace TileChunkRenderer
+        {
+            // The buffers of chunks that haven't been drawn for this many frames are released.
+            constexpr std::uint64_t RetainFrameCount = 300;
+
+            struct ChunkGeometry
+            {
+                Graphics::IVertexArray* m_VertexArray = nullptr;
+
+                Graphics::IVertexBuffer* m_PositionSizeBuffer = nullptr;
+                Graphics::IVertexBuffer* m_UvRadiusBuffer = nullptr;
+
+                const Graphics::TextureAtlas* m_Atlas = nullptr;
+                std::uint32_t m_Version = 0;
+
+                int m_InstanceCount = 0;
+
+                std::uint64_t m_LastUsedFrame = 0;
+            };
+
+            std::unordered_map<std::uint64_t, ChunkGeometry> m_ChunkGeometry;
+
+            std::uint64_t m_FrameIndex = 0;
+
+            void UpdateGeometry(ChunkGeometry& geometry, const TileChunk& chunk, const Graphics::TextureAtlas* atlas)
+            {
+                PINE_PF_COUNTER("Tilemap chunk uploads", 1);
+
+                static std::vector<Vector4f> positionSizeData;
+                static std::vector<Vector4f> uvTransformData;
+
+                positionSizeData.clear();
+                uvTransformData.clear();
+
+                const auto uvScale = atlas->GetTextureUvScale();
+
+                for (int i = 0; i < TileChunkArea; i++)
+                {
+                    const auto& tile = chunk.m_Tiles[i];
+
+                    if (!chunk.m_Occupied[i] || tile.m_Flags & TileFlags_Hidden)
+                        continue;
+
+                    const auto& uvOffset = atlas->GetTextureUvOffset(tile.m_RenderIndex);
+
+                    // Positions are stored in tiles, the shader moves them into place.
+                    positionSizeData.emplace_back(static_cast<float>(tile.m_Position.x), static_cast<float>(tile.m_Position.y), 1.f, 1.f);
+                    uvTransformData.emplace_back(uvOffset.x, uvOffset.y, uvScale, -uvScale);
+                }
+
+                geometry.m_InstanceCount = static_cast<int>(positionSizeData.size());
+                geometry.m_Atlas = atlas;
+                geometry.m_Version = chunk.m_Version;
+
+                if (geometry.m_InstanceCount == 0)
+                    return;
+
+                geometry.m_VertexArray->Bind();
+
+                geometry.m_PositionSizeBuffer->Bind();
+                geometry.m_PositionSizeBuffer->UploadData(positionSizeData.data(), sizeof(Vector4f) * positionSizeData.size(), 0);
+
+                geometry.m_UvRadiusBuffer->Bind();
+                geometry.m_UvRadiusBuffer->UploadData(uvTransformData.data(), sizeof(Vector4f) * uvTransformData.size(), 0);
+            }
+
+            void RenderChunk(RenderingContext* context, const TileChunk& chunk, const Graphics::TextureAtlas* atlas)
+            {
+                auto& geometry = m_ChunkGeometry[chunk.m_Id];
+
+                if (geometry.m_VertexArray == nullptr)
+                {
+                    geometry.m_VertexArray = CreateCachedGeometry(TileChunkArea, geometry.m_PositionSizeBuffer, geometry.m_UvRadiusBuffer);
+
+                    UpdateGeometry(geometry, chunk, atlas);
+                }
+                else if (geometry.m_Version != chunk.m_Version || geometry.m_Atlas != atlas)
+                {
+                    UpdateGeometry(geometry, chunk, atlas);
+                }
+
+                geometry.m_LastUsedFrame = m_FrameIndex;
+
+                if (geometry.m_InstanceCount == 0)
+                    return;
+
+                geometry.m_VertexArray->Bind();
+
+                m_GraphicsAPI->DrawElementsInstanced(Graphics::RenderMode::Triangles, 6, geometry.m_InstanceCount);
+
+                context->Statistics.DrawCalls++;
+                context->Statistics.Batches2D++;
+
+                PINE_PF_COUNTER("Tilemap chunks drawn", 1);
+            }
+
+            void Render(RenderingContext* context, const TilemapItem& item)
+            {
+                const auto tileset = item.m_Tilemap->GetTileset();
+
+                if (tileset == nullptr || tileset->GetTextureAtlas() == nullptr || item.m_Tilemap->GetTileCount() == 0)
+                    return;
+
+                const auto atlas = tileset->GetTextureAtlas();
+                const auto tileSize = Vector2f(item.m_TileSize);
+
+                // The rectangle positions are linear in the tile positions, so the transform from one to
+                // the other can be derived from the first tile and its neighbour.
+                const auto origin = ComputePositionSize(context, item.m_Position, tileSize, item.m_CoordinateSystem);
+                const auto next = ComputePositionSize(context, item.m_Position + tileSize, tileSize, item.m_CoordinateSystem);
+
+                const auto tileStep = Vector2f(next.x - origin.x, next.y - origin.y);
+                const auto tileOffset = Vector2f(origin.x, origin.y);
+                const auto tileExtent = Vector2f(origin.z, origin.w) * ComputeScaling(context);
+
+                if (tileStep.x == 0.f || tileStep.y == 0.f)
+                    return;
+
+                // Find the visible area before the camera transform, and the tiles that may overlap it.
+                const auto inverseViewProjection = glm::inverse(m_ProjectionMatrix * m_ViewMatrix);
+
+                auto visibleMin = Vector2f(std::numeric_limits<float>::max());
+                auto visibleMax = Vector2f(std::numeric_limits<float>::lowest());
+
+                for (const auto& corner : { Vector2f(-1.f, -1.f), Vector2f(1.f, -1.f), Vector2f(-1.f, 1.f), Vector2f(1.f, 1.f) })
+                {
+                    const auto point = inverseViewProjection * Vector4f(corner.x, corner.y, 0.f, 1.f);
+
+                    visibleMin = glm::min(visibleMin, Vector2f(point.x, point.y) / point.w);
+                    visibleMax = glm::max(visibleMax, Vector2f(point.x, point.y) / point.w);
+                }
+
+                const auto tileA = (visibleMin - tileExtent - tileOffset) / tileStep;
+                const auto tileB = (visibleMax + tileExtent - tileOffset) / tileStep;
+
+                // Keep the range within what fits in an integer, in case the camera is zoomed out very far.
+                const auto tileMin = glm::clamp(glm::floor(glm::min(tileA, tileB)), Vector2f(-1e9f), Vector2f(1e9f));
+                const auto tileMax = glm::clamp(glm::ceil(glm::max(tileA, tileB)), Vector2f(-1e9f), Vector2f(1e9f));
+
+                const auto chunkMin = Tilemap::GetChunkPosition(Vector2i(tileMin));
+                const auto chunkMax = Tilemap::GetChunkPosition(Vector2i(tileMax));
+
+                auto shader = item.m_Shader == nullptr ? m_FilledRectangleRender.m_Shader : item.m_Shader;
+
+                shader->GetProgram()->Use();
+
+                shader->GetProgram()->GetUniformVariable("m_ViewMatrix")->LoadMatrix4(m_ViewMatrix);
+                shader->GetProgram()->GetUniformVariable("m_ProjectionMatrix")->LoadMatrix4(m_ProjectionMatrix);
+                shader->GetProgram()->GetUniformVariable("m_Scaling")->LoadVector2(ComputeScaling(context));
+                shader->GetProgram()->GetUniformVariable("m_InstanceTransform")->LoadVector4(Vector4f(tileStep.x, tileStep.y, tileOffset.x, tileOffset.y));
+                shader->GetProgram()->GetUniformVariable("m_InstanceSizeScale")->LoadVector2(Vector2f(origin.z, origin.w));
+                shader->GetProgram()->GetUniformVariable("m_InstanceSizeOffset")->LoadVector2(Vector2f(0.f));
+                shader->GetProgram()->GetUniformVariable("m_InstanceColor")->LoadVector4(Vector4f(1.f));
+
+                m_DefaultTexture->Bind();
+                atlas->GetColorBuffer()->Bind(1);
+
+                const auto& chunks = item.m_Tilemap->GetChunks();
+
+                const auto visibleChunkCount = (static_cast<double>(chunkMax.x) - chunkMin.x + 1.0) * (static_cast<double>(chunkMax.y) - chunkMin.y + 1.0);
+
+                // Look up the chunks in the visible area, unless that area has more chunks than the tilemap.
+                if (visibleChunkCount <= static_cast<double>(chunks.size()))
+                {
+                    for (int y = chunkMin.y; y <= chunkMax.y; y++)
+                    {
+                        for (int x = chunkMin.x; x <= chunkMax.x; x++)
+                        {
+                            if (const auto chunk = item.m_Tilemap->GetChunk(Vector2i(x, y)))
+                                RenderChunk(context, *chunk, atlas);
+                        }
+                    }
+                }
+                else
+                {
+                    for (const auto& [key, chunk] : chunks)
+                    {
+                        if (chunk.m_Position.x < chunkMin.x || chunk.m_Position.x > chunkMax.x ||
+                            chunk.m_Position.y < chunkMin.y || chunk.m_Position.y > chunkMax.y)
+                            continue;
+
+                        RenderChunk(context, chunk, atlas);
+                    }
+                }
+            }
+
+            void ReleaseUnusedGeometry()
+            {
+                m_FrameIndex++;
+
+                if (m_FrameIndex % 60 != 0)
+                    return;
+
+                for (auto it = m_ChunkGeometry.begin(); it != m_ChunkGeometry.end();)
+                {
+                    if (m_FrameIndex - it->second.m_LastUsedFrame > RetainFrameCount)
+                    {
+                        m_GraphicsAPI->DestroyVertexArray(it->second.m_VertexArray);
+
+                        it = m_ChunkGeometry.erase(it);
+                    }
+                    else
+                    {
+                        ++it;
+                    }
+                }
+            }
+        }
+
+        // Text is drawn from the instance buffers of its layout, which are moved into place and colored by the shader.
+        namespace TextRenderer
+        {
+            void UploadGeometry(TextLayoutCache::TextLayout& layout)
+            {
+                PINE_PF_COUNTER("Text layout uploads", 1);
+
+                const auto glyphCount = static_cast<int>(layout.m_Glyphs.size());
+
+                if (glyphCount > layout.m_Capacity)
+                {
+                    if (layout.m_VertexArray != nullptr)
+                        m_GraphicsAPI->DestroyVertexArray(layout.m_VertexArray);
+
+                    layout.m_VertexArray = CreateCachedGeometry(glyphCount, layout.m_PositionSizeBuffer, layout.m_UvRadiusBuffer);
+                    layout.m_Capacity = glyphCount;
+                }
+
+                static std::vector<Vector4f> positionSizeData;
+                static std::vector<Vector4f> uvTransformData;
+
+                positionSizeData.clear();
+                uvTransformData.clear();
+
+                for (const auto& glyph : layout.m_Glyphs)
+                {
+                    positionSizeData.emplace_back(glyph.m_Position.x, glyph.m_Position.y, glyph.m_Size.x, glyph.m_Size.y);
+                    uvTransformData.emplace_back(glyph.m_UvOffset.x, glyph.m_UvOffset.y, glyph.m_UvScale.x, glyph.m_UvScale.y);
+                }
+
+                layout.m_VertexArray->Bind();
+
+                layout.m_PositionSizeBuffer->Bind();
+                layout.m_PositionSizeBuffer->UploadData(positionSizeData.data(), sizeof(Vector4f) * positionSizeData.size(), 0);
+
+                layout.m_UvRadiusBuffer->Bind();
+                layout.m_UvRadiusBuffer->UploadData(uvTransformData.data(), sizeof(Vector4f) * uvTransformData.size(), 0);
+
+                layout.m_Uploaded = true;
+            }
+
+            void Render(RenderingContext* context, const TextItem& item)
+            {
+                auto& layout = *item.m_Layout;
+
+                if (layout.m_Glyphs.empty())
+                    return;
+
+                if (!layout.m_Uploaded)
+                    UploadGeometry(layout);
+
+                // The rectangle positions are linear in both the glyph positions and sizes, so the transform is derived
+                // from a rectangle at the start of the text, one pixel further, and one a pixel in size.
+                const auto origin = ComputePositionSize(context, item.m_Position, Vector2f(0.f), item.m_CoordinateSystem);
+                const auto next = ComputePositionSize(context, item.m_Position + Vector2f(1.f), Vector2f(0.f), item.m_CoordinateSystem);
+                const auto sized = ComputePositionSize(context, item.m_Position, Vector2f(1.f), item.m_CoordinateSystem);
+
+                auto shader = item.m_Shader == nullptr ? m_FilledRectangleRender.m_Shader : item.m_Shader;
+
+                shader->GetProgram()->Use();
+
+                shader->GetProgram()->GetUniformVariable("m_ViewMatrix")->LoadMatrix4(m_ViewMatrix);
+                shader->GetProgram()->GetUniformVariable("m_ProjectionMatrix")->LoadMatrix4(m_ProjectionMatrix);
+                shader->GetProgram()->GetUniformVariable("m_Scaling")->LoadVector2(ComputeScaling(context));
+                shader->GetProgram()->GetUniformVariable("m_InstanceTransform")->LoadVector4(Vector4f(next.x - origin.x, next.y - origin.y, origin.x, origin.y));
+                shader->GetProgram()->GetUniformVariable("m_InstanceSizeScale")->LoadVector2(Vector2f(sized.z, sized.w));
+                shader->GetProgram()->GetUniformVariable("m_InstanceSizeOffset")->LoadVector2(Vector2f(sized.x - origin.x, sized.y - origin.y));
+                shader->GetProgram()->GetUniformVariable("m_InstanceColor")->LoadVector4(Vector4f(static_cast<float>(item.m_Color.r) / 255.f,
+                                                                                                  static_cast<float>(item.m_Color.g) / 255.f,
+                                                                                                  static_cast<float>(item.m_Color.b) / 255.f,
+                                                                                                  static_cast<float>(item.m_Color.a) / 255.f));
+
+                m_DefaultTexture->Bind();
+                layout.m_Font->GetFontData(layout.m_FontIndex).m_TextureFontAtlas->Bind(1);
+
+                layout.m_VertexArray->Bind();
+
+                m_GraphicsAPI->DrawElementsInstanced(Graphics::RenderMode::Triangles, 6, static_cast<int>(layout.m_Glyphs.size()));
+
+                context->Statistics.DrawCalls++;
+                context->Statistics.Batches2D++;
+
+                PINE_PF_COUNTER("Text runs drawn", 1);
+            }
+        }
+
         void PrepareFrame()
         {
             if (m_FilledRectangleRender.m_Shader == nullptr)
@@ -323,27 +1072,46 @@ namespace
                 throw std::runtime_error("Renderer2D::RenderFrame(): Missing essential shaders.");
             }
 
-            if (!m_FilledRectangles.empty())
+            m_FilledRectangles.reserve(context->PreAllocItems);
+
+            // Tilemaps and text are drawn separately, so the filled rectangles are drawn in parts in between them.
+            std::size_t rectangleIndex = 0;
+
+            for (const auto& item : m_CachedItems)
             {
-                m_FilledRectangles.reserve(context->PreAllocItems);
+                if (item.m_RectangleIndex > rectangleIndex)
+                {
+                    m_FilledRectangleRender.Render(context, m_FilledRectangles.data() + rectangleIndex, static_cast<int>(item.m_RectangleIndex - rectangleIndex));
 
-                if (!m_FilledRectangles.empty())
-                    m_FilledRectangleRender.Render(context, m_FilledRectangles);
+                    rectangleIndex = item.m_RectangleIndex;
+                }
+
+                if (item.m_IsText)
+                    TextRenderer::Render(context, m_TextItems[item.m_Index]);
+                else
+                    TileChunkRenderer::Render(context, m_Tilemaps[item.m_Index]);
             }
 
+            if (m_FilledRectangles.size() > rectangleIndex)
+                m_FilledRectangleRender.Render(context, m_FilledRectangles.data() + rectangleIndex, static_cast<int>(m_FilledRectangles.size() - rectangleIndex));
+
             if (!m_Rectangles.empty())
             {
                 m_Rectangles.reserve(context->PreAllocItems);
 
                 if (!m_Rectangles.empty())
-                    m_RectangleRender.Render(context, m_Rectangles);
+                    m_RectangleRender.Render(context, m_Rectangles.data(), static_cast<int>(m_Rectangles.size()));
             }
+
+            TileChunkRenderer::ReleaseUnusedGeometry();
         }
     }
 }
 
 void Renderer2D::PrepareFrame()
 {
+    PINE_PF_ALLOCATION_SCOPE("Renderer2D");
+
     // Cache Graphics API
     m_GraphicsAPI = Graphics::GetGraphicsAPI();
 
@@ -365,14 +1133,21 @@ void Renderer2D::PrepareFrame()
     }
 
     RectangleRenderer::PrepareFrame();
+    SpriteAtlas::PrepareFrame();
+    TextLayoutCache::ReleaseUnusedLayouts();
 
     // Clear up stuff from the last frame
     m_FilledRectangles.clear();
     m_Rectangles.clear();
+    m_Tilemaps.clear();
+    m_TextItems.clear();
+    m_CachedItems.clear();
 }
 
 void Renderer2D::RenderFrame(RenderingContext* context)
 {
+    PINE_PF_ALLOCATION_SCOPE("Renderer2D");
+
     if (!context)
     {
         throw std::runtime_error("Renderer2D::RenderFrame(): No rendering context provided");
@@ -391,11 +1166,15 @@ void Renderer2D::RenderFrame(RenderingContext* context)
 
     Graphics::GetGraphicsAPI()->SetViewport(Vector2i(0), context->Size);
 
+    TextLayoutCache::UpdateLayouts();
+
     RectangleRenderer::RenderFrame(context);
 }
 
 void Renderer2D::AddFilledRectangle(Vector2f position, Vector2f size, float rotation, Color color)
 {
+    PINE_PF_ALLOCATION_SCOPE("Renderer2D");
+
     Rectangle rectangleItem =
     {
         position,
@@ -405,11 +1184,15 @@ void Renderer2D::AddFilledRectangle(Vector2f position, Vector2f size, float rota
         m_CoordinateSystem
     };
 
+    rectangleItem.m_Shader = m_OverrideShader;
+
     m_FilledRectangles.push_back(rectangleItem);
 }
 
 void Renderer2D::AddFilledTexturedRectangle(Vector2f position, Vector2f size, float rotation, Color color, const Texture2D* texture, Vector2f uvOffset, Vector2f uvScale)
 {
+    PINE_PF_ALLOCATION_SCOPE("Renderer2D");
+
     Rectangle rectangleItem =
     {
         position,
@@ -423,6 +1206,12 @@ void Renderer2D::AddFilledTexturedRectangle(Vector2f position, Vector2f size, fl
         uvScale
     };
 
+    rectangleItem.m_Shader = m_OverrideShader;
+
+    // Sprites covering their whole texture can be drawn from the sprite atlas, together with other sprites.
+    if (uvOffset == Vector2f(0.f) && uvScale == Vector2f(1.f))
+        SpriteAtlas::Map(rectangleItem);
+
     m_FilledRectangles.push_back(rectangleItem);
 }
 
@@ -442,11 +1231,15 @@ void Renderer2D::AddFilledTexturedRectangle(Vector2f position, Vector2f size, fl
         uvScale
     };
 
+    rectangleItem.m_Shader = m_OverrideShader;
+
     m_FilledRectangles.push_back(rectangleItem);
 }
 
 void Renderer2D::AddFilledRoundedRectangle(Vector2f position, Vector2f size, float radius, Color color)
 {
+    PINE_PF_ALLOCATION_SCOPE("Renderer2D");
+
     Rectangle rectangleItem =
     {
         position,
@@ -457,38 +1250,24 @@ void Renderer2D::AddFilledRoundedRectangle(Vector2f position, Vector2f size, flo
         radius
     };
 
+    rectangleItem.m_Shader = m_OverrideShader;
+
     m_FilledRectangles.push_back(rectangleItem);
 }
 
-void Renderer2D::AddText(Vector2f position, Color color, const std::string& str, const Pine::Font* font)
+void Renderer2D::AddText(Vector2f position, Color color, const std::string& str, Pine::Font* font, std::uint32_t fontIndex)
 {
-    if (font->GetFontData(0).m_TextureFontAtlas == nullptr)
+    PINE_PF_ALLOCATION_SCOPE("Renderer2D");
+
+    if (font->GetFontData(fontIndex).m_TextureFontAtlas == nullptr)
     {
         throw std::runtime_error("Renderer2D::AddText(): Font atlas is not loaded.");
     }
 
-    const auto& fontData = font->GetFontData(0);
-    const auto textureAtlasSize = Vector2f(fontData.m_TextureFontAtlas->GetWidth(), fontData.m_TextureFontAtlas->GetHeight());
-
-    float cursor = 0.f;
+    auto& layout = TextLayoutCache::GetLayout(font, fontIndex, str);
 
-    for (auto chr : str)
-    {
-        if (chr < 32 || chr > 126)
-            continue;
-
-        const auto& chrData = fontData.m_CharData[chr - 32];
-
-       AddFilledTexturedRectangle(position + Vector2f(cursor + chrData.xoff, chrData.yoff),
-                                  Pine::Vector2f(chrData.x1 - chrData.x0, chrData.y1 - chrData.y0),
-                                  0.f,
-                                  color,
-                                  fontData.m_TextureFontAtlas,
-                                  Vector2f(chrData.x0, chrData.y0) / textureAtlasSize,
-                                  Vector2f(chrData.x1 - chrData.x0, chrData.y1 - chrData.y0) / textureAtlasSize);
-
-       cursor += chrData.xadvance;
-    }
+    m_CachedItems.push_back({ true, m_TextItems.size(), m_FilledRectangles.size() });
+    m_TextItems.push_back({ &layout, position, color, m_CoordinateSystem, m_OverrideShader });
 }
 
 void Renderer2D::AddTextureAtlasItem(Vector2f position, float size, const Graphics::TextureAtlas* atlas, std::uint32_t itemId,
@@ -509,9 +1288,19 @@ void Renderer2D::AddTextureAtlasItem(Vector2f position, float size, const Graphi
         Vector2f(uvScale, -uvScale)
     };
 
+    rectangleItem.m_Shader = m_OverrideShader;
+
     m_FilledRectangles.push_back(rectangleItem);
 }
 
+void Renderer2D::AddTilemap(const Tilemap* tilemap, Vector2f position, float tileSize)
+{
+    PINE_PF_ALLOCATION_SCOPE("Renderer2D");
+
+    m_CachedItems.push_back({ false, m_Tilemaps.size(), m_FilledRectangles.size() });
+    m_Tilemaps.push_back({ tilemap, position, tileSize, m_CoordinateSystem, m_OverrideShader });
+}
+
 void Renderer2D::SetCoordinateSystem(Rendering::CoordinateSystem coordinateSystem)
 {
     m_CoordinateSystem = coordinateSystem;
@@ -534,6 +1323,8 @@ Pine::Shader* Pine::Renderer2D::GetOverrideShader()
 
 void Renderer2D::AddRectangle(Vector2f position, Vector2f size, float rotation, Color color)
 {
+    PINE_PF_ALLOCATION_SCOPE("Renderer2D");
+
     Rectangle rectangleItem =
     {
         position,
@@ -543,5 +1334,7 @@ void Renderer2D::AddRectangle(Vector2f position, Vector2f size, float rotation,
         m_CoordinateSystem
     };
 
+    rectangleItem.m_Shader = m_OverrideShader;
+
     m_Rectangles.push_back(rectangleItem);
 }
\ No newline at end of file
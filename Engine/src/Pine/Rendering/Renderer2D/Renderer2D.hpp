@@ -12,6 +12,7 @@
 
 namespace Pine
 {
+    class Tilemap;
 }
 
 namespace Pine::Graphics
@@ -28,6 +29,7 @@ namespace Pine::Renderer2D
     void SetCoordinateSystem(Rendering::CoordinateSystem coordinateSystem);
     Rendering::CoordinateSystem GetCoordinateSystem();
 
+    // Items added while an override shader is set are drawn with it instead of the default 2D shader.
     void SetOverrideShader(Pine::Shader* shader);
     Pine::Shader* GetOverrideShader();
 
@@ -40,6 +42,12 @@ namespace Pine::Renderer2D
 
     void AddTextureAtlasItem(Vector2f position, float size, const Graphics::TextureAtlas* atlas, std::uint32_t itemId, Color color);
 
-    void AddText(Vector2f position, Color color, const std::string& str, const Pine::Font* font);
+    // Draws the tiles of a tilemap with the top left tile at position. Only the chunks within the camera's view
+    // are drawn, and their geometry is kept on the GPU until the chunk changes.
+    void AddTilemap(const Tilemap* tilemap, Vector2f position, float tileSize);
+
+    // The layout of the text is cached, so drawing the same string again only copies its glyphs. Characters
+    // missing from the font atlas are added to it on first use.
+    void AddText(Vector2f position, Color color, const std::string& str, Pine::Font* font, std::uint32_t fontIndex = 0);
 
 }
\ No newline at end of file
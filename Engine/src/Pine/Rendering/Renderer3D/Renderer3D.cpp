@@ -37,7 +37,8 @@ namespace
 
     Camera* m_Camera = nullptr;
 
-    int m_CurrentLightIndex = 0;
+    // Slot 0 is reserved for the directional light.
+    int m_CurrentLightIndex = 1;
 }
 
 void Renderer3D::Setup()
@@ -62,6 +63,19 @@ void Renderer3D::Setup()
     ShaderStorages::Material.Create();
     ShaderStorages::Lights.Create();
     ShaderStorages::Shadows.Create();
+    ShaderStorages::LightClusters.Create();
+
+    // The light blocks are kept within the 16 kB every OpenGL implementation has to support, but make it obvious
+    // if the graphics API reports an even smaller limit.
+    const auto maxUniformBlockSize = static_cast<std::size_t>(m_GraphicsAPI->GetMaxUniformBlockSize());
+
+    Log::Verbose("Renderer3D: Max uniform block size is {} bytes, Lights uses {} and LightClusters {}.",
+                 maxUniformBlockSize, sizeof(ShaderStorages::LightsData), sizeof(ShaderStorages::LightClusterData));
+
+    if (sizeof(ShaderStorages::LightsData) > maxUniformBlockSize || sizeof(ShaderStorages::LightClusterData) > maxUniformBlockSize)
+    {
+        Log::Error("Renderer3D: The light uniform blocks exceed the max uniform block size of {} bytes, expect lighting issues.", maxUniformBlockSize);
+    }
 }
 
 void Renderer3D::Shutdown()
@@ -71,6 +85,7 @@ void Renderer3D::Shutdown()
     ShaderStorages::Material.Dispose();
     ShaderStorages::Lights.Dispose();
     ShaderStorages::Shadows.Dispose();
+    ShaderStorages::LightClusters.Dispose();
 }
 
 Renderer3D::RenderConfiguration& Renderer3D::GetRenderConfiguration()
@@ -171,52 +186,18 @@ void Renderer3D::PrepareMesh(Mesh *mesh, Material* overrideMaterial)
     }
 }
 
-bool Renderer3D::AddInstance(const Matrix4f& transformationMatrix, ModelRendererHintData* data)
+bool Renderer3D::AddInstance(const Matrix4f& transformationMatrix)
 {
     const bool isFull = m_CurrentInstanceIndex == Specifications::General::MAX_INSTANCE_COUNT - 1;
     const int instanceId = m_CurrentInstanceIndex++;
 
     ShaderStorages::Instance.Data().Instances[instanceId].TransformationMatrix = transformationMatrix;
 
-    if (data != nullptr)
-    {
-        auto& lightIndices = ShaderStorages::Instance.Data().Instances[instanceId].LightIndices;
-
-        for (int i = 0; i < 6;i++)
-        {
-            if (auto light = data->LightSlotIndex[i].Get())
-            {
-                lightIndices[i] = light->GetLightHintData().LightIndex;
-            }
-            else
-            {
-                lightIndices[i] = 0;
-            }
-        }
-    }
-
     return isFull;
 }
 
-void Renderer3D::RenderMesh(const Matrix4f& transformationMatrix, ModelRendererHintData* data, int writeStencilBuffer)
+void Renderer3D::RenderMesh(const Matrix4f& transformationMatrix, int writeStencilBuffer)
 {
-    if (data != nullptr)
-    {
-        auto& lightIndices = ShaderStorages::Instance.Data().Instances[0].LightIndices;
-
-        for (int i = 0; i < 6;i++)
-        {
-            if (auto light = data->LightSlotIndex[i].Get())
-            {
-                lightIndices[i] = light->GetLightHintData().LightIndex;
-            }
-            else
-            {
-                lightIndices[i] = 0;
-            }
-        }
-    }
-
     ShaderStorages::Instance.Data().Instances[0].TransformationMatrix = transformationMatrix;
     ShaderStorages::Instance.Upload(sizeof(ShaderStorages::InstanceData::Instance));
 
@@ -322,6 +303,11 @@ void Renderer3D::SetShader(Shader* shader, const ShaderVersion preferredVersion)
             Log::Error("Renderer3D: Shader is missing 'Shadows' shader storage, expect rendering issues.");
         }
 
+        if (!ShaderStorages::LightClusters.AttachShaderProgram(shaderProgram))
+        {
+            Log::Error("Renderer3D: Shader is missing 'LightClusters' shader storage, expect rendering issues.");
+        }
+
         shader->SetReady(true, version);
     }
 
@@ -388,30 +374,15 @@ void Renderer3D::AddLight(Light *light)
     lightData.Attenuation = light->GetLightAttenuation();
     lightData.Angle = light->GetSpotlightRadius();
     lightData.AngleSmoothness = light->GetSpotlightCutoff();
+    lightData.Type = static_cast<int>(light->GetLightType());
 
     light->GetLightHintData().LightIndex = lightSlot;
-
-    auto& [_, LightIndices] = ShaderStorages::Instance.Data().Instances[0];
-
-    if (light->GetLightType() == LightType::PointLight)
-    {
-        for (int i = 0; i < 5;i++)
-        {
-            if (LightIndices[i] == 0)
-            {
-                LightIndices[i] = lightSlot;
-            }
-        }
-    }
-    else if (light->GetLightType() == LightType::SpotLight)
-    {
-        LightIndices[5] = lightSlot;
-    }
 }
 
 void Renderer3D::UploadLights()
 {
     ShaderStorages::Lights.Upload();
+    ShaderStorages::LightClusters.Upload();
 
     m_CurrentLightIndex = 1;
 }
@@ -429,14 +400,16 @@ void Renderer3D::FrameReset()
         Light.Color = Vector3f(0.0f, 0.0f, 0.0f);
     }
 
-    auto& [_, LightIndices] = ShaderStorages::Instance.Data().Instances[0];
-    for (int i = 0; i < 8;i++)
+    // Without any clusters being built, only the directional light remains.
+    for (auto& cluster : ShaderStorages::LightClusters.Data().Clusters)
     {
-        LightIndices[i] = 0;
+        cluster = 0;
     }
 
     ShaderStorages::Lights.Data().AmbientColor = Vector3f(0.f);
 
+    m_CurrentLightIndex = 1;
+
     m_RenderingContext = nullptr;
     m_Shader = nullptr;
     m_Mesh = nullptr;
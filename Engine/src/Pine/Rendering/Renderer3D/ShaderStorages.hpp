@@ -18,7 +18,6 @@ namespace Pine::Renderer3D::ShaderStorages
         struct Instance
         {
             Matrix4f TransformationMatrix;
-            int LightIndices[8];
         }Instances[Specifications::General::MAX_INSTANCE_COUNT];
     };
 
@@ -53,7 +52,7 @@ namespace Pine::Renderer3D::ShaderStorages
             float Angle = 0.f;
 
             float AngleSmoothness = 0.f;
-            float Pad4 = 0;
+            int Type = 0;
             float Pad5 = 0;
             float Pad6 = 0;
         }Lights[Specifications::General::DYNAMIC_LIGHT_COUNT];
@@ -67,9 +66,28 @@ namespace Pine::Renderer3D::ShaderStorages
         Matrix4f LightSpaceMatrix[8];
     };
 
+    struct LightClusterData
+    {
+        // Maps the view space depth onto a cluster slice, z is 1 for linear (orthographic) slices and 0 for logarithmic ones.
+        Vector4f Parameters = Vector4f(0.f);
+
+        // The offset into LightIndices in the lower 16 bits, and the amount of lights in the upper 16 bits.
+        std::uint32_t Clusters[Specifications::LightClusters::CLUSTER_COUNT] = {};
+
+        // Four 8-bit light indices packed into every element, starting at the lowest bits.
+        std::uint32_t LightIndices[Specifications::LightClusters::MAX_LIGHT_INDICES / 4] = {};
+    };
+
+    // OpenGL only guarantees uniform blocks of up to 16 kB, the blocks sized by the specifications are kept within that.
+    constexpr std::size_t MinUniformBlockSize = 16384;
+
+    static_assert(sizeof(LightsData) <= MinUniformBlockSize, "The Lights uniform block is too large.");
+    static_assert(sizeof(LightClusterData) <= MinUniformBlockSize, "The LightClusters uniform block is too large.");
+
     inline Graphics::ShaderStorage<MatrixData> Matrix(Specifications::ShaderStorages::MATRICES, "Matrices");
     inline Graphics::ShaderStorage<InstanceData> Instance(Specifications::ShaderStorages::INSTANCE, "Instances");
     inline Graphics::ShaderStorage<MaterialData> Material(Specifications::ShaderStorages::MATERIAL, "Material");
     inline Graphics::ShaderStorage<LightsData> Lights(Specifications::ShaderStorages::LIGHTS, "Lights");
     inline Graphics::ShaderStorage<ShadowData> Shadows(Specifications::ShaderStorages::SHADOWS, "Shadows");
+    inline Graphics::ShaderStorage<LightClusterData> LightClusters(Specifications::ShaderStorages::LIGHT_CLUSTERS, "LightClusters");
 }
\ No newline at end of file
@@ -4,10 +4,15 @@ namespace Pine::Renderer3D::Specifications
 {
     namespace General
     {
-        constexpr int DYNAMIC_LIGHT_COUNT = 32;
-        constexpr int DYNAMIC_LIGHT_OBJECT_COUNT = 6;
+        // Light clusters store light indices as 8-bit values, so this can't go above 256. The Lights
+        // uniform block also has to stay within 16 kB, which is as large as OpenGL guarantees blocks can be.
+        constexpr int DYNAMIC_LIGHT_COUNT = 192;
         constexpr int MAX_INSTANCE_COUNT = 512;
 
+        // Lights without any meaningful attenuation get clamped to this range, both by the light
+        // clusters and the spatial index.
+        constexpr float MAX_LIGHT_RANGE = 1000.f;
+
         // TODO: Stop with this.
         constexpr int INTERNAL_WIDTH = 1920;
         constexpr int INTERNAL_HEIGHT = 1080;
@@ -24,6 +29,19 @@ namespace Pine::Renderer3D::Specifications
         constexpr float MAX_SHADOW_DISTANCE = 1024.f;
     }
 
+    // Note: Changing any of these requires updating the shared shader code as well.
+    namespace LightClusters
+    {
+        constexpr int CLUSTER_X = 16;
+        constexpr int CLUSTER_Y = 9;
+        constexpr int CLUSTER_Z = 16;
+        constexpr int CLUSTER_COUNT = CLUSTER_X * CLUSTER_Y * CLUSTER_Z;
+
+        constexpr int MAX_LIGHTS_PER_CLUSTER = 32;
+        // Limited by the LightClusters uniform block having to stay within 16 kB, same as the lights.
+        constexpr int MAX_LIGHT_INDICES = 6144;
+    }
+
     namespace PostProcessing
     {
         constexpr int AMBIENT_OCCLUSION_RES = 2;
@@ -52,5 +70,6 @@ namespace Pine::Renderer3D::Specifications
         constexpr int MATERIAL = 2;
         constexpr int LIGHTS = 3;
         constexpr int SHADOWS = 4;
+        constexpr int LIGHT_CLUSTERS = 5;
     }
 }
\ No newline at end of file
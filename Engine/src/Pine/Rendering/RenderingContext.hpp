@@ -12,7 +12,14 @@ namespace Pine
         int LightCount = 0;
         int ModelLightCalculationCount = 0;
         int DrawCalls = 0;
+        int VisibleObjects = 0;
+        int CulledObjects = 0;
         std::uint64_t VertexCount = 0;
+
+        // Instanced draws made by Renderer2D, and how many of those were cut short by the instance or texture slot limit.
+        int Batches2D = 0;
+        int BatchFlushes2D = 0;
+
         double RenderTime = 0.f;
 
         void Reset()
@@ -20,7 +27,11 @@ namespace Pine
             LightCount = 0;
             ModelLightCalculationCount = 0;
             DrawCalls = 0;
+            VisibleObjects = 0;
+            CulledObjects = 0;
             VertexCount = 0;
+            Batches2D = 0;
+            BatchFlushes2D = 0;
             RenderTime = 0.f;
         }
     };
@@ -1,5 +1,5 @@
 ﻿#pragma once
-#include "Pine/World/Components/ModelRenderer/ModelRenderer.hpp"
+#include "Pine/World/Components/Light/Light.hpp"
 
 namespace Pine::Rendering::SceneProcessor
 {
@@ -9,6 +9,4 @@ namespace Pine::Rendering::SceneProcessor
 namespace Pine::Rendering::SceneProcessor::Lights
 {
     void Prepare(SceneProcessorContext& context);
-
-    void ProcessModelRenderer(const SceneProcessorContext& context, ModelRenderer* modelRenderer);
 }
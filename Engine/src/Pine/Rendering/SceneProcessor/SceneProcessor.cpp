@@ -1,5 +1,7 @@
 ﻿#include "SceneProcessor.hpp"
 
+#include <cassert>
+
 #include "Pine/Performance/Performance.hpp"
 #include "Pine/World/Components/Components.hpp"
 #include "Pine/World/Components/ModelRenderer/ModelRenderer.hpp"
@@ -8,69 +10,186 @@
 
 namespace
 {
-    // Find and sort all active ModelRenderers in the scene. Will make sure to group together models using the
-    // same mesh and material to allow for effective batch rendering. We also make sure to figure out which
-    // materials will require discarding and blending.
-    void PrepareRenderingBatch(Pine::Rendering::SceneProcessor::SceneProcessorContext& context)
+    Pine::Rendering::ObjectBatchData m_RenderingBatch;
+
+    std::vector<Pine::ModelRenderer*> m_PendingBatchUpdates;
+
+    // The material rendering mode revision the blend batches were last classified at.
+    std::uint32_t m_BlendBatchRevision = 0;
+
+    bool RequiresBlending(const Pine::Rendering::RenderObject& object)
     {
-        PINE_PF_SCOPE();
+        if (object.OverrideMaterial != nullptr)
+        {
+            return object.OverrideMaterial->GetRenderingMode() == Pine::MaterialRenderingMode::Transparent;
+        }
 
-        context.RenderingBatch = Pine::Rendering::ObjectBatchData();
+        return object.Model->HasTransparentMaterial();
+    }
+
+    std::uint32_t AddInstance(Pine::Rendering::ObjectBatchMap& batches, const Pine::Rendering::RenderObject& object, Pine::ModelRenderer* modelRenderer)
+    {
+        auto& instances = batches[object];
+
+        instances.push_back({ modelRenderer, 0.f });
+
+        return static_cast<std::uint32_t>(instances.size() - 1);
+    }
 
-        for (auto& modelRenderer : Pine::Components::Get<Pine::ModelRenderer>())
+    // Removes the instance by moving the last instance of the batch into its place, and updates the
+    // stored index of the moved instance. Empty batches are removed entirely.
+    void RemoveInstance(Pine::Rendering::ObjectBatchMap& batches,
+                        const Pine::Rendering::RenderObject& object,
+                        std::uint32_t index,
+                        std::uint32_t Pine::Renderer3D::ModelRendererHintData::* indexMember)
+    {
+        const auto it = batches.find(object);
+
+        assert(it != batches.end());
+
+        auto& instances = it->second;
+
+        if (index != instances.size() - 1)
+        {
+            instances[index] = instances.back();
+            instances[index].renderer->GetRenderingHintData().*indexMember = index;
+        }
+
+        instances.pop_back();
+
+        if (instances.empty())
         {
-            if (!modelRenderer.GetModel())
+            batches.erase(it);
+        }
+    }
+
+    void AddToBatches(Pine::ModelRenderer* modelRenderer, const Pine::Rendering::RenderObject& object)
+    {
+        auto& data = modelRenderer->GetRenderingHintData();
+
+        data.BatchIndex = AddInstance(m_RenderingBatch.OpaqueObjects, object, modelRenderer);
+        data.InBlendBatch = RequiresBlending(object);
+
+        if (data.InBlendBatch)
+        {
+            data.BlendBatchIndex = AddInstance(m_RenderingBatch.BlendObjects, object, modelRenderer);
+        }
+
+        data.InRenderBatch = true;
+        data.BatchModel = object.Model;
+        data.BatchOverrideMaterial = object.OverrideMaterial;
+    }
+
+    void UpdateBatches(Pine::ModelRenderer* modelRenderer)
+    {
+        auto& data = modelRenderer->GetRenderingHintData();
+
+        const Pine::Rendering::RenderObject object = { modelRenderer->GetModel(), modelRenderer->GetOverrideMaterial() };
+
+        const bool shouldRender = object.Model != nullptr &&
+                                  modelRenderer->GetParent() != nullptr &&
+                                  modelRenderer->IsWorldEnabled();
+
+        if (shouldRender && data.InRenderBatch && data.BatchModel == object.Model && data.BatchOverrideMaterial == object.OverrideMaterial)
+        {
+            return;
+        }
+
+        Pine::Rendering::SceneProcessor::RemoveFromBatches(modelRenderer);
+
+        if (shouldRender)
+        {
+            AddToBatches(modelRenderer, object);
+        }
+    }
+
+    // Assets may get deleted while still being used, the model renderers will stop returning them
+    // once that happens, so their instances have to be moved elsewhere.
+    void QueueDeletedAssetInstances()
+    {
+        for (const auto& [object, instances] : m_RenderingBatch.OpaqueObjects)
+        {
+            if (!object.Model->IsDeleted() && (object.OverrideMaterial == nullptr || !object.OverrideMaterial->IsDeleted()))
             {
                 continue;
             }
 
-            Pine::Rendering::SceneProcessor::Lights::ProcessModelRenderer(context, &modelRenderer);
-
-            // Find out if a mesh within this model has a transparent material
-            bool hasTransparentMaterial = false;
-            for (const auto& mesh : modelRenderer.GetModel()->GetMeshes())
+            for (const auto& instance : instances)
             {
-                if (mesh->GetMaterial() && mesh->GetMaterial()->GetRenderingMode() == Pine::MaterialRenderingMode::Transparent)
-                {
-                    hasTransparentMaterial = true;
-                }
+                Pine::Rendering::SceneProcessor::QueueBatchUpdate(instance.renderer);
             }
+        }
+    }
+
+    // If any material rendering mode has changed, the objects that require blending have to be classified again.
+    void UpdateBlendBatches()
+    {
+        const auto revision = Pine::Material::GetRenderingModeRevision();
+
+        if (m_BlendBatchRevision == revision)
+        {
+            return;
+        }
 
-            const Pine::Rendering::RenderObject uniqueObject = { modelRenderer.GetModel(), modelRenderer.GetOverrideMaterial() };
+        m_BlendBatchRevision = revision;
 
-            // Find out if we have a hint on how many instances this model has, we do this to avoid
-            // having to re-allocate the vector too much.
-            if (context.RenderingBatch.OpaqueObjects.count(uniqueObject) == 0)
+        m_RenderingBatch.BlendObjects.clear();
+
+        for (const auto& [object, instances] : m_RenderingBatch.OpaqueObjects)
+        {
+            const bool requiresBlending = RequiresBlending(object);
+
+            for (const auto& instance : instances)
             {
-                if (context.ModelInstanceCountHint.count(uniqueObject) != 0)
+                auto& data = instance.renderer->GetRenderingHintData();
+
+                data.InBlendBatch = requiresBlending;
+
+                if (requiresBlending)
                 {
-                    context.RenderingBatch.OpaqueObjects[uniqueObject].reserve(context.ModelInstanceCountHint[uniqueObject]);
+                    data.BlendBatchIndex = AddInstance(m_RenderingBatch.BlendObjects, object, instance.renderer);
                 }
             }
+        }
+    }
+
+    // Brings the render batches up to date with the model renderers that have changed since the last frame, which
+    // groups together models using the same mesh and material to allow for effective batch rendering.
+    void PrepareRenderingBatch()
+    {
+        PINE_PF_SCOPE();
+
+        QueueDeletedAssetInstances();
 
-            context.RenderingBatch.OpaqueObjects[uniqueObject].push_back({&modelRenderer, 0.f});
+        for (auto modelRenderer : m_PendingBatchUpdates)
+        {
+            auto& data = modelRenderer->GetRenderingHintData();
 
-            if (hasTransparentMaterial)
+            // The model renderer may have been queued more than once, or have been destroyed since.
+            if (!data.BatchUpdateQueued)
             {
-                context.RenderingBatch.BlendObjects[uniqueObject].push_back({&modelRenderer, 0.f});
+                continue;
             }
-        }
 
-        // Store instance count hint for the next frame
-        for (const auto&[objectGroup, modelRenderers] : context.RenderingBatch.OpaqueObjects)
-        {
-            context.ModelInstanceCountHint[objectGroup] = modelRenderers.size();
+            data.BatchUpdateQueued = false;
+
+            UpdateBatches(modelRenderer);
         }
+
+        m_PendingBatchUpdates.clear();
+
+        UpdateBlendBatches();
     }
 }
 
 void Pine::Rendering::SceneProcessor::Prepare(SceneProcessorContext& context)
 {
     PINE_PF_SCOPE();
+    PINE_PF_ALLOCATION_SCOPE("SceneProcessor");
 
     Lights::Prepare(context);
 
-    PrepareRenderingBatch(context);
+    PrepareRenderingBatch();
 
     // TODO: This should really not be done here, since it could be used by other engine components.
     // Right now it will sort of work since the rendering is done last anyway, but it's not ideal.
@@ -79,3 +198,49 @@ void Pine::Rendering::SceneProcessor::Prepare(SceneProcessorContext& context)
         entity->SetDirty(false);
     }
 }
+
+void Pine::Rendering::SceneProcessor::QueueBatchUpdate(ModelRenderer* modelRenderer)
+{
+    auto& data = modelRenderer->GetRenderingHintData();
+
+    if (modelRenderer->GetStandalone() || data.BatchUpdateQueued)
+    {
+        return;
+    }
+
+    data.BatchUpdateQueued = true;
+
+    m_PendingBatchUpdates.push_back(modelRenderer);
+}
+
+void Pine::Rendering::SceneProcessor::RemoveFromBatches(ModelRenderer* modelRenderer)
+{
+    auto& data = modelRenderer->GetRenderingHintData();
+
+    // Any queued update will be skipped, as the component's memory may get reused.
+    data.BatchUpdateQueued = false;
+
+    if (!data.InRenderBatch)
+    {
+        return;
+    }
+
+    const RenderObject object = { data.BatchModel, data.BatchOverrideMaterial };
+
+    RemoveInstance(m_RenderingBatch.OpaqueObjects, object, data.BatchIndex, &Renderer3D::ModelRendererHintData::BatchIndex);
+
+    if (data.InBlendBatch)
+    {
+        RemoveInstance(m_RenderingBatch.BlendObjects, object, data.BlendBatchIndex, &Renderer3D::ModelRendererHintData::BlendBatchIndex);
+    }
+
+    data.InRenderBatch = false;
+    data.InBlendBatch = false;
+    data.BatchModel = nullptr;
+    data.BatchOverrideMaterial = nullptr;
+}
+
+const Pine::Rendering::ObjectBatchData& Pine::Rendering::SceneProcessor::GetRenderingBatch()
+{
+    return m_RenderingBatch;
+}
@@ -36,10 +36,13 @@ namespace Pine::Rendering
         }
     };
 
+    // Every batch keeps its instances in a contiguous array. Instances are removed by moving the last
+    // instance into their place, so the order within a batch isn't stable.
     typedef std::unordered_map<RenderObject, std::vector<ObjectRenderInstance>, RenderObjectHash> ObjectBatchMap;
 
     struct ObjectBatchData
     {
+        // All objects, the renderer picks the meshes matching the rendering mode it's rendering.
         ObjectBatchMap OpaqueObjects;
 
         // Objects which will require discarding
@@ -54,13 +57,16 @@ namespace Pine::Rendering::SceneProcessor
 {
     struct SceneProcessorContext
     {
-        std::unordered_map<RenderObject, std::uint32_t, RenderObjectHash> ModelInstanceCountHint;
-
-        ObjectBatchData RenderingBatch;
-
         std::vector<Light*> Lights;
     };
 
     void Prepare(SceneProcessorContext& context);
     void Run(SceneProcessorContext& context);
+
+    // The render batches persist between frames, and are only updated for the model renderers that have been
+    // queued, which they do as they're created, enabled, disabled or get a new model or material.
+    void QueueBatchUpdate(ModelRenderer* modelRenderer);
+    void RemoveFromBatches(ModelRenderer* modelRenderer);
+
+    const ObjectBatchData& GetRenderingBatch();
 }
@@ -227,15 +227,7 @@ namespace
 
     MonoArray* FindEntityByTag(uint64_t tag)
     {
-        std::vector<Pine::Entity*> entities;
-
-        for (const auto& entity : Pine::Entities::GetList())
-        {
-            if (entity->GetTags() & tag)
-            {
-                entities.push_back(entity);
-            }
-        }
+        const auto entities = Pine::Entities::FindByTag(tag);
 
         auto arr = mono_array_new(mono_domain_get(), Pine::Script::ObjectFactory::GetEntityClass(), entities.size());
 
@@ -152,7 +152,7 @@ Pine::Script::RuntimeAssembly* Pine::Script::Runtime::LoadAssembly(const std::fi
     {
         if (assembly.Path == path)
         {
-            Log::Error(fmt::format("Assembly already loaded: {}", path.string()));
+            Log::Error("Assembly already loaded: {}", path.string());
             return nullptr;
         }
     }
@@ -160,14 +160,14 @@ Pine::Script::RuntimeAssembly* Pine::Script::Runtime::LoadAssembly(const std::fi
     auto assembly = mono_domain_assembly_open(m_AppDomain, path.string().c_str());
     if (!assembly)
     {
-        Log::Error(fmt::format("Failed to open assembly: {}", path.string()));
+        Log::Error("Failed to open assembly: {}", path.string());
         return nullptr;
     }
 
     auto image = mono_assembly_get_image(assembly);
     if (!image)
     {
-        Log::Error(fmt::format("Failed to get image from assembly: {}", path.string()));
+        Log::Error("Failed to get image from assembly: {}", path.string());
         return nullptr;
     }
 
@@ -234,7 +234,7 @@ void Pine::Script::Runtime::RunGarbageCollector()
 
     mono_gc_collect(mono_gc_max_generation());
 
-    Log::Verbose(fmt::format("mono_gc_get_heap_size(): {}", mono_gc_get_heap_size()));
+    Log::Verbose("mono_gc_get_heap_size(): {}", mono_gc_get_heap_size());
 }
 
 void Pine::Script::Runtime::Reset()
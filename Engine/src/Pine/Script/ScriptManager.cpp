@@ -91,7 +91,7 @@ namespace
         auto monoClass = mono_class_from_name(m_GameAssembly->Image, "Game", fileName.c_str());
         if (!monoClass)
         {
-            Pine::Log::Warning(fmt::format("Failed to find class for script: {}", fileName));
+            Pine::Log::Warning("Failed to find class for script: {}", fileName);
             return;
         }
 
@@ -231,11 +231,13 @@ void Pine::Script::Manager::OnStart()
 
         mono_runtime_invoke(scriptData->MethodOnStart, objectHandle->Object, nullptr, &exception);
 
+        PINE_PF_COUNTER("Script invocations", 1);
+
         if (exception != nullptr)
         {
             auto str = mono_object_to_string(exception, nullptr);
 
-            Log::Error(fmt::format("Exception thrown in script '{}': {}", script->GetFileName(), mono_string_to_utf8(str)));
+            Log::Error("Exception thrown in script '{}': {}", script->GetFileName(), mono_string_to_utf8(str));
         }
     }
 }
@@ -271,11 +273,13 @@ void Pine::Script::Manager::OnUpdate(float deltaTime)
 
         mono_runtime_invoke(scriptData->MethodOnUpdate, objectHandle->Object, args, &exception);
 
+        PINE_PF_COUNTER("Script invocations", 1);
+
         if (exception != nullptr)
         {
             auto str = mono_object_to_string(exception, nullptr);
 
-            Log::Error(fmt::format("Exception thrown in script '{}': {}", script->GetFileName(), mono_string_to_utf8(str)));
+            Log::Error("Exception thrown in script '{}': {}", script->GetFileName(), mono_string_to_utf8(str));
         }
     }
 }
@@ -1,83 +1,175 @@
-#pragma once
-
 #include "Threading.hpp"
 
 #include <condition_variable>
 #include <deque>
-#include <optional>
+#include <memory>
+#include <thread>
 
+#include "Pine/Core/Log/Log.hpp"
 #include "Pine/Engine/Engine.hpp"
+#include "Pine/Performance/Performance.hpp"
+#include "Pine/Threading/WorkStealingQueue/WorkStealingQueue.hpp"
+
+using namespace Pine::Threading;
 
 namespace
 {
-    bool m_IsRunning = false;
+    // The maximum number of queued jobs per thread, jobs pushed beyond this will end up in the external queue.
+    constexpr std::int64_t JobQueueCapacity = 4096;
+
+    // The number of pooled job records per thread, has to be a power of two.
+    constexpr std::uint32_t JobPoolSize = 4096;
+
+    // Every thread that is part of the scheduler (the main thread and the workers) has
+    // its own job queue and pool of job records.
+    struct ThreadContext
+    {
+        WorkStealingQueue<Job*, JobQueueCapacity> Queue;
+
+        std::unique_ptr<Job[]> JobPool = std::make_unique<Job[]>(JobPoolSize);
+        std::uint32_t JobPoolIndex = 0;
+    };
+
+    // Index 0 is the main thread, the rest are the workers.
+    std::vector<std::unique_ptr<ThreadContext>> m_ThreadContexts;
+
+    thread_local ThreadContext* m_CurrentThreadContext = nullptr;
+    thread_local std::size_t m_CurrentThreadIndex = 0;
+
+    // Jobs submitted by threads outside the scheduler, or by threads with a full queue.
+    std::mutex m_ExternalQueueMutex;
+    std::deque<Job*> m_ExternalQueue;
+    std::atomic<std::int32_t> m_ExternalQueueSize = 0;
+
+    std::atomic<bool> m_IsRunning = false;
 
     std::vector<std::thread> m_Threads;
 
-    std::mutex m_TaskQueueMutex;
-    std::condition_variable m_TaskQueueUpdated;
-    std::deque<std::shared_ptr<Pine::Task>> m_TasksQueue;
+    // Used to put idle workers to sleep until there is work available.
+    std::atomic<std::int32_t> m_QueuedJobs = 0;
+    std::atomic<std::int32_t> m_SleepingWorkers = 0;
+    std::mutex m_SleepMutex;
+    std::condition_variable m_WorkAvailable;
 
-    // Grab the FIFO task from the queue, this call is blocking and can be waiting for either:
-    // 1. We have a new task ready
-    // 2. m_IsRunning == false, and we should exit.
-    std::optional<std::shared_ptr<Pine::Task>> GrabTask()
+    void PushJob(Job* job)
     {
-        std::unique_lock lock(m_TaskQueueMutex);
+        if (m_CurrentThreadContext == nullptr || !m_CurrentThreadContext->Queue.Push(job))
+        {
+            std::unique_lock lock(m_ExternalQueueMutex);
+
+            m_ExternalQueue.push_back(job);
+            m_ExternalQueueSize++;
+        }
 
-        m_TaskQueueUpdated.wait(lock, []{ return !m_IsRunning || !m_TasksQueue.empty(); });
+        m_QueuedJobs++;
 
-        if (!m_IsRunning)
+        if (m_SleepingWorkers > 0)
         {
-            return {};
+            // Make sure the worker isn't in between checking the predicate and going to sleep.
+            {
+                std::unique_lock lock(m_SleepMutex);
+            }
+
+            m_WorkAvailable.notify_one();
         }
+    }
 
-        auto task = m_TasksQueue.front();
+    // Grabs a job from, in order, the calling thread's own queue, the external queue
+    // or any of the other threads' queues.
+    Job* GrabJob()
+    {
+        Job* job = nullptr;
 
-        m_TasksQueue.pop_front();
+        if (m_CurrentThreadContext != nullptr && m_CurrentThreadContext->Queue.Pop(job))
+        {
+            m_QueuedJobs--;
+            return job;
+        }
 
-        lock.unlock();
+        if (m_ExternalQueueSize > 0)
+        {
+            std::unique_lock lock(m_ExternalQueueMutex);
 
-        return task;
-    }
+            if (!m_ExternalQueue.empty())
+            {
+                job = m_ExternalQueue.front();
 
-    void Worker(int workerId)
-    {
-        Pine::Log::Verbose(fmt::format("[Threading] Worker #{} has started.", workerId + 1));
+                m_ExternalQueue.pop_front();
+                m_ExternalQueueSize--;
+                m_QueuedJobs--;
 
-        while (m_IsRunning)
+                return job;
+            }
+        }
+
+        const auto threadCount = m_ThreadContexts.size();
+
+        for (std::size_t i = 1; i <= threadCount; i++)
         {
-            const auto& optTask = GrabTask();
+            const auto& context = m_ThreadContexts[(m_CurrentThreadIndex + i) % threadCount];
 
-            if (!optTask.has_value())
+            if (context.get() == m_CurrentThreadContext)
             {
                 continue;
             }
 
-            auto& task = optTask.value();
+            if (context->Queue.Steal(job))
+            {
+                m_QueuedJobs--;
+                return job;
+            }
+        }
 
-            task->State = Pine::TaskState::Running;
+        return nullptr;
+    }
 
-            task->Result = task->WorkFunction(task->WorkData);
+    void Worker(std::size_t workerId)
+    {
+        Pine::Log::Verbose("[Threading] Worker #{} has started.", workerId);
 
-            std::unique_lock lck(task->Mutex);
+        m_CurrentThreadContext = m_ThreadContexts[workerId].get();
+        m_CurrentThreadIndex = workerId;
 
-            task->State = Pine::TaskState::Finished;
+        Pine::Performance::SetThreadName(fmt::format("Worker #{}", workerId));
 
-            task->ConditionVariable.notify_all();
+        while (m_IsRunning)
+        {
+            if (const auto job = GrabJob())
+            {
+                Internal::Execute(job);
+                continue;
+            }
+
+            std::unique_lock lock(m_SleepMutex);
+
+            m_SleepingWorkers++;
+            m_WorkAvailable.wait(lock, []{ return !m_IsRunning || m_QueuedJobs > 0; });
+            m_SleepingWorkers--;
         }
 
-        Pine::Log::Verbose(fmt::format("Threading: Worker #{} has stopped.", workerId + 1));
+        Pine::Log::Verbose("[Threading] Worker #{} has stopped.", workerId);
     }
 }
 
 void Pine::Threading::Setup()
 {
-    const auto engineConfiguration = Engine::GetEngineConfiguration();
+    const auto& engineConfiguration = Engine::GetEngineConfiguration();
+    const auto workerCount = static_cast<std::size_t>(std::max(engineConfiguration.m_ThreadPoolWorkers, 0));
+
+    // All contexts have to exist before any worker starts, since they steal from each other.
+    for (std::size_t i = 0; i < workerCount + 1; i++)
+    {
+        m_ThreadContexts.push_back(std::make_unique<ThreadContext>());
+    }
+
+    m_CurrentThreadContext = m_ThreadContexts[0].get();
+    m_CurrentThreadIndex = 0;
+
+    Performance::SetThreadName("Main");
 
     m_IsRunning = true;
 
-    for (int i = 0; i < engineConfiguration.m_ThreadPoolWorkers;i++)
+    for (std::size_t i = 1; i < workerCount + 1; i++)
     {
         m_Threads.emplace_back(Worker, i);
     }
@@ -85,11 +177,11 @@ void Pine::Threading::Setup()
 
 void Pine::Threading::Shutdown()
 {
-    std::unique_lock lck(m_TaskQueueMutex);
+    std::unique_lock lck(m_SleepMutex);
 
     m_IsRunning = false;
 
-    m_TaskQueueUpdated.notify_all();
+    m_WorkAvailable.notify_all();
 
     lck.unlock();
 
@@ -97,31 +189,133 @@ void Pine::Threading::Shutdown()
     {
         thread.join();
     }
+
+    m_Threads.clear();
+
+    m_CurrentThreadContext = nullptr;
+    m_ThreadContexts.clear();
 }
 
-std::shared_ptr<Pine::Task> Pine::Threading::AddTask(TaskFunc taskFunction, TaskData* data)
+int Pine::Threading::GetWorkerCount()
 {
-    auto task = std::make_shared<Task>();
+    return static_cast<int>(m_Threads.size());
+}
 
-    task->WorkFunction = taskFunction;
-    task->WorkData = data;
+void Pine::Threading::Wait(TaskGroup& group)
+{
+    while (!group.IsFinished())
+    {
+        if (const auto job = GrabJob())
+        {
+            Internal::Execute(job);
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    // The thread that finished the last job may still be releasing continuations,
+    // make sure it's done with the group before we return and the group goes away.
+    std::unique_lock lock(group.m_Mutex);
+}
+
+bool Pine::Threading::RunPendingJob()
+{
+    const auto job = GrabJob();
+
+    if (job == nullptr)
+    {
+        return false;
+    }
+
+    Internal::Execute(job);
+
+    return true;
+}
+
+Pine::Threading::Job* Pine::Threading::Internal::AllocateJob()
+{
+    if (m_CurrentThreadContext == nullptr)
+    {
+        const auto job = new Job();
+
+        job->HeapAllocated = true;
+        job->InUse = true;
+
+        return job;
+    }
+
+    auto& context = *m_CurrentThreadContext;
+    const auto job = &context.JobPool[context.JobPoolIndex++ & (JobPoolSize - 1)];
+
+    // Only the owning thread allocates from the pool, so if the record has been released
+    // it's safe to take it.
+    if (job->InUse.load(std::memory_order_acquire))
+    {
+        return nullptr;
+    }
 
-    std::unique_lock lock(m_TaskQueueMutex);
+    job->InUse.store(true, std::memory_order_relaxed);
 
-    m_TasksQueue.push_back(task);
+    return job;
+}
+
+void Pine::Threading::Internal::Submit(Job* job, TaskGroup& group)
+{
+    job->Group = &group;
+    group.m_PendingJobs++;
 
-    lock.unlock();
+    PushJob(job);
+}
 
-    m_TaskQueueUpdated.notify_one();
+void Pine::Threading::Internal::SubmitAfter(Job* job, TaskGroup& dependency, TaskGroup& group)
+{
+    job->Group = &group;
+    group.m_PendingJobs++;
+
+    {
+        std::unique_lock lock(dependency.m_Mutex);
 
-    return task;
+        if (dependency.m_PendingJobs > 0)
+        {
+            // Will be pushed by whoever finishes the last job in the dependency.
+            dependency.m_Continuations.push_back(job);
+            return;
+        }
+    }
+
+    PushJob(job);
 }
 
-Pine::TaskResult Pine::Threading::AwaitResult(const std::shared_ptr<Task>& task)
+void Pine::Threading::Internal::Execute(Job* job)
 {
-    std::unique_lock lck(task->Mutex);
+    job->Function(job);
 
-    task->ConditionVariable.wait(lck, [&]{ return task->State == TaskState::Finished; });
+    const auto group = job->Group;
 
-    return task->Result;
+    if (job->HeapAllocated)
+    {
+        delete job;
+    }
+    else
+    {
+        job->InUse.store(false, std::memory_order_release);
+    }
+
+    std::vector<Job*> continuations;
+
+    {
+        std::unique_lock lock(group->m_Mutex);
+
+        if (--group->m_PendingJobs == 0)
+        {
+            continuations.swap(group->m_Continuations);
+        }
+    }
+
+    for (const auto continuation : continuations)
+    {
+        PushJob(continuation);
+    }
 }
@@ -1,46 +1,180 @@
 #pragma once
-#include <memory>
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
-namespace Pine
+namespace Pine::Threading
 {
-    using TaskData = void*;
-    using TaskResult = void*;
+    struct Job;
 
-    typedef TaskResult(*TaskFunc)(TaskData);
+    // Keeps track of a set of scheduled jobs, Wait() will return once all of them have finished.
+    // Groups can also be used as a dependency for other jobs through RunAfter().
+    class TaskGroup
+    {
+    private:
+        // The number of jobs scheduled through this group that haven't finished yet.
+        std::atomic<std::uint32_t> m_PendingJobs = 0;
+
+        // Jobs waiting for this group to finish before they may be scheduled.
+        std::vector<Job*> m_Continuations;
+        std::mutex m_Mutex;
+
+        friend void Wait(TaskGroup& group);
+        friend struct Internal;
+    public:
+        TaskGroup() = default;
 
-    enum class TaskState
+        TaskGroup(const TaskGroup&) = delete;
+        TaskGroup& operator=(const TaskGroup&) = delete;
+
+        bool IsFinished() const
+        {
+            return m_PendingJobs.load(std::memory_order_acquire) == 0;
+        }
+    };
+
+    // The amount of bytes a job may use to store its function object.
+    constexpr std::size_t JobStorageSize = 64;
+
+    struct alignas(64) Job
     {
-        Queued,
-        Running,
-        Finished
+        // Invokes and destroys the function object in `Storage`.
+        void (*Function)(Job* job) = nullptr;
+
+        TaskGroup* Group = nullptr;
+
+        // Set while the job is queued or running, pooled jobs are only reused once this is cleared.
+        std::atomic<bool> InUse = false;
+
+        // Jobs allocated by threads that are not part of the scheduler are not pooled.
+        bool HeapAllocated = false;
+
+        alignas(std::max_align_t) unsigned char Storage[JobStorageSize];
     };
 
-    struct Task
+    // Internal functions used by the templates below, prefer Run(), RunAfter() and ParallelFor().
+    struct Internal
     {
-        // The argument we'll use for the work function.
-        TaskData WorkData = nullptr;
+        // Grabs a job record from the calling thread's pool, or returns nullptr if the pool is exhausted.
+        static Job* AllocateJob();
+
+        static void Submit(Job* job, TaskGroup& group);
+        static void SubmitAfter(Job* job, TaskGroup& dependency, TaskGroup& group);
+
+        static void Execute(Job* job);
+
+        template<typename F>
+        static Job* CreateJob(F&& fn)
+        {
+            using Fn = std::decay_t<F>;
 
-        // The underlying function that the threading system will call to take care
-        // of whatever user work.
-        TaskFunc WorkFunction = nullptr;
+            static_assert(sizeof(Fn) <= JobStorageSize, "Job function object is too large, capture less or capture by reference.");
+            static_assert(alignof(Fn) <= alignof(std::max_align_t), "Job function object alignment is not supported.");
 
-        // Whenever the task is done, the result of `WorkFunction` will be stored here.
-        TaskResult Result = nullptr;
+            const auto job = AllocateJob();
 
-        std::atomic<TaskState> State = TaskState::Queued;
+            if (job == nullptr)
+            {
+                return nullptr;
+            }
 
-        std::mutex Mutex;
-        std::condition_variable ConditionVariable;
+            new (job->Storage) Fn(std::forward<F>(fn));
+
+            job->Function = [](Job* self)
+            {
+                auto& function = *std::launder(reinterpret_cast<Fn*>(self->Storage));
+
+                function();
+                function.~Fn();
+            };
+
+            return job;
+        }
     };
 
-    namespace Threading
+    // Starts the worker threads, the calling thread is registered as the main thread and
+    // gets its own job queue as well.
+    void Setup();
+    void Shutdown();
+
+    // The number of worker threads, excluding the main thread.
+    int GetWorkerCount();
+
+    // Blocks until every job in the group has finished, the calling thread will help out
+    // executing queued jobs in the meantime.
+    void Wait(TaskGroup& group);
+
+    // Executes a single queued job on the calling thread, returns false if there was nothing to run.
+    bool RunPendingJob();
+
+    // Schedules `fn` to run on any thread as part of `group`.
+    template<typename F>
+    void Run(TaskGroup& group, F&& fn)
+    {
+        const auto job = Internal::CreateJob(std::forward<F>(fn));
+
+        if (job == nullptr)
+        {
+            // Out of job records, just do the work right away instead.
+            fn();
+            return;
+        }
+
+        Internal::Submit(job, group);
+    }
+
+    // Schedules `fn` as part of `group`, but only once every job in `dependency` has finished.
+    template<typename F>
+    void RunAfter(TaskGroup& dependency, TaskGroup& group, F&& fn)
+    {
+        const auto job = Internal::CreateJob(std::forward<F>(fn));
+
+        if (job == nullptr)
+        {
+            Wait(dependency);
+            fn();
+            return;
+        }
+
+        Internal::SubmitAfter(job, dependency, group);
+    }
+
+    // Splits [0, count) into chunks of `grainSize` elements and calls fn(begin, end) for each
+    // chunk across all threads, returns once all chunks are done. The calling thread processes
+    // the first chunk itself.
+    template<typename F>
+    void ParallelFor(std::uint32_t count, std::uint32_t grainSize, const F& fn)
     {
-        void Setup();
-        void Shutdown();
+        if (count == 0)
+        {
+            return;
+        }
+
+        grainSize = std::max(grainSize, 1u);
+
+        if (count <= grainSize)
+        {
+            fn(0u, count);
+            return;
+        }
+
+        TaskGroup group;
+
+        for (std::uint32_t begin = grainSize; begin < count; begin += grainSize)
+        {
+            const std::uint32_t end = std::min(begin + grainSize, count);
+
+            Run(group, [&fn, begin, end] { fn(begin, end); });
+        }
 
-        std::shared_ptr<Task> AddTask(TaskFunc taskFunction, TaskData* data = nullptr);
+        fn(0u, grainSize);
 
-        TaskResult AwaitResult(const std::shared_ptr<Task>& task);
+        Wait(group);
     }
 }
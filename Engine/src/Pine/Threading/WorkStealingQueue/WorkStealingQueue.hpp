@@ -0,0 +1,100 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+namespace Pine::Threading
+{
+
+    // Fixed capacity lock-free Chase-Lev deque. Only the owning thread may call Push() and Pop(),
+    // which work on the bottom end, while any other thread may Steal() from the top end.
+    // Capacity has to be a power of two.
+    template<typename T, std::int64_t Capacity>
+    class WorkStealingQueue
+    {
+    private:
+        static_assert((Capacity & (Capacity - 1)) == 0, "WorkStealingQueue capacity has to be a power of two.");
+
+        alignas(64) std::atomic<std::int64_t> m_Top = 0;
+        alignas(64) std::atomic<std::int64_t> m_Bottom = 0;
+
+        std::atomic<T> m_Items[Capacity];
+    public:
+        // Returns false if the queue is full.
+        bool Push(T item)
+        {
+            const auto bottom = m_Bottom.load(std::memory_order_relaxed);
+            const auto top = m_Top.load(std::memory_order_acquire);
+
+            if (bottom - top >= Capacity)
+            {
+                return false;
+            }
+
+            m_Items[bottom & (Capacity - 1)].store(item, std::memory_order_relaxed);
+
+            // Publishes the item to thieves
+            m_Bottom.store(bottom + 1, std::memory_order_release);
+
+            return true;
+        }
+
+        // Takes the most recently pushed item, returns false if the queue is empty.
+        bool Pop(T& item)
+        {
+            const auto bottom = m_Bottom.load(std::memory_order_relaxed) - 1;
+
+            m_Bottom.store(bottom, std::memory_order_relaxed);
+
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            auto top = m_Top.load(std::memory_order_relaxed);
+
+            if (top > bottom)
+            {
+                // Empty queue
+                m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+                return false;
+            }
+
+            item = m_Items[bottom & (Capacity - 1)].load(std::memory_order_relaxed);
+
+            if (top != bottom)
+            {
+                // There are still items left, so no thief can race us for this one.
+                return true;
+            }
+
+            // Last item, make sure no thief took it before us.
+            const bool success = m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+
+            m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+
+            return success;
+        }
+
+        // Takes the oldest item, returns false if the queue is empty or another thread won the race.
+        bool Steal(T& item)
+        {
+            auto top = m_Top.load(std::memory_order_acquire);
+
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            const auto bottom = m_Bottom.load(std::memory_order_acquire);
+
+            if (top >= bottom)
+            {
+                return false;
+            }
+
+            item = m_Items[top & (Capacity - 1)].load(std::memory_order_relaxed);
+
+            return m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+        }
+
+        bool Empty() const
+        {
+            return m_Bottom.load(std::memory_order_relaxed) <= m_Top.load(std::memory_order_relaxed);
+        }
+    };
+
+}
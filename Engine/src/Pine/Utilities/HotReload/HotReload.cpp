@@ -16,7 +16,7 @@ namespace
 
         if (assetsReloaded > 0)
         {
-            Pine::Log::Verbose(fmt::format("Reloaded {} assets due to hot-reload", assetsReloaded));
+            Pine::Log::Verbose("Reloaded {} assets due to hot-reload", assetsReloaded);
         }
     }
 
@@ -33,7 +33,7 @@ namespace
 
 void Pine::Utilities::HotReload::Setup()
 {
-    if (!Engine::GetEngineConfiguration().m_EnableDebugTools)
+    if (!Engine::GetEngineConfiguration().m_EnableDebugTools || !WindowManager::IsWindowCreated())
     {
         return;
     }
@@ -73,6 +73,17 @@ void Pine::AudioSource::OnSetup()
         alSourcePlay(m_SourceId);
 }
 
+void Pine::AudioSource::OnCloned()
+{
+    IComponent::OnCloned();
+
+    m_AudioFile.AddReference();
+
+    // The audio source of the original component can't be shared, the clone needs one of its own.
+    m_SourceId = m_AudioFile.Get() != nullptr ? m_AudioFile->GetNewSource() : 0;
+    m_IsPlaying = false;
+}
+
 void Pine::AudioSource::SetAudioFile(AudioFile *file)
 {
     if (file != nullptr)
@@ -43,6 +43,7 @@ namespace Pine
         float GetVolume() const;
 
         void OnSetup() override;
+        void OnCloned() override;
         //void OnCopied() override;
 
         void SetAudioFile(AudioFile* file);
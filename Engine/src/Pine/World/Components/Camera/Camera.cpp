@@ -79,6 +79,24 @@ void Pine::Camera::SaveData(nlohmann::json &j)
     j["orthographicSize"] = m_OrthographicSize;
 }
 
+void Pine::Camera::LoadData(Serialization::BinaryReader& reader)
+{
+    reader.Read(m_CameraType);
+    reader.Read(m_NearPlane);
+    reader.Read(m_FarPlane);
+    reader.Read(m_FieldOfView);
+    reader.Read(m_OrthographicSize);
+}
+
+void Pine::Camera::SaveData(Serialization::BinaryWriter& writer)
+{
+    writer.Write(m_CameraType);
+    writer.Write(m_NearPlane);
+    writer.Write(m_FarPlane);
+    writer.Write(m_FieldOfView);
+    writer.Write(m_OrthographicSize);
+}
+
 const Pine::Matrix4f &Pine::Camera::GetProjectionMatrix() const
 {
     return m_ProjectionMatrix;
@@ -192,3 +210,32 @@ std::array<Pine::Vector3f, 8> Pine::Camera::GetFrustumCorners() const
 
     return ret;
 }
+
+std::array<Pine::Vector4f, 6> Pine::Camera::GetFrustumPlanes() const
+{
+    const Matrix4f viewProjection = m_ProjectionMatrix * m_ViewMatrix;
+
+    // The matrix is column major, so grab the rows first.
+    std::array<Vector4f, 4> rows;
+
+    for (int i = 0; i < 4; i++)
+    {
+        rows[i] = Vector4f(viewProjection[0][i], viewProjection[1][i], viewProjection[2][i], viewProjection[3][i]);
+    }
+
+    std::array<Vector4f, 6> planes = {
+        rows[3] + rows[0],
+        rows[3] - rows[0],
+        rows[3] + rows[1],
+        rows[3] - rows[1],
+        rows[3] + rows[2],
+        rows[3] - rows[2]
+    };
+
+    for (auto& plane : planes)
+    {
+        plane /= glm::length(Vector3f(plane));
+    }
+
+    return planes;
+}
@@ -59,11 +59,18 @@ namespace Pine
 
         std::array<Vector3f, 8> GetFrustumCorners() const;
 
+        // The left, right, bottom, top, near and far planes of the frustum in world space, with
+        // the normals (xyz) pointing inwards and w being the distance.
+        std::array<Vector4f, 6> GetFrustumPlanes() const;
+
         void OnRender(float) override;
 
         void LoadData(const nlohmann::json& j) override;
         void SaveData(nlohmann::json& j) override;
 
+        void LoadData(Serialization::BinaryReader& reader) override;
+        void SaveData(Serialization::BinaryWriter& writer) override;
+
         const Matrix4f& GetProjectionMatrix() const;
         const Matrix4f& GetViewMatrix() const;
     };
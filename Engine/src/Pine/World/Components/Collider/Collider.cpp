@@ -266,4 +266,26 @@ void Pine::Collider::SaveData(nlohmann::json &j)
     j["lmask"] = m_LayerMask;
     j["trig"] = m_IsTrigger;
     j["trigm"] = m_TriggerMask;
+}
+
+void Pine::Collider::LoadData(Serialization::BinaryReader &reader)
+{
+    reader.Read(m_Position);
+    reader.Read(m_Size);
+    reader.Read(m_ColliderType);
+    reader.Read(m_Layer);
+    reader.Read(m_LayerMask);
+    reader.Read(m_IsTrigger);
+    reader.Read(m_TriggerMask);
+}
+
+void Pine::Collider::SaveData(Serialization::BinaryWriter &writer)
+{
+    writer.Write(m_Position);
+    writer.Write(m_Size);
+    writer.Write(m_ColliderType);
+    writer.Write(m_Layer);
+    writer.Write(m_LayerMask);
+    writer.Write(m_IsTrigger);
+    writer.Write(m_TriggerMask);
 }
\ No newline at end of file
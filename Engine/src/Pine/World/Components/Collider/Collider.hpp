@@ -85,6 +85,9 @@ namespace Pine
 
         void LoadData(const nlohmann::json &j) override;
         void SaveData(nlohmann::json &j) override;
+
+        void LoadData(Serialization::BinaryReader &reader) override;
+        void SaveData(Serialization::BinaryWriter &writer) override;
     };
 
 }
\ No newline at end of file
@@ -1,7 +1,11 @@
 #include "Collider2D.hpp"
 
 #include "Pine/Physics/Physics2D/Physics2D.hpp"
+#include "Pine/Physics/Physics2D/TilemapCollision/TilemapCollision.hpp"
+#include "Pine/Performance/Performance.hpp"
+#include "Pine/Rendering/Rendering.hpp"
 
+#include <algorithm>
 #include <box2d/b2_body.h>
 #include <box2d/b2_world.h>
 #include <box2d/b2_fixture.h>
@@ -9,11 +13,18 @@
 
 #include "Pine/Core/Serialization/Serialization.hpp"
 #include "Pine/World/Components/SpriteRenderer/SpriteRenderer.hpp"
+#include "Pine/World/Components/TilemapRenderer/TilemapRenderer.hpp"
 #include "Pine/World/Components/RigidBody2D/RigidBody2D.hpp"
 #include "Pine/World/Entity/Entity.hpp"
 
 void Pine::Collider2D::UpdateBody()
 {
+	if (m_ColliderType == Collider2DType::Tilemap)
+	{
+		UpdateTilemapBody();
+		return;
+	}
+
 	const bool hasRigidBody = GetParent()->HasComponent<RigidBody2D>();
 
 	bool shouldDestroyBody = false;
@@ -30,12 +41,9 @@ void Pine::Collider2D::UpdateBody()
 		shouldDestroyBody = true;
 	}
 
-	if (shouldDestroyBody && m_Body)
+	if (shouldDestroyBody)
 	{
-		Physics2D::GetWorld()->DestroyBody(m_Body);
-
-		m_Body = nullptr;
-		m_Fixture = nullptr; // TODO: Is this getting freed properly?
+		DestroyBody();
 	}
 
 	if (hasRigidBody)
@@ -63,6 +71,116 @@ void Pine::Collider2D::UpdateBody()
 	m_Body->SetTransform(b2Vec2(newPosition.x, newPosition.y), ComputeRotation());
 }
 
+void Pine::Collider2D::UpdateTilemapBody()
+{
+	const auto tilemapRenderer = GetParent()->GetComponent<TilemapRenderer>();
+	const auto tilemap = tilemapRenderer ? tilemapRenderer->GetTilemap() : nullptr;
+
+	if (tilemap == nullptr || tilemap->GetTileset() == nullptr)
+	{
+		DestroyBody();
+		return;
+	}
+
+	const auto tileSize = static_cast<float>(tilemap->GetTileset()->GetTileSize()) / Rendering::PixelsPerUnit * GetParent()->GetTransform()->GetScale().x;
+
+	// Everything has to be rebuilt for a different tilemap or tile size.
+	if (m_Body && (tilemap != m_BodyTilemap || tileSize != m_BodyTileSize))
+	{
+		DestroyBody();
+	}
+
+	if (!m_Body)
+	{
+		b2BodyDef def;
+
+		m_Body = Physics2D::GetWorld()->CreateBody(&def);
+		m_BodyTilemap = tilemap;
+		m_BodyTileSize = tileSize;
+	}
+
+	static std::vector<Physics2D::TileColliderBox> boxes;
+
+	const auto& chunks = tilemap->GetChunks();
+
+	auto& tileChunkFixtures = Physics2D::GetTileChunkFixtures(GetUniqueId());
+
+	for (const auto& [key, chunk] : chunks)
+	{
+		auto& chunkFixtures = tileChunkFixtures[chunk.m_Id];
+
+		if (chunkFixtures.m_Version == chunk.m_Version)
+			continue;
+
+		for (const auto fixture : chunkFixtures.m_Fixtures)
+			m_Body->DestroyFixture(fixture);
+
+		chunkFixtures.m_Fixtures.clear();
+		chunkFixtures.m_Version = chunk.m_Version;
+
+		boxes.clear();
+
+		Physics2D::BuildTileChunkColliders(chunk, tilemap->GetTileset(), boxes);
+
+		// The tile grid goes downwards from the top left corner of the first tile, while the world's Y axis goes up.
+		for (const auto& box : boxes)
+		{
+			b2PolygonShape shape;
+
+			shape.SetAsBox(box.m_Size.x * tileSize * 0.5f,
+			               box.m_Size.y * tileSize * 0.5f,
+			               b2Vec2((box.m_Position.x + 0.5f) * tileSize, -(box.m_Position.y + 0.5f) * tileSize),
+			               -box.m_Rotation);
+
+			chunkFixtures.m_Fixtures.push_back(m_Body->CreateFixture(&shape, 0.f));
+		}
+
+		PINE_PF_COUNTER("Tilemap collision rebuilds", 1);
+	}
+
+	// Every chunk of the tilemap has an entry by now, so any others belong to chunks that were removed.
+	if (tileChunkFixtures.size() != chunks.size())
+	{
+		for (auto it = tileChunkFixtures.begin(); it != tileChunkFixtures.end();)
+		{
+			const bool exists = std::any_of(chunks.begin(), chunks.end(), [&](const auto& entry)
+			{
+				return entry.second.m_Id == it->first;
+			});
+
+			if (exists)
+			{
+				++it;
+				continue;
+			}
+
+			for (const auto fixture : it->second.m_Fixtures)
+				m_Body->DestroyFixture(fixture);
+
+			it = tileChunkFixtures.erase(it);
+		}
+	}
+
+	const auto newPosition = ComputePosition();
+
+	m_Body->SetTransform(b2Vec2(newPosition.x, newPosition.y), ComputeRotation());
+}
+
+void Pine::Collider2D::DestroyBody()
+{
+	// Standalone colliders never get a body, so they won't touch the fixtures of the collider sharing their unique id.
+	if (m_Body)
+	{
+		Physics2D::GetWorld()->DestroyBody(m_Body);
+		Physics2D::ReleaseTileChunkFixtures(GetUniqueId());
+	}
+
+	m_Body = nullptr;
+	m_Fixture = nullptr;
+
+	m_BodyTilemap = nullptr;
+}
+
 Pine::Vector2f Pine::Collider2D::ComputePosition() const
 {
 	return (Pine::Vector2f(GetParent()->GetTransform()->GetPosition()) + m_ColliderOffset);
@@ -111,6 +229,12 @@ Pine::Collider2D::Collider2D()
 
 void Pine::Collider2D::SetColliderType(Collider2DType type)
 {
+	// The body is recreated during the next physics update.
+	if (type != m_ColliderType)
+	{
+		DestroyBody();
+	}
+
 	m_ColliderType = type;
 }
 
@@ -163,13 +287,7 @@ void Pine::Collider2D::OnDestroyed()
 {
 	IComponent::OnDestroyed();
 
-	if (m_Body)
-	{
-		Physics2D::GetWorld()->DestroyBody(m_Body);
-
-		m_Body = nullptr;
-		m_Fixture = nullptr;
-	}
+	DestroyBody();
 }
 
 void Pine::Collider2D::OnCopied()
@@ -178,6 +296,19 @@ void Pine::Collider2D::OnCopied()
 
 	m_Body = nullptr;
 	m_Fixture = nullptr;
+
+	m_BodyTilemap = nullptr;
+}
+
+void Pine::Collider2D::OnCloned()
+{
+	IComponent::OnCloned();
+
+	// The body belongs to the source collider, the clone creates its own during the next physics update.
+	m_Body = nullptr;
+	m_Fixture = nullptr;
+
+	m_BodyTilemap = nullptr;
 }
 
 void Pine::Collider2D::OnRender(float deltaTime)
@@ -203,3 +334,23 @@ void Pine::Collider2D::SaveData(nlohmann::json& j)
 	j["csize"] = Serialization::StoreVector2(m_ColliderSize);
 	j["crot"] = m_ColliderRotation;
 }
+
+void Pine::Collider2D::LoadData(Serialization::BinaryReader& reader)
+{
+	IComponent::LoadData(reader);
+
+	reader.Read(m_ColliderType);
+	reader.Read(m_ColliderOffset);
+	reader.Read(m_ColliderSize);
+	reader.Read(m_ColliderRotation);
+}
+
+void Pine::Collider2D::SaveData(Serialization::BinaryWriter& writer)
+{
+	IComponent::SaveData(writer);
+
+	writer.Write(m_ColliderType);
+	writer.Write(m_ColliderOffset);
+	writer.Write(m_ColliderSize);
+	writer.Write(m_ColliderRotation);
+}
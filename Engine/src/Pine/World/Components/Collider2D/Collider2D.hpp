@@ -11,6 +11,8 @@ class b2Body;
 namespace Pine
 {
 
+    class Tilemap;
+
     enum class Collider2DType
     {
         Box,
@@ -34,7 +36,13 @@ namespace Pine
         // it's creation and update it when the user size changes.
         Vector2f m_BodySize = Vector2f(1.f);
 
+        // Tilemap colliders get fixtures per chunk, which are kept by Physics2D::GetTileChunkFixtures().
+        const Tilemap* m_BodyTilemap = nullptr;
+        float m_BodyTileSize = 0.f;
+
         void UpdateBody();
+        void UpdateTilemapBody();
+        void DestroyBody();
     protected:
         Vector2f ComputePosition() const;
         Vector2f ComputeSize() const;
@@ -57,11 +65,15 @@ namespace Pine
         void OnPrePhysicsUpdate() override;
         void OnDestroyed() override;
         void OnCopied() override;
+        void OnCloned() override;
 
         void OnRender(float deltaTime) override;
         void LoadData(const nlohmann::json& j) override;
         void SaveData(nlohmann::json& j) override;
 
+        void LoadData(Serialization::BinaryReader& reader) override;
+        void SaveData(Serialization::BinaryWriter& writer) override;
+
         friend class RigidBody2D;
     };
 
@@ -4,7 +4,9 @@
 #include "AudioSource/AudioSource.hpp"
 #include "Pine/Core/Log/Log.hpp"
 #include "Pine/Engine/Engine.hpp"
+#include "Pine/Performance/Performance.hpp"
 #include "Pine/Script/Factory/ScriptObjectFactory.hpp"
+#include "Pine/World/Entities/Entities.hpp"
 #include "Pine/World/Components/Collider2D/Collider2D.hpp"
 #include "Pine/World/Components/Camera/Camera.hpp"
 #include "Pine/World/Components/IComponent/IComponent.hpp"
@@ -25,99 +27,116 @@ namespace
 {
     std::vector<ComponentDataBlock<IComponent>*> m_ComponentDataBlocks;
 
-    bool ResizeComponentDataBlock(ComponentDataBlock<IComponent>* block, std::uint32_t size)
+    // Allocates another page of components for the block, increasing its capacity by ComponentPageSlotCount.
+    // Existing pages are left untouched, so any pointers to components in the block remain valid.
+    bool AllocateComponentPage(ComponentDataBlock<IComponent>* block)
     {
-        // Allocate the new data
-        void* arrayData = malloc(block->m_ComponentSize * size);
-        const auto arrayOccupationData = new bool[size];
+        const auto pageSize = block->m_ComponentSize * ComponentPageSlotCount;
+        const auto pageData = malloc(pageSize);
 
-        if (!arrayData)
+        if (!pageData)
         {
             Log::Error("Failure allocating data for component block");
             return false;
         }
 
-        memset(arrayData, 0, block->m_ComponentSize * size);
-        memset(arrayOccupationData, 0, sizeof(bool) * size);
+        memset(pageData, 0, pageSize);
 
-        void* oldArrayData = nullptr;
-        void* oldOccupationArray = nullptr;
+        block->m_ComponentPages.push_back(pageData);
+        block->m_ComponentSlots.SetCapacity(block->GetComponentCapacity());
 
-        // Copy over the old data if we have any
-        if (block->m_ComponentArray != nullptr &&
-            block->m_ComponentOccupationArray != nullptr)
-        {
-            std::size_t arrayBlockCopySize = block->m_ComponentArraySize;
-            std::size_t occupationArrayCopySize = block->m_ComponentOccupationArraySize;
-
-            if (block->m_ComponentArraySize > block->m_ComponentSize * size)
-            {
-                Log::Warning("Smaller new buffer for component data block, data loss possible.");
+        PINE_PF_COUNTER("Component pages allocated", 1);
 
-                arrayBlockCopySize = block->m_ComponentSize * size;
-                occupationArrayCopySize = sizeof(bool) * size;
-            }
-
-            memcpy(arrayData, block->m_ComponentArray, arrayBlockCopySize);
-            memcpy(arrayOccupationData, block->m_ComponentOccupationArray, occupationArrayCopySize);
+        if (Log::IsEnabled(LogSeverity::Verbose))
+        {
+            const auto usage = block->GetStorageUsage();
 
-            oldArrayData = static_cast<void*>(block->m_ComponentArray);
-            oldOccupationArray = static_cast<void*>(block->m_ComponentOccupationArray);
+            Log::Verbose("[Components] {} storage grew to {} pages, {}/{} slots used, {:.1f} kB",
+                         ComponentTypeToString(block->m_Component->GetType()), usage.Pages, usage.Used, usage.Capacity, usage.AllocatedSize / 1024.0);
         }
 
-        // Set the new array pointers
-        block->m_ComponentArray = static_cast<IComponent*>(arrayData);
-        block->m_ComponentArraySize = block->m_ComponentSize * size;
-
-        block->m_ComponentOccupationArray = arrayOccupationData;
-        block->m_ComponentOccupationArraySize = sizeof(bool) * size;
-
-        // Set the new size
-        block->m_ComponentArrayAllocatedCount = size;
-
-        // Free the old data (if any)
-        free(oldArrayData);
-        free(oldOccupationArray);
-
         return true;
     }
 
     template<typename T>
-    ComponentDataBlock<T>* CreateComponentDataBlock(std::uint32_t overrideInstanceCount = 0)
+    ComponentDataBlock<T>* CreateComponentDataBlock()
     {
         auto block = new ComponentDataBlock<T>();
 
         block->m_Component = new T();
         block->m_ComponentSize = sizeof(T);
 
-        std::uint32_t instanceCount = Engine::GetEngineConfiguration().m_MaxObjectCount;
-
-        if (overrideInstanceCount != 0)
-            instanceCount = overrideInstanceCount;
-
-        ResizeComponentDataBlock(reinterpret_cast<ComponentDataBlock<IComponent>*>(block), instanceCount);
-
+        // No pages are allocated up front, the block will grow as components are created.
         m_ComponentDataBlocks.push_back(reinterpret_cast<ComponentDataBlock<IComponent>*>(block));
 
         return block;
     }
 
-    template <class T> std::vector<T>& GetComponentList(ComponentType type)
+    // Creates a component of the specified type with its data copied from source, which is either
+    // the block's default component or another component of the same type.
+    IComponent* CreateFrom(ComponentType type, const IComponent* source, bool standalone)
     {
-        // Not going to bother with sanity checking the type, as it's an enum with an already known size.
-        // Hopefully, all components specified in the enum are also created in this vector though.
-        return *m_ComponentDataBlocks[static_cast<int>(type)]->m_ComponentArray;
-    }
+        const auto componentDataBlock = m_ComponentDataBlocks[static_cast<int>(type)];
+
+        IComponent* component;
+        std::uint32_t componentLookupId = 0;
+        std::uint64_t uniqueId = 0;
+
+        // Get a pointer to some free memory for the new component, depending on if we want a standalone
+        // or in the data block
+        if (standalone)
+        {
+            component = static_cast<IComponent*>(malloc(componentDataBlock->m_ComponentSize));
+        }
+        else
+        {
+            // Find a slot in the block we can use, this will also mark the slot as occupied
+            // and keep track of the new highest index.
+            auto newTargetSlot = componentDataBlock->m_ComponentSlots.Allocate();
+
+            if (newTargetSlot >= componentDataBlock->GetComponentCapacity())
+            {
+                // We've run out of space in the allocated pages, add another one. Since the
+                // other pages stay where they are, this won't invalidate any component pointers.
+                if (!AllocateComponentPage(componentDataBlock))
+                {
+                    throw std::runtime_error("Component allocation failure.");
+                }
+
+                newTargetSlot = componentDataBlock->m_ComponentSlots.Allocate();
+            }
+
+            component = componentDataBlock->GetComponent(newTargetSlot);
+
+            componentLookupId = newTargetSlot;
+            uniqueId = componentDataBlock->m_UniqueIdCount++;
+        }
 
-    bool m_IgnoreSetHighestEntityIndexFlag = false;
+        if (component == nullptr)
+        {
+            throw std::runtime_error("Component allocation failure.");
+        }
+
+        memcpy(component, source, componentDataBlock->m_ComponentSize);
+
+        component->SetStandalone(standalone);
+        component->SetInternalId(componentLookupId);
+        component->SetUniqueId(uniqueId);
+
+        component->OnCloned();
+
+        PINE_PF_COUNTER("Components created", 1);
+
+        return component;
+    }
 }
 
 void Components::Setup()
 {
     CreateComponentDataBlock<Transform>();
     CreateComponentDataBlock<ModelRenderer>();
-    CreateComponentDataBlock<NativeScript>(1); // Stub for Terrain Renderer
-    CreateComponentDataBlock<Camera>(32);
+    CreateComponentDataBlock<NativeScript>(); // Stub for Terrain Renderer
+    CreateComponentDataBlock<Camera>();
     CreateComponentDataBlock<Light>();
     CreateComponentDataBlock<Collider>();
     CreateComponentDataBlock<RigidBody>();
@@ -125,27 +144,38 @@ void Components::Setup()
     CreateComponentDataBlock<RigidBody2D>();
     CreateComponentDataBlock<SpriteRenderer>();
     CreateComponentDataBlock<TilemapRenderer>();
-    CreateComponentDataBlock<NativeScript>(1); // "Stub" for NativeScript, we cannot create NativeScripts through here, but we need to align the array.
+    CreateComponentDataBlock<NativeScript>(); // "Stub" for NativeScript, we cannot create NativeScripts through here, but we need to align the array.
     CreateComponentDataBlock<ScriptComponent>();
     CreateComponentDataBlock<AudioSource>();
     CreateComponentDataBlock<AudioListener>();
 
-    std::size_t totalSize = 0;
+    std::size_t totalPageSize = 0;
+    std::string pageSizeReport;
 
     for (const auto& block : m_ComponentDataBlocks)
     {
-        totalSize += block->m_ComponentArraySize;
+        const auto pageSize = block->m_ComponentSize * ComponentPageSlotCount;
+
+        totalPageSize += pageSize;
+
+        pageSizeReport += fmt::format("{}{} {:.1f} kB", pageSizeReport.empty() ? "" : ", ", ComponentTypeToString(block->m_Component->GetType()), pageSize / 1024.0);
     }
 
-    Log::Verbose("[Components] Total size allocated: " + std::to_string(totalSize / 1024) + " kB (" + std::to_string(Engine::GetEngineConfiguration().m_MaxObjectCount) + " objects per type)");
+    Log::Verbose("[Components] Paged storage, {} components per page, {:.1f} kB for one page of every type", ComponentPageSlotCount, totalPageSize / 1024.0);
+    Log::Verbose("[Components] Page sizes: {}", pageSizeReport);
 }
 
 void Components::Shutdown()
 {
     for (const auto block : m_ComponentDataBlocks)
     {
-        free(block->m_ComponentArray);
-        delete[] block->m_ComponentOccupationArray;
+        for (const auto page : block->m_ComponentPages)
+        {
+            free(page);
+        }
+
+        delete block->m_Component;
+        delete block;
     }
 
     m_ComponentDataBlocks.clear();
@@ -158,58 +188,8 @@ const std::vector<ComponentDataBlock<IComponent>*>&Components::GetComponentTypes
 
 IComponent* Components::Create(ComponentType type, bool standalone)
 {
-    const auto componentDataBlock = m_ComponentDataBlocks[static_cast<int>(type)];
-
-    IComponent* component;
-    std::uint32_t componentLookupId = 0;
-    std::uint64_t uniqueId = 0;
-
-    // Get a pointer to some free memory for the new component, depending on if we want a standalone
-    // or in the data block
-    if (standalone)
-    {
-        component = static_cast<IComponent*>(malloc(componentDataBlock->m_ComponentSize));
-    }
-    else
-    {
-        // Find a slot in the array we can use
-        const auto newTargetSlot = componentDataBlock->GetAvailableIndex();
-
-        if (newTargetSlot >= componentDataBlock->m_ComponentArrayAllocatedCount)
-        {
-            // I wouldn't resize the component array right now...
-            throw std::runtime_error("Maximum component count reached");
-
-            // We've run out of space in the array, we need to resize it and make it bigger.
-            // Not sure if just putting it + 128 is a good idea, but it's fine for now.
-            ResizeComponentDataBlock(componentDataBlock, componentDataBlock->m_ComponentArrayAllocatedCount + 128);
-        }
-
-        component = componentDataBlock->GetComponent(newTargetSlot);
-
-        componentLookupId = newTargetSlot;
-        uniqueId = componentDataBlock->m_UniqueIdCount++;
-
-        // Mark the index as occupied
-        componentDataBlock->m_ComponentOccupationArray[newTargetSlot] = true;
-
-        // Store the new highest index
-        componentDataBlock->m_HighestComponentIndex = componentDataBlock->GetHighestComponentIndex();
-    }
-
-    if (component == nullptr)
-    {
-        throw std::runtime_error("Component allocation failure.");
-    }
-
     // Copy the data from the 'default' component object
-    memcpy(component, componentDataBlock->m_Component, componentDataBlock->m_ComponentSize);
-
-    component->SetStandalone(standalone);
-    component->SetInternalId(componentLookupId);
-    component->SetUniqueId(uniqueId);
-
-    return component;
+    return CreateFrom(type, m_ComponentDataBlocks[static_cast<int>(type)]->m_Component, standalone);
 }
 
 IComponent* Components::Copy(IComponent* component, bool standalone)
@@ -226,6 +206,28 @@ IComponent* Components::Copy(IComponent* component, bool standalone)
     return newComponent;
 }
 
+IComponent* Components::Clone(const IComponent* component, bool standalone)
+{
+    const auto newComponent = CreateFrom(component->GetType(), component, standalone);
+
+    newComponent->SetParent(nullptr);
+
+    return newComponent;
+}
+
+void Components::Reserve(ComponentType type, std::uint32_t count)
+{
+    const auto componentDataBlock = m_ComponentDataBlocks[static_cast<int>(type)];
+
+    while (componentDataBlock->m_ComponentSlots.GetAvailableCount() < count)
+    {
+        if (!AllocateComponentPage(componentDataBlock))
+        {
+            throw std::runtime_error("Component allocation failure.");
+        }
+    }
+}
+
 bool Components::Destroy(IComponent* targetComponent)
 {
     if (m_ComponentDataBlocks.empty())
@@ -237,6 +239,8 @@ bool Components::Destroy(IComponent* targetComponent)
 
     targetComponent->OnDestroyed();
 
+    PINE_PF_COUNTER("Components destroyed", 1);
+
     // Extra fail-safe to make sure the script object handle is removed, to avoid memory leaks
     // within the scripting engine.
     assert(targetComponent->GetComponentScriptHandle()->Object == nullptr);
@@ -255,11 +259,7 @@ bool Components::Destroy(IComponent* targetComponent)
 
     // We don't have to free any memory or anything, so marking the slot as "available"
     // should be sufficient.
-    data.m_ComponentOccupationArray[internalId] = false;
-
-    // Store the new highest index
-    if (!m_IgnoreSetHighestEntityIndexFlag)
-        data.m_HighestComponentIndex = data.GetHighestComponentIndex();
+    data.m_ComponentSlots.Free(internalId);
 
     return true;
 }
@@ -269,22 +269,45 @@ ComponentDataBlock<IComponent>& Components::GetData(ComponentType type)
     return *m_ComponentDataBlocks[static_cast<int>(type)];
 }
 
-IComponent* Components::GetByInternalId(ComponentType type, std::uint32_t internalId)
+void Components::LogStorageUsage()
 {
-    auto& block = GetData(type);
+    std::size_t totalSize = 0;
 
-    return block.GetComponent(internalId);
-}
+    for (const auto& block : m_ComponentDataBlocks)
+    {
+        const auto usage = block->GetStorageUsage();
 
-void Components::SetIgnoreHighestEntityIndexFlag(bool ignore)
-{
-    m_IgnoreSetHighestEntityIndexFlag = ignore;
+        totalSize += usage.AllocatedSize;
+
+        // Types that were never used have no pages, and cost nothing but their default instance.
+        if (usage.Pages == 0)
+            continue;
+
+        Log::Verbose("[Components] {}: {} pages, {}/{} slots used, {:.1f} kB",
+                  ComponentTypeToString(block->m_Component->GetType()), usage.Pages, usage.Used, usage.Capacity, usage.AllocatedSize / 1024.0);
+    }
+
+    const auto entityUsage = Entities::GetStorageUsage();
+
+    Log::Verbose("[Components] Entities: {} pages, {}/{} slots used, {:.1f} kB",
+              entityUsage.Pages, entityUsage.Used, entityUsage.Capacity, entityUsage.AllocatedSize / 1024.0);
+
+    Log::Verbose("[Components] {:.1f} kB allocated for component pages in total", totalSize / 1024.0);
 }
 
-void Components::RecomputeHighestComponentIndex()
+IComponent* Components::GetByInternalId(ComponentType type, std::uint32_t internalId)
 {
-    for (const auto block : m_ComponentDataBlocks)
+    if (static_cast<std::size_t>(type) >= m_ComponentDataBlocks.size())
+    {
+        return nullptr;
+    }
+
+    auto& block = GetData(type);
+
+    if (!block.ComponentIndexValid(internalId))
     {
-        block->m_HighestComponentIndex = block->GetHighestComponentIndex();
+        return nullptr;
     }
+
+    return block.GetComponent(internalId);
 }
@@ -1,11 +1,32 @@
 #pragma once
+#include "Pine/Core/SlotAllocator/SlotAllocator.hpp"
 #include "Pine/World/Components/IComponent/IComponent.hpp"
+#include "Pine/World/Components/NativeScript/NativeScript.hpp"
+
+#include <type_traits>
 
 namespace Pine
 {
     template<typename T>
     struct ComponentDataBlockIterator;
 
+    // The number of components stored in each page of a component data block, pages are
+    // allocated on demand and never move, so component pointers stay valid while the block grows.
+    constexpr std::uint32_t ComponentPageSlotCount = 256;
+    constexpr std::uint32_t ComponentPageSlotShift = 8;
+
+    // Memory use of a paged object storage, such as a component data block or the entity storage.
+    struct StorageUsage
+    {
+        std::uint32_t Pages = 0;
+
+        // Occupied slots, out of the slots the allocated pages can fit.
+        std::uint32_t Used = 0;
+        std::uint32_t Capacity = 0;
+
+        std::size_t AllocatedSize = 0;
+    };
+
     template<typename T>
     struct ComponentDataBlock
     {
@@ -14,23 +35,16 @@ namespace Pine
         T* m_Component = nullptr;
         std::size_t m_ComponentSize = sizeof(T);
 
-        // The allocated data with all component objects
-        T* m_ComponentArray = nullptr;
-        std::size_t m_ComponentArraySize = 0;
-
-        // Data of which elements of the component array is occupied.
-        bool* m_ComponentOccupationArray = nullptr;
-        std::size_t m_ComponentOccupationArraySize = 0;
+        // The allocated pages, each holding ComponentPageSlotCount component objects.
+        std::vector<void*> m_ComponentPages;
 
-        // The number of components the array currently can fit (capacity)
-        std::uint32_t m_ComponentArrayAllocatedCount = 0;
+        // Keeps track of which elements of the component pages are occupied, also
+        // hands out free slots and the highest occupied index.
+        SlotAllocator m_ComponentSlots;
 
         // Incrementing counter to hand out unique ids to every created component.
         std::uint64_t m_UniqueIdCount = 0;
 
-        // Cached version of GetHighestComponentIndex(), _should_ always be correct. Will be -1 if empty.
-        int m_HighestComponentIndex = -1;
-
         // Sort of hacky, but it allows us to select what components we want to iterate through
         // I don't really like the placing of this either, problem for future me.
         bool m_IterateDisabledObjects = false;
@@ -42,43 +56,49 @@ namespace Pine
 
         ComponentDataBlockIterator<T> end()
         {
-            return ComponentDataBlockIterator<T>(m_HighestComponentIndex == -1 ? 0 : m_HighestComponentIndex, this, m_IterateDisabledObjects);
+            return ComponentDataBlockIterator<T>(GetHighestComponentIndex(), this, m_IterateDisabledObjects);
         }
 
-        __inline int GetHighestComponentIndex() const
+        // Highest occupied index + 1, zero if empty.
+        __inline std::uint32_t GetHighestComponentIndex() const
         {
-            int highestIndex = -1;
+            return m_ComponentSlots.GetHighestSlot();
+        }
 
-            for (int i = 0; i < m_ComponentOccupationArraySize;i++)
-            {
-                if (m_ComponentOccupationArray[i])
-                    highestIndex = i + 1;
-            }
+        __inline std::uint32_t GetComponentCount() const
+        {
+            return m_ComponentSlots.GetCount();
+        }
 
-            return highestIndex;
+        // The number of components the allocated pages currently can fit (capacity)
+        __inline std::uint32_t GetComponentCapacity() const
+        {
+            return static_cast<std::uint32_t>(m_ComponentPages.size()) * ComponentPageSlotCount;
         }
 
-        __inline std::uint32_t GetAvailableIndex() const
+        // The number of bytes allocated for component pages
+        __inline std::size_t GetAllocatedSize() const
         {
-            for (std::uint32_t i = 0; i < m_ComponentOccupationArraySize;i++)
-            {
-                if (!m_ComponentOccupationArray[i])
-                    return i;
-            }
+            return m_ComponentPages.size() * ComponentPageSlotCount * m_ComponentSize;
+        }
 
-            return static_cast<std::uint32_t>(m_ComponentOccupationArraySize);
+        StorageUsage GetStorageUsage() const
+        {
+            return { static_cast<std::uint32_t>(m_ComponentPages.size()), GetComponentCount(), GetComponentCapacity(), GetAllocatedSize() };
         }
 
         __inline T* GetComponent(std::uint32_t index)
         {
             // Don't wanna directly access the array here since T could be either
             // an IComponent or the component itself.
-            return reinterpret_cast<T*>(reinterpret_cast<std::uintptr_t>(m_ComponentArray) + m_ComponentSize * index);
+            const auto page = reinterpret_cast<std::uintptr_t>(m_ComponentPages[index >> ComponentPageSlotShift]);
+
+            return reinterpret_cast<T*>(page + m_ComponentSize * (index & (ComponentPageSlotCount - 1)));
         }
 
         __inline bool ComponentIndexValid(std::uint32_t index) const
         {
-            return m_ComponentOccupationArray[index];
+            return m_ComponentSlots.IsOccupied(index);
         }
     };
 
@@ -91,25 +111,7 @@ namespace Pine
               m_BlockParent(block),
               m_IterateDisabledObjects(iterateDisabledObjects)
         {
-            m_ComponentPtr = block->GetComponent(index);
-
-            if (!m_BlockParent->m_ComponentOccupationArray[index] &&
-                block->m_HighestComponentIndex != -1 &&
-                index < block->m_HighestComponentIndex)
-            {
-                ++(*this);
-            }
-
-            if (!m_IterateDisabledObjects &&
-                m_ComponentPtr &&
-                block->m_HighestComponentIndex != -1 &&
-                index < block->m_HighestComponentIndex)
-            {
-                if (!reinterpret_cast<IComponent*>(m_ComponentPtr)->IsWorldEnabled())
-                {
-                    ++(*this);
-                }
-            }
+            SeekValidComponent();
         }
 
         T& operator*() const
@@ -126,26 +128,7 @@ namespace Pine
         {
             m_ComponentIndex++;
 
-            // If we've reached .end(), we just to stop
-            if (m_ComponentIndex == m_BlockParent->m_HighestComponentIndex)
-            {
-                m_ComponentPtr = m_BlockParent->GetComponent(m_ComponentIndex);
-                return *this;
-            }
-
-            // Else start searching for the next component
-            while (!m_BlockParent->m_ComponentOccupationArray[m_ComponentIndex] ||
-                  (!m_IterateDisabledObjects && !reinterpret_cast<IComponent*>(m_BlockParent->GetComponent(m_ComponentIndex))->IsWorldEnabled()))
-            {
-                if (m_ComponentIndex >= m_BlockParent->m_HighestComponentIndex)
-                {
-                    break;
-                }
-
-                m_ComponentIndex++;
-            }
-
-            m_ComponentPtr = m_BlockParent->GetComponent(m_ComponentIndex);
+            SeekValidComponent();
 
             return *this;
         }
@@ -157,14 +140,41 @@ namespace Pine
             return tmp;
         }
 
-        friend bool operator== (const ComponentDataBlockIterator& a, const ComponentDataBlockIterator& b) { return a.m_ComponentPtr == b.m_ComponentPtr; };
-        friend bool operator!= (const ComponentDataBlockIterator& a, const ComponentDataBlockIterator& b) { return a.m_ComponentPtr != b.m_ComponentPtr; };
+        friend bool operator== (const ComponentDataBlockIterator& a, const ComponentDataBlockIterator& b) { return a.m_ComponentIndex == b.m_ComponentIndex; };
+        friend bool operator!= (const ComponentDataBlockIterator& a, const ComponentDataBlockIterator& b) { return a.m_ComponentIndex != b.m_ComponentIndex; };
     private:
+        // Moves the iterator forward to the first occupied (and enabled, if requested) component at or
+        // after the current index, or to .end() if there are none left.
+        void SeekValidComponent()
+        {
+            const auto& slots = m_BlockParent->m_ComponentSlots;
+
+            while (true)
+            {
+                m_ComponentIndex = slots.FindNextOccupied(m_ComponentIndex);
+
+                if (m_ComponentIndex >= slots.GetHighestSlot())
+                {
+                    m_ComponentPtr = nullptr;
+                    return;
+                }
+
+                m_ComponentPtr = m_BlockParent->GetComponent(m_ComponentIndex);
+
+                if (m_IterateDisabledObjects || reinterpret_cast<IComponent*>(m_ComponentPtr)->IsWorldEnabled())
+                {
+                    return;
+                }
+
+                m_ComponentIndex++;
+            }
+        }
+
         uint32_t m_ComponentIndex;
 
         ComponentDataBlock<T>* m_BlockParent;
 
-        T* m_ComponentPtr;
+        T* m_ComponentPtr = nullptr;
 
         bool m_IterateDisabledObjects = false;
     };
@@ -183,31 +193,60 @@ namespace Pine::Components
     IComponent* Copy(IComponent* component, bool standalone = false);
     bool Destroy(IComponent* component);
 
+    // Same as Copy(), but copies the component's memory directly instead of going through the
+    // serializer. The copy isn't attached to any entity, and OnCopied() is left to the caller so
+    // it can be done in bulk.
+    IComponent* Clone(const IComponent* component, bool standalone = false);
+
+    // Makes sure at least count more components of the type can be created without allocating.
+    void Reserve(ComponentType type, std::uint32_t count);
+
     // Iteration through component objects
     ComponentDataBlock<IComponent>& GetData(ComponentType type);
 
+    // Writes the pages and slots currently in use by every component type and the entities to the log.
+    void LogStorageUsage();
+
     // Returns a ComponentType from a template type
     template<typename T>
-    ComponentType GetType()
+    constexpr ComponentType GetType()
     {
-        static T ent;
-        static auto type = static_cast<IComponent*>(&ent)->GetType();
+        if constexpr (ComponentTypeTrait<T>::Valid)
+        {
+            return ComponentTypeTrait<T>::Type;
+        }
+        else
+        {
+            static_assert(std::is_base_of_v<NativeScript, T>, "T is not a component type.");
 
-        return type;
+            return ComponentType::NativeScript;
+        }
     }
 
+    // Casts the component to T, which is a plain static_cast unless T is a native script.
     template<typename T>
-    T& Create()
+    T* Cast(IComponent* component)
     {
-        static auto type = GetType<T>();
+        if constexpr (ComponentTypeTrait<T>::Valid || std::is_same_v<T, IComponent>)
+        {
+            return static_cast<T*>(component);
+        }
+        else
+        {
+            return dynamic_cast<T*>(component);
+        }
+    }
 
-        return *dynamic_cast<T*>(Create(type));
+    template<typename T>
+    T& Create()
+    {
+        return *Cast<T>(Create(GetType<T>()));
     }
 
     template<typename T>
     ComponentDataBlock<T>& Get(bool includeInactiveComponents = false)
     {
-        static auto type = GetType<T>();
+        constexpr auto type = GetType<T>();
 
         auto& block = *reinterpret_cast<ComponentDataBlock<T>*>(&GetData(type));
 
@@ -219,20 +258,19 @@ namespace Pine::Components
     template<typename T>
     T* GetByInternalId(std::uint32_t internalId)
     {
-        static auto type = GetType<T>();
+        constexpr auto type = GetType<T>();
 
         auto& block = *reinterpret_cast<ComponentDataBlock<T>*>(&GetData(type));
 
+        if (!block.ComponentIndexValid(internalId))
+        {
+            return nullptr;
+        }
+
         return block.GetComponent(internalId);
     }
 
     IComponent* GetByInternalId(Pine::ComponentType type, std::uint32_t internalId);
-
-    // Internal hints that may be set by the engine to optimize component iteration
-    void SetIgnoreHighestEntityIndexFlag(bool ignore);
-
-    // Internal hints that may be set by the engine to optimize component iteration
-    void RecomputeHighestComponentIndex();
 }
 
 namespace Pine
@@ -262,7 +300,7 @@ namespace Pine
                 return nullptr;
             }
 
-            return dynamic_cast<T*>(component);
+            return Components::Cast<T>(component);
         }
 
         T *operator->()
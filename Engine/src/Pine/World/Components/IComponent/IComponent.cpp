@@ -19,7 +19,12 @@ std::uint64_t Pine::IComponent::GetUniqueId() const
 
 void Pine::IComponent::SetActive(bool value)
 {
+    if (m_Active == value)
+        return;
+
     m_Active = value;
+
+    OnEnabledChanged();
 }
 
 bool Pine::IComponent::GetActive() const
@@ -73,6 +78,14 @@ void Pine::IComponent::OnCopied()
     m_ScriptObjectHandle = { nullptr, 0 };
 }
 
+void Pine::IComponent::OnCloned()
+{
+}
+
+void Pine::IComponent::OnEnabledChanged()
+{
+}
+
 void Pine::IComponent::OnSetup()
 {
 }
@@ -101,6 +114,14 @@ void Pine::IComponent::SaveData(nlohmann::json& j)
 {
 }
 
+void Pine::IComponent::LoadData(Serialization::BinaryReader& reader)
+{
+}
+
+void Pine::IComponent::SaveData(Serialization::BinaryWriter& writer)
+{
+}
+
 bool Pine::IComponent::IsWorldEnabled() const
 {
     return m_Active && m_Parent->GetActive();
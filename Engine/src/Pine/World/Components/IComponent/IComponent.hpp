@@ -1,6 +1,7 @@
 #pragma once
 
 #include <nlohmann/json.hpp>
+#include "Pine/Core/Serialization/Binary/Binary.hpp"
 #include "Pine/Script/Factory/ScriptObjectFactory.hpp"
 
 namespace Pine
@@ -26,6 +27,51 @@ namespace Pine
         AudioListener,
     };
 
+    constexpr std::size_t ComponentTypeCount = static_cast<std::size_t>(ComponentType::AudioListener) + 1;
+
+    class Transform;
+    class ModelRenderer;
+    class Camera;
+    class Light;
+    class Collider;
+    class RigidBody;
+    class Collider2D;
+    class RigidBody2D;
+    class SpriteRenderer;
+    class TilemapRenderer;
+    class ScriptComponent;
+    class AudioSource;
+    class AudioListener;
+
+    // Maps a component class to its ComponentType at compile time. Native scripts are left out on purpose,
+    // as they're user defined classes deriving from NativeScript and an entity may have several of them.
+    template<typename T>
+    struct ComponentTypeTrait
+    {
+        static constexpr bool Valid = false;
+    };
+
+    template<ComponentType T>
+    struct ComponentTypeTraitValue
+    {
+        static constexpr bool Valid = true;
+        static constexpr ComponentType Type = T;
+    };
+
+    template<> struct ComponentTypeTrait<Transform> : ComponentTypeTraitValue<ComponentType::Transform> {};
+    template<> struct ComponentTypeTrait<ModelRenderer> : ComponentTypeTraitValue<ComponentType::ModelRenderer> {};
+    template<> struct ComponentTypeTrait<Camera> : ComponentTypeTraitValue<ComponentType::Camera> {};
+    template<> struct ComponentTypeTrait<Light> : ComponentTypeTraitValue<ComponentType::Light> {};
+    template<> struct ComponentTypeTrait<Collider> : ComponentTypeTraitValue<ComponentType::Collider> {};
+    template<> struct ComponentTypeTrait<RigidBody> : ComponentTypeTraitValue<ComponentType::RigidBody> {};
+    template<> struct ComponentTypeTrait<Collider2D> : ComponentTypeTraitValue<ComponentType::Collider2D> {};
+    template<> struct ComponentTypeTrait<RigidBody2D> : ComponentTypeTraitValue<ComponentType::RigidBody2D> {};
+    template<> struct ComponentTypeTrait<SpriteRenderer> : ComponentTypeTraitValue<ComponentType::SpriteRenderer> {};
+    template<> struct ComponentTypeTrait<TilemapRenderer> : ComponentTypeTraitValue<ComponentType::TilemapRenderer> {};
+    template<> struct ComponentTypeTrait<ScriptComponent> : ComponentTypeTraitValue<ComponentType::Script> {};
+    template<> struct ComponentTypeTrait<AudioSource> : ComponentTypeTraitValue<ComponentType::AudioSource> {};
+    template<> struct ComponentTypeTrait<AudioListener> : ComponentTypeTraitValue<ComponentType::AudioListener> {};
+
     inline const char *ComponentTypeToString(ComponentType type)
     {
         switch (type)
@@ -157,6 +203,14 @@ namespace Pine
         // Used to over fix raw pointers to new objects.
         virtual void OnCopied();
 
+        // Called right after the component's memory was copied from its source, which is either the type's default
+        // component or the component given to Components::Clone(). Anything the component owns outside of its own
+        // memory, such as asset references, has to be set up again here.
+        virtual void OnCloned();
+
+        // Called whenever the component or its entity gets enabled or disabled.
+        virtual void OnEnabledChanged();
+
         // Called when the game world is set to be initialized.
         // May or may not be directly after OnCreated()
         virtual void OnSetup();
@@ -173,6 +227,10 @@ namespace Pine
 
         virtual void LoadData(const nlohmann::json &j);
         virtual void SaveData(nlohmann::json &j);
+
+        // Binary counterparts used by cooked assets, should read and write the same fields as the JSON versions.
+        virtual void LoadData(Serialization::BinaryReader &reader);
+        virtual void SaveData(Serialization::BinaryWriter &writer);
     };
 
 }
\ No newline at end of file
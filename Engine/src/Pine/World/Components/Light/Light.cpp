@@ -1,5 +1,15 @@
 #include "Light.hpp"
 #include "Pine/Core/Serialization/Serialization.hpp"
+#include "Pine/World/SpatialIndex/SpatialIndex.hpp"
+
+#include <limits>
+
+namespace
+{
+    // The attenuated intensity at which we consider the light to no longer contribute,
+    // relative to the brightest color channel.
+    constexpr float LightRangeThreshold = 1.f / 256.f;
+}
 
 Pine::Light::Light()
         : IComponent(ComponentType::Light)
@@ -9,6 +19,8 @@ Pine::Light::Light()
 void Pine::Light::SetLightType(LightType type)
 {
     m_LightType = type;
+
+    SpatialIndex::QueueUpdate(this);
 }
 
 Pine::LightType Pine::Light::GetLightType() const
@@ -19,6 +31,8 @@ Pine::LightType Pine::Light::GetLightType() const
 void Pine::Light::SetLightColor(Vector3f color)
 {
     m_LightColor = color;
+
+    SpatialIndex::QueueUpdate(this);
 }
 
 const Pine::Vector3f &Pine::Light::GetLightColor() const
@@ -29,6 +43,8 @@ const Pine::Vector3f &Pine::Light::GetLightColor() const
 void Pine::Light::SetLightAttenuation(Vector3f attenuation)
 {
     m_LightAttenuation = attenuation;
+
+    SpatialIndex::QueueUpdate(this);
 }
 
 const Pine::Vector3f & Pine::Light::GetLightAttenuation() const
@@ -56,6 +72,35 @@ float Pine::Light::GetSpotlightCutoff() const
     return m_SpotlightCutoff;
 }
 
+float Pine::Light::GetRange() const
+{
+    if (m_LightType == LightType::Directional)
+    {
+        return std::numeric_limits<float>::infinity();
+    }
+
+    const float constant = m_LightAttenuation.x;
+    const float linear = m_LightAttenuation.y;
+    const float quadratic = m_LightAttenuation.z;
+
+    const float brightness = std::max(std::max(m_LightColor.x, m_LightColor.y), m_LightColor.z);
+
+    // Solve brightness / (constant + linear * d + quadratic * d^2) = threshold for d
+    const float target = constant - brightness / LightRangeThreshold;
+
+    if (quadratic > 0.f)
+    {
+        return std::max((-linear + std::sqrt(linear * linear - 4.f * quadratic * target)) / (2.f * quadratic), 0.f);
+    }
+
+    if (linear > 0.f)
+    {
+        return std::max(-target / linear, 0.f);
+    }
+
+    return std::numeric_limits<float>::infinity();
+}
+
 Pine::Renderer3D::LightHintData& Pine::Light::GetLightHintData()
 {
     return m_LightHintData;
@@ -68,6 +113,8 @@ void Pine::Light::LoadData(const nlohmann::json &j)
     Serialization::LoadVector3(j, "lightAttenuation", m_LightAttenuation);
     Serialization::LoadValue(j, "spotlightRadius", m_SpotlightRadius);
     Serialization::LoadValue(j, "spotlightCutoff", m_SpotlightCutoff);
+
+    SpatialIndex::QueueUpdate(this);
 }
 
 void Pine::Light::SaveData(nlohmann::json &j)
@@ -78,3 +125,45 @@ void Pine::Light::SaveData(nlohmann::json &j)
     j["spotlightRadius"] = m_SpotlightRadius;
     j["spotlightCutoff"] = m_SpotlightCutoff;
 }
+
+void Pine::Light::LoadData(Serialization::BinaryReader& reader)
+{
+    reader.Read(m_LightType);
+    reader.Read(m_LightColor);
+    reader.Read(m_LightAttenuation);
+    reader.Read(m_SpotlightRadius);
+    reader.Read(m_SpotlightCutoff);
+
+    SpatialIndex::QueueUpdate(this);
+}
+
+void Pine::Light::SaveData(Serialization::BinaryWriter& writer)
+{
+    writer.Write(m_LightType);
+    writer.Write(m_LightColor);
+    writer.Write(m_LightAttenuation);
+    writer.Write(m_SpotlightRadius);
+    writer.Write(m_SpotlightCutoff);
+}
+
+void Pine::Light::OnCreated()
+{
+    IComponent::OnCreated();
+
+    SpatialIndex::QueueUpdate(this);
+}
+
+void Pine::Light::OnDestroyed()
+{
+    IComponent::OnDestroyed();
+
+    SpatialIndex::Remove(this);
+}
+
+void Pine::Light::OnCopied()
+{
+    IComponent::OnCopied();
+
+    m_LightHintData.SpatialProxy = DynamicAABBTree::NullNode;
+    m_LightHintData.SpatialUpdateQueued = false;
+}
@@ -1,6 +1,7 @@
 #pragma once
 #include "Pine/World/Components/IComponent/IComponent.hpp"
 #include "Pine/Core/Math/Math.hpp"
+#include "Pine/Core/DynamicAABBTree/DynamicAABBTree.hpp"
 
 namespace Pine
 {
@@ -17,6 +18,11 @@ namespace Pine
         struct LightHintData
         {
             std::uint16_t LightIndex {};
+
+            // The spatial index proxy, which tree it's in, and if it's queued to be refit.
+            std::int32_t SpatialProxy = DynamicAABBTree::NullNode;
+            bool SpatialStatic = false;
+            bool SpatialUpdateQueued = false;
         };
     }
 
@@ -51,10 +57,21 @@ namespace Pine
         void SetSpotlightCutoff(float cutoff);
         float GetSpotlightCutoff() const;
 
+        // The distance at which the light's contribution becomes negligible according to the
+        // attenuation, infinite for directional lights.
+        float GetRange() const;
+
         Renderer3D::LightHintData& GetLightHintData();
 
+        void OnCreated() override;
+        void OnDestroyed() override;
+        void OnCopied() override;
+
         void LoadData(const nlohmann::json& j) override;
         void SaveData(nlohmann::json& j) override;
+
+        void LoadData(Serialization::BinaryReader& reader) override;
+        void SaveData(Serialization::BinaryWriter& writer) override;
     };
 
 }
@@ -1,5 +1,7 @@
 #include "ModelRenderer.hpp"
 #include "Pine/Core/Serialization/Serialization.hpp"
+#include "Pine/Rendering/SceneProcessor/SceneProcessor.hpp"
+#include "Pine/World/SpatialIndex/SpatialIndex.hpp"
 
 Pine::ModelRenderer::ModelRenderer()
         : IComponent(ComponentType::ModelRenderer)
@@ -9,6 +11,9 @@ Pine::ModelRenderer::ModelRenderer()
 void Pine::ModelRenderer::SetModel(Model*model)
 {
     m_Model = model;
+
+    SpatialIndex::QueueUpdate(this);
+    Rendering::SceneProcessor::QueueBatchUpdate(this);
 }
 
 Pine::Model *Pine::ModelRenderer::GetModel() const
@@ -19,6 +24,8 @@ Pine::Model *Pine::ModelRenderer::GetModel() const
 void Pine::ModelRenderer::SetOverrideMaterial(Material *material)
 {
     m_OverrideMaterial = material;
+
+    Rendering::SceneProcessor::QueueBatchUpdate(this);
 }
 
 Pine::Material * Pine::ModelRenderer::GetOverrideMaterial() const
@@ -26,11 +33,59 @@ Pine::Material * Pine::ModelRenderer::GetOverrideMaterial() const
     return m_OverrideMaterial.Get();
 }
 
+void Pine::ModelRenderer::OnCreated()
+{
+    IComponent::OnCreated();
+
+    SpatialIndex::QueueUpdate(this);
+    Rendering::SceneProcessor::QueueBatchUpdate(this);
+}
+
+void Pine::ModelRenderer::OnDestroyed()
+{
+    IComponent::OnDestroyed();
+
+    SpatialIndex::Remove(this);
+    Rendering::SceneProcessor::RemoveFromBatches(this);
+}
+
+void Pine::ModelRenderer::OnCopied()
+{
+    IComponent::OnCopied();
+
+    m_RenderingHintData.SpatialProxy = DynamicAABBTree::NullNode;
+    m_RenderingHintData.SpatialUpdateQueued = false;
+
+    m_RenderingHintData.BatchUpdateQueued = false;
+    m_RenderingHintData.InRenderBatch = false;
+    m_RenderingHintData.InBlendBatch = false;
+    m_RenderingHintData.BatchModel = nullptr;
+    m_RenderingHintData.BatchOverrideMaterial = nullptr;
+}
+
+void Pine::ModelRenderer::OnCloned()
+{
+    IComponent::OnCloned();
+
+    m_Model.AddReference();
+    m_OverrideMaterial.AddReference();
+}
+
+void Pine::ModelRenderer::OnEnabledChanged()
+{
+    IComponent::OnEnabledChanged();
+
+    Rendering::SceneProcessor::QueueBatchUpdate(this);
+}
+
 void Pine::ModelRenderer::LoadData(const nlohmann::json &j)
 {
     Serialization::LoadAsset<Pine::Model>(j, "model", m_Model);
     Serialization::LoadAsset<Pine::Material>(j, "overrideMaterial", m_OverrideMaterial);
     Serialization::LoadValue(j, "modelMeshIndex", m_ModelMeshIndex);
+
+    SpatialIndex::QueueUpdate(this);
+    Rendering::SceneProcessor::QueueBatchUpdate(this);
 }
 
 void Pine::ModelRenderer::SaveData(nlohmann::json &j)
@@ -40,6 +95,23 @@ void Pine::ModelRenderer::SaveData(nlohmann::json &j)
     j["modelMeshIndex"] = m_ModelMeshIndex;
 }
 
+void Pine::ModelRenderer::LoadData(Serialization::BinaryReader& reader)
+{
+    Serialization::LoadAsset(reader, m_Model);
+    Serialization::LoadAsset(reader, m_OverrideMaterial);
+    reader.Read(m_ModelMeshIndex);
+
+    SpatialIndex::QueueUpdate(this);
+    Rendering::SceneProcessor::QueueBatchUpdate(this);
+}
+
+void Pine::ModelRenderer::SaveData(Serialization::BinaryWriter& writer)
+{
+    Serialization::StoreAsset(writer, m_Model);
+    Serialization::StoreAsset(writer, m_OverrideMaterial);
+    writer.Write(m_ModelMeshIndex);
+}
+
 void Pine::ModelRenderer::SetOverrideStencilBuffer(bool value)
 {
     m_OverrideStencilBuffer = value;
@@ -1,19 +1,33 @@
 #pragma once
 #include "Pine/Assets/Model/Model.hpp"
+#include "Pine/Core/DynamicAABBTree/DynamicAABBTree.hpp"
 #include "Pine/World/Components/Components.hpp"
 #include "Pine/World/Components/IComponent/IComponent.hpp"
 
 namespace Pine
 {
-    class Light;
-
     namespace Renderer3D
     {
         struct ModelRendererHintData
         {
             bool HasPassedFrustumCulling = false;
-            bool HasComputedData = false;
-            std::array<ComponentHandle<Light>, 6> LightSlotIndex = {};
+
+            // World space bounds of the model, maintained by the spatial index.
+            AABB WorldBounds;
+
+            // The spatial index proxy, which tree it's in, and if it's queued to be refit.
+            std::int32_t SpatialProxy = DynamicAABBTree::NullNode;
+            bool SpatialStatic = false;
+            bool SpatialUpdateQueued = false;
+
+            // Where the model renderer is within the scene processor's render batches.
+            bool BatchUpdateQueued = false;
+            bool InRenderBatch = false;
+            bool InBlendBatch = false;
+            Model* BatchModel = nullptr;
+            Material* BatchOverrideMaterial = nullptr;
+            std::uint32_t BatchIndex = 0;
+            std::uint32_t BlendBatchIndex = 0;
         };
     }
 
@@ -48,8 +62,17 @@ namespace Pine
 
         Renderer3D::ModelRendererHintData& GetRenderingHintData();
 
+        void OnCreated() override;
+        void OnDestroyed() override;
+        void OnCopied() override;
+        void OnCloned() override;
+        void OnEnabledChanged() override;
+
         void LoadData(const nlohmann::json& j) override;
         void SaveData(nlohmann::json& j) override;
+
+        void LoadData(Serialization::BinaryReader& reader) override;
+        void SaveData(Serialization::BinaryWriter& writer) override;
     };
 
 }
@@ -204,20 +204,24 @@ void Pine::RigidBody::OnPrePhysicsUpdate()
 }
 
 void Pine::RigidBody::OnPostPhysicsUpdate()
+{
+    ApplyGlobalPose(*GetParent()->GetTransform());
+}
+
+void Pine::RigidBody::ApplyGlobalPose(Transform& transform)
 {
     if (m_Parent->GetStatic())
         return;
     if (m_RigidBody == nullptr)
         return;
 
-    const auto transform = GetParent()->GetTransform();
     const auto position = m_RigidBody->getGlobalPose().p;
     const auto rotation = m_RigidBody->getGlobalPose().q;
 
     if (m_RigidBodyType == RigidBodyType::Dynamic)
     {
-        transform->SetLocalPosition(Vector3f(position.x, position.y, position.z) - m_EngineCollider->GetPosition());
-        transform->SetLocalRotation({rotation.w, rotation.x, rotation.y, rotation.z});
+        transform.SetLocalPosition(Vector3f(position.x, position.y, position.z) - m_EngineCollider->GetPosition());
+        transform.SetLocalRotation({rotation.w, rotation.x, rotation.y, rotation.z});
     }
 }
 
@@ -259,4 +263,26 @@ void Pine::RigidBody::SaveData(nlohmann::json &j)
     j["mlin"] = m_MaxLinearVelocity;
     j["posl"] = m_PositionLock;
     j["rotl"] = m_RotationLock;
+}
+
+void Pine::RigidBody::LoadData(Serialization::BinaryReader &reader)
+{
+    reader.Read(m_Mass);
+    reader.Read(m_GravityEnabled);
+    reader.Read(m_RigidBodyType);
+    reader.Read(m_MaxAngularVelocity);
+    reader.Read(m_MaxLinearVelocity);
+    reader.Read(m_PositionLock);
+    reader.Read(m_RotationLock);
+}
+
+void Pine::RigidBody::SaveData(Serialization::BinaryWriter &writer)
+{
+    writer.Write(m_Mass);
+    writer.Write(m_GravityEnabled);
+    writer.Write(m_RigidBodyType);
+    writer.Write(m_MaxAngularVelocity);
+    writer.Write(m_MaxLinearVelocity);
+    writer.Write(m_PositionLock);
+    writer.Write(m_RotationLock);
 }
\ No newline at end of file
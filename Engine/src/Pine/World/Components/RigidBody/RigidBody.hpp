@@ -70,6 +70,9 @@ namespace Pine
 
         bool IsColliderAttached(const Collider *collider) const;
 
+        // Moves the transform, which has to be the parent entity's, to where the simulation put the body.
+        void ApplyGlobalPose(Transform& transform);
+
         void OnPrePhysicsUpdate() override;
         void OnPostPhysicsUpdate() override;
 
@@ -78,6 +81,9 @@ namespace Pine
 
         void LoadData(const nlohmann::json &j) override;
         void SaveData(nlohmann::json &j) override;
+
+        void LoadData(Serialization::BinaryReader &reader) override;
+        void SaveData(Serialization::BinaryWriter &writer) override;
     };
 
 
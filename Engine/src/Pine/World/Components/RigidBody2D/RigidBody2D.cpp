@@ -36,6 +36,12 @@ void Pine::RigidBody2D::UpdateBody()
 
 	auto collider = GetParent()->GetComponent<Collider2D>();
 
+	// Tilemap colliders are always static, and create their own body.
+	if (collider->GetColliderType() == Collider2DType::Tilemap)
+	{
+		return;
+	}
+
 	if (m_Body)
 	{
 	    if (m_BodySize != collider->ComputeSize() || 
@@ -156,3 +162,17 @@ void Pine::RigidBody2D::SaveData(nlohmann::json& j)
 
 	j["rtype"] = m_RigidBodyType;
 }
+
+void Pine::RigidBody2D::LoadData(Serialization::BinaryReader& reader)
+{
+	IComponent::LoadData(reader);
+
+	reader.Read(m_RigidBodyType);
+}
+
+void Pine::RigidBody2D::SaveData(Serialization::BinaryWriter& writer)
+{
+	IComponent::SaveData(writer);
+
+	writer.Write(m_RigidBodyType);
+}
@@ -47,6 +47,9 @@ namespace Pine
         void OnRender(float deltaTime) override;
         void LoadData(const nlohmann::json& j) override;
         void SaveData(nlohmann::json& j) override;
+
+        void LoadData(Serialization::BinaryReader& reader) override;
+        void SaveData(Serialization::BinaryWriter& writer) override;
     };
 
 
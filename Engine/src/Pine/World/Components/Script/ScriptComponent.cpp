@@ -52,6 +52,13 @@ void Pine::ScriptComponent::OnCopied()
     m_ScriptObjectHandle.Handle = 0;
 }
 
+void Pine::ScriptComponent::OnCloned()
+{
+    IComponent::OnCloned();
+
+    m_Script.AddReference();
+}
+
 void Pine::ScriptComponent::OnDestroyed()
 {
     IComponent::OnDestroyed();
@@ -103,3 +110,13 @@ void Pine::ScriptComponent::SaveData(nlohmann::json &j)
 {
     j["script"] = Serialization::StoreAsset(m_Script);
 }
+
+void Pine::ScriptComponent::LoadData(Serialization::BinaryReader& reader)
+{
+    Serialization::LoadAsset(reader, m_Script);
+}
+
+void Pine::ScriptComponent::SaveData(Serialization::BinaryWriter& writer)
+{
+    Serialization::StoreAsset(writer, m_Script);
+}
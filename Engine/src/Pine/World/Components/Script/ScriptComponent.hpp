@@ -26,10 +26,14 @@ namespace Pine
 
         void OnCreated() override;
         void OnCopied() override;
+        void OnCloned() override;
         void OnDestroyed() override;
 
         void LoadData(const nlohmann::json& j) override;
         void SaveData(nlohmann::json& j) override;
+
+        void LoadData(Serialization::BinaryReader& reader) override;
+        void SaveData(Serialization::BinaryWriter& writer) override;
     };
 
 }
\ No newline at end of file
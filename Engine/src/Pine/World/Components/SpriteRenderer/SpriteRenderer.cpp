@@ -46,6 +46,13 @@ Pine::SpriteScalingMode Pine::SpriteRenderer::GetScalingMode() const
     return m_ScalingMode;
 }
 
+void Pine::SpriteRenderer::OnCloned()
+{
+    IComponent::OnCloned();
+
+    m_StaticTexture.AddReference();
+}
+
 void Pine::SpriteRenderer::LoadData(const nlohmann::json& j)
 {
     Serialization::LoadAsset(j, "tex", m_StaticTexture);
@@ -61,3 +68,19 @@ void Pine::SpriteRenderer::SaveData(nlohmann::json& j)
     j["odr"] = m_Order;
     j["clr"] = Serialization::StoreVector4(m_Color);
 }
+
+void Pine::SpriteRenderer::LoadData(Serialization::BinaryReader& reader)
+{
+    Serialization::LoadAsset(reader, m_StaticTexture);
+    reader.Read(m_ScalingMode);
+    reader.Read(m_Order);
+    reader.Read(m_Color);
+}
+
+void Pine::SpriteRenderer::SaveData(Serialization::BinaryWriter& writer)
+{
+    Serialization::StoreAsset(writer, m_StaticTexture);
+    writer.Write(m_ScalingMode);
+    writer.Write(m_Order);
+    writer.Write(m_Color);
+}
@@ -37,8 +37,13 @@ namespace Pine
         void SetColor(const Pine::Vector4f& color);
         const Pine::Vector4f& GetColor() const;
 
+        void OnCloned() override;
+
         void LoadData(const nlohmann::json& j) override;
         void SaveData(nlohmann::json& j) override;
+
+        void LoadData(Serialization::BinaryReader& reader) override;
+        void SaveData(Serialization::BinaryWriter& writer) override;
     };
 
 }
\ No newline at end of file
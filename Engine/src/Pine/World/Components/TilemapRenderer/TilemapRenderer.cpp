@@ -26,6 +26,13 @@ int Pine::TilemapRenderer::GetOrder() const
     return m_Order;
 }
 
+void Pine::TilemapRenderer::OnCloned()
+{
+    IComponent::OnCloned();
+
+    m_Tilemap.AddReference();
+}
+
 void Pine::TilemapRenderer::LoadData(const nlohmann::json& j)
 {
     Serialization::LoadAsset(j, "tm", m_Tilemap);
@@ -37,3 +44,15 @@ void Pine::TilemapRenderer::SaveData(nlohmann::json& j)
     j["tm"] = Serialization::StoreAsset(m_Tilemap.Get());
     j["odr"] = m_Order;
 }
+
+void Pine::TilemapRenderer::LoadData(Serialization::BinaryReader& reader)
+{
+    Serialization::LoadAsset(reader, m_Tilemap);
+    reader.Read(m_Order);
+}
+
+void Pine::TilemapRenderer::SaveData(Serialization::BinaryWriter& writer)
+{
+    Serialization::StoreAsset(writer, m_Tilemap);
+    writer.Write(m_Order);
+}
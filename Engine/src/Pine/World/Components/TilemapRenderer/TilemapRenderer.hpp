@@ -21,8 +21,13 @@ namespace Pine
         void SetOrder(int order);
         int GetOrder() const;
 
+        void OnCloned() override;
+
         void LoadData(const nlohmann::json& j) override;
         void SaveData(nlohmann::json& j) override;
+
+        void LoadData(Serialization::BinaryReader& reader) override;
+        void SaveData(Serialization::BinaryWriter& writer) override;
     };
 
 }
\ No newline at end of file
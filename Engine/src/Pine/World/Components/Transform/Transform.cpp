@@ -1,18 +1,116 @@
 #include "Transform.hpp"
 #include "Pine/Core/Serialization/Serialization.hpp"
+#include "Pine/Threading/Threading.hpp"
+#include "Pine/World/Components/Transform/TransformStore/TransformStore.hpp"
 #include "Pine/World/Entity/Entity.hpp"
 
+#include <mutex>
+
 using namespace Pine;
 
-void Transform::CalculateTransformationMatrix()
+namespace
+{
+    // Incremented by Transform::EndFrame(), used to tell if a transform has changed since the last frame.
+    std::uint32_t m_FrameIndex = 1;
+
+    // The number of local matrices each job builds, and the number of hierarchies each job
+    // updates in UpdateWorldTransforms()
+    constexpr std::uint32_t BuildGrainSize = 1024;
+    constexpr std::uint32_t UpdateGrainSize = 64;
+
+    // The local transforms of every transform in the world, indexed by component slot.
+    Pine::TransformStore m_TransformStore;
+
+    // The dirty transforms gathered by UpdateWorldTransforms(), each hierarchy is stored depth first so
+    // parents always come before their children.
+    std::vector<const Pine::Transform*> m_DirtyTransforms;
+    std::vector<std::uint32_t> m_HierarchyOffsets;
+
+    // See Transform::TakeChangedTransforms(), the mutex is only needed for the lazy updates done by the
+    // getters, since those may happen from any thread.
+    std::vector<const Pine::Transform*> m_ChangedTransforms;
+    std::mutex m_ChangedTransformsMutex;
+
+    void GatherHierarchy(const Pine::Entity* entity)
+    {
+        m_DirtyTransforms.push_back(entity->GetTransform());
+
+        for (const auto child : entity->GetChildren())
+        {
+            GatherHierarchy(child);
+        }
+    }
+}
+
+void Transform::CalculateTransformationMatrix() const
+{
+    if (!m_Standalone)
+    {
+        m_TransformStore.BuildMatrices(m_InternalId, m_InternalId + 1);
+
+        CalculateWorldTransform(m_TransformStore.GetMatrix(m_InternalId));
+
+        std::lock_guard lock(m_ChangedTransformsMutex);
+
+        QueueChange();
+
+        return;
+    }
+
+    Matrix4f localMatrix = Matrix4f(1.f);
+
+    localMatrix = translate(localMatrix, m_LocalPosition);
+    localMatrix *= toMat4(m_LocalRotation);
+    localMatrix = scale(localMatrix, m_LocalScale);
+
+    CalculateWorldTransform(localMatrix);
+}
+
+void Transform::CalculateWorldTransform(const Matrix4f& localMatrix) const
 {
-    m_TransformationMatrix = Matrix4f(1.f);
+    const auto localRotation = GetLocalRotation();
+    const auto localScale = GetLocalScale();
+
+    m_TransformationMatrix = localMatrix;
+
+    m_Rotation = localRotation;
+    m_Scale = localScale;
+
+    if (m_Parent != nullptr && m_Parent->GetParent() != nullptr)
+    {
+        const auto parentTransform = m_Parent->GetParent()->GetTransform();
+
+        if (parentTransform->m_IsDirty)
+        {
+            parentTransform->CalculateTransformationMatrix();
+        }
 
-    m_TransformationMatrix = translate(m_TransformationMatrix, GetPosition());
-    m_TransformationMatrix *= toMat4(GetRotation());
-    m_TransformationMatrix = scale(m_TransformationMatrix, GetScale());
+        m_TransformationMatrix = parentTransform->m_TransformationMatrix * m_TransformationMatrix;
+
+        m_Rotation = parentTransform->m_Rotation * localRotation;
+
+        // Multiplying the scales component-wise is only correct as long as no parent is rotated, so the scale is
+        // taken from the length of the world matrix's axes instead. Mirrored axes keep their sign.
+        m_Scale = glm::sign(parentTransform->m_Scale * localScale) * Vector3f(glm::length(Vector3f(m_TransformationMatrix[0])),
+                                                                                 glm::length(Vector3f(m_TransformationMatrix[1])),
+                                                                                 glm::length(Vector3f(m_TransformationMatrix[2])));
+    }
+
+    m_Position = Vector3f(m_TransformationMatrix[3]);
 
     m_IsDirty = false;
+    m_UpdateFrame = m_FrameIndex;
+}
+
+void Transform::QueueChange() const
+{
+    if (m_Standalone || m_ChangeQueued)
+    {
+        return;
+    }
+
+    m_ChangeQueued = true;
+    m_ChangedTransforms.push_back(this);
 }
 
 Transform::Transform() :
@@ -23,6 +121,22 @@ Transform::Transform() :
 void Transform::SetDirty()
 {
     m_IsDirty = true;
+
+    if (m_Parent == nullptr)
+    {
+        return;
+    }
+
+    for (const auto child : m_Parent->GetChildren())
+    {
+        const auto childTransform = child->GetTransform();
+
+        // Anything below an already dirty transform is dirty as well.
+        if (!childTransform->m_IsDirty)
+        {
+            childTransform->SetDirty();
+        }
+    }
 }
 
 bool Transform::IsDirty() const
@@ -30,6 +144,37 @@ bool Transform::IsDirty() const
     return m_IsDirty;
 }
 
+bool Transform::HasChanged() const
+{
+    return m_UpdateFrame == m_FrameIndex;
+}
+
+void Transform::OnCloned()
+{
+    IComponent::OnCloned();
+
+    if (m_Standalone)
+    {
+        return;
+    }
+
+    // The store grows a page of slots at a time, same as the component storage.
+    m_TransformStore.Reserve((m_InternalId / ComponentPageSlotCount + 1) * ComponentPageSlotCount);
+    m_TransformStore.Set(m_InternalId, m_LocalPosition, m_LocalRotation, m_LocalScale);
+
+    m_IsDirty = true;
+    m_ChangeQueued = false;
+}
+
+void Transform::OnDestroyed()
+{
+    IComponent::OnDestroyed();
+
+    // The transform stays in the list of changed transforms until the next TakeChangedTransforms(), which
+    // skips it once this is cleared, as the entity is about to go away.
+    m_ChangeQueued = false;
+}
+
 void Transform::OnRender(float deltaTime)
 {
     if (!m_IsDirty)
@@ -42,117 +187,236 @@ void Transform::OnRender(float deltaTime)
 
 void Transform::LoadData(const nlohmann::json &j)
 {
-    Serialization::LoadVector3(j, "pos", m_LocalPosition);
-    Serialization::LoadQuaternion(j, "rot", m_LocalRotation);
-    Serialization::LoadVector3(j, "scl", m_LocalScale);
+    auto position = GetLocalPosition();
+    auto rotation = GetLocalRotation();
+    auto scale = GetLocalScale();
 
-    m_IsDirty = true;
+    Serialization::LoadVector3(j, "pos", position);
+    Serialization::LoadQuaternion(j, "rot", rotation);
+    Serialization::LoadVector3(j, "scl", scale);
+
+    SetLocalPosition(position);
+    SetLocalRotation(rotation);
+    SetLocalScale(scale);
 }
 
 void Transform::SaveData(nlohmann::json &j)
 {
-    j["pos"] = Serialization::StoreVector3(m_LocalPosition);
-    j["rot"] = Serialization::StoreQuaternion(m_LocalRotation);
-    j["scl"] = Serialization::StoreVector3(m_LocalScale);
+    j["pos"] = Serialization::StoreVector3(GetLocalPosition());
+    j["rot"] = Serialization::StoreQuaternion(GetLocalRotation());
+    j["scl"] = Serialization::StoreVector3(GetLocalScale());
+}
+
+void Transform::LoadData(Serialization::BinaryReader& reader)
+{
+    Vector3f position;
+    Quaternion rotation;
+    Vector3f scale;
+
+    reader.Read(position);
+    reader.Read(rotation);
+    reader.Read(scale);
+
+    SetLocalPosition(position);
+    SetLocalRotation(rotation);
+    SetLocalScale(scale);
+}
+
+void Transform::SaveData(Serialization::BinaryWriter& writer)
+{
+    writer.Write(GetLocalPosition());
+    writer.Write(GetLocalRotation());
+    writer.Write(GetLocalScale());
 }
 
-const Vector3f& Transform::GetLocalPosition() const
+Vector3f Transform::GetLocalPosition() const
 {
-    return m_LocalPosition;
+    return m_Standalone ? m_LocalPosition : m_TransformStore.GetPosition(m_InternalId);
 }
 
 void Transform::SetLocalPosition(const Vector3f& position)
 {
-    m_LocalPosition = position;
-    m_IsDirty = true;
+    if (m_Standalone)
+        m_LocalPosition = position;
+    else
+        m_TransformStore.SetPosition(m_InternalId, position);
+
+    if (!m_IsDirty)
+        SetDirty();
 }
 
-const Quaternion& Transform::GetLocalRotation() const
+Quaternion Transform::GetLocalRotation() const
 {
-    return m_LocalRotation;
+    return m_Standalone ? m_LocalRotation : m_TransformStore.GetRotation(m_InternalId);
 }
 
 void Transform::SetLocalRotation(const Quaternion& rotation)
 {
-    m_LocalRotation = rotation;
-    m_IsDirty = true;
+    if (m_Standalone)
+        m_LocalRotation = rotation;
+    else
+        m_TransformStore.SetRotation(m_InternalId, rotation);
+
+    if (!m_IsDirty)
+        SetDirty();
 }
 
-const Vector3f& Transform::GetLocalScale() const
+Vector3f Transform::GetLocalScale() const
 {
-    return m_LocalScale;
+    return m_Standalone ? m_LocalScale : m_TransformStore.GetScale(m_InternalId);
 }
 
 void Transform::SetLocalScale(const Vector3f& scale)
 {
-    m_LocalScale = scale;
-    m_IsDirty = true;
+    if (m_Standalone)
+        m_LocalScale = scale;
+    else
+        m_TransformStore.SetScale(m_InternalId, scale);
+
+    if (!m_IsDirty)
+        SetDirty();
 }
 
 Vector3f Transform::GetPosition() const
 {
-    Vector3f position = m_LocalPosition;
-
-    if (m_Parent->GetParent() != nullptr)
+    if (m_IsDirty)
     {
-        position += m_Parent->GetParent()->GetTransform()->GetPosition();
+        CalculateTransformationMatrix();
     }
 
-    return position;
+    return m_Position;
 }
 
 Quaternion Transform::GetRotation() const
 {
-    Quaternion rotation = m_LocalRotation;
-
-    if (m_Parent->GetParent() != nullptr)
+    if (m_IsDirty)
     {
-        rotation = m_Parent->GetParent()->GetTransform()->GetRotation();
-        rotation *= m_LocalRotation;
+        CalculateTransformationMatrix();
     }
 
-    return rotation;
+    return m_Rotation;
 }
 
 Vector3f Transform::GetScale() const
 {
-    Vector3f scale = m_LocalScale;
-
-    if (m_Parent->GetParent() != nullptr)
+    if (m_IsDirty)
     {
-        scale *= m_Parent->GetParent()->GetTransform()->GetScale();
+        CalculateTransformationMatrix();
     }
 
-    return scale;
+    return m_Scale;
 }
 
 Vector3f Transform::GetForward() const
 {
-    return m_LocalRotation * Vector3f(0.f, 0.f, -1.f);
+    return GetRotation() * Vector3f(0.f, 0.f, -1.f);
 }
 
 Vector3f Transform::GetRight() const
 {
-    return m_LocalRotation * Vector3f(1.f, 0.f, 0.f);
+    return GetRotation() * Vector3f(1.f, 0.f, 0.f);
 }
 
 Vector3f Transform::GetUp() const
 {
-    return m_LocalRotation * Vector3f(0.f, 1.f, 0.f);
+    return GetRotation() * Vector3f(0.f, 1.f, 0.f);
 }
 
 const Matrix4f &Transform::GetTransformationMatrix() const
 {
+    if (m_IsDirty)
+    {
+        CalculateTransformationMatrix();
+    }
+
     return m_TransformationMatrix;
 }
 
 Vector3f Transform::GetEulerAngles() const
 {
-    return degrees(eulerAngles(m_LocalRotation));
+    return degrees(eulerAngles(GetLocalRotation()));
 }
 
 void Transform::SetEulerAngles(Vector3f angle)
 {
-    m_LocalRotation = glm::quat(radians(angle));
-    m_IsDirty = true;
+    SetLocalRotation(glm::quat(radians(angle)));
+}
+
+void Transform::UpdateWorldTransforms()
+{
+    // The local matrices only depend on the transform itself, so every out of date one can be built in one go.
+    Threading::ParallelFor(m_TransformStore.GetCount(), BuildGrainSize, [](std::uint32_t begin, std::uint32_t end)
+    {
+        m_TransformStore.BuildMatrices(begin, end);
+    });
+
+    m_DirtyTransforms.clear();
+    m_HierarchyOffsets.clear();
+
+    for (auto& transform : Components::Get<Transform>(true))
+    {
+        if (!transform.m_IsDirty)
+        {
+            continue;
+        }
+
+        // Only start at the highest dirty transform, since everything below it will be dirty as well.
+        const auto parentEntity = transform.m_Parent->GetParent();
+
+        if (parentEntity != nullptr && parentEntity->GetTransform()->m_IsDirty)
+        {
+            continue;
+        }
+
+        m_HierarchyOffsets.push_back(static_cast<std::uint32_t>(m_DirtyTransforms.size()));
+
+        GatherHierarchy(transform.m_Parent);
+    }
+
+    const auto hierarchyCount = static_cast<std::uint32_t>(m_HierarchyOffsets.size());
+
+    m_HierarchyOffsets.push_back(static_cast<std::uint32_t>(m_DirtyTransforms.size()));
+
+    for (const auto transform : m_DirtyTransforms)
+    {
+        transform->QueueChange();
+    }
+
+    // The hierarchies don't overlap, and only read their (already updated) parent's transform.
+    Threading::ParallelFor(hierarchyCount, UpdateGrainSize, [](std::uint32_t begin, std::uint32_t end)
+    {
+        for (std::uint32_t i = m_HierarchyOffsets[begin]; i < m_HierarchyOffsets[end]; i++)
+        {
+            const auto transform = m_DirtyTransforms[i];
+
+            transform->CalculateWorldTransform(m_TransformStore.GetMatrix(transform->m_InternalId));
+        }
+    });
+}
+
+void Transform::EndFrame()
+{
+    m_FrameIndex++;
+}
+
+void Transform::TakeChangedTransforms(std::vector<const Transform*>& transforms)
+{
+    std::lock_guard lock(m_ChangedTransformsMutex);
+
+    transforms.clear();
+
+    for (const auto transform : m_ChangedTransforms)
+    {
+        // Cleared if the transform has been destroyed in the meantime.
+        if (!transform->m_ChangeQueued)
+        {
+            continue;
+        }
+
+        transform->m_ChangeQueued = false;
+
+        transforms.push_back(transform);
+    }
+
+    m_ChangedTransforms.clear();
 }
@@ -3,41 +3,74 @@
 #include "Pine/Core/Math/Math.hpp"
 #include "Pine/World/Components/IComponent/IComponent.hpp"
 
+#include <vector>
+
 namespace Pine
 {
 
     class Transform final : public IComponent
     {
     private:
-        Matrix4f m_TransformationMatrix = Matrix4f(1.f);
-
+        // Only used by standalone transforms, such as the ones within blueprints. Transforms in the world keep
+        // their local transform in the transform store instead, see OnCloned().
         Vector3f m_LocalPosition = Vector3f(0.f);
         Vector3f m_LocalScale = Vector3f(1.f);
         Quaternion m_LocalRotation = glm::identity<glm::quat>();
 
-        bool m_IsDirty = true;
+        // Cached world space transform, recalculated from the parent's cached transform once dirty. These
+        // are mutable since the getters will bring them up to date if they are queried while dirty.
+        mutable Matrix4f m_TransformationMatrix = Matrix4f(1.f);
+        mutable Vector3f m_Position = Vector3f(0.f);
+        mutable Quaternion m_Rotation = glm::identity<glm::quat>();
+        mutable Vector3f m_Scale = Vector3f(1.f);
+
+        // If this transform is dirty, every transform below it in the hierarchy is dirty as well.
+        mutable bool m_IsDirty = true;
+
+        // The frame the world transform was last recalculated in, see HasChanged().
+        mutable std::uint32_t m_UpdateFrame = 0;
+
+        // If the transform is in the list of changed transforms, see TakeChangedTransforms().
+        mutable bool m_ChangeQueued = false;
+
+        void CalculateTransformationMatrix() const;
+
+        void QueueChange() const;
 
-        void CalculateTransformationMatrix();
+        // Updates the cached world transform from the local matrix and the parent's world transform.
+        void CalculateWorldTransform(const Matrix4f& localMatrix) const;
     public:
         explicit Transform();
 
         // If the parent is static, and we want the transform to update, you have
-        // to manually call SetDirty() to update the transformation matrix.
+        // to manually call SetDirty() to update the transformation matrix. Also marks
+        // every transform below this one in the hierarchy as dirty.
         void SetDirty();
         bool IsDirty() const;
 
+        // If the world transform has been recalculated since the last rendered frame.
+        bool HasChanged() const;
+
+        // Moves the copied local transform over to the transform store, for transforms in the world. The
+        // local transform is read from the component's own memory, so the source has to be standalone.
+        void OnCloned() override;
+        void OnDestroyed() override;
+
         void OnRender(float deltaTime) override;
 
         void LoadData(const nlohmann::json& j) override;
         void SaveData(nlohmann::json& j) override;
 
-        const Vector3f& GetLocalPosition() const;
+        void LoadData(Serialization::BinaryReader& reader) override;
+        void SaveData(Serialization::BinaryWriter& writer) override;
+
+        Vector3f GetLocalPosition() const;
         void SetLocalPosition(const Vector3f& position);
 
-        const Quaternion& GetLocalRotation() const;
+        Quaternion GetLocalRotation() const;
         void SetLocalRotation(const Quaternion& rotation);
 
-        const Vector3f& GetLocalScale() const;
+        Vector3f GetLocalScale() const;
         void SetLocalScale(const Vector3f& scale);
 
         Vector3f GetPosition() const;
@@ -52,6 +85,18 @@ namespace Pine
         void SetEulerAngles(Vector3f angle);
 
         const Matrix4f& GetTransformationMatrix() const;
+
+        // Recalculates every dirty transform in the world, top-down from the highest dirty transform
+        // in each hierarchy. The out of date local matrices are built in batches straight from the
+        // transform store, after which separate hierarchies are processed in parallel.
+        static void UpdateWorldTransforms();
+
+        // Should be called once a frame has been rendered, see HasChanged().
+        static void EndFrame();
+
+        // Moves every transform in the world whose world transform has been recalculated since the last call
+        // over to transforms, so systems such as the spatial index only have to go through what actually moved.
+        static void TakeChangedTransforms(std::vector<const Transform*>& transforms);
     };
 
 }
\ No newline at end of file
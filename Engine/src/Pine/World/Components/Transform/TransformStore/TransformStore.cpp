@@ -0,0 +1,208 @@
+#include "TransformStore.hpp"
+
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PINE_TRANSFORM_STORE_SSE
+#include <xmmintrin.h>
+#endif
+
+namespace
+{
+
+#ifdef PINE_TRANSFORM_STORE_SSE
+    // Writes one column of four matrices, where each register holds the same row for all four.
+    void StoreColumn(Pine::Matrix4f* matrices, int column, __m128 x, __m128 y, __m128 z, __m128 w)
+    {
+        _MM_TRANSPOSE4_PS(x, y, z, w);
+
+        _mm_storeu_ps(&matrices[0][column].x, x);
+        _mm_storeu_ps(&matrices[1][column].x, y);
+        _mm_storeu_ps(&matrices[2][column].x, z);
+        _mm_storeu_ps(&matrices[3][column].x, w);
+    }
+#endif
+
+}
+
+void Pine::TransformStore::Reserve(std::uint32_t count)
+{
+    if (count <= m_Count)
+    {
+        return;
+    }
+
+    m_Count = count;
+
+    m_PositionX.resize(count, 0.f);
+    m_PositionY.resize(count, 0.f);
+    m_PositionZ.resize(count, 0.f);
+
+    m_RotationX.resize(count, 0.f);
+    m_RotationY.resize(count, 0.f);
+    m_RotationZ.resize(count, 0.f);
+    m_RotationW.resize(count, 1.f);
+
+    m_ScaleX.resize(count, 1.f);
+    m_ScaleY.resize(count, 1.f);
+    m_ScaleZ.resize(count, 1.f);
+
+    m_Dirty.resize(count, 1);
+    m_Matrices.resize(count, Matrix4f(1.f));
+}
+
+std::uint32_t Pine::TransformStore::GetCount() const
+{
+    return m_Count;
+}
+
+void Pine::TransformStore::Set(std::uint32_t slot, const Vector3f& position, const Quaternion& rotation, const Vector3f& scale)
+{
+    SetPosition(slot, position);
+    SetRotation(slot, rotation);
+    SetScale(slot, scale);
+}
+
+void Pine::TransformStore::SetPosition(std::uint32_t slot, const Vector3f& position)
+{
+    m_PositionX[slot] = position.x;
+    m_PositionY[slot] = position.y;
+    m_PositionZ[slot] = position.z;
+
+    m_Dirty[slot] = 1;
+}
+
+Pine::Vector3f Pine::TransformStore::GetPosition(std::uint32_t slot) const
+{
+    return Vector3f(m_PositionX[slot], m_PositionY[slot], m_PositionZ[slot]);
+}
+
+void Pine::TransformStore::SetRotation(std::uint32_t slot, const Quaternion& rotation)
+{
+    m_RotationX[slot] = rotation.x;
+    m_RotationY[slot] = rotation.y;
+    m_RotationZ[slot] = rotation.z;
+    m_RotationW[slot] = rotation.w;
+
+    m_Dirty[slot] = 1;
+}
+
+Pine::Quaternion Pine::TransformStore::GetRotation(std::uint32_t slot) const
+{
+    return Quaternion(m_RotationW[slot], m_RotationX[slot], m_RotationY[slot], m_RotationZ[slot]);
+}
+
+void Pine::TransformStore::SetScale(std::uint32_t slot, const Vector3f& scale)
+{
+    m_ScaleX[slot] = scale.x;
+    m_ScaleY[slot] = scale.y;
+    m_ScaleZ[slot] = scale.z;
+
+    m_Dirty[slot] = 1;
+}
+
+Pine::Vector3f Pine::TransformStore::GetScale(std::uint32_t slot) const
+{
+    return Vector3f(m_ScaleX[slot], m_ScaleY[slot], m_ScaleZ[slot]);
+}
+
+void Pine::TransformStore::BuildMatrices(std::uint32_t begin, std::uint32_t end)
+{
+    std::uint32_t i = begin;
+
+    // Same as glm's translate(), toMat4() and scale() combined, written out so that it can
+    // be done for four transforms at once.
+#ifdef PINE_TRANSFORM_STORE_SSE
+    const __m128 one = _mm_set1_ps(1.f);
+    const __m128 two = _mm_set1_ps(2.f);
+    const __m128 zero = _mm_setzero_ps();
+
+    for (; i + 4 <= end; i += 4)
+    {
+        std::uint32_t dirty;
+
+        memcpy(&dirty, &m_Dirty[i], sizeof(dirty));
+
+        // Rebuilding the clean matrices next to a dirty one gives the same result, so only
+        // groups of four without any dirty matrix are skipped.
+        if (dirty == 0)
+        {
+            continue;
+        }
+
+        const __m128 x = _mm_loadu_ps(&m_RotationX[i]);
+        const __m128 y = _mm_loadu_ps(&m_RotationY[i]);
+        const __m128 z = _mm_loadu_ps(&m_RotationZ[i]);
+        const __m128 w = _mm_loadu_ps(&m_RotationW[i]);
+
+        const __m128 xx = _mm_mul_ps(x, x);
+        const __m128 yy = _mm_mul_ps(y, y);
+        const __m128 zz = _mm_mul_ps(z, z);
+        const __m128 xy = _mm_mul_ps(x, y);
+        const __m128 xz = _mm_mul_ps(x, z);
+        const __m128 yz = _mm_mul_ps(y, z);
+        const __m128 wx = _mm_mul_ps(w, x);
+        const __m128 wy = _mm_mul_ps(w, y);
+        const __m128 wz = _mm_mul_ps(w, z);
+
+        const __m128 scaleX = _mm_loadu_ps(&m_ScaleX[i]);
+        const __m128 scaleY = _mm_loadu_ps(&m_ScaleY[i]);
+        const __m128 scaleZ = _mm_loadu_ps(&m_ScaleZ[i]);
+
+        const auto matrices = &m_Matrices[i];
+
+        StoreColumn(matrices, 0,
+                    _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(yy, zz))), scaleX),
+                    _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(xy, wz)), scaleX),
+                    _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(xz, wy)), scaleX),
+                    zero);
+
+        StoreColumn(matrices, 1,
+                    _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(xy, wz)), scaleY),
+                    _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, zz))), scaleY),
+                    _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(yz, wx)), scaleY),
+                    zero);
+
+        StoreColumn(matrices, 2,
+                    _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(xz, wy)), scaleZ),
+                    _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(yz, wx)), scaleZ),
+                    _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, yy))), scaleZ),
+                    zero);
+
+        StoreColumn(matrices, 3,
+                    _mm_loadu_ps(&m_PositionX[i]),
+                    _mm_loadu_ps(&m_PositionY[i]),
+                    _mm_loadu_ps(&m_PositionZ[i]),
+                    one);
+
+        memset(&m_Dirty[i], 0, sizeof(dirty));
+    }
+#endif
+
+    for (; i < end; i++)
+    {
+        if (!m_Dirty[i])
+        {
+            continue;
+        }
+
+        const float x = m_RotationX[i];
+        const float y = m_RotationY[i];
+        const float z = m_RotationZ[i];
+        const float w = m_RotationW[i];
+
+        auto& matrix = m_Matrices[i];
+
+        matrix[0] = Vector4f(1.f - 2.f * (y * y + z * z), 2.f * (x * y + w * z), 2.f * (x * z - w * y), 0.f) * m_ScaleX[i];
+        matrix[1] = Vector4f(2.f * (x * y - w * z), 1.f - 2.f * (x * x + z * z), 2.f * (y * z + w * x), 0.f) * m_ScaleY[i];
+        matrix[2] = Vector4f(2.f * (x * z + w * y), 2.f * (y * z - w * x), 1.f - 2.f * (x * x + y * y), 0.f) * m_ScaleZ[i];
+        matrix[3] = Vector4f(m_PositionX[i], m_PositionY[i], m_PositionZ[i], 1.f);
+
+        m_Dirty[i] = 0;
+    }
+}
+
+const Pine::Matrix4f& Pine::TransformStore::GetMatrix(std::uint32_t slot) const
+{
+    return m_Matrices[slot];
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "Pine/Core/Math/Math.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace Pine
+{
+
+    // Structure-of-arrays storage of the local transforms of every Transform in the world, indexed by their
+    // component slot. Keeping them like this allows the local matrices to be built several transforms at a time.
+    class TransformStore
+    {
+    private:
+        std::uint32_t m_Count = 0;
+
+        std::vector<float> m_PositionX;
+        std::vector<float> m_PositionY;
+        std::vector<float> m_PositionZ;
+
+        std::vector<float> m_RotationX;
+        std::vector<float> m_RotationY;
+        std::vector<float> m_RotationZ;
+        std::vector<float> m_RotationW;
+
+        std::vector<float> m_ScaleX;
+        std::vector<float> m_ScaleY;
+        std::vector<float> m_ScaleZ;
+
+        // Set for the slots whose local matrix is out of date.
+        std::vector<std::uint8_t> m_Dirty;
+
+        std::vector<Matrix4f> m_Matrices;
+    public:
+        // Makes sure there is room for the slots [0, count), the store never shrinks.
+        void Reserve(std::uint32_t count);
+
+        std::uint32_t GetCount() const;
+
+        void Set(std::uint32_t slot, const Vector3f& position, const Quaternion& rotation, const Vector3f& scale);
+
+        void SetPosition(std::uint32_t slot, const Vector3f& position);
+        Vector3f GetPosition(std::uint32_t slot) const;
+
+        void SetRotation(std::uint32_t slot, const Quaternion& rotation);
+        Quaternion GetRotation(std::uint32_t slot) const;
+
+        void SetScale(std::uint32_t slot, const Vector3f& scale);
+        Vector3f GetScale(std::uint32_t slot) const;
+
+        // Builds the out of date local matrices (translation * rotation * scale) of the slots in [begin, end),
+        // uses SSE when available. Different ranges may be built from different threads.
+        void BuildMatrices(std::uint32_t begin, std::uint32_t end);
+
+        const Matrix4f& GetMatrix(std::uint32_t slot) const;
+    };
+
+}
@@ -1,6 +1,13 @@
 #include "Entities.hpp"
+#include "Pine/Core/Bits/Bits.hpp"
+#include "Pine/Core/Log/Log.hpp"
+#include "Pine/Core/SlotAllocator/SlotAllocator.hpp"
 #include "Pine/Engine/Engine.hpp"
 
+#include <array>
+#include <limits>
+#include <unordered_map>
+
 using namespace Pine;
 
 namespace
@@ -9,48 +16,261 @@ namespace
     // each entity will have a unique id.
     std::uint32_t m_EntityId = 1;
 
-    // The current set engine configuration for the maximum number of entities in the scene.
-    // Currently, stays constant during the lifespan of the application.
-    std::uint32_t m_MaxEntityCount = 0;
+    // The number of entities stored in each page, pages are allocated on demand and never move,
+    // so entity pointers stay valid while the storage grows.
+    constexpr std::uint32_t EntityPageSlotCount = 256;
+    constexpr std::uint32_t EntityPageSlotShift = 8;
+
+    constexpr std::uint32_t InvalidPosition = std::numeric_limits<std::uint32_t>::max();
+
+    // The pages where all the entity data is actually stored, each holding EntityPageSlotCount entities.
+    std::vector<Entity*> m_EntityPages;
+
+    // Keeps track of which element indices in the entity pages are occupied, hands out free indices
+    // in constant time and caches the current highest element index.
+    SlotAllocator m_EntitySlots;
+
+    // The outwards facing entity list vector, with pointers to the entity pages. This allows us to move
+    // pointers around in this list, without having to move entity data around.
+    std::vector<Entity*> m_EntityPointerList;
+
+    // The position of each entity within m_EntityPointerList, indexed by the entity's slot.
+    std::vector<std::uint32_t> m_EntityListPositions;
+
+    // Deleted entities leave a nullptr behind in m_EntityPointerList, which are all removed in one go the next
+    // time the list is requested, rather than shifting the whole list for each deleted entity.
+    std::uint32_t m_RemovedEntityCount = 0;
 
-    // The array where all the entity data is actually stored, size is m_MaxEntityCount
-    Entity* m_Entities;
+    // Entity id -> slot
+    std::unordered_map<std::uint32_t, std::uint32_t> m_EntityIdSlots;
 
-    // Array which holds if an element index in m_Entities is occupied, also the size of m_MaxEntityCount
-    bool* m_EntityOccupationArray;
+    // Entity name -> slots of the entities with that name, and the position of each entity within
+    // its name's list indexed by the entity's slot, allowing constant time removal.
+    std::unordered_map<std::string, std::vector<std::uint32_t>> m_EntityNames;
+    std::vector<std::uint32_t> m_EntityNamePositions;
 
-    // Get the current highest element index of an entity
-    std::uint32_t GetHighestEntityIndex()
+    // A set of entity slots with constant time insertion and removal, and a dense list to iterate.
+    struct EntitySlotSet
     {
-        std::uint32_t highestIndex = 0;
+        std::vector<std::uint32_t> Slots;
 
-        for (std::uint32_t i = 0; i < m_MaxEntityCount;i++)
+        // The position of each slot within Slots, indexed by the slot. Only allocated once the set is used.
+        std::vector<std::uint32_t> Positions;
+
+        void Insert(std::uint32_t slot)
         {
-            if (m_EntityOccupationArray[i])
-                highestIndex = i + 1;
+            if (slot >= Positions.size())
+            {
+                Positions.resize(m_EntitySlots.GetCapacity(), InvalidPosition);
+            }
+
+            Positions[slot] = static_cast<std::uint32_t>(Slots.size());
+            Slots.push_back(slot);
         }
 
-        return highestIndex;
+        void Remove(std::uint32_t slot)
+        {
+            const auto position = Positions[slot];
+
+            Slots[position] = Slots.back();
+            Positions[Slots[position]] = position;
+
+            Slots.pop_back();
+
+            Positions[slot] = InvalidPosition;
+        }
+
+        void Clear()
+        {
+            for (const auto slot : Slots)
+            {
+                Positions[slot] = InvalidPosition;
+            }
+
+            Slots.clear();
+        }
+    };
+
+    // The entities with each tag bit set.
+    std::array<EntitySlotSet, 64> m_EntityTags;
+
+    Entity* GetEntity(std::uint32_t index)
+    {
+        return &m_EntityPages[index >> EntityPageSlotShift][index & (EntityPageSlotCount - 1)];
     }
 
-    // Cached version of GetHighestEntityIndex()
-    std::uint32_t m_HighestEntityIndex = 0;
+    // Allocates another page of entities, increasing the capacity by EntityPageSlotCount.
+    void AllocateEntityPage()
+    {
+        const auto page = static_cast<Entity*>(malloc(sizeof(Entity) * EntityPageSlotCount));
+
+        if (page == nullptr)
+        {
+            throw std::runtime_error("Failed to allocate entity data.");
+        }
 
-    // Gets the first available element index in m_Entities
-    std::uint32_t GetAvailableEntityIndex()
+        memset(page, 0, sizeof(Entity) * EntityPageSlotCount);
+
+        m_EntityPages.push_back(page);
+        m_EntitySlots.SetCapacity(static_cast<std::uint32_t>(m_EntityPages.size()) * EntityPageSlotCount);
+
+        if (Log::IsEnabled(LogSeverity::Verbose))
+        {
+            Log::Verbose("[Entities] Entity storage grew to {} pages, {}/{} slots used, {:.1f} kB",
+                         m_EntityPages.size(), m_EntitySlots.GetCount(), m_EntitySlots.GetCapacity(), m_EntityPages.size() * EntityPageSlotCount * sizeof(Entity) / 1024.0);
+        }
+
+        m_EntityListPositions.resize(m_EntitySlots.GetCapacity(), InvalidPosition);
+        m_EntityNamePositions.resize(m_EntitySlots.GetCapacity(), InvalidPosition);
+    }
+
+    void AddName(std::uint32_t slot, const std::string& name)
     {
-        for (std::uint32_t i = 0; i < m_MaxEntityCount;i++)
+        auto& slots = m_EntityNames[name];
+
+        m_EntityNamePositions[slot] = static_cast<std::uint32_t>(slots.size());
+
+        slots.push_back(slot);
+    }
+
+    void RemoveName(std::uint32_t slot, const std::string& name)
+    {
+        const auto it = m_EntityNames.find(name);
+
+        if (it == m_EntityNames.end())
         {
-            if (!m_EntityOccupationArray[i])
-                return i;
+            return;
         }
 
-        return m_MaxEntityCount;
+        auto& slots = it->second;
+        const auto position = m_EntityNamePositions[slot];
+
+        slots[position] = slots.back();
+        m_EntityNamePositions[slots[position]] = position;
+
+        slots.pop_back();
+
+        if (slots.empty())
+        {
+            m_EntityNames.erase(it);
+        }
     }
 
-    // The outwards facing entity list vector, with pointers to m_Entities. This allows us to move
-    // pointers around in this list, without having to move entity data around.
-    std::vector<Entity*> m_EntityPointerList;
+    void AddTags(std::uint32_t slot, std::uint64_t tags)
+    {
+        for (; tags != 0; tags &= tags - 1)
+        {
+            m_EntityTags[Bits::CountTrailingZeros(tags)].Insert(slot);
+        }
+    }
+
+    void RemoveTags(std::uint32_t slot, std::uint64_t tags)
+    {
+        for (; tags != 0; tags &= tags - 1)
+        {
+            m_EntityTags[Bits::CountTrailingZeros(tags)].Remove(slot);
+        }
+    }
+
+    void AddToIndices(const Entity* entity)
+    {
+        const auto slot = entity->GetInternalId();
+
+        m_EntityIdSlots[entity->GetId()] = slot;
+
+        AddName(slot, entity->GetName());
+        AddTags(slot, entity->GetTags());
+    }
+
+    void RemoveFromIndices(const Entity* entity)
+    {
+        const auto slot = entity->GetInternalId();
+
+        m_EntityIdSlots.erase(entity->GetId());
+
+        RemoveName(slot, entity->GetName());
+        RemoveTags(slot, entity->GetTags());
+    }
+
+    void ClearIndices()
+    {
+        m_EntityIdSlots.clear();
+        m_EntityNames.clear();
+
+        for (auto& tag : m_EntityTags)
+        {
+            tag.Clear();
+        }
+    }
+
+    void AddToList(Entity* entity)
+    {
+        m_EntityListPositions[entity->GetInternalId()] = static_cast<std::uint32_t>(m_EntityPointerList.size());
+        m_EntityPointerList.push_back(entity);
+    }
+
+    // Returns true if the entity is part of the world and hasn't been deleted.
+    bool IsListed(const Entity* entity)
+    {
+        if (entity == nullptr)
+        {
+            return false;
+        }
+
+        const auto internalId = entity->GetInternalId();
+
+        return internalId < m_EntityListPositions.size() &&
+               m_EntityListPositions[internalId] < m_EntityPointerList.size() &&
+               m_EntityPointerList[m_EntityListPositions[internalId]] == entity;
+    }
+
+    // Removes the entries left behind by deleted entities, keeping the order of the remaining ones.
+    void CompactEntityList()
+    {
+        if (m_RemovedEntityCount == 0)
+        {
+            return;
+        }
+
+        std::uint32_t position = 0;
+
+        for (const auto entity : m_EntityPointerList)
+        {
+            if (entity == nullptr)
+                continue;
+
+            m_EntityListPositions[entity->GetInternalId()] = position;
+            m_EntityPointerList[position++] = entity;
+        }
+
+        m_EntityPointerList.resize(position);
+
+        m_RemovedEntityCount = 0;
+    }
+
+    Entity* CreateEntity(bool addTransform)
+    {
+        // Also marks the slot as occupied
+        auto availableEntityIndex = m_EntitySlots.Allocate();
+
+        if (availableEntityIndex >= m_EntitySlots.GetCapacity())
+        {
+            // Out of space, grow the storage by another page
+            AllocateEntityPage();
+
+            availableEntityIndex = m_EntitySlots.Allocate();
+        }
+
+        const auto entityPtr = GetEntity(availableEntityIndex);
+
+        // Call constructor on the entity
+        new(entityPtr) Entity(m_EntityId++, availableEntityIndex, addTransform);
+
+        AddToList(entityPtr);
+        AddToIndices(entityPtr);
+
+        return entityPtr;
+    }
 
     // See https://stackoverflow.com/a/57399634
     template <typename t> void MoveElementInVector(std::vector<t>& v, std::size_t oldIndex, std::size_t newIndex)
@@ -65,50 +285,39 @@ namespace
 
 void Entities::Setup()
 {
-    m_MaxEntityCount = Engine::GetEngineConfiguration().m_MaxObjectCount;
-
-    m_Entities = static_cast<Entity*>(malloc((sizeof(Entity) * m_MaxEntityCount) + 1));
-    m_EntityOccupationArray = new bool[m_MaxEntityCount];
+    // Entity pages are allocated as entities are created, the configured object count
+    // is only used as a hint for the outwards facing list.
+    m_EntityPointerList.reserve(Engine::GetEngineConfiguration().m_MaxObjectCount);
+}
 
-    if (m_Entities == nullptr || m_MaxEntityCount == 0)
+void Entities::Shutdown()
+{
+    for (const auto page : m_EntityPages)
     {
-        throw std::runtime_error("Failed to allocate entity data.");
+        free(page);
     }
 
-    memset(m_Entities, 0, sizeof(Entity) * m_MaxEntityCount);
-    memset(m_EntityOccupationArray, 0, sizeof(bool) * m_MaxEntityCount);
+    m_EntityPages.clear();
 
-    m_EntityPointerList.reserve(m_MaxEntityCount);
-}
-
-void Entities::Shutdown()
-{
-    free(m_Entities);
-    delete[] m_EntityOccupationArray;
+    m_EntitySlots = SlotAllocator();
 
     m_EntityPointerList.clear();
-}
+    m_EntityListPositions.clear();
+    m_RemovedEntityCount = 0;
 
-Entity* Entities::Create()
-{
-    const auto availableEntityIndex = GetAvailableEntityIndex();
+    ClearIndices();
 
-    if (availableEntityIndex == m_MaxEntityCount)
+    m_EntityNamePositions.clear();
+
+    for (auto& tag : m_EntityTags)
     {
-        throw std::runtime_error("Maximum entity count reached.");
+        tag.Positions.clear();
     }
+}
 
-    const auto entityPtr = &m_Entities[availableEntityIndex];
-
-    // Call constructor on the entity
-    new(entityPtr) Entity(m_EntityId++, availableEntityIndex);
-
-    // Mark the slot as occupied
-    m_EntityOccupationArray[availableEntityIndex] = true;
-
-    m_EntityPointerList.push_back(entityPtr);
-
-    return entityPtr;
+Entity* Entities::Create()
+{
+    return CreateEntity(true);
 }
 
 Entity* Entities::Create(const std::string& name)
@@ -120,66 +329,143 @@ Entity* Entities::Create(const std::string& name)
     return entity;
 }
 
+Entity* Entities::CreateEmpty()
+{
+    return CreateEntity(false);
+}
+
+void Entities::Reserve(std::uint32_t count)
+{
+    while (m_EntitySlots.GetAvailableCount() < count)
+    {
+        AllocateEntityPage();
+    }
+
+    m_EntityPointerList.reserve(m_EntityPointerList.size() + count);
+}
+
+StorageUsage Entities::GetStorageUsage()
+{
+    return { static_cast<std::uint32_t>(m_EntityPages.size()), m_EntitySlots.GetCount(), m_EntitySlots.GetCapacity(), m_EntityPages.size() * EntityPageSlotCount * sizeof(Entity) };
+}
+
 Entity* Entities::Find(const std::string& name)
 {
-    for (const auto entity : m_EntityPointerList)
+    const auto it = m_EntityNames.find(name);
+
+    if (it == m_EntityNames.end())
+    {
+        return nullptr;
+    }
+
+    // Several entities may share the name, in which case the first one in the entity list is returned.
+    auto firstSlot = it->second.front();
+
+    for (const auto slot : it->second)
     {
-        if (entity->GetName() == name)
-            return entity;
+        if (m_EntityListPositions[slot] < m_EntityListPositions[firstSlot])
+        {
+            firstSlot = slot;
+        }
     }
 
-    return nullptr;
+    return GetEntity(firstSlot);
 }
 
 Entity* Entities::Find(std::uint32_t id)
 {
-    for (const auto entity : m_EntityPointerList)
+    const auto it = m_EntityIdSlots.find(id);
+
+    if (it == m_EntityIdSlots.end())
     {
-        if (entity->GetId() == id)
-            return entity;
+        return nullptr;
     }
 
-    return nullptr;
+    return GetEntity(it->second);
 }
 
-bool Entities::Delete(const Entity* entity)
+std::vector<Entity*> Entities::FindByTag(std::uint64_t tags)
 {
-    bool foundEntity = false;
+    std::vector<Entity*> entities;
 
-    // First remove the entity from the pointer list
-    for (int i = 0; i < m_EntityPointerList.size();i++)
+    for (auto remainingTags = tags; remainingTags != 0; remainingTags &= remainingTags - 1)
     {
-        if (m_EntityPointerList[i] == entity)
-        {
-            m_EntityPointerList.erase(m_EntityPointerList.begin() + i);
+        const auto tag = Bits::CountTrailingZeros(remainingTags);
 
-            foundEntity = true;
+        for (const auto slot : m_EntityTags[tag].Slots)
+        {
+            const auto entity = GetEntity(slot);
 
-            break;
+            // Entities with several of the tags are only added through the lowest one.
+            if (Bits::CountTrailingZeros(entity->GetTags() & tags) == tag)
+            {
+                entities.push_back(entity);
+            }
         }
     }
 
-    if (!foundEntity)
+    return entities;
+}
+
+std::vector<Entity*> Entities::FindAllWithTags(std::uint64_t tags)
+{
+    std::vector<Entity*> entities;
+
+    if (tags == 0)
     {
-        return false;
+        return entities;
     }
 
-    const auto highestEntityIndex = GetHighestEntityIndex();
+    // Go through the least used tag, and check the rest of the tags for each of those entities.
+    const EntitySlotSet* smallestSet = nullptr;
 
-    for (std::uint32_t i = 0; i < highestEntityIndex;i++)
+    for (auto remainingTags = tags; remainingTags != 0; remainingTags &= remainingTags - 1)
     {
-        if (!m_EntityOccupationArray[i])
-            continue;
+        const auto& set = m_EntityTags[Bits::CountTrailingZeros(remainingTags)];
 
-        if (m_Entities[i].GetId() == entity->GetId())
+        if (smallestSet == nullptr || set.Slots.size() < smallestSet->Slots.size())
         {
-            m_Entities[i].~Entity();
-            m_EntityOccupationArray[i] = false;
+            smallestSet = &set;
+        }
+    }
+
+    for (const auto slot : smallestSet->Slots)
+    {
+        const auto entity = GetEntity(slot);
 
-            return true;
+        if ((entity->GetTags() & tags) == tags)
+        {
+            entities.push_back(entity);
         }
     }
 
+    return entities;
+}
+
+bool Entities::Delete(const Entity* entity)
+{
+    // The internal id is the element index, so no need to go looking for the entity.
+    if (!IsListed(entity))
+    {
+        return false;
+    }
+
+    const auto internalId = entity->GetInternalId();
+
+    // First remove the entity from the pointer list, the entry is cleaned up the next time the list is requested.
+    m_EntityPointerList[m_EntityListPositions[internalId]] = nullptr;
+    m_RemovedEntityCount++;
+
+    RemoveFromIndices(entity);
+
+    if (m_EntitySlots.IsOccupied(internalId) && GetEntity(internalId) == entity)
+    {
+        GetEntity(internalId)->~Entity();
+        m_EntitySlots.Free(internalId);
+
+        return true;
+    }
+
     // If we've reached this point, something has gone terribly wrong.
 
     throw std::runtime_error("Failed to find entity pointer while removing entity.");
@@ -189,82 +475,103 @@ void Entities::DeleteAll(bool includeTemporary)
 {
     if (includeTemporary)
     {
-        for (std::uint32_t i = 0; i < GetHighestEntityIndex();i++)
+        for (std::uint32_t i = m_EntitySlots.FindNextOccupied(0); i < m_EntitySlots.GetHighestSlot(); i = m_EntitySlots.FindNextOccupied(i + 1))
         {
-            if (!m_EntityOccupationArray[i])
-                continue;
-
-            m_Entities[i].~Entity();
-            m_EntityOccupationArray[i] = false;
+            GetEntity(i)->~Entity();
+            m_EntitySlots.Free(i);
         }
 
         m_EntityPointerList.clear();
+        m_RemovedEntityCount = 0;
+
+        ClearIndices();
 
         return;
     }
 
     std::vector<Entity*> entitiesToRestore;
 
-    const auto highestEntityIndex = GetHighestEntityIndex();
-
-    Components::SetIgnoreHighestEntityIndexFlag(true);
-
-    for (std::uint32_t i = 0; i < highestEntityIndex;i++)
+    for (std::uint32_t i = m_EntitySlots.FindNextOccupied(0); i < m_EntitySlots.GetHighestSlot(); i = m_EntitySlots.FindNextOccupied(i + 1))
     {
-        if (!m_EntityOccupationArray[i])
-            continue;
-
-        if (m_Entities[i].GetTemporary())
+        if (GetEntity(i)->GetTemporary())
         {
-            entitiesToRestore.push_back(&m_Entities[i]);
+            entitiesToRestore.push_back(GetEntity(i));
         }
         else
         {
-            m_Entities[i].~Entity();
-            m_EntityOccupationArray[i] = false;
+            GetEntity(i)->~Entity();
+            m_EntitySlots.Free(i);
         }
     }
 
-    Components::SetIgnoreHighestEntityIndexFlag(false);
-    Components::RecomputeHighestComponentIndex();
-
     m_EntityPointerList.clear();
+    m_RemovedEntityCount = 0;
+
+    ClearIndices();
 
     for (auto entity : entitiesToRestore)
     {
-        m_EntityPointerList.push_back(entity);
+        AddToList(entity);
+        AddToIndices(entity);
     }
 }
 
 const std::vector<Entity*>& Entities::GetList()
 {
+    CompactEntityList();
+
     return m_EntityPointerList;
 }
 
 void Entities::MoveEntity(const Entity* entity, std::size_t newIndex)
 {
-    bool foundEntity = false;
-    std::size_t oldIndex = 0;
+    CompactEntityList();
 
-    for (std::size_t i = 0; i < m_EntityPointerList.size();i++)
-    {
-        if (m_EntityPointerList[i]->GetId() == entity->GetId())
-        {
-            foundEntity = true;
-            oldIndex = i;
-            break;
-        }
-    }
-
-    if (!foundEntity)
+    if (!IsListed(entity))
     {
         throw std::runtime_error("MoveEntity() called on invalid entity pointer.");
     }
 
+    const std::size_t oldIndex = m_EntityListPositions[entity->GetInternalId()];
+
     MoveElementInVector(m_EntityPointerList, oldIndex, newIndex);
+
+    // Only the entities between the old and new index have been shifted.
+    for (std::size_t i = std::min(oldIndex, newIndex); i <= std::max(oldIndex, newIndex); i++)
+    {
+        m_EntityListPositions[m_EntityPointerList[i]->GetInternalId()] = static_cast<std::uint32_t>(i);
+    }
 }
 
 Entity *Entities::GetByInternalId(std::uint32_t internalId)
 {
-    return &m_Entities[internalId];
+    // Ids may come from scripts or the editor, and refer to an entity that has since been deleted.
+    if (!m_EntitySlots.IsOccupied(internalId))
+    {
+        return nullptr;
+    }
+
+    return GetEntity(internalId);
+}
+
+void Entities::OnEntityRenamed(const Entity* entity, const std::string& oldName)
+{
+    if (!IsListed(entity))
+    {
+        return;
+    }
+
+    RemoveName(entity->GetInternalId(), oldName);
+    AddName(entity->GetInternalId(), entity->GetName());
 }
+
+void Entities::OnEntityTagsChanged(const Entity* entity, std::uint64_t oldTags)
+{
+    if (!IsListed(entity))
+    {
+        return;
+    }
+
+    RemoveTags(entity->GetInternalId(), oldTags);
+    AddTags(entity->GetInternalId(), entity->GetTags());
+}
\ No newline at end of file
@@ -10,17 +10,38 @@ namespace Pine::Entities
     Entity* Create();
     Entity* Create(const std::string& name);
 
+    // Creates an entity without the default Transform component, which has to be
+    // attached by the caller before the entity is used.
+    Entity* CreateEmpty();
+
+    // Makes sure at least count more entities can be created without allocating.
+    void Reserve(std::uint32_t count);
+
+    StorageUsage GetStorageUsage();
+
+    // Returns the first entity in the entity list with the name, or nullptr if none is found.
     Entity* Find(const std::string& name);
     Entity* Find(std::uint32_t id);
 
+    // Returns all entities with any of the specified tag bits set.
+    std::vector<Entity*> FindByTag(std::uint64_t tags);
+
+    // Returns all entities with every one of the specified tag bits set.
+    std::vector<Entity*> FindAllWithTags(std::uint64_t tags);
+
     Entity* GetByInternalId(std::uint32_t internalId);
 
     bool Delete(const Entity* entity);
     void DeleteAll(bool includeTemporary = false);
 
+    // Please note that deleting entities while iterating this list is not allowed, copy the list first.
     const std::vector<Entity*>& GetList();
 
     // Allows you to move the specified entity.
     // newIndex specifying the element index in the vector itself.
     void MoveEntity(const Entity* entity, std::size_t newIndex);
+
+    // Used by Entity to keep the lookup indices up to date as the name or tags of a world entity change.
+    void OnEntityRenamed(const Entity* entity, const std::string& oldName);
+    void OnEntityTagsChanged(const Entity* entity, std::uint64_t oldTags);
 }
\ No newline at end of file
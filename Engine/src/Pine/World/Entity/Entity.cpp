@@ -1,18 +1,22 @@
 #include "Entity.hpp"
 #include "Pine/Core/Log/Log.hpp"
 #include "Pine/World/Entities/Entities.hpp"
+#include "Pine/World/SpatialIndex/SpatialIndex.hpp"
 
 Pine::Entity::Entity(std::uint32_t id)
     : m_Id(id)
 {
 }
 
-Pine::Entity::Entity(std::uint32_t id, std::uint32_t internalId)
+Pine::Entity::Entity(std::uint32_t id, std::uint32_t internalId, bool addTransform)
         : m_Id(id), m_InternalId(internalId)
 {
     CreateScriptHandle();
 
-    AddComponent<Transform>();
+    if (addTransform)
+    {
+        AddComponent<Transform>();
+    }
 }
 
 Pine::Entity::~Entity()
@@ -28,6 +32,8 @@ Pine::Entity::~Entity()
     }
 
     m_Components.clear();
+    m_ComponentSlots.fill(nullptr);
+    m_ComponentMask = 0;
 
     // If the id is zero, this entity is not part of the world, therefore we'll have to do things
     // a bit more manually.
@@ -70,7 +76,15 @@ std::uint32_t Pine::Entity::GetInternalId() const
 
 void Pine::Entity::SetActive(bool value)
 {
+    if (m_Active == value)
+        return;
+
     m_Active = value;
+
+    for (auto component : m_Components)
+    {
+        component->OnEnabledChanged();
+    }
 }
 
 bool Pine::Entity::GetActive() const
@@ -80,7 +94,16 @@ bool Pine::Entity::GetActive() const
 
 void Pine::Entity::SetStatic(bool value)
 {
+    if (m_Static == value)
+        return;
+
     m_Static = value;
+
+    // The spatial index keeps static and dynamic objects in separate trees.
+    for (auto component : m_Components)
+    {
+        SpatialIndex::QueueUpdate(component);
+    }
 }
 
 bool Pine::Entity::GetStatic() const
@@ -90,7 +113,14 @@ bool Pine::Entity::GetStatic() const
 
 void Pine::Entity::SetTags(std::uint64_t tags)
 {
+    if (m_Tags == tags)
+        return;
+
+    const auto oldTags = m_Tags;
+
     m_Tags = tags;
+
+    Entities::OnEntityTagsChanged(this, oldTags);
 }
 
 std::uint64_t Pine::Entity::GetTags() const
@@ -120,7 +150,14 @@ bool Pine::Entity::GetTemporary() const
 
 void Pine::Entity::SetName(const std::string& name)
 {
+    if (m_Name == name)
+        return;
+
+    const auto oldName = std::move(m_Name);
+
     m_Name = name;
+
+    Entities::OnEntityRenamed(this, oldName);
 }
 
 const std::string& Pine::Entity::GetName() const
@@ -131,6 +168,13 @@ const std::string& Pine::Entity::GetName() const
 void Pine::Entity::SetParent(Entity* entity)
 {
     m_Parent = entity;
+
+    // The world transform depends on the parent, entities that are still being
+    // put together may not have their Transform yet though.
+    if (const auto transform = m_ComponentSlots[static_cast<int>(ComponentType::Transform)])
+    {
+        static_cast<Transform*>(transform)->SetDirty();
+    }
 }
 
 Pine::Entity* Pine::Entity::GetParent() const
@@ -159,16 +203,24 @@ Pine::IComponent* Pine::Entity::AddComponent(ComponentType type)
 
     m_Components.push_back(component);
 
+    AddComponentSlot(component);
+
     return component;
 }
 
-Pine::IComponent* Pine::Entity::AddComponent(IComponent* component)
+Pine::IComponent* Pine::Entity::AddComponent(IComponent* component, bool callOnCreated)
 {
     component->SetParent(this);
-    component->OnCreated();
+
+    if (callOnCreated)
+    {
+        component->OnCreated();
+    }
 
     m_Components.push_back(component);
 
+    AddComponentSlot(component);
+
     return component;
 }
 
@@ -182,6 +234,8 @@ bool Pine::Entity::RemoveComponent(const IComponent* targetComponent)
         {
             m_Components.erase(m_Components.begin() + i);
 
+            RemoveComponentSlot(component);
+
             if (Components::Destroy(component))
                 return true;
         }
@@ -198,36 +252,36 @@ void Pine::Entity::ClearComponents()
     }
 
     m_Components.clear();
+    m_ComponentSlots.fill(nullptr);
+    m_ComponentMask = 0;
 }
 
 Pine::IComponent * Pine::Entity::GetComponent(ComponentType type) const
 {
-    for (auto component : m_Components)
-    {
-        if (component && component->GetType() == type)
-        {
-            return component;
-        }
-    }
-
-    return nullptr;
+    return m_ComponentSlots[static_cast<int>(type)];
 }
 
 bool Pine::Entity::HasComponent(ComponentType type) const
 {
-    return GetComponent(type) != nullptr;
+    return m_ComponentMask & (1u << static_cast<int>(type));
+}
+
+std::uint32_t Pine::Entity::GetComponentMask() const
+{
+    return m_ComponentMask;
 }
 
 Pine::Transform* Pine::Entity::GetTransform() const
 {
-    if (m_Components.empty())
+    const auto transform = m_ComponentSlots[static_cast<int>(ComponentType::Transform)];
+
+    // The transform component should always be available in all entities.
+    if (transform == nullptr)
     {
         throw std::runtime_error("Entity does not contain Transform component");
     }
 
-    // The transform component should always be the first component
-    // and should be available in all entities.
-    return dynamic_cast<Transform*>(m_Components[0]);
+    return static_cast<Transform*>(transform);
 }
 
 const std::vector<Pine::IComponent*>& Pine::Entity::GetComponents() const
@@ -270,6 +324,40 @@ const std::vector<Pine::Entity*>& Pine::Entity::GetChildren() const
     return m_Children;
 }
 
+void Pine::Entity::AddComponentSlot(IComponent* component)
+{
+    const auto type = static_cast<int>(component->GetType());
+
+    if (m_ComponentSlots[type] == nullptr)
+    {
+        m_ComponentSlots[type] = component;
+        m_ComponentMask |= 1u << type;
+    }
+}
+
+void Pine::Entity::RemoveComponentSlot(const IComponent* component)
+{
+    const auto type = static_cast<int>(component->GetType());
+
+    if (m_ComponentSlots[type] != component)
+    {
+        return;
+    }
+
+    m_ComponentSlots[type] = nullptr;
+    m_ComponentMask &= ~(1u << type);
+
+    // Fall back to the next component of the same type, if there is one.
+    for (const auto otherComponent : m_Components)
+    {
+        if (otherComponent->GetType() == component->GetType())
+        {
+            AddComponentSlot(otherComponent);
+            break;
+        }
+    }
+}
+
 void Pine::Entity::Delete()
 {
     Entities::Delete(this);
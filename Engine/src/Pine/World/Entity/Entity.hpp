@@ -3,6 +3,7 @@
 #include "Pine/World/Components/IComponent/IComponent.hpp"
 #include "Pine/World/Components/Transform/Transform.hpp"
 #include "Pine/Script/Factory/ScriptObjectFactory.hpp"
+#include <array>
 #include <cstdint>
 #include <string>
 #include <vector>
@@ -34,14 +35,22 @@ namespace Pine
         std::vector<IComponent*> m_Components;
         std::vector<Entity*> m_Children;
 
+        // One bit per ComponentType the entity has, and the first component of each type, so typed
+        // lookups don't have to go through m_Components.
+        std::uint32_t m_ComponentMask = 0;
+        std::array<IComponent*, ComponentTypeCount> m_ComponentSlots {};
+
         Script::ObjectHandle m_EntityScriptHandle = { nullptr, 0 };
 
         Entity* m_Parent = nullptr;
 
         //AssetHandle<Blueprint> m_AssetBlueprint;
+
+        void AddComponentSlot(IComponent* component);
+        void RemoveComponentSlot(const IComponent* component);
     public:
         explicit Entity(std::uint32_t id);
-        Entity(std::uint32_t id, std::uint32_t internalId);
+        Entity(std::uint32_t id, std::uint32_t internalId, bool addTransform = true);
         ~Entity();
 
         std::uint32_t GetId() const;
@@ -87,6 +96,8 @@ namespace Pine
 
             m_Components.push_back(&component);
 
+            AddComponentSlot(&component);
+
             return &component;
         }
 
@@ -95,23 +106,33 @@ namespace Pine
 
         // Attaches an existing component to the entity, please prefer to use
         // the other AddComponent()'s if you want to create a new component though.
-        IComponent* AddComponent(IComponent* component);
+        // If callOnCreated is false, the caller is responsible for calling OnCreated().
+        IComponent* AddComponent(IComponent* component, bool callOnCreated = true);
 
         // Removes the first component with the specified type from the entity, returns
         // true if any component was removed.
         template <typename T>
         bool RemoveComponent()
         {
-            for (auto& component : m_Components)
+            if constexpr (ComponentTypeTrait<T>::Valid)
             {
-                if (typeid(*component) == typeid(T))
+                const auto component = m_ComponentSlots[static_cast<int>(ComponentTypeTrait<T>::Type)];
+
+                return component != nullptr && RemoveComponent(component);
+            }
+            else
+            {
+                for (auto& component : m_Components)
                 {
-                    if (RemoveComponent(component))
-                        return true;
+                    if (typeid(*component) == typeid(T))
+                    {
+                        if (RemoveComponent(component))
+                            return true;
+                    }
                 }
-            }
 
-            return false;
+                return false;
+            }
         }
 
         // Removes the component with the provided pointer, returns false on failure.
@@ -126,27 +147,44 @@ namespace Pine
         template<typename T>
         T* GetComponent()
         {
-            for (auto component : m_Components)
+            if constexpr (ComponentTypeTrait<T>::Valid)
             {
-                if (component && typeid(*component) == typeid(T))
+                return static_cast<T*>(m_ComponentSlots[static_cast<int>(ComponentTypeTrait<T>::Type)]);
+            }
+            else
+            {
+                for (auto component : m_Components)
                 {
-                    return dynamic_cast<T*>(component);
+                    if (component && typeid(*component) == typeid(T))
+                    {
+                        return dynamic_cast<T*>(component);
+                    }
                 }
-            }
 
-            return nullptr;
+                return nullptr;
+            }
         }
 
         template<typename T>
         bool HasComponent()
         {
-            return GetComponent<T>() != nullptr;
+            if constexpr (ComponentTypeTrait<T>::Valid)
+            {
+                return m_ComponentMask & (1u << static_cast<int>(ComponentTypeTrait<T>::Type));
+            }
+            else
+            {
+                return GetComponent<T>() != nullptr;
+            }
         }
 
         IComponent* GetComponent(ComponentType type) const;
 
         bool HasComponent(ComponentType type) const;
 
+        // One bit per ComponentType attached to the entity.
+        std::uint32_t GetComponentMask() const;
+
         // Returns the transform component for the entity, will
         // never be nullptr.
         Transform* GetTransform() const;
@@ -0,0 +1,120 @@
+#pragma once
+#include "Pine/Threading/Threading.hpp"
+#include "Pine/World/Components/Components.hpp"
+#include "Pine/World/Entity/Entity.hpp"
+
+#include <array>
+#include <cstdint>
+#include <tuple>
+#include <vector>
+
+namespace Pine::World
+{
+
+    // A view over the entities that have every one of the component types T. The matching components are
+    // gathered into a packed list as the view is created, so iterating it doesn't have to go through the
+    // entities anymore. Entities created or deleted afterwards aren't reflected, create a new view each time.
+    template<typename... T>
+    class QueryView
+    {
+    private:
+        static_assert(sizeof...(T) > 0, "A query needs at least one component type.");
+        static_assert((ComponentTypeTrait<T>::Valid && ...), "Only engine component types may be queried.");
+
+        static constexpr std::uint32_t RequiredMask = ((1u << static_cast<int>(ComponentTypeTrait<T>::Type)) | ...);
+
+        std::vector<std::tuple<T*...>> m_Entries;
+    public:
+        explicit QueryView(bool includeInactive)
+        {
+            constexpr std::array<ComponentType, sizeof...(T)> types = { ComponentTypeTrait<T>::Type... };
+
+            // Go through the component type with the fewest components, and filter out the entities
+            // missing any of the other types through their component mask.
+            auto driverType = types[0];
+
+            for (const auto type : types)
+            {
+                if (Components::GetData(type).GetComponentCount() < Components::GetData(driverType).GetComponentCount())
+                {
+                    driverType = type;
+                }
+            }
+
+            auto& block = Components::GetData(driverType);
+
+            block.m_IterateDisabledObjects = includeInactive;
+
+            m_Entries.reserve(block.GetComponentCount());
+
+            for (auto& component : block)
+            {
+                const auto entity = component.GetParent();
+
+                if (entity == nullptr || (entity->GetComponentMask() & RequiredMask) != RequiredMask)
+                {
+                    continue;
+                }
+
+                std::tuple<T*...> entry = { entity->template GetComponent<T>()... };
+
+                // The block only checks the driving component, so check the rest of them as well.
+                if (!includeInactive && !(std::get<T*>(entry)->GetActive() && ...))
+                {
+                    continue;
+                }
+
+                m_Entries.push_back(entry);
+            }
+        }
+
+        // Calls fn(T&...) for every matching entity.
+        template<typename F>
+        void ForEach(const F& fn) const
+        {
+            for (const auto& entry : m_Entries)
+            {
+                fn(*std::get<T*>(entry)...);
+            }
+        }
+
+        // Calls fn(T&...) for every matching entity spread across the worker threads, returns once all of
+        // them are done. Only use this for systems that either only read, or only write to their own entity.
+        template<typename F>
+        void ForEachParallel(const F& fn, std::uint32_t grainSize = 64) const
+        {
+            Threading::ParallelFor(static_cast<std::uint32_t>(m_Entries.size()), grainSize, [this, &fn](std::uint32_t begin, std::uint32_t end)
+            {
+                for (std::uint32_t i = begin; i < end; i++)
+                {
+                    fn(*std::get<T*>(m_Entries[i])...);
+                }
+            });
+        }
+
+        std::size_t GetCount() const
+        {
+            return m_Entries.size();
+        }
+
+        // Allows iterating the view with structured bindings, i.e. for (auto [transform, rigidBody] : query)
+        auto begin() const
+        {
+            return m_Entries.begin();
+        }
+
+        auto end() const
+        {
+            return m_Entries.end();
+        }
+    };
+
+    // Returns a view over every enabled entity with all of the specified components, for example
+    // World::Query<Transform, RigidBody>().ForEach([](Transform& transform, RigidBody& rigidBody) { ... });
+    template<typename... T>
+    QueryView<T...> Query(bool includeInactive = false)
+    {
+        return QueryView<T...>(includeInactive);
+    }
+
+}
@@ -0,0 +1,304 @@
+#include "SpatialIndex.hpp"
+
+#include "Pine/Rendering/Renderer3D/Specifications.hpp"
+#include "Pine/World/Components/Components.hpp"
+#include "Pine/World/Components/Light/Light.hpp"
+#include "Pine/World/Components/ModelRenderer/ModelRenderer.hpp"
+#include "Pine/World/Components/Transform/Transform.hpp"
+#include "Pine/World/Entity/Entity.hpp"
+
+#include <cmath>
+
+using namespace Pine;
+
+namespace
+{
+    // Moving objects get a margin so they don't have to be re-inserted every frame, static objects
+    // are expected to stay where they are.
+    constexpr float DynamicMargin = 0.5f;
+    constexpr float StaticMargin = 0.f;
+
+    struct ComponentTrees
+    {
+        DynamicAABBTree Static = DynamicAABBTree(StaticMargin);
+        DynamicAABBTree Dynamic = DynamicAABBTree(DynamicMargin);
+
+        DynamicAABBTree& Get(bool isStatic)
+        {
+            return isStatic ? Static : Dynamic;
+        }
+    };
+
+    ComponentTrees m_ModelRendererTrees;
+    ComponentTrees m_LightTrees;
+
+    // Components queued with SpatialIndex::QueueUpdate(), and the transforms taken from Transform every update.
+    std::vector<IComponent*> m_PendingUpdates;
+    std::vector<const Transform*> m_ChangedTransforms;
+
+    ComponentTrees* GetTrees(ComponentType type)
+    {
+        switch (type)
+        {
+            case ComponentType::ModelRenderer:
+                return &m_ModelRendererTrees;
+            case ComponentType::Light:
+                return &m_LightTrees;
+            default:
+                return nullptr;
+        }
+    }
+
+    // Fits an axis aligned box around the model's bounding box transformed by the matrix.
+    AABB GetWorldBounds(const Model* model, const Matrix4f& matrix)
+    {
+        const auto localCenter = (model->GetBoundingBoxMin() + model->GetBoundingBoxMax()) * 0.5f;
+        const auto localExtent = (model->GetBoundingBoxMax() - model->GetBoundingBoxMin()) * 0.5f;
+
+        const auto center = Vector3f(matrix * Vector4f(localCenter, 1.f));
+        Vector3f extent(0.f);
+
+        for (int axis = 0; axis < 3; axis++)
+        {
+            extent += glm::abs(Vector3f(matrix[axis])) * localExtent[axis];
+        }
+
+        return { center - extent, center + extent };
+    }
+
+    // Places the proxy in the correct tree with the new bounds, creating it if needed.
+    void UpdateProxy(ComponentTrees& trees, IComponent* component, std::int32_t& proxy, bool& proxyStatic, bool isStatic, const AABB& bounds)
+    {
+        if (proxy != DynamicAABBTree::NullNode && proxyStatic != isStatic)
+        {
+            trees.Get(proxyStatic).DestroyProxy(proxy);
+            proxy = DynamicAABBTree::NullNode;
+        }
+
+        auto& tree = trees.Get(isStatic);
+
+        if (proxy == DynamicAABBTree::NullNode)
+        {
+            proxy = tree.CreateProxy(bounds, component);
+        }
+        else
+        {
+            tree.MoveProxy(proxy, bounds);
+        }
+
+        proxyStatic = isStatic;
+    }
+
+    void RemoveProxy(ComponentTrees& trees, std::int32_t& proxy, bool proxyStatic)
+    {
+        if (proxy == DynamicAABBTree::NullNode)
+        {
+            return;
+        }
+
+        trees.Get(proxyStatic).DestroyProxy(proxy);
+        proxy = DynamicAABBTree::NullNode;
+    }
+
+    // Returns the queued flag of a model renderer or light, or nullptr for any other type.
+    bool* GetUpdateQueued(IComponent* component)
+    {
+        switch (component->GetType())
+        {
+            case ComponentType::ModelRenderer:
+                return &dynamic_cast<ModelRenderer*>(component)->GetRenderingHintData().SpatialUpdateQueued;
+            case ComponentType::Light:
+                return &dynamic_cast<Light*>(component)->GetLightHintData().SpatialUpdateQueued;
+            default:
+                return nullptr;
+        }
+    }
+
+    void UpdateModelRenderer(ModelRenderer* modelRenderer)
+    {
+        auto& data = modelRenderer->GetRenderingHintData();
+
+        const auto entity = modelRenderer->GetParent();
+        const auto model = modelRenderer->GetModel();
+
+        if (model == nullptr)
+        {
+            RemoveProxy(m_ModelRendererTrees, data.SpatialProxy, data.SpatialStatic);
+            return;
+        }
+
+        data.WorldBounds = GetWorldBounds(model, entity->GetTransform()->GetTransformationMatrix());
+
+        UpdateProxy(m_ModelRendererTrees, modelRenderer, data.SpatialProxy, data.SpatialStatic, entity->GetStatic(), data.WorldBounds);
+    }
+
+    void UpdateLight(Light* light)
+    {
+        auto& data = light->GetLightHintData();
+
+        if (light->GetLightType() == LightType::Directional)
+        {
+            RemoveProxy(m_LightTrees, data.SpatialProxy, data.SpatialStatic);
+            return;
+        }
+
+        const auto entity = light->GetParent();
+        const auto position = entity->GetTransform()->GetPosition();
+        const float range = std::min(light->GetRange(), Renderer3D::Specifications::General::MAX_LIGHT_RANGE);
+
+        UpdateProxy(m_LightTrees, light, data.SpatialProxy, data.SpatialStatic, entity->GetStatic(), { position - Vector3f(range), position + Vector3f(range) });
+    }
+
+    void UpdateComponent(IComponent* component)
+    {
+        if (component->GetType() == ComponentType::ModelRenderer)
+        {
+            UpdateModelRenderer(dynamic_cast<ModelRenderer*>(component));
+        }
+        else if (component->GetType() == ComponentType::Light)
+        {
+            UpdateLight(dynamic_cast<Light*>(component));
+        }
+    }
+
+    template<typename F>
+    void ForEachTree(ComponentType type, const F& fn)
+    {
+        const auto trees = GetTrees(type);
+
+        if (trees == nullptr)
+        {
+            return;
+        }
+
+        fn(trees->Static);
+        fn(trees->Dynamic);
+    }
+}
+
+void SpatialIndex::Update()
+{
+    for (auto component : m_PendingUpdates)
+    {
+        auto queued = GetUpdateQueued(component);
+
+        // The flag is cleared if the component has been removed in the meantime.
+        if (!*queued)
+        {
+            continue;
+        }
+
+        *queued = false;
+
+        if (component->GetParent() != nullptr)
+        {
+            UpdateComponent(component);
+        }
+    }
+
+    m_PendingUpdates.clear();
+
+    Transform::TakeChangedTransforms(m_ChangedTransforms);
+
+    for (const auto transform : m_ChangedTransforms)
+    {
+        for (const auto component : transform->GetParent()->GetComponents())
+        {
+            UpdateComponent(component);
+        }
+    }
+}
+
+void SpatialIndex::QueueUpdate(IComponent* component)
+{
+    const auto queued = GetUpdateQueued(component);
+
+    if (queued == nullptr || component->GetStandalone() || *queued)
+    {
+        return;
+    }
+
+    *queued = true;
+
+    m_PendingUpdates.push_back(component);
+}
+
+void SpatialIndex::Remove(IComponent* component)
+{
+    if (component->GetStandalone())
+    {
+        return;
+    }
+
+    if (component->GetType() == ComponentType::ModelRenderer)
+    {
+        auto& data = dynamic_cast<ModelRenderer*>(component)->GetRenderingHintData();
+
+        RemoveProxy(m_ModelRendererTrees, data.SpatialProxy, data.SpatialStatic);
+
+        // Any queued update will be skipped, as the component's memory may get reused.
+        data.SpatialUpdateQueued = false;
+    }
+    else if (component->GetType() == ComponentType::Light)
+    {
+        auto& data = dynamic_cast<Light*>(component)->GetLightHintData();
+
+        RemoveProxy(m_LightTrees, data.SpatialProxy, data.SpatialStatic);
+
+        data.SpatialUpdateQueued = false;
+    }
+}
+
+void SpatialIndex::Clear()
+{
+    for (auto trees : { &m_ModelRendererTrees, &m_LightTrees })
+    {
+        trees->Static.Clear();
+        trees->Dynamic.Clear();
+    }
+}
+
+std::uint32_t SpatialIndex::GetCount(ComponentType type)
+{
+    std::uint32_t count = 0;
+
+    ForEachTree(type, [&](const DynamicAABBTree& tree)
+    {
+        count += tree.GetProxyCount();
+    });
+
+    return count;
+}
+
+void SpatialIndex::QueryBounds(ComponentType type, const AABB& bounds, std::vector<IComponent*>& results)
+{
+    ForEachTree(type, [&](const DynamicAABBTree& tree)
+    {
+        tree.Query(bounds, [&](std::int32_t, void* userData)
+        {
+            results.push_back(static_cast<IComponent*>(userData));
+        });
+    });
+}
+
+void SpatialIndex::QuerySphere(ComponentType type, const Vector3f& center, float radius, std::vector<IComponent*>& results)
+{
+    ForEachTree(type, [&](const DynamicAABBTree& tree)
+    {
+        tree.QuerySphere(center, radius, [&](std::int32_t, void* userData)
+        {
+            results.push_back(static_cast<IComponent*>(userData));
+        });
+    });
+}
+
+void SpatialIndex::QueryFrustum(ComponentType type, const std::array<Vector4f, 6>& planes, std::vector<IComponent*>& results)
+{
+    ForEachTree(type, [&](const DynamicAABBTree& tree)
+    {
+        tree.QueryFrustum(planes, [&](std::int32_t, void* userData)
+        {
+            results.push_back(static_cast<IComponent*>(userData));
+        });
+    });
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "Pine/Core/DynamicAABBTree/DynamicAABBTree.hpp"
+#include "Pine/World/Components/IComponent/IComponent.hpp"
+
+#include <array>
+#include <vector>
+
+// Spatial index over the world's model renderers and lights, so that culling and light assignment
+// don't have to go through every single component. Every type is split into a static and a dynamic
+// tree depending on Entity::GetStatic(), so static objects stay out of the tree that changes every frame.
+namespace Pine::SpatialIndex
+{
+
+    // Brings the index up to date with the model renderers and lights that have been queued, or whose
+    // transform has changed, since the last update. Called by the render manager every frame.
+    void Update();
+
+    // Queues the model renderer or light to be refit by the next Update(), called as they are created
+    // or have their model, range or static flag changed. Any other component type is ignored.
+    void QueueUpdate(IComponent* component);
+
+    // Removes the component from the index, called as model renderers and lights are destroyed.
+    void Remove(IComponent* component);
+
+    void Clear();
+
+    // The number of indexed components of the type.
+    std::uint32_t GetCount(ComponentType type);
+
+    // The queries below append every model renderer or light (depending on type) whose fattened bounds pass
+    // the test to results, which may include disabled components. Lights are indexed by their range, and
+    // directional lights aren't part of the index at all.
+    void QueryBounds(ComponentType type, const AABB& bounds, std::vector<IComponent*>& results);
+    void QuerySphere(ComponentType type, const Vector3f& center, float radius, std::vector<IComponent*>& results);
+    void QueryFrustum(ComponentType type, const std::array<Vector4f, 6>& planes, std::vector<IComponent*>& results);
+
+}
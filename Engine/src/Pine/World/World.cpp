@@ -1,4 +1,3 @@
-#include <GLFW/glfw3.h>
 #include "World.hpp"
 #include "Pine/Assets/Level/Level.hpp"
 #include "Pine/Physics/Physics3D/Physics3D.hpp"
@@ -7,6 +6,7 @@
 #include "Pine/Script/ScriptManager.hpp"
 #include "Pine/Core/Log/Log.hpp"
 #include "Pine/Performance/Performance.hpp"
+#include "Pine/Engine/Engine.hpp"
 #include "Pine/Physics/Physics2D/Physics2D.hpp"
 
 namespace
@@ -25,7 +25,7 @@ namespace
     double CalculateFrameTime()
     {
         // Calculate delta time
-        m_CurrentTime = glfwGetTime();
+        m_CurrentTime = Pine::Engine::GetTime();
 
         if (m_LastRenderTime == 0.0)
         {
@@ -63,10 +63,7 @@ void Pine::World::SetActiveLevel(Level *level, bool ignoreLoad)
 
     m_Level = level;
 
-    for (auto& transform : Components::Get<Pine::Transform>())
-    {
-        transform.OnRender(0.f);
-    }
+    Transform::UpdateWorldTransforms();
 }
 
 Pine::Level *Pine::World::GetActiveLevel()
@@ -90,6 +87,8 @@ void Pine::World::Update()
 
     const auto deltaTime = CalculateFrameTime();
 
+    Transform::UpdateWorldTransforms();
+
     Physics3D::Update(deltaTime);
     Physics2D::Update(deltaTime);
 
@@ -1,21 +1,48 @@
 #include <Pine/Pine.hpp>
+#include <Pine/Performance/Performance.hpp>
 
-int main()
+#include <string>
+
+int main(int argc, char* argv[])
 {
+    // Passing --trace <file> records a profiler capture of the whole run, which can be opened in Perfetto.
+    std::string tracePath;
+
+    for (int i = 1; i < argc - 1; i++)
+    {
+        if (std::string(argv[i]) == "--trace")
+        {
+            tracePath = argv[i + 1];
+        }
+    }
+
     Pine::Engine::EngineConfiguration engineConfiguration;
 
     engineConfiguration.m_WindowTitle = "Pine Game Host";
     engineConfiguration.m_WindowSize = Pine::Vector2i(1920, 1080);
+    engineConfiguration.m_LogFilePath = "game.log";
 
     if (!Pine::Engine::Setup(engineConfiguration))
     {
         return 0;
     }
 
-    Pine::Assets::LoadDirectory("game/assets");
+    // Prefer the cooked assets written by the editor if there are any.
+    Pine::Assets::LoadDirectory(std::filesystem::exists("game/cooked") ? "game/cooked" : "game/assets");
+
+    if (!tracePath.empty())
+    {
+        // The trace is streamed to the file as the game runs, so long sessions don't keep every event in memory.
+        Pine::Performance::StartCapture(tracePath);
+    }
 
     Pine::Engine::Run();
 
+    if (!tracePath.empty())
+    {
+        Pine::Performance::StopCapture();
+    }
+
     Pine::Engine::Shutdown();
 
     return 0;
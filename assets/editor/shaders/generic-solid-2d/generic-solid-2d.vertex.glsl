@@ -20,16 +20,26 @@ uniform mat4 m_ViewMatrix;
 
 uniform vec2 m_Scaling;
 
+// Transforms the instance positions and sizes, used by tilemaps which store their positions in tiles, and text
+// which stores its glyphs relative to the start of the text.
+uniform vec4 m_InstanceTransform;
+uniform vec2 m_InstanceSizeScale;
+uniform vec2 m_InstanceSizeOffset;
+uniform vec4 m_InstanceColor;
+
 void main()
 {
     // Set instance data to the fragment shader
     m_PassVertexPosition = m_Vertex;
-    m_PassColor = m_Color;
+    m_PassColor = m_Color * m_InstanceColor;
     m_PassUvTransform = m_UvTransform;
     m_PassTextureIndexRadius = m_TextureIndexRadius.xy;
 
     // Set vertex UV
     m_PassUv = m_Uv;
 
-    gl_Position = m_ProjectionMatrix * m_ViewMatrix * (vec4(m_PositionScale.xy, 0, 0) + vec4(m_Vertex.xy, 0, 1) * vec4(m_PositionScale.zw * m_Scaling, 0, 1));
+    vec2 instancePosition = m_PositionScale.xy * m_InstanceTransform.xy + m_InstanceTransform.zw + m_PositionScale.zw * m_InstanceSizeOffset;
+    vec2 instanceSize = m_PositionScale.zw * m_InstanceSizeScale;
+
+    gl_Position = m_ProjectionMatrix * m_ViewMatrix * (vec4(instancePosition, 0, 0) + vec4(m_Vertex.xy, 0, 1) * vec4(instanceSize * m_Scaling, 0, 1));
 }
\ No newline at end of file
@@ -15,7 +15,6 @@ struct BaseResult
 {
     vec3 diffuse;
     vec3 specular;
-    vec3 ambient;
 };
 
 #include "shared/common.glsl"
@@ -27,8 +26,9 @@ in VertexData
     vec3 cameraPos;
 	vec3 cameraDir;
 	vec3 normalDir;
-	vec3 lightDir[8];
-    flat int lightIndices[8];
+	vec3 viewPosition;
+	vec3 directionalLightDir;
+	mat3 tangentMatrix;
 }vIn;
 
 uniform TextureSamplers textureSamplers;
@@ -63,21 +63,30 @@ BaseResult calculateBaseLightning(vec3 lightDirection, int lightIndex)
     vec3 halfwayDirection = normalize(lightDirection + vIn.cameraDir);
     float specularFactor = pow(max(dot(normal, halfwayDirection), 0.0), material.shininess);
 
-    vec3 ambient = (material.ambientColor + (worldAmbientColor * diffuseColor)) * texture(textureSamplers.diffuse, vIn.uv * material.uvScale).xyz;
     vec3 diffuse = lights[lightIndex].color * diffuseColor * texture(textureSamplers.diffuse, vIn.uv * material.uvScale).xyz * diffuseFactor;
     vec3 specular = lights[lightIndex].color * material.specularColor * (1 - texture(textureSamplers.specular, vIn.uv * material.uvScale).xyz) * specularFactor;
 
     result.diffuse = diffuse;
     result.specular = specular;
-    //result.ambient = max(0.5 - diffuseFactor, 0) * ambient;
-    result.ambient = ambient;
 
     return result;
 }
 
+// The ambient light is applied once on its own, so it doesn't depend on the scene having a directional light.
+vec3 calculateAmbientLight()
+{
+#if defined(OVERRIDE_MAT_COLORS)
+    vec3 diffuseColor = override.diffuseColor;
+#else
+    vec3 diffuseColor = material.diffuseColor;
+#endif
+
+    return (material.ambientColor + (worldAmbientColor * diffuseColor)) * texture(textureSamplers.diffuse, vIn.uv * material.uvScale).xyz;
+}
+
 vec3 calculateDirectionalLight()
 {
-    BaseResult result = calculateBaseLightning(vIn.lightDir[0], 0);
+    BaseResult result = calculateBaseLightning(vIn.directionalLightDir, 0);
 
     if (hasDirectionalShadowMap)
     {
@@ -135,15 +144,18 @@ vec3 calculateDirectionalLight()
 
     }
 
-    return result.diffuse + result.specular + result.ambient;
+    return result.diffuse + result.specular;
 }
 
-vec3 calculateSpotLight(int index, int directionIndex)
+// Point and spot lights.
+vec3 calculateLocalLight(int index)
 {
-    BaseResult baseResult = calculateBaseLightning(vIn.lightDir[directionIndex], index);
+    vec3 lightOffset = lights[index].position - vIn.worldPosition;
+    float lightDistance = length(lightOffset);
+    vec3 lightDirection = lightOffset / lightDistance;
+
+    BaseResult baseResult = calculateBaseLightning(vIn.tangentMatrix * lightDirection, index);
 
-    float lightDistance = length(lights[index].position - vIn.worldPosition);
-    
     // x component being the constant factor, y is the linear factor and z the quadratic factor
     vec3 attenuationFactors = lights[index].attenuation;
 
@@ -151,59 +163,48 @@ vec3 calculateSpotLight(int index, int directionIndex)
                                attenuationFactors.y * lightDistance + 
                                attenuationFactors.z * (lightDistance * lightDistance));
 
-    baseResult.diffuse *= attenuation;
-    baseResult.specular *= attenuation;
-    
-    return baseResult.diffuse + baseResult.specular + baseResult.ambient;
-}
-
-vec3 calculatePointLight(int index, int directionIndex)
-{
-    BaseResult baseResult = calculateBaseLightning(vIn.lightDir[directionIndex], index);
+    if (lights[index].type == LIGHT_TYPE_SPOT)
+    {
+        float lightRotationDirection = dot(lightDirection, -lights[index].rotation);
 
-    float lightDistance = length(lights[index].position - vIn.worldPosition);
-    
-    // x component being the constant factor, y is the linear factor and z the quadratic factor
-    vec3 attenuationFactors = lights[index].attenuation;
+        attenuation *= smoothstep(lights[index].cutOffAngle, lights[index].cutOffSmoothness, lightRotationDirection);
+    }
 
-    float attenuation = 1.0 / (attenuationFactors.x +
-                               attenuationFactors.y * lightDistance + 
-                               attenuationFactors.z * (lightDistance * lightDistance));
+    return (baseResult.diffuse + baseResult.specular) * attenuation;
+}
 
-    baseResult.diffuse *= attenuation;
-    baseResult.specular *= attenuation;
+// Finds the light cluster this fragment is in, see LightClusters.cpp for how the clusters are laid out.
+int getLightCluster()
+{
+    vec4 clipPosition = projectionMatrix * vec4(vIn.viewPosition, 1.0);
+    vec2 tile = (clipPosition.xy / clipPosition.w * 0.5 + 0.5) * vec2(LIGHT_CLUSTER_X, LIGHT_CLUSTER_Y);
 
-    float lightRotationDirection = dot(vIn.lightDir[index], -lights[index].rotation);
-    float lightRotationDirectionStep = smoothstep(lights[index].cutOffAngle, lights[index].cutOffSmoothness, lightRotationDirection);
+    float depth = max(-vIn.viewPosition.z, 0.0001);
+    float slice = (clusterParameters.z > 0.5 ? depth : log(depth)) * clusterParameters.x + clusterParameters.y;
 
-    baseResult.diffuse *= lightRotationDirectionStep;
-    baseResult.specular *= lightRotationDirectionStep;
+    ivec3 cluster = clamp(ivec3(vec3(tile, slice)), ivec3(0), ivec3(LIGHT_CLUSTER_X - 1, LIGHT_CLUSTER_Y - 1, LIGHT_CLUSTER_Z - 1));
 
-    return baseResult.diffuse + baseResult.specular + baseResult.ambient;
+    return cluster.x + cluster.y * LIGHT_CLUSTER_X + cluster.z * LIGHT_CLUSTER_X * LIGHT_CLUSTER_Y;
 }
 
-vec3 calculateSpotLights()
+vec3 calculateClusterLights()
 {
-    vec3 lightColorOutput = vec3(0.f);
+    int clusterIndex = getLightCluster();
+    uint cluster = clusters[clusterIndex / 4][clusterIndex % 4];
 
-    for (int i = 0; i < 5;i++) {
-        if (vIn.lightIndices[i] != 0) {
-            lightColorOutput += calculateSpotLight(vIn.lightIndices[i], i + 1);
-        }
-    }
+    int offset = int(cluster & 0xFFFFu);
+    int count = int(cluster >> 16);
 
-    return lightColorOutput;
-}
+    vec3 lightColorOutput = vec3(0.0);
 
-vec3 calculatePointLights()
-{
-    vec3 a = vec3(0.f);
+    for (int i = offset; i < offset + count; i++)
+    {
+        int lightIndex = int((clusterLightIndices[i / 16][(i / 4) % 4] >> uint((i % 4) * 8)) & 0xFFu);
 
-    if (vIn.lightIndices[5] != 0) {
-        a = calculatePointLight(vIn.lightIndices[5], 6);
+        lightColorOutput += calculateLocalLight(lightIndex);
     }
 
-    return a;
+    return lightColorOutput;
 }
 
 void main(void)
@@ -219,11 +220,11 @@ void main(void)
     }
 #endif
 
-    vec4 directionalLight = vec4(calculateDirectionalLight(), 1.0);
-    vec4 spotLights = vec4(calculateSpotLights(), 1.0);
-    vec4 pointLights = vec4(calculatePointLights(), 1.0);
+    vec4 ambientLight = vec4(calculateAmbientLight(), 1.0);
+    vec4 directionalLight = vec4(calculateDirectionalLight(), 0.0);
+    vec4 clusterLights = vec4(calculateClusterLights(), 0.0);
 
-    m_OutputColor = directionalLight + spotLights + pointLights;
+    m_OutputColor = ambientLight + directionalLight + clusterLights;
 
     #shader postFragment
 }
\ No newline at end of file
@@ -14,27 +14,17 @@ out VertexData
 	vec3 cameraPos;
 	vec3 cameraDir;
 	vec3 normalDir;
-	vec3 lightDir[8];
-    flat int lightIndices[8];
+	vec3 viewPosition;
+	vec3 directionalLightDir;
+
+	// Converts world space directions into the space the lightning is calculated in.
+	mat3 tangentMatrix;
 }vOut;
 
 uniform bool hasTangentData;
 
 #shader hooks
 
-void writeLightIndices()
-{
-    vOut.lightIndices[0] = instances[gl_InstanceID].lightIndices[0].x;
-    vOut.lightIndices[1] = instances[gl_InstanceID].lightIndices[0].y;
-    vOut.lightIndices[2] = instances[gl_InstanceID].lightIndices[0].z;
-    vOut.lightIndices[3] = instances[gl_InstanceID].lightIndices[0].w;
-
-    vOut.lightIndices[4] = instances[gl_InstanceID].lightIndices[1].x;
-    vOut.lightIndices[5] = instances[gl_InstanceID].lightIndices[1].y;
-    vOut.lightIndices[6] = instances[gl_InstanceID].lightIndices[1].z;
-    vOut.lightIndices[7] = instances[gl_InstanceID].lightIndices[1].w;
-}
-
 void main()
 {
 	vec4 vertexPosition = vec4(vertex, 1.0);
@@ -44,23 +34,17 @@ void main()
 
 	vOut.worldPosition = (transformationMatrix * vertexPosition).xyz;
 	vOut.uv = uv;
+	vOut.viewPosition = (viewMatrix * vec4(vOut.worldPosition, 1.0)).xyz;
 	vOut.cameraPos = (inverse(viewMatrix) * vec4(0.0, 0.0, 0.0, 1.0)).xyz;
 
-	writeLightIndices();
-
 	// Apply object transformation to our normal vector
 	vec3 worldNormalDir = normalize((transformationMatrix * vec4(normal, 0.0)).xyz);
 	
 	// Extract the camera origin from the view matrix, and calculate the direction from the vertex.
 	vec3 cameraDir = normalize(vOut.cameraPos - vOut.worldPosition.xyz);	
 
-	// Pass everything directly in world space
-	vOut.lightDir[0] = normalize(lights[0].rotation);
-
-    for (int i = 1; i < 6;i++)
-    {
-    	vOut.lightDir[i] = normalize(lights[vOut.lightIndices[i - 1]].position - vOut.worldPosition.xyz);
-    }
+	// Pass everything directly in world space, point and spot light directions are calculated per fragment.
+	vOut.directionalLightDir = normalize(lights[0].rotation);
 
 	if (hasTangentData)
 	{
@@ -75,18 +59,15 @@ void main()
 			worldTangent.z, worldBiTangent.z, worldNormalDir.z
 		);
 
-		vOut.lightDir[0] = tangentMatrix * vOut.lightDir[0];
-
-		for (int i = 1; i < 6;i++)
-		{
-			vOut.lightDir[i] = tangentMatrix * vOut.lightDir[i];
-		}	
+		vOut.directionalLightDir = tangentMatrix * vOut.directionalLightDir;
 
+		vOut.tangentMatrix = tangentMatrix;
 		vOut.cameraDir = tangentMatrix * cameraDir;
 		vOut.normalDir = tangentMatrix * worldNormalDir;
 	}
 	else
 	{
+		vOut.tangentMatrix = mat3(1.0);
 		vOut.cameraDir = cameraDir;
 		vOut.normalDir = worldNormalDir;
 	}
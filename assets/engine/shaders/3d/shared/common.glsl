@@ -6,12 +6,24 @@
 	vec3 attenuation;
 	float cutOffAngle;
 	float cutOffSmoothness;
+	int type;
 };
 
+// Needs to match LightType within the engine.
+#define LIGHT_TYPE_DIRECTIONAL 0
+#define LIGHT_TYPE_POINT 1
+#define LIGHT_TYPE_SPOT 2
+
+// Needs to match Renderer3D::Specifications::LightClusters
+#define LIGHT_CLUSTER_X 16
+#define LIGHT_CLUSTER_Y 9
+#define LIGHT_CLUSTER_Z 16
+#define LIGHT_CLUSTER_COUNT (LIGHT_CLUSTER_X * LIGHT_CLUSTER_Y * LIGHT_CLUSTER_Z)
+#define LIGHT_CLUSTER_MAX_LIGHT_INDICES 6144
+
 struct Instance
 {
 	mat4 transformationMatrix;
-	ivec4 lightIndices[2];
 };
 
 layout(std140) uniform Matrices
@@ -27,7 +39,7 @@ layout(std140) uniform Instances
 
 layout(std140) uniform Lights
 {
-	Light lights[32];
+	Light lights[192];
     vec3 worldAmbientColor;
 };
 
@@ -43,4 +55,16 @@ layout(std140) uniform Material
 layout(std140) uniform Shadows
 {
 	mat4 lightSpaceMatrix[8];
+};
+
+layout(std140) uniform LightClusters
+{
+	// Maps the view space depth onto a cluster slice, z is 1 for linear slices and 0 for logarithmic ones.
+	vec4 clusterParameters;
+
+	// The offset into clusterLightIndices in the lower 16 bits, and the amount of lights in the upper 16 bits.
+	uvec4 clusters[LIGHT_CLUSTER_COUNT / 4];
+
+	// Four 8-bit light indices packed into every component, starting at the lowest bits.
+	uvec4 clusterLightIndices[LIGHT_CLUSTER_MAX_LIGHT_INDICES / 16];
 };
\ No newline at end of file